@@ -0,0 +1,567 @@
+/*!
+ * \file src/archive.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for footprint library archives (fpw --archive).
+ *
+ * An archive holds all footprints of a library build in one file, so
+ * the tools which use the library do not pay for thousands of small
+ * files in directory lookups, inodes and rsync time.\n
+ * The archive starts with a header and an index sorted on name, so a
+ * footprint is found by a binary search in the mapped archive, without
+ * reading the other footprints.\n
+ * A footprint is stored as is or as a gzip stream.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifdef HAVE_ZLIB_H
+#  include <zlib.h>
+#endif
+
+#include "archive.h"
+
+
+/*!
+ * \brief Write all of a buffer at an offset of a file.
+ *
+ * \return \c EXIT_SUCCESS when the buffer was written,
+ * \c EXIT_FAILURE when it was not, \c errno is set.
+ */
+static int
+archive_pwrite
+(
+        gint fd,
+                /*!< : the file descriptor.*/
+        const gchar *buffer,
+                /*!< : the buffer.*/
+        gsize size,
+                /*!< : the size of the buffer.*/
+        guint64 offset
+                /*!< : the offset in the file.*/
+)
+{
+        gssize written;
+
+        while (size > 0)
+        {
+                written = pwrite (fd, buffer, size, offset);
+                if ((written < 0) && (errno == EINTR))
+                {
+                        continue;
+                }
+                if (written <= 0)
+                {
+                        if (written == 0)
+                        {
+                                errno = EIO;
+                        }
+                        return (EXIT_FAILURE);
+                }
+                buffer += written;
+                size -= written;
+                offset += written;
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Close an archive.
+ */
+void
+archive_close
+(
+        archive_t *archive
+                /*!< : the archive, may be \c NULL.*/
+)
+{
+        if (!archive)
+        {
+                return;
+        }
+        g_mapped_file_unref (archive->file);
+        g_free (archive);
+}
+
+
+/*!
+ * \brief Compress a footprint into a gzip stream.
+ *
+ * \return \c EXIT_SUCCESS when the footprint was compressed, the
+ * \c compressed text is to be freed with g_free (), \c EXIT_FAILURE
+ * when fpw was built without zlib.
+ */
+int
+archive_compress
+(
+        const gchar *text,
+                /*!< : the footprint text.*/
+        gsize size,
+                /*!< : the size of the footprint text.*/
+        gchar **compressed,
+                /*!< : is set to the gzip stream.*/
+        gsize *compressed_size
+                /*!< : is set to the size of the gzip stream.*/
+)
+{
+#ifdef HAVE_ZLIB_H
+        z_stream stream;
+
+        memset (&stream, 0, sizeof (stream));
+        if (deflateInit2 (&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+                return (EXIT_FAILURE);
+        }
+        *compressed = g_malloc (deflateBound (&stream, size));
+        stream.next_in = (Bytef *) text;
+        stream.avail_in = size;
+        stream.next_out = (Bytef *) *compressed;
+        stream.avail_out = deflateBound (&stream, size);
+        if (deflate (&stream, Z_FINISH) != Z_STREAM_END)
+        {
+                deflateEnd (&stream);
+                g_free (*compressed);
+                *compressed = NULL;
+                return (EXIT_FAILURE);
+        }
+        *compressed_size = stream.total_out;
+        deflateEnd (&stream);
+        return (EXIT_SUCCESS);
+#else
+        return (EXIT_FAILURE);
+#endif /* HAVE_ZLIB_H */
+}
+
+
+/*!
+ * \brief Append a footprint to an archive which is being written.
+ *
+ * The room for the footprint is taken from \c end with an atomic add,
+ * so any number of processes and threads can append to the same archive
+ * at the same time.\n
+ * The \c entry is filled in, but for its name.
+ *
+ * \return \c EXIT_SUCCESS when the footprint was appended,
+ * \c EXIT_FAILURE when it was not, \c errno is set.
+ */
+int
+archive_append
+(
+        gint fd,
+                /*!< : the file descriptor of the archive.*/
+        guint64 *end,
+                /*!< : the end of the footprints in the archive, in memory
+                 * shared by the writers.*/
+        const gchar *text,
+                /*!< : the footprint text.*/
+        gsize size,
+                /*!< : the size of the footprint text.*/
+        archive_compression_t compression,
+                /*!< : the compression of the footprint.*/
+        archive_entry_t *entry
+                /*!< : is filled in.*/
+)
+{
+        gchar *compressed = NULL;
+        gsize compressed_size = 0;
+        gint result;
+
+        if ((compression == ARCHIVE_GZIP) &&
+                (archive_compress (text, size, &compressed, &compressed_size) == EXIT_FAILURE))
+        {
+                errno = ENOTSUP;
+                return (EXIT_FAILURE);
+        }
+        entry->compression = compression;
+        entry->original_size = size;
+        entry->size = compressed ? compressed_size : size;
+        entry->offset = __sync_fetch_and_add (end, entry->size);
+        result = archive_pwrite (fd, compressed ? compressed : text, entry->size, entry->offset);
+        g_free (compressed);
+        return (result);
+}
+
+
+/*!
+ * \brief Extract footprints from an archive into a directory.
+ *
+ * \return \c EXIT_SUCCESS when the footprints were extracted,
+ * \c EXIT_FAILURE when a footprint could not be extracted.
+ */
+int
+archive_extract
+(
+        archive_t *archive,
+                /*!< : the archive.*/
+        const gchar *directory,
+                /*!< : the directory.*/
+        const gchar *name
+                /*!< : the name of the footprint to extract, \c NULL to
+                 * extract all footprints.*/
+)
+{
+        gchar *text;
+        gchar *filename;
+        gsize size;
+        gint index;
+        gint result = EXIT_SUCCESS;
+        guint first = 0;
+        guint last = archive->count;
+        guint i;
+
+        if (g_mkdir_with_parents (directory, 0755) != 0)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create output directory %s."),
+                                directory);
+                }
+                return (EXIT_FAILURE);
+        }
+        if (name)
+        {
+                index = archive_lookup (archive, name);
+                if (index < 0)
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("footprint %s is not in the archive."),
+                                        name);
+                        }
+                        return (EXIT_FAILURE);
+                }
+                first = index;
+                last = index + 1;
+        }
+        for (i = first; i < last; i++)
+        {
+                /* A name is a filename without a directory, so nothing is
+                 * extracted outside the directory. */
+                if (strchr (archive_get_name (archive, i), G_DIR_SEPARATOR) ||
+                        (archive_get_name (archive, i)[0] == '.'))
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("skipped footprint %s: not a filename."),
+                                        archive_get_name (archive, i));
+                        }
+                        result = EXIT_FAILURE;
+                        continue;
+                }
+                filename = g_build_filename (directory, archive_get_name (archive, i), NULL);
+                text = archive_read (archive, i, &size);
+                if (!text ||
+                        (uring_pwrite_file (filename, text, size) == EXIT_FAILURE))
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("could not extract footprint %s."),
+                                        filename);
+                        }
+                        result = EXIT_FAILURE;
+                }
+                g_free (text);
+                g_free (filename);
+        }
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("extracted %u footprints into %s."),
+                        last - first, directory);
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Get the name of a footprint in an archive.
+ *
+ * \return the name, owned by the archive.
+ */
+const gchar *
+archive_get_name
+(
+        archive_t *archive,
+                /*!< : the archive.*/
+        guint index
+                /*!< : the index of the footprint.*/
+)
+{
+        return (archive->names + GUINT64_FROM_LE (archive->entries[index].name_offset));
+}
+
+
+/*!
+ * \brief Look up a footprint in an archive by name.
+ *
+ * The index is sorted on name, so this is a binary search in the mapped
+ * archive.
+ *
+ * \return the index of the footprint, -1 when it is not in the archive.
+ */
+gint
+archive_lookup
+(
+        archive_t *archive,
+                /*!< : the archive.*/
+        const gchar *name
+                /*!< : the name of the footprint.*/
+)
+{
+        guint low = 0;
+        guint high = archive->count;
+        guint middle;
+        gint order;
+
+        while (low < high)
+        {
+                middle = low + (high - low) / 2;
+                order = strcmp (name, archive_get_name (archive, middle));
+                if (order == 0)
+                {
+                        return (middle);
+                }
+                if (order < 0)
+                {
+                        high = middle;
+                }
+                else
+                {
+                        low = middle + 1;
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Open an archive for reading.
+ *
+ * The archive is mapped and its header and index are checked, so the
+ * footprints can be read without further checks.
+ *
+ * \return the archive, \c NULL when it could not be opened or is not a
+ * valid archive.
+ */
+archive_t *
+archive_open
+(
+        const gchar *filename
+                /*!< : the name of the archive.*/
+)
+{
+        archive_t *archive;
+        archive_header_t header;
+        const archive_entry_t *entry;
+        guint64 names_offset;
+        guint64 end;
+        guint i;
+
+        archive = g_new0 (archive_t, 1);
+        archive->file = g_mapped_file_new (filename, FALSE, NULL);
+        if (!archive->file)
+        {
+                g_free (archive);
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not open archive %s."),
+                                filename);
+                }
+                return (NULL);
+        }
+        archive->data = g_mapped_file_get_contents (archive->file);
+        archive->size = g_mapped_file_get_length (archive->file);
+        if (archive->size < sizeof (header))
+        {
+                goto invalid;
+        }
+        memcpy (&header, archive->data, sizeof (header));
+        if (memcmp (header.magic, ARCHIVE_MAGIC, sizeof (header.magic)) ||
+                (GUINT32_FROM_LE (header.version) != ARCHIVE_FORMAT_VERSION))
+        {
+                goto invalid;
+        }
+        archive->count = GUINT32_FROM_LE (header.count);
+        names_offset = GUINT64_FROM_LE (header.names_offset);
+        archive->names_size = GUINT64_FROM_LE (header.names_size);
+        if ((sizeof (header) + (guint64) archive->count * sizeof (archive_entry_t) > names_offset) ||
+                (names_offset > archive->size) ||
+                (archive->names_size > archive->size - names_offset) ||
+                ((archive->names_size > 0) && (archive->data[names_offset + archive->names_size - 1] != '\0')))
+        {
+                goto invalid;
+        }
+        archive->entries = (const archive_entry_t *) (archive->data + sizeof (header));
+        archive->names = archive->data + names_offset;
+        for (i = 0; i < archive->count; i++)
+        {
+                entry = &archive->entries[i];
+                end = GUINT64_FROM_LE (entry->offset) + GUINT64_FROM_LE (entry->size);
+                if ((GUINT64_FROM_LE (entry->name_offset) >= archive->names_size) ||
+                        (end < GUINT64_FROM_LE (entry->offset)) ||
+                        (end > archive->size) ||
+                        (GUINT32_FROM_LE (entry->compression) > ARCHIVE_GZIP))
+                {
+                        goto invalid;
+                }
+        }
+        return (archive);
+invalid:
+        if ((verbose) || (!silent))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("%s is not a valid footprint archive."),
+                        filename);
+        }
+        archive_close (archive);
+        return (NULL);
+}
+
+
+/*!
+ * \brief Read a footprint from an archive.
+ *
+ * \return the footprint text, to be freed with g_free (), \c NULL when
+ * it could not be decompressed.
+ */
+gchar *
+archive_read
+(
+        archive_t *archive,
+                /*!< : the archive.*/
+        guint index,
+                /*!< : the index of the footprint.*/
+        gsize *size
+                /*!< : is set to the size of the footprint text.*/
+)
+{
+        const archive_entry_t *entry;
+        const gchar *data;
+#ifdef HAVE_ZLIB_H
+        gchar *text;
+        z_stream stream;
+        gint status;
+#endif
+
+        entry = &archive->entries[index];
+        data = archive->data + GUINT64_FROM_LE (entry->offset);
+        *size = GUINT64_FROM_LE (entry->original_size);
+        if (GUINT32_FROM_LE (entry->compression) == ARCHIVE_STORED)
+        {
+                if (*size != GUINT64_FROM_LE (entry->size))
+                {
+                        return (NULL);
+                }
+                return (g_memdup (data, *size));
+        }
+#ifdef HAVE_ZLIB_H
+        text = g_malloc (MAX (*size, 1));
+        memset (&stream, 0, sizeof (stream));
+        if (inflateInit2 (&stream, 15 + 16) != Z_OK)
+        {
+                g_free (text);
+                return (NULL);
+        }
+        stream.next_in = (Bytef *) data;
+        stream.avail_in = GUINT64_FROM_LE (entry->size);
+        stream.next_out = (Bytef *) text;
+        stream.avail_out = *size;
+        status = inflate (&stream, Z_FINISH);
+        inflateEnd (&stream);
+        if ((status != Z_STREAM_END) || (stream.total_out != *size))
+        {
+                g_free (text);
+                return (NULL);
+        }
+        return (text);
+#else
+        return (NULL);
+#endif /* HAVE_ZLIB_H */
+}
+
+
+/*!
+ * \brief Write the header, the index and the names of an archive.
+ *
+ * The \c entries and \c names are sorted on name, the offsets and sizes
+ * of the entries are filled in.\n
+ * The header, index and names are written at the start of the file, in
+ * the room left before the footprints.
+ *
+ * \return \c EXIT_SUCCESS when the index was written,
+ * \c EXIT_FAILURE when it was not, \c errno is set.
+ */
+int
+archive_write_index
+(
+        gint fd,
+                /*!< : the file descriptor of the archive.*/
+        guint count,
+                /*!< : the number of footprints.*/
+        archive_entry_t *entries,
+                /*!< : the entries, are converted to little endian.*/
+        gchar **names
+                /*!< : the names.*/
+)
+{
+        archive_header_t header;
+        GString *blob;
+        gint result;
+        guint i;
+
+        blob = g_string_new (NULL);
+        for (i = 0; i < count; i++)
+        {
+                entries[i].name_offset = GUINT64_TO_LE (blob->len);
+                entries[i].name_length = GUINT32_TO_LE (strlen (names[i]));
+                entries[i].offset = GUINT64_TO_LE (entries[i].offset);
+                entries[i].size = GUINT64_TO_LE (entries[i].size);
+                entries[i].original_size = GUINT64_TO_LE (entries[i].original_size);
+                entries[i].compression = GUINT32_TO_LE (entries[i].compression);
+                g_string_append_len (blob, names[i], strlen (names[i]) + 1);
+        }
+        memset (&header, 0, sizeof (header));
+        memcpy (header.magic, ARCHIVE_MAGIC, sizeof (header.magic));
+        header.version = GUINT32_TO_LE (ARCHIVE_FORMAT_VERSION);
+        header.count = GUINT32_TO_LE (count);
+        header.names_offset = GUINT64_TO_LE (sizeof (header) + count * sizeof (archive_entry_t));
+        header.names_size = GUINT64_TO_LE (blob->len);
+        result = archive_pwrite (fd, (gchar *) &header, sizeof (header), 0);
+        if (result == EXIT_SUCCESS)
+        {
+                result = archive_pwrite (fd, (gchar *) entries,
+                        count * sizeof (archive_entry_t), sizeof (header));
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                result = archive_pwrite (fd, blob->str, blob->len,
+                        sizeof (header) + count * sizeof (archive_entry_t));
+        }
+        g_string_free (blob, TRUE);
+        return (result);
+}
+
+
+/* EOF */
@@ -0,0 +1,134 @@
+/*!
+ * \file src/archive.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for footprint library archives (fpw --archive).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __ARCHIVE_INCLUDED__
+#define __ARCHIVE_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief The magic at the start of an archive.
+ */
+#define ARCHIVE_MAGIC "fpwarch"
+
+/*!
+ * \brief The format version of an archive.
+ */
+#define ARCHIVE_FORMAT_VERSION 1
+
+/*!
+ * \brief The alignment of the footprint data after the index.
+ */
+#define ARCHIVE_ALIGNMENT 4096
+
+/*!
+ * \brief The compression of a footprint in an archive.
+ */
+typedef enum archive_compression
+{
+        ARCHIVE_STORED, /*!< Stored as is.*/
+        ARCHIVE_GZIP /*!< A gzip stream.*/
+} archive_compression_t;
+
+/*!
+ * \brief The header at the start of an archive.
+ *
+ * All numbers are little endian.\n
+ * The index of \c count entries follows the header, sorted on name, then
+ * the names, then the footprints.
+ */
+typedef struct archive_header
+{
+        gchar magic[8];
+                /*!< : is \c ARCHIVE_MAGIC.*/
+        guint32 version;
+                /*!< : is \c ARCHIVE_FORMAT_VERSION.*/
+        guint32 count;
+                /*!< : is the number of footprints.*/
+        guint64 names_offset;
+                /*!< : is the offset of the names in the archive.*/
+        guint64 names_size;
+                /*!< : is the size of the names.*/
+} archive_header_t;
+
+/*!
+ * \brief A footprint in the index of an archive.
+ */
+typedef struct archive_entry
+{
+        guint64 name_offset;
+                /*!< : is the offset of the name in the names, the name
+                 * is terminated by a NUL character.*/
+        guint64 offset;
+                /*!< : is the offset of the footprint in the archive.*/
+        guint64 size;
+                /*!< : is the size of the footprint in the archive.*/
+        guint64 original_size;
+                /*!< : is the size of the footprint text.*/
+        guint32 name_length;
+                /*!< : is the length of the name.*/
+        guint32 compression;
+                /*!< : is the \c archive_compression_t of the
+                 * footprint.*/
+} archive_entry_t;
+
+/*!
+ * \brief An archive opened for reading.
+ */
+typedef struct archive
+{
+        GMappedFile *file;
+                /*!< : is the mapped archive.*/
+        const gchar *data;
+                /*!< : is the contents of the archive.*/
+        gsize size;
+                /*!< : is the size of the archive.*/
+        guint count;
+                /*!< : is the number of footprints.*/
+        const archive_entry_t *entries;
+                /*!< : is the index, sorted on name.*/
+        const gchar *names;
+                /*!< : are the names.*/
+        gsize names_size;
+                /*!< : is the size of the names.*/
+} archive_t;
+
+
+int archive_append (gint fd, guint64 *end, const gchar *text, gsize size, archive_compression_t compression, archive_entry_t *entry);
+void archive_close (archive_t *archive);
+int archive_compress (const gchar *text, gsize size, gchar **compressed, gsize *compressed_size);
+int archive_extract (archive_t *archive, const gchar *directory, const gchar *name);
+const gchar *archive_get_name (archive_t *archive, guint index);
+gint archive_lookup (archive_t *archive, const gchar *name);
+archive_t *archive_open (const gchar *filename);
+gchar *archive_read (archive_t *archive, guint index, gsize *size);
+int archive_write_index (gint fd, guint count, archive_entry_t *entries, gchar **names);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __ARCHIVE_INCLUDED__ */
+
+
+/* EOF */
@@ -0,0 +1,1279 @@
+/*!
+ * \file src/bench.c
+ *
+ * \author Copyright (C) 2007-2013 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief fpw-bench is a benchmark of the package generators of fpw.
+ *
+ * Every footprint is generated in memory, through the DRC, the creation
+ * of the element and the writing of the footprint, like fpw does, but
+ * without the cache of generated footprints.\n
+ * The footprints come from four sets:
+ * - "defaults": the predefined packages of the create_packages_list ()
+ *   function of every package type,
+ * - "synthetic": a package for every package type which has no
+ *   predefined package which passes the DRC,
+ * - "library": the rows of the footprint libraries given with --library,
+ * - "stress": synthetic packages, a 100 x 100 BGA, a 200 pin header and
+ *   a BGA with a large pin/pad exceptions list.
+ *
+ * A package without a courtyard gets one of the size of the package body
+ * and the courtyard clearance, like its element does.\n
+ * For every package type in a set the time per footprint, per pad and in
+ * the DRC, the creation of the element and the writing, the
+ * allocations per footprint and the peak resident set size are
+ * reported, as a table or as JSON to compare between commits. The package types without a footprint which
+ * passed the DRC are listed as skipped.\n
+ * Run it with "make bench".\n
+ * \n
+ * With --micro the hot functions of libfpw are measured on their own
+ * instead: get_pin_pad_exception () with a large pin/pad exceptions list,
+ * get_package_type (), the lookup of the slowest predefined package name
+ * of every *_get_default_footprint_values () function, the write_pad (),
+ * write_pin () and write_element_line () formatters and
+ * read_footprintwizard_file ().\n
+ * Every micro-benchmark is warmed up while the number of calls per sample
+ * is calibrated, then sampled \c samples times, the median, minimum, mean,
+ * standard deviation and the noise of the samples are reported.\n
+ * Run it with "make microbench".\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifdef HAVE_CONFIG_H
+#  include <config.h>
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <getopt.h>
+#ifdef __GLIBC__
+#  include <malloc.h>
+#endif
+#include <gtk/gtk.h>
+#include <stdlib.h>
+
+/* Standard gettext macros. */
+#ifdef ENABLE_NLS
+#  include <libintl.h>
+#  undef _
+#  define _(String) dgettext (PACKAGE, String)
+#  define Q_(String) g_strip_context ((String), gettext (String))
+#  ifdef gettext_noop
+#    define N_(String) gettext_noop (String)
+#  else
+#    define N_(String) (String)
+#  endif
+#else
+#  define textdomain(String) (String)
+#  define gettext(String) (String)
+#  define dgettext(Domain,Message) (Message)
+#  define dcgettext(Domain,Message,Type) (Message)
+#  define bindtextdomain(Domain,Directory) (Domain)
+#  define _(String) (String)
+#  define Q_(String) g_strip_context ((String), (String))
+#  define N_(String) (String)
+#endif
+
+#define GUI 0
+/*!< Define whether this is a GTK User Interface (GUI) or not. */
+#define CLI 1
+/*!< Define whether this is a Command Line Interface (CLI) or not. */
+
+
+#include "libfpw.c"
+#include "cache.c"
+#include "packages.h"
+#include "library.c"
+#include "stats.c"
+#include "uring.c"
+#include "archive.c"
+#include "build.c"
+#include "bench.h"
+
+
+gchar *program_name = NULL;
+GSList *library_filenames = NULL;
+guint repeat = BENCH_REPEAT;
+guint samples = BENCH_MICRO_SAMPLES;
+gboolean print_json = FALSE;
+gboolean micro = FALSE;
+
+/*!
+ * \brief The synthetic packages, for the package types without a
+ * predefined package which passes the DRC.
+ */
+static bench_synthetic_t bench_synthetic_packages[] =
+{
+        {"CAPC1005X55N", "BENCH_CAPM", "footprint_type=CAPM"},
+        {"CAPC1005X55N", "BENCH_CAPMP", "footprint_type=CAPMP"},
+        {"CON-HDR", "BENCH_CON_HDR", "number_of_rows=2;number_of_columns=3;number_of_pins=6"},
+        {"DIOMELF1911L", "BENCH_DIOMELF", "pitch_y=1.5"},
+        {"CAPC1005X55N", "BENCH_DIOM", "footprint_type=DIOM;pitch_y=1.5"},
+        {"HDRV4W60P254_2X2_762L254W254H", "BENCH_HDRV", "number_of_rows=2;number_of_columns=3;number_of_pins=6"},
+        {"INDC1005X60N", "BENCH_INDC", "pitch_y=1.5"},
+        {"CAPC1005X55N", "BENCH_INDM", "footprint_type=INDM;pitch_y=1.5"},
+        {"CAPC1005X55N", "BENCH_INDP", "footprint_type=INDP;pitch_y=1.5"},
+        {"RESAD", "BENCH_JUMP", "footprint_type=JUMP"},
+        {"MTGNP", "BENCH_MTGNP", "package_body_height=1.0"},
+        {"MTGP", "BENCH_MTGP", "package_body_height=1.0"},
+        {"CAPC1005X55N", "BENCH_RESC", "footprint_type=RESC;pitch_y=1.5"},
+        {"RESAD", "BENCH_TO92", "footprint_type=TO92;number_of_pins=3;pitch_y=2.54"},
+        {"RESAD", "BENCH_TO220", "footprint_type=TO220;number_of_pins=3;pitch_y=2.54"},
+        {"RESAD", "BENCH_TO220S", "footprint_type=TO220S;number_of_pins=3;pitch_y=2.54"},
+        {"RESAD", "BENCH_TO220SW", "footprint_type=TO220SW;number_of_pins=3;pitch_y=2.54"},
+        {"RESAD", "BENCH_TO220W", "footprint_type=TO220W;number_of_pins=3;pitch_y=2.54"}
+};
+
+
+/*!
+ * \brief Get the time of the monotonic clock.
+ *
+ * \return the time in nanoseconds.
+ */
+static gint64
+bench_get_time ()
+{
+        struct timespec now;
+
+        clock_gettime (CLOCK_MONOTONIC, &now);
+        return ((gint64) now.tv_sec * 1000000000 + now.tv_nsec);
+}
+
+
+/*!
+ * \brief Reset the peak resident set size of the benchmark to the
+ * current resident set size.
+ *
+ * On Linux writing "5" to /proc/self/clear_refs resets the high water
+ * mark, so the peak of every row is measured on its own.\n
+ * The memory freed by the rows before is given back first, so it does
+ * not count for the next row.
+ *
+ * \return \c EXIT_SUCCESS when the peak was reset,
+ * \c EXIT_FAILURE when it only grows over the run.
+ */
+static int
+bench_reset_peak_rss ()
+{
+        FILE *file;
+        gint failed;
+
+#ifdef __GLIBC__
+        malloc_trim (0);
+#endif
+        file = fopen ("/proc/self/clear_refs", "w");
+        if (!file)
+        {
+                return (EXIT_FAILURE);
+        }
+        failed = (fputs ("5", file) == EOF);
+        failed |= fclose (file);
+        return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Get the peak resident set size of the benchmark since the last
+ * bench_reset_peak_rss ().
+ *
+ * The VmHWM line of /proc/self/status is used, without it the peak of
+ * the whole run from getrusage ().
+ *
+ * \return the peak resident set size in KiB.
+ */
+static glong
+bench_get_peak_rss ()
+{
+        struct rusage usage;
+        FILE *file;
+        gchar line[128];
+        glong peak = -1;
+
+        file = fopen ("/proc/self/status", "r");
+        if (file)
+        {
+                while ((peak < 0) && fgets (line, sizeof (line), file))
+                {
+                        if (sscanf (line, "VmHWM: %ld kB", &peak) != 1)
+                        {
+                                peak = -1;
+                        }
+                }
+                fclose (file);
+        }
+        if (peak < 0)
+        {
+                getrusage (RUSAGE_SELF, &usage);
+                peak = usage.ru_maxrss;
+        }
+        return (peak);
+}
+
+
+/*!
+ * \brief Find a footprint in a footprint library by its name.
+ *
+ * \return the row, -1 when there is no footprint with the name.
+ */
+static gint
+bench_find_row
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        const gchar *name
+                /*!< : the footprint name.*/
+)
+{
+        const gchar *row_name;
+        guint row;
+
+        for (row = 0; row < library->rows; row++)
+        {
+                row_name = library_get_string (library, LIBRARY_FOOTPRINT_NAME, row);
+                if (row_name && !strcmp (row_name, name))
+                {
+                        return (row);
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Get the result of a package type or a footprint in a set, a new
+ * result when there is none yet.
+ *
+ * \return the result.
+ */
+static bench_result_t *
+bench_get_result
+(
+        GArray *results,
+                /*!< : the results.*/
+        const gchar *set,
+                /*!< : the set of footprints.*/
+        gint type,
+                /*!< : the package type.*/
+        const gchar *name
+                /*!< : the footprint name, \c NULL for all footprints of
+                 * the package type.*/
+)
+{
+        bench_result_t result;
+        guint i;
+
+        for (i = 0; i < results->len; i++)
+        {
+                if ((g_array_index (results, bench_result_t, i).set == set) &&
+                        (g_array_index (results, bench_result_t, i).package_type == type) &&
+                        (g_array_index (results, bench_result_t, i).name == name))
+                {
+                        return (&g_array_index (results, bench_result_t, i));
+                }
+        }
+        memset (&result, 0, sizeof (result));
+        result.set = set;
+        result.package_type = type;
+        result.name = name;
+        g_array_append_val (results, result);
+        return (&g_array_index (results, bench_result_t, results->len - 1));
+}
+
+
+/*!
+ * \brief Divide for the report, 0 when there is nothing to divide by.
+ *
+ * \return the quotient.
+ */
+static gdouble
+bench_per
+(
+        gdouble value,
+                /*!< : the value.*/
+        gdouble count
+                /*!< : the count to divide by.*/
+)
+{
+        return ((count > 0) ? (value / count) : 0.0);
+}
+
+
+/*!
+ * \brief Compare two doubles for qsort ().
+ *
+ * \return -1, 0 or 1 when the first double is less than, equal to or
+ * greater than the second double.
+ */
+static int
+bench_compare_doubles
+(
+        const void *a,
+                /*!< : the first double.*/
+        const void *b
+                /*!< : the second double.*/
+)
+{
+        gdouble x = *(const gdouble *) a;
+        gdouble y = *(const gdouble *) b;
+
+        return ((x > y) - (x < y));
+}
+
+
+/*!
+ * \brief Get the median of an array of doubles, the array is sorted.
+ *
+ * \return the median.
+ */
+static gdouble
+bench_median
+(
+        gdouble *values,
+                /*!< : the values.*/
+        guint n
+                /*!< : the number of values, at least 1.*/
+)
+{
+        qsort (values, n, sizeof (gdouble), bench_compare_doubles);
+        if (n % 2)
+        {
+                return (values[n / 2]);
+        }
+        return ((values[n / 2 - 1] + values[n / 2]) / 2.0);
+}
+
+
+/*!
+ * \brief Create the pin/pad exceptions list of the stress BGA, the
+ * \c BENCH_STRESS_EXCEPTIONS_SIZE x \c BENCH_STRESS_EXCEPTIONS_SIZE pins
+ * in the center of a \c BENCH_STRESS_BGA_SIZE x \c BENCH_STRESS_BGA_SIZE
+ * BGA.
+ *
+ * \return the comma separated pin names, to be freed with g_free ().
+ */
+static gchar *
+bench_new_exceptions_string ()
+{
+        GString *exceptions;
+        gint first;
+        gint i;
+        gint j;
+
+        exceptions = g_string_new ("");
+        first = (BENCH_STRESS_BGA_SIZE - BENCH_STRESS_EXCEPTIONS_SIZE) / 2;
+        for (i = first; i < first + BENCH_STRESS_EXCEPTIONS_SIZE; i++)
+        {
+                for (j = first; j < first + BENCH_STRESS_EXCEPTIONS_SIZE; j++)
+                {
+                        g_string_append_printf (exceptions, "%s%s%d",
+                                exceptions->len ? "," : "", row_letters[i], j + 1);
+                }
+        }
+        return (g_string_free (exceptions, FALSE));
+}
+
+
+/*!
+ * \brief Look up the default values of a predefined package.
+ */
+static void
+bench_micro_get_default_footprint_values
+(
+        gpointer data,
+                /*!< : the lookup, a bench_lookup_t.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        bench_lookup_t *lookup = data;
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                /* A lookup which succeeds replaces the footprint name. */
+                footprint_name = g_strdup (lookup->name);
+                lookup->get_default_footprint_values ();
+                g_free (footprint_name);
+        }
+        footprint_name = NULL;
+}
+
+
+/*!
+ * \brief Determine the package type of \c footprint_type.
+ */
+static void
+bench_micro_get_package_type
+(
+        gpointer data,
+                /*!< : not used.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                get_package_type ();
+        }
+}
+
+
+/*!
+ * \brief Look a pin up in \c pin_pad_exceptions_string.
+ */
+static void
+bench_micro_get_pin_pad_exception
+(
+        gpointer data,
+                /*!< : the pin name.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                get_pin_pad_exception (data);
+        }
+}
+
+
+/*!
+ * \brief Read a footprintwizard file.
+ */
+static void
+bench_micro_read_footprintwizard_file
+(
+        gpointer data,
+                /*!< : the filename.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                read_footprintwizard_file (data);
+        }
+}
+
+
+/*!
+ * \brief Write an element line to \c fp.
+ */
+static void
+bench_micro_write_element_line
+(
+        gpointer data,
+                /*!< : not used.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                write_element_line (-55000.0, -55000.0, 55000.0, -55000.0, 1000.0);
+        }
+}
+
+
+/*!
+ * \brief Write a pad to \c fp.
+ */
+static void
+bench_micro_write_pad
+(
+        gpointer data,
+                /*!< : not used.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                write_pad (1, "A1", -17716.0, -17716.0, -17716.0, -17716.0,
+                        1575.0, 1181.0, 2756.0, "onsolder,square");
+        }
+}
+
+
+/*!
+ * \brief Write a pin to \c fp.
+ */
+static void
+bench_micro_write_pin
+(
+        gpointer data,
+                /*!< : not used.*/
+        guint iterations
+                /*!< : the number of calls.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < iterations; i++)
+        {
+                write_pin (1, "1", 0.0, 10000.0, 6000.0, 1500.0, 6600.0,
+                        3500.0, "square");
+        }
+}
+
+
+/*!
+ * \brief Add synthetic stress packages to a footprint library.
+ *
+ * The stress packages are grown from predefined packages:
+ * - a \c BENCH_STRESS_BGA_SIZE x \c BENCH_STRESS_BGA_SIZE BGA,
+ * - the same BGA without the \c BENCH_STRESS_EXCEPTIONS_SIZE x
+ *   \c BENCH_STRESS_EXCEPTIONS_SIZE pins in its center, all listed in
+ *   the pin/pad exceptions,
+ * - a single row header with \c BENCH_STRESS_HEADER_PINS pins.
+ */
+void
+bench_add_stress_rows
+(
+        library_t *stress,
+                /*!< : the footprint library to append the rows to.*/
+        library_t *defaults
+                /*!< : the predefined packages.*/
+)
+{
+        gchar *exceptions;
+        gint row;
+
+        row = bench_find_row (defaults, "BGA100C100P10X10_1100X1100X140");
+        if (row >= 0)
+        {
+                library_set_globals (defaults, row);
+                number_of_rows = BENCH_STRESS_BGA_SIZE;
+                number_of_columns = BENCH_STRESS_BGA_SIZE;
+                number_of_pins = number_of_rows * number_of_columns;
+                package_body_width = (number_of_columns + 1) * pitch_x;
+                package_body_length = (number_of_rows + 1) * pitch_y;
+                silkscreen_width = package_body_width;
+                silkscreen_length = package_body_length;
+                courtyard_width = package_body_width + 2 * pitch_x;
+                courtyard_length = package_body_length + 2 * pitch_y;
+                footprint_name = "BENCH_BGA_100X100";
+                library_append_globals (stress);
+                /* Leave the center out. */
+                exceptions = bench_new_exceptions_string ();
+                pin_pad_exceptions_string = exceptions;
+                number_of_exceptions = BENCH_STRESS_EXCEPTIONS_SIZE * BENCH_STRESS_EXCEPTIONS_SIZE;
+                number_of_pins -= number_of_exceptions;
+                footprint_name = "BENCH_BGA_100X100_EXCEPTIONS";
+                library_append_globals (stress);
+                g_free (exceptions);
+        }
+        row = bench_find_row (defaults, "CON_SIL-254P-2N");
+        if (row >= 0)
+        {
+                library_set_globals (defaults, row);
+                number_of_pins = BENCH_STRESS_HEADER_PINS;
+                number_of_rows = number_of_pins;
+                package_body_length = number_of_rows * pitch_y;
+                silkscreen_length = package_body_length;
+                courtyard_length = package_body_length;
+                footprint_name = "BENCH_CON_SIL_200";
+                library_append_globals (stress);
+        }
+        pin_pad_exceptions_string = NULL;
+        footprint_name = NULL;
+}
+
+
+/*!
+ * \brief Add the synthetic packages of the package types without a
+ * predefined package which passes the DRC to a footprint library.
+ *
+ * Every synthetic package starts from the values of a predefined
+ * package, the donor, and replaces some of them, a package of which the
+ * donor is missing is left out.
+ */
+void
+bench_add_synthetic_rows
+(
+        library_t *synthetic,
+                /*!< : the footprint library to append the rows to.*/
+        library_t *defaults
+                /*!< : the predefined packages.*/
+)
+{
+        gchar **parameters;
+        gchar *value;
+        gint row;
+        guint i;
+        guint j;
+
+        for (i = 0; i < G_N_ELEMENTS (bench_synthetic_packages); i++)
+        {
+                row = bench_find_row (defaults, bench_synthetic_packages[i].donor);
+                if (row < 0)
+                {
+                        continue;
+                }
+                library_set_globals (defaults, row);
+                parameters = g_strsplit (bench_synthetic_packages[i].parameters, ";", 0);
+                for (j = 0; parameters[j]; j++)
+                {
+                        if ((value = strchr (parameters[j], '=')))
+                        {
+                                *value++ = '\0';
+                                set_footprintwizard_value (parameters[j], value,
+                                        strlen (value), "bench");
+                        }
+                }
+                g_strfreev (parameters);
+                footprint_name = (gchar *) bench_synthetic_packages[i].name;
+                if ((get_package_type () == EXIT_SUCCESS) &&
+                        (update_units_variables () == EXIT_SUCCESS) &&
+                        (update_pad_shapes_variables () == EXIT_SUCCESS))
+                {
+                        library_append_globals (synthetic);
+                }
+        }
+        footprint_name = NULL;
+}
+
+
+/*!
+ * \brief Measure a function with the warm-up, repeat and statistics
+ * harness of the micro-benchmarks and add the statistics to the results.
+ *
+ * The number of calls per sample is doubled until a sample takes at least
+ * \c BENCH_MICRO_SAMPLE_TIME, which warms up the caches and the branch
+ * predictors, then \c BENCH_MICRO_WARMUP_SAMPLES samples are thrown away
+ * and \c samples samples are measured.\n
+ * The noise is the median absolute deviation of the samples relative to
+ * the median, it is robust against the odd sample which was interrupted.
+ */
+void
+bench_measure
+(
+        const gchar *name,
+                /*!< : the name of the micro-benchmark.*/
+        const gchar *argument,
+                /*!< : the argument the function is called with, for the
+                 * report.*/
+        void (*function) (gpointer data, guint iterations),
+                /*!< : the function, calls the measured function
+                 * \c iterations times.*/
+        gpointer data,
+                /*!< : the data passed to the function.*/
+        GArray *results
+                /*!< : the results.*/
+)
+{
+        bench_micro_result_t result;
+        gdouble *times;
+        gdouble sum = 0.0;
+        gdouble squares = 0.0;
+        gint64 start;
+        gint64 elapsed;
+        guint iterations = 1;
+        guint i;
+
+        for (;;)
+        {
+                start = bench_get_time ();
+                function (data, iterations);
+                elapsed = bench_get_time () - start;
+                if ((elapsed >= BENCH_MICRO_SAMPLE_TIME) || (iterations >= G_MAXUINT / 2))
+                {
+                        break;
+                }
+                iterations *= 2;
+        }
+        for (i = 0; i < BENCH_MICRO_WARMUP_SAMPLES; i++)
+        {
+                function (data, iterations);
+        }
+        times = g_new (gdouble, samples);
+        for (i = 0; i < samples; i++)
+        {
+                start = bench_get_time ();
+                function (data, iterations);
+                times[i] = (gdouble) (bench_get_time () - start) / iterations;
+                sum += times[i];
+                squares += times[i] * times[i];
+        }
+        memset (&result, 0, sizeof (result));
+        result.name = g_strdup (name);
+        result.argument = g_strdup (argument);
+        result.iterations = iterations;
+        result.samples = samples;
+        result.mean = sum / samples;
+        result.stddev = sqrt (MAX (0.0, squares / samples - result.mean * result.mean));
+        result.median = bench_median (times, samples);
+        result.min = times[0];
+        /* Reuse the samples for the absolute deviations. */
+        for (i = 0; i < samples; i++)
+        {
+                times[i] = fabs (times[i] - result.median);
+        }
+        result.noise = bench_per (100.0 * bench_median (times, samples), result.median);
+        g_free (times);
+        g_array_append_val (results, result);
+}
+
+
+/*!
+ * \brief Run the micro-benchmarks of the hot functions of libfpw.
+ *
+ * - get_pin_pad_exception () with the pin/pad exceptions list of the
+ *   stress BGA, for the last pin in the list and for a pin which is not
+ *   in the list,
+ * - get_package_type () for the last package type it tests,
+ * - every *_get_default_footprint_values () function, for the predefined
+ *   package name which is the slowest to look up,
+ * - write_pad (), write_pin () and write_element_line (), to /dev/null,
+ * - read_footprintwizard_file () of a predefined BGA package.
+ *
+ * \return \c EXIT_SUCCESS when all micro-benchmarks ran,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+bench_micro
+(
+        library_t *defaults,
+                /*!< : the predefined packages.*/
+        GArray *results
+                /*!< : the results.*/
+)
+{
+        bench_lookup_t lookup;
+        GList *names;
+        FILE *output;
+        gchar *exceptions;
+        gchar *last;
+        gchar *name;
+        gchar *slowest;
+        gchar *function_name;
+        gchar *filename;
+        gint64 start;
+        gint64 elapsed;
+        gint64 slowest_elapsed;
+        gint row;
+        gint fd;
+        guint i;
+
+        exceptions = bench_new_exceptions_string ();
+        pin_pad_exceptions_string = exceptions;
+        last = strrchr (exceptions, ',') + 1;
+        bench_measure ("get_pin_pad_exception", last,
+                bench_micro_get_pin_pad_exception, last, results);
+        bench_measure ("get_pin_pad_exception", "A1",
+                bench_micro_get_pin_pad_exception, "A1", results);
+        pin_pad_exceptions_string = NULL;
+        g_free (exceptions);
+        footprint_type = "TO220W";
+        bench_measure ("get_package_type", footprint_type,
+                bench_micro_get_package_type, NULL, results);
+        footprint_type = NULL;
+        for (i = 0; i < G_N_ELEMENTS (library_packages); i++)
+        {
+                g_list_free (packages_list);
+                packages_list = NULL;
+                library_packages[i].create_packages_list ();
+                lookup.get_default_footprint_values = library_packages[i].get_default_footprint_values;
+                slowest = NULL;
+                slowest_elapsed = -1;
+                for (names = packages_list; names; names = g_list_next (names))
+                {
+                        name = g_strconcat ("?", names->data, NULL);
+                        lookup.name = name;
+                        bench_micro_get_default_footprint_values (&lookup, BENCH_MICRO_PROBE_ITERATIONS);
+                        start = bench_get_time ();
+                        bench_micro_get_default_footprint_values (&lookup, BENCH_MICRO_PROBE_ITERATIONS);
+                        elapsed = bench_get_time () - start;
+                        if (elapsed > slowest_elapsed)
+                        {
+                                g_free (slowest);
+                                slowest = name;
+                                slowest_elapsed = elapsed;
+                        }
+                        else
+                        {
+                                g_free (name);
+                        }
+                }
+                if (!slowest)
+                {
+                        continue;
+                }
+                lookup.name = slowest;
+                name = g_ascii_strdown (library_package_names[library_packages[i].type], -1);
+                function_name = g_strconcat (name, "_get_default_footprint_values", NULL);
+                bench_measure (function_name, slowest + 1,
+                        bench_micro_get_default_footprint_values, &lookup, results);
+                g_free (function_name);
+                g_free (name);
+                g_free (slowest);
+        }
+        g_list_free (packages_list);
+        packages_list = NULL;
+        output = fopen ("/dev/null", "w");
+        if (!output)
+        {
+                return (EXIT_FAILURE);
+        }
+        fp = output;
+        bench_measure ("write_pad", "A1", bench_micro_write_pad, NULL, results);
+        bench_measure ("write_pin", "1", bench_micro_write_pin, NULL, results);
+        bench_measure ("write_element_line", "", bench_micro_write_element_line, NULL, results);
+        fp = NULL;
+        fclose (output);
+        row = bench_find_row (defaults, "BGA100C100P10X10_1100X1100X140");
+        if (row < 0)
+        {
+                return (EXIT_FAILURE);
+        }
+        fd = g_file_open_tmp ("fpw-bench-XXXXXX.fpw", &filename, NULL);
+        if (fd < 0)
+        {
+                return (EXIT_FAILURE);
+        }
+        close (fd);
+        library_set_globals (defaults, row);
+        footprint_filename = footprint_name;
+        if (write_footprintwizard_file (filename) == EXIT_SUCCESS)
+        {
+                bench_measure ("read_footprintwizard_file", footprint_name,
+                        bench_micro_read_footprintwizard_file, filename, results);
+        }
+        footprint_filename = NULL;
+        unlink (filename);
+        g_free (filename);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Print the results.
+ *
+ * The times are in nanoseconds, the peak resident set size in KiB.
+ *
+ * \return \c EXIT_SUCCESS.
+ */
+int
+bench_print
+(
+        FILE *stream,
+                /*!< : the stream to print to.*/
+        GArray *results,
+                /*!< : the results.*/
+        gboolean json
+                /*!< : print a JSON object instead of a table.*/
+)
+{
+        bench_result_t *result;
+        gboolean passed[STATS_NUMBER_OF_PACKAGE_TYPES];
+        gdouble footprints;
+        guint skipped;
+        guint i;
+
+        memset (passed, 0, sizeof (passed));
+        if (json)
+        {
+                fprintf (stream, "{\"version\":\"%s\",\"repeat\":%u,\"results\":[", VERSION, repeat);
+        }
+        else
+        {
+                fprintf (stream, "%-9s %-8s %10s %8s %14s %12s %12s %12s %12s %12s %10s %s\n",
+                        "set", "type", "footprints", "failed", "ns/footprint",
+                        "ns/pad", "drc ns", "element ns", "write ns", "allocations",
+                        "peak KiB", "footprint");
+        }
+        for (i = 0; i < results->len; i++)
+        {
+                result = &g_array_index (results, bench_result_t, i);
+                footprints = result->footprints;
+                if (result->footprints > result->drc_failed)
+                {
+                        passed[result->package_type] = TRUE;
+                }
+                if (json)
+                {
+                        fprintf (stream, "%s\n{\"set\":\"%s\",\"package_type\":\"%s\","
+                                "\"footprint_name\":%s%s%s,\"footprints\":%u,\"drc_failed\":%u,"
+                                "\"ns_per_footprint\":%.0f,\"ns_per_pad\":%.1f,"
+                                "\"drc_ns_per_footprint\":%.0f,\"element_ns_per_footprint\":%.0f,"
+                                "\"write_ns_per_footprint\":%.0f,"
+                                "\"pads_per_footprint\":%.1f,\"allocations_per_footprint\":%.1f,"
+                                "\"peak_rss_kib\":%ld}",
+                                i ? "," : "",
+                                result->set,
+                                library_package_names[result->package_type],
+                                result->name ? "\"" : "",
+                                result->name ? result->name : "null",
+                                result->name ? "\"" : "",
+                                result->footprints,
+                                result->drc_failed,
+                                bench_per (result->elapsed, footprints),
+                                bench_per (result->elapsed, result->record.count[STATS_PADS]),
+                                bench_per (result->record.time[STATS_DRC] * 1000.0, footprints),
+                                bench_per (result->record.time[STATS_GEOMETRY] * 1000.0, footprints),
+                                bench_per (result->record.time[STATS_WRITE] * 1000.0, footprints),
+                                bench_per (result->record.count[STATS_PADS], footprints),
+                                bench_per (result->record.count[STATS_ALLOCATIONS], footprints),
+                                result->peak_rss);
+                }
+                else
+                {
+                        fprintf (stream, "%-9s %-8s %10u %8u %14.0f %12.1f %12.0f %12.0f %12.0f %12.1f %10ld %s\n",
+                                result->set,
+                                library_package_names[result->package_type],
+                                result->footprints,
+                                result->drc_failed,
+                                bench_per (result->elapsed, footprints),
+                                bench_per (result->elapsed, result->record.count[STATS_PADS]),
+                                bench_per (result->record.time[STATS_DRC] * 1000.0, footprints),
+                                bench_per (result->record.time[STATS_GEOMETRY] * 1000.0, footprints),
+                                bench_per (result->record.time[STATS_WRITE] * 1000.0, footprints),
+                                bench_per (result->record.count[STATS_ALLOCATIONS], footprints),
+                                result->peak_rss,
+                                result->name ? result->name : "");
+                }
+        }
+        /* The package types without a footprint which passed the DRC
+         * were not measured. */
+        fprintf (stream, json ? "\n],\"skipped\":[" : "skipped:");
+        skipped = 0;
+        for (i = NO_PACKAGE + 1; i < STATS_NUMBER_OF_PACKAGE_TYPES; i++)
+        {
+                if (!passed[i])
+                {
+                        fprintf (stream, json ? "%s\"%s\"" : "%s%s",
+                                json ? (skipped ? "," : "") : " ",
+                                library_package_names[i]);
+                        skipped++;
+                }
+        }
+        fprintf (stream, json ? "]}\n" : "\n");
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Print the results of the micro-benchmarks.
+ *
+ * The times are in nanoseconds per call, the noise in percent.
+ *
+ * \return \c EXIT_SUCCESS.
+ */
+int
+bench_print_micro
+(
+        FILE *stream,
+                /*!< : the stream to print to.*/
+        GArray *results,
+                /*!< : the results of the micro-benchmarks.*/
+        gboolean json
+                /*!< : print a JSON object instead of a table.*/
+)
+{
+        bench_micro_result_t *result;
+        guint i;
+
+        if (json)
+        {
+                fprintf (stream, "{\"version\":\"%s\",\"samples\":%u,\"micro\":[", VERSION, samples);
+        }
+        else
+        {
+                fprintf (stream, "%-38s %10s %8s %12s %12s %12s %12s %8s %s\n",
+                        "function", "iterations", "samples", "median ns",
+                        "min ns", "mean ns", "stddev ns", "noise %", "argument");
+        }
+        for (i = 0; i < results->len; i++)
+        {
+                result = &g_array_index (results, bench_micro_result_t, i);
+                if (json)
+                {
+                        fprintf (stream, "%s\n{\"function\":\"%s\",\"argument\":\"%s\","
+                                "\"iterations\":%u,\"samples\":%u,"
+                                "\"median_ns\":%.1f,\"min_ns\":%.1f,\"mean_ns\":%.1f,"
+                                "\"stddev_ns\":%.1f,\"noise_percent\":%.2f}",
+                                i ? "," : "",
+                                result->name,
+                                result->argument,
+                                result->iterations,
+                                result->samples,
+                                result->median,
+                                result->min,
+                                result->mean,
+                                result->stddev,
+                                result->noise);
+                }
+                else
+                {
+                        fprintf (stream, "%-38s %10u %8u %12.1f %12.1f %12.1f %12.1f %8.2f %s\n",
+                                result->name,
+                                result->iterations,
+                                result->samples,
+                                result->median,
+                                result->min,
+                                result->mean,
+                                result->stddev,
+                                result->noise,
+                                result->argument);
+                }
+        }
+        if (json)
+        {
+                fprintf (stream, "\n]}\n");
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Generate every footprint of a footprint library \c repeat times
+ * and add the cost to the results of its package type.
+ *
+ * The footprints are generated with generate_footprint (), so the cache
+ * of generated footprints is not used, and written to /dev/null.\n
+ * The peak resident set size is reset before every row, the peak of a
+ * result is the largest peak of its rows.\n
+ * Rows which do not describe a footprint are skipped.
+ */
+void
+bench_run
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        const gchar *set,
+                /*!< : the name of the set of footprints.*/
+        gboolean per_footprint,
+                /*!< : report every footprint on its own, not per
+                 * package type.*/
+        GArray *results
+                /*!< : the results.*/
+)
+{
+        bench_result_t *result;
+        stats_record_t before;
+        stats_record_t after;
+        gboolean drc_passed;
+        FILE *output;
+        gint64 start;
+        glong peak_rss;
+        guint row;
+        guint i;
+
+        output = fopen ("/dev/null", "w");
+        if (!output)
+        {
+                return;
+        }
+        for (row = 0; row < library->rows; row++)
+        {
+                if (build_set_row_globals (library, row) == EXIT_FAILURE)
+                {
+                        continue;
+                }
+                /* Many predefined packages have no courtyard, derive it
+                 * from the package body and the courtyard clearance like
+                 * the elements of the packages do. */
+                if (courtyard_length <= 0.0)
+                {
+                        courtyard_length = package_body_length + 2.0 * courtyard_clearance_with_package;
+                }
+                if (courtyard_width <= 0.0)
+                {
+                        courtyard_width = package_body_width + 2.0 * courtyard_clearance_with_package;
+                }
+                result = bench_get_result (results, set, package_type,
+                        per_footprint ? footprint_name : NULL);
+                bench_reset_peak_rss ();
+                stats_get_total (&before);
+                start = bench_get_time ();
+                for (i = 0; i < repeat; i++)
+                {
+                        footprint_output = output;
+                        drc_passed = FALSE;
+                        generate_footprint (&drc_passed);
+                        if (!drc_passed)
+                        {
+                                result->drc_failed++;
+                        }
+                        result->footprints++;
+                }
+                result->elapsed += bench_get_time () - start;
+                peak_rss = bench_get_peak_rss ();
+                result->peak_rss = MAX (result->peak_rss, peak_rss);
+                footprint_output = NULL;
+                stats_get_total (&after);
+                for (i = 0; i < STATS_NUMBER_OF_PHASES; i++)
+                {
+                        result->record.time[i] += after.time[i] - before.time[i];
+                }
+                for (i = 0; i < STATS_NUMBER_OF_COUNTERS; i++)
+                {
+                        result->record.count[i] += after.count[i] - before.count[i];
+                }
+        }
+        fclose (output);
+}
+
+
+/*!
+ * \brief The benchmark of the package generators.
+ *
+ * \return \c EXIT_SUCCESS when the benchmark ran,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+main
+(
+        int argc, /*!< : number of arguments */
+        char **argv /*!< : array of argument variables */
+)
+{
+        library_t *defaults;
+        library_t *synthetic;
+        library_t *libraries;
+        library_t *stress;
+        GArray *results;
+        GArray *micro_results;
+        GSList *filename;
+        guint log_handler;
+        guint i;
+        gint result = EXIT_SUCCESS;
+
+        program_name = argv[0];
+        static const struct option opts[] =
+        {
+                {"help", no_argument, NULL, 'h'},
+                {"library", required_argument, NULL, 'l'},
+                {"repeat", required_argument, NULL, 'r'},
+                {"json", no_argument, NULL, 'j'},
+                {"micro", no_argument, NULL, 'm'},
+                {"samples", required_argument, NULL, 's'},
+                {0, 0, 0, 0}
+        };
+        int optc;
+        while ((optc = getopt_long (argc, argv, "hl:r:jms:", opts, NULL)) != -1)
+        {
+                switch (optc)
+                {
+                        case 'h':
+                                fprintf (stderr, (_("\nUsage: %s [--library <csv file>] [--repeat <number>] [--json]\n")), program_name);
+                                fprintf (stderr, (_("       %s --micro [--samples <number>] [--json]\n\n")), program_name);
+                                fprintf (stderr, (_("Generate every predefined package, every row of the footprint\n")));
+                                fprintf (stderr, (_("libraries and the stress packages --repeat times, default %d,\n")), BENCH_REPEAT);
+                                fprintf (stderr, (_("and print the cost per package type as a table or as JSON.\n\n")));
+                                fprintf (stderr, (_("With --micro measure the hot functions of libfpw on their own,\n")));
+                                fprintf (stderr, (_("--samples times, default %d, and print the time per call.\n\n")), BENCH_MICRO_SAMPLES);
+                                exit (EXIT_SUCCESS);
+                        case 'l':
+                                library_filenames = g_slist_append (library_filenames, strdup (optarg));
+                                break;
+                        case 'r':
+                                repeat = MAX (1, atoi (optarg));
+                                break;
+                        case 'j':
+                                print_json = TRUE;
+                                break;
+                        case 'm':
+                                micro = TRUE;
+                                break;
+                        case 's':
+                                samples = MAX (1, atoi (optarg));
+                                break;
+                        default:
+                                exit (EXIT_FAILURE);
+                }
+        }
+        defaults = library_new ();
+        library_add_packages (defaults);
+        if (micro)
+        {
+                /* The micro-benchmarks are run without the statistics,
+                 * so their spans cost next to nothing. */
+                silent = TRUE;
+                verbose = FALSE;
+                log_handler = g_log_set_handler ("", G_LOG_LEVEL_MASK,
+                        library_log_nothing, NULL);
+                micro_results = g_array_new (FALSE, FALSE, sizeof (bench_micro_result_t));
+                result = bench_micro (defaults, micro_results);
+                g_log_remove_handler ("", log_handler);
+                bench_print_micro (stdout, micro_results, print_json);
+                for (i = 0; i < micro_results->len; i++)
+                {
+                        g_free (g_array_index (micro_results, bench_micro_result_t, i).name);
+                        g_free (g_array_index (micro_results, bench_micro_result_t, i).argument);
+                }
+                g_array_free (micro_results, TRUE);
+                library_free (defaults);
+                return (result);
+        }
+        if (stats_enable () == EXIT_FAILURE)
+        {
+                exit (EXIT_FAILURE);
+        }
+        libraries = library_new ();
+        for (filename = library_filenames; filename; filename = g_slist_next (filename))
+        {
+                if (library_read_csv_file (libraries, filename->data) == EXIT_FAILURE)
+                {
+                        result = EXIT_FAILURE;
+                }
+        }
+        synthetic = library_new ();
+        bench_add_synthetic_rows (synthetic, defaults);
+        stress = library_new ();
+        bench_add_stress_rows (stress, defaults);
+        /* The DRC messages of the failing footprints are not of
+         * interest here. */
+        silent = TRUE;
+        verbose = FALSE;
+        log_handler = g_log_set_handler ("", G_LOG_LEVEL_MASK,
+                library_log_nothing, NULL);
+        results = g_array_new (FALSE, FALSE, sizeof (bench_result_t));
+        bench_run (defaults, "defaults", FALSE, results);
+        bench_run (synthetic, "synthetic", FALSE, results);
+        bench_run (libraries, "library", FALSE, results);
+        bench_run (stress, "stress", TRUE, results);
+        g_log_remove_handler ("", log_handler);
+        bench_print (stdout, results, print_json);
+        g_array_free (results, TRUE);
+        library_free (defaults);
+        library_free (synthetic);
+        library_free (libraries);
+        library_free (stress);
+        stats_free ();
+        return (result);
+}
+
+
+/* EOF */
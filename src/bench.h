@@ -0,0 +1,178 @@
+/*!
+ * \file src/bench.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for fpw-bench, the benchmark of the package
+ * generators and of the hot functions of libfpw.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __BENCH_INCLUDED__
+#define __BENCH_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief The default number of times every footprint is generated.
+ */
+#define BENCH_REPEAT 5
+
+/*!
+ * \brief The default number of samples of a micro-benchmark.
+ */
+#define BENCH_MICRO_SAMPLES 25
+
+/*!
+ * \brief The minimum time of a sample of a micro-benchmark, in
+ * nanoseconds, the number of iterations per sample is calibrated to it.
+ */
+#define BENCH_MICRO_SAMPLE_TIME 1000000
+
+/*!
+ * \brief The number of samples of a micro-benchmark which are run and
+ * thrown away before the measurement.
+ */
+#define BENCH_MICRO_WARMUP_SAMPLES 3
+
+/*!
+ * \brief The number of lookups of every predefined package name when
+ * looking for the slowest name of a package type.
+ */
+#define BENCH_MICRO_PROBE_ITERATIONS 16
+
+/*!
+ * \brief The number of rows and columns of the stress BGA packages.
+ */
+#define BENCH_STRESS_BGA_SIZE 100
+
+/*!
+ * \brief The number of rows and columns of the pins left out of the
+ * stress BGA package with a large pin/pad exceptions list.
+ */
+#define BENCH_STRESS_EXCEPTIONS_SIZE 60
+
+/*!
+ * \brief The number of pins of the stress single row header.
+ */
+#define BENCH_STRESS_HEADER_PINS 200
+
+/*!
+ * \brief A synthetic package for a package type which has no predefined
+ * package which passes the DRC.
+ */
+typedef struct bench_synthetic
+{
+        const gchar *donor;
+                /*!< : is the name of the predefined package the values
+                 * start from.*/
+        const gchar *name;
+                /*!< : is the name of the synthetic package.*/
+        const gchar *parameters;
+                /*!< : are the values which replace those of the donor,
+                 * "key=value" pairs with the keys of a footprintwizard
+                 * file, separated by ";".*/
+} bench_synthetic_t;
+
+/*!
+ * \brief The cost of the footprints of a package type in a set.
+ */
+typedef struct bench_result
+{
+        const gchar *set;
+                /*!< : is the set of footprints, "defaults",
+                 * "synthetic", "library" or "stress".*/
+        gint package_type;
+                /*!< : is the package type.*/
+        const gchar *name;
+                /*!< : is the footprint name when the result is of one
+                 * footprint, \c NULL when it is of all footprints of the
+                 * package type.*/
+        guint footprints;
+                /*!< : is the number of footprints generated, every row
+                 * of the set is generated \c repeat times.*/
+        guint drc_failed;
+                /*!< : is the number of footprints which failed the
+                 * DRC.*/
+        gint64 elapsed;
+                /*!< : is the time spent generating the footprints, in
+                 * nanoseconds.*/
+        stats_record_t record;
+                /*!< : are the statistics of the footprints.*/
+        glong peak_rss;
+                /*!< : is the largest peak resident set size of the
+                 * benchmark while generating a row, in KiB.*/
+} bench_result_t;
+
+/*!
+ * \brief A lookup of the default values of a predefined package.
+ */
+typedef struct bench_lookup
+{
+        int (*get_default_footprint_values) ();
+                /*!< : sets the values of a predefined package.*/
+        const gchar *name;
+                /*!< : is the footprint name looked up, with the leading
+                 * "?".*/
+} bench_lookup_t;
+
+/*!
+ * \brief The statistics of the samples of a micro-benchmark.
+ */
+typedef struct bench_micro_result
+{
+        gchar *name;
+                /*!< : is the name of the micro-benchmark.*/
+        gchar *argument;
+                /*!< : is the argument the function is called with.*/
+        guint iterations;
+                /*!< : is the number of calls per sample.*/
+        guint samples;
+                /*!< : is the number of samples.*/
+        gdouble min;
+                /*!< : is the fastest sample, in nanoseconds per call.*/
+        gdouble median;
+                /*!< : is the median sample, in nanoseconds per call.*/
+        gdouble mean;
+                /*!< : is the mean of the samples, in nanoseconds per
+                 * call.*/
+        gdouble stddev;
+                /*!< : is the standard deviation of the samples, in
+                 * nanoseconds per call.*/
+        gdouble noise;
+                /*!< : is the median absolute deviation of the samples
+                 * relative to the median, in percent.*/
+} bench_micro_result_t;
+
+
+void bench_add_stress_rows (library_t *stress, library_t *defaults);
+void bench_add_synthetic_rows (library_t *synthetic, library_t *defaults);
+void bench_measure (const gchar *name, const gchar *argument, void (*function) (gpointer data, guint iterations), gpointer data, GArray *results);
+int bench_micro (library_t *defaults, GArray *results);
+int bench_print (FILE *stream, GArray *results, gboolean json);
+int bench_print_micro (FILE *stream, GArray *results, gboolean json);
+void bench_run (library_t *library, const gchar *set, gboolean per_footprint, GArray *results);
+int main (int , char **);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __BENCH_INCLUDED__ */
+
+
+/* EOF */
@@ -35,18 +35,15 @@
 int
 bga_create_element ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
         gdouble dx;
         gint pin_number;
         gchar *pin_pad_name = g_strdup ("");
-        gint i;
-        gint j;
+        gboolean *exceptions;
+        PadType pad_template;
         FlagType pad_flag;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -61,136 +58,55 @@ bga_create_element ()
          * put the element mark. */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties. */
-        xmin = multiplier *
-        (
-                ((-pitch_x * number_of_columns) / 2.0) -
-                (pad_diameter / 2.0) -
-                pad_solder_mask_clearance
-        );
-        xmax = multiplier *
-        (
-                ((pitch_x * number_of_columns) / 2.0) +
-                (pad_diameter / 2.0) +
-                pad_solder_mask_clearance
-        );
-        ymin = multiplier *
-        (
-                ((-pitch_y * number_of_rows) / 2.0) -
-                (pad_diameter / 2.0) -
-                pad_solder_mask_clearance
-        );
-        ymax = multiplier *
-        (
-                ((pitch_y * number_of_rows) / 2.0) +
-                (pad_diameter / 2.0) +
-                pad_solder_mask_clearance
-        );
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties. */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it. */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
+        /* Create the pads of the ball grid array, one row at a time
+         * [A .. ZZ ..] etc. excluding "I", "O", "Q", "S" and "Z", with all
+         * columns of a row [1 .. n]. */
+        pad_template.Point1.X = 0;
+        pad_template.Point1.Y = 0;
+        pad_template.Point2.X = 0;
+        pad_template.Point2.Y = 0;
+        pad_template.Thickness = units_to_coord (pad_diameter);
+        pad_template.Clearance = units_to_coord (pad_clearance);
+        pad_template.Mask = units_to_coord (pad_diameter + (2 * pad_solder_mask_clearance));
+        pad_template.Flags.f = CLEAR;
+        exceptions = get_grid_exceptions (number_of_rows, number_of_columns, ROW_LETTERS);
+        if (create_grid_array (element, number_of_rows, number_of_columns,
+                pitch_x, pitch_y,
+                ROW_LETTERS, exceptions, pin1_square, NULL, &pad_template))
+        {
+                g_free (exceptions);
+                free_element (element);
+                return (EXIT_FAILURE);
         }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
+        g_free (exceptions);
+        pin_number = (number_of_rows * number_of_columns) + 1;
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pads and the package properties. */
+        update_element_courtyard (element);
         /* Guess for a place where to put the element name. */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
         /* Guess for a place where to put the element refdes. */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
         /* Guess for a place where to put the element value. */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
-        /* Create pin and/or pad entities. */
-        pin_number = 1;
-        for (i = 0; (i < number_of_rows); i++)
-        /* one row at a time [A .. ZZ ..] etc.
-         * where i is one or more letters of the alphabet,
-         * excluding "I", "O", "Q", "S" and "Z". */
-        {
-                for (j = 0; (j < number_of_columns); j++)
-                /* all columns of a row [1 .. n]
-                 * where j is a member of the positive Natural numbers (N). */
-                {
-                        if (pin1_square && (pin_number == 1))
-                        {
-                                pad_flag.f = SQUARE;
-                        }
-                        else
-                        {
-                                pad_flag.f = CLEAR;
-                        }
-                        pin_pad_name = g_strdup_printf ("%s%d", (row_letters[i]), (j + 1));
-                        if (get_pin_pad_exception (pin_pad_name))
-                        {
-                                create_new_pad
-                                (
-                                        element,
-                                        (int) (multiplier * ((((-number_of_columns -1) / 2.0) + 1 + j) * pitch_x)), /* x0 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * ((((-number_of_columns -1) / 2.0) + 1 + j) * pitch_x)), /* x1 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y)), /* y1-coordinate */
-                                        (int) (multiplier * pad_diameter), /* pad width */
-                                        (int) (multiplier * pad_clearance), /* clearance */
-                                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                                        pin_pad_name, /* pin name */
-                                        g_strdup_printf ("%d", pin_number), /* pin number */
-                                        pad_flag /* flags */
-                                );
-                        }
-                        pin_number++;
-                }
-        }
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
         /* Create fiducials if the package seem to have them. */
         if (fiducial)
         {
@@ -199,60 +115,60 @@ bga_create_element ()
                 create_new_pad
                 (
                         element,
-                        (int) (multiplier * ((silkscreen_length - courtyard_length > 2) ?
+                        units_to_coord ((silkscreen_length - courtyard_length > 2) ?
                                 (courtyard_length / 2) :
-                                ((courtyard_length / 2 ) + 1))),
+                                ((courtyard_length / 2 ) + 1)),
                                 /* x0 coordinate */
-                        (int) (multiplier * ((silkscreen_width - courtyard_width > 2) ?
+                        units_to_coord ((silkscreen_width - courtyard_width > 2) ?
                                 (-courtyard_width / 2) :
-                                ((-courtyard_width / 2 ) - 1))),
+                                ((-courtyard_width / 2 ) - 1)),
                                 /* y0 coordinate */
-                        (int) (multiplier * ((silkscreen_length - courtyard_length > 2) ?
+                        units_to_coord ((silkscreen_length - courtyard_length > 2) ?
                                 (courtyard_length / 2) :
-                                ((courtyard_length / 2 ) + 1))),
+                                ((courtyard_length / 2 ) + 1)),
                                 /* x1 coordinate */
-                        (int) (multiplier * ((silkscreen_width - courtyard_width > 2) ?
+                        units_to_coord ((silkscreen_width - courtyard_width > 2) ?
                                 (-courtyard_width / 2) :
-                                ((-courtyard_width / 2 ) - 1))),
+                                ((-courtyard_width / 2 ) - 1)),
                                 /* y1 coordinate */
-                        (int) (multiplier * fiducial_pad_diameter), /* pad width */
-                        (int) (multiplier * fiducial_pad_solder_mask_clearance),
+                        units_to_coord (fiducial_pad_diameter), /* pad width */
+                        units_to_coord (fiducial_pad_solder_mask_clearance),
                                 /* pad clearance */
-                        (int) (multiplier * (fiducial_pad_diameter +
-                                (2 * fiducial_pad_solder_mask_clearance))),
+                        units_to_coord (fiducial_pad_diameter +
+                                (2 * fiducial_pad_solder_mask_clearance)),
                                 /* solder mask clearance */
                         pin_pad_name, /* pin name */
-                        "0", /* pin number */
+                        g_strdup_printf ("%d", pin_number), /* pin number */
                         pad_flag /* flags */
                 );
                 pin_number++;
                 create_new_pad
                 (
                         element,
-                        (int) (multiplier * ((silkscreen_length - courtyard_length > 2) ?
+                        units_to_coord ((silkscreen_length - courtyard_length > 2) ?
                                 (-courtyard_length / 2) :
-                                ((-courtyard_length / 2 ) - 1))),
+                                ((-courtyard_length / 2 ) - 1)),
                                 /* x0 coordinate */
-                        (int) (multiplier * ((silkscreen_width - courtyard_width > 2) ?
+                        units_to_coord ((silkscreen_width - courtyard_width > 2) ?
                                 (courtyard_width / 2) :
-                                ((courtyard_width / 2 ) + 1))),
+                                ((courtyard_width / 2 ) + 1)),
                                 /* y0 coordinate */
-                        (int) (multiplier * ((silkscreen_length - courtyard_length > 2) ?
+                        units_to_coord ((silkscreen_length - courtyard_length > 2) ?
                                 (-courtyard_length / 2) :
-                                ((-courtyard_length / 2 ) - 1))),
+                                ((-courtyard_length / 2 ) - 1)),
                                 /* x1 coordinate */
-                        (int) (multiplier * ((silkscreen_width - courtyard_width > 2) ?
+                        units_to_coord ((silkscreen_width - courtyard_width > 2) ?
                                 (courtyard_width / 2) :
-                                ((courtyard_width / 2 ) + 1))),
+                                ((courtyard_width / 2 ) + 1)),
                                 /* y1 coordinate */
-                        (int) (multiplier * fiducial_pad_diameter), /* pad width */
-                        (int) (multiplier * fiducial_pad_solder_mask_clearance),
+                        units_to_coord (fiducial_pad_diameter), /* pad width */
+                        units_to_coord (fiducial_pad_solder_mask_clearance),
                                 /* pad clearance */
-                        (int) (multiplier * (fiducial_pad_diameter +
-                                (2 * fiducial_pad_solder_mask_clearance))),
+                        units_to_coord (fiducial_pad_diameter +
+                                (2 * fiducial_pad_solder_mask_clearance)),
                                 /* solder mask clearance */
                         pin_pad_name, /* pin name */
-                        "0", /* pin number */
+                        g_strdup_printf ("%d", pin_number), /* pin number */
                         pad_flag /* flags */
                 );
         }
@@ -262,38 +178,38 @@ bga_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
         }
         /* Create a pin #1 marker. */
@@ -304,11 +220,11 @@ bga_create_element ()
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (-package_body_length / 2.0)),
-                                (int) (multiplier * ((-package_body_width / 2.0) + dx)),
-                                (int) (multiplier * ((-package_body_length / 2.0) + dx)),
-                                (int) (multiplier * (-package_body_width / 2.0)),
-                                (int) (multiplier * (silkscreen_line_width))
+                                units_to_coord (-package_body_length / 2.0),
+                                units_to_coord ((-package_body_width / 2.0) + dx),
+                                units_to_coord ((-package_body_length / 2.0) + dx),
+                                units_to_coord (-package_body_width / 2.0),
+                                units_to_coord (silkscreen_line_width)
                         );
                 }
         }
@@ -318,38 +234,38 @@ bga_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
         }
         /* Create attributes here. */
@@ -365,7 +281,8 @@ bga_create_element ()
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
@@ -706,7 +623,7 @@ bga_drc ()
         }
         /* Check for clearance of the package length with regard to the
          * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -718,7 +635,7 @@ bga_drc ()
         }
         /* Check for clearance of the package width with regard to the
          * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -767,8 +684,8 @@ bga_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MIL_100:
                 if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
                 {
@@ -779,8 +696,8 @@ bga_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MM:
                 if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
                 {
@@ -791,8 +708,8 @@ bga_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 default:
                 {
                         if (verbose)
@@ -911,6 +828,9 @@ bga_drc ()
  * - BGA1284C100P36X36_3750X3750X380,
  * - BGA1284C100P36X36_3750X3750X400,
  *
+ * Other well-formed IPC-7351 footprint names are decoded by
+ * ipc7351_get_default_footprint_values ().
+ *
  * \return \c EXIT_SUCCESS when default values for a footprint were
  * found, \c EXIT_FAILURE when the footprint name was not found.
  */
@@ -4751,6 +4671,12 @@ bga_get_default_footprint_values ()
         }
         else
         {
+                /* Not a predefined footprint, try to derive the values
+                 * from the IPC-7351 footprint name. */
+                if (ipc7351_get_default_footprint_values (BGA) == EXIT_SUCCESS)
+                {
+                        return (EXIT_SUCCESS);
+                }
                 g_log ("", G_LOG_LEVEL_WARNING,
                          (_("default values for footprint %s not found.\n")),
                          footprint_name);
@@ -4847,263 +4773,7 @@ bga_set_gui_constraints ()
 int
 bga_write_footprint ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gdouble dx;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
-        gchar *pin_pad_flags = g_strdup ("");
-        gint i;
-        gint j;
-
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
-        {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        (_("could not open file for %s footprint: %s.")),
-                        footprint_type, footprint_filename);
-                fclose (fp);
-                return (EXIT_FAILURE);
-        }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = multiplier *
-        (
-                ((-pitch_x * number_of_columns) / 2.0) -
-                (pad_diameter / 2.0) -
-                pad_solder_mask_clearance
-        );
-        xmax = multiplier *
-        (
-                ((pitch_x * number_of_columns) / 2.0) +
-                (pad_diameter / 2.0) +
-                pad_solder_mask_clearance
-        );
-        ymin = multiplier *
-        (
-                ((-pitch_y * number_of_rows) / 2.0) -
-                (pad_diameter / 2.0) -
-                pad_solder_mask_clearance
-        );
-        ymax = multiplier *
-        (
-                ((pitch_y * number_of_rows) / 2.0) +
-                (pad_diameter / 2.0) +
-                pad_solder_mask_clearance
-        );
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        pin_number = 1;
-        for (i = 0; (i < number_of_rows); i++)
-        /* one row at a time [A .. ZZ ..] etc.
-         * where i is one or more letters of the alphabet,
-         * excluding "I", "O", "Q", "S" and "Z" */
-        {
-                for (j = 0; (j < number_of_columns); j++)
-                /* all columns of a row [1 .. n]
-                 * where j is a member of the positive Natural numbers (N) */
-                {
-                        if (pin1_square && (pin_number == 1))
-                        {
-                                pin_pad_flags = g_strdup ("square");
-                        }
-                        else
-                        {
-                                pin_pad_flags = g_strdup ("");
-                        }
-                        pin_pad_name = g_strdup_printf ("%s%d", (row_letters[i]), (j + 1));
-                        if (get_pin_pad_exception (pin_pad_name))
-                        {
-                                write_pad
-                                (
-                                        pin_number, /* pin number */
-                                        pin_pad_name, /* pin name */
-                                        multiplier * ((((-number_of_columns -1) / 2.0) + 1 + j) * pitch_x), /* x0 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
-                                        multiplier * ((((-number_of_columns -1) / 2.0) + 1 + j) * pitch_x), /* x1 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y1-coordinate */
-                                        multiplier * pad_diameter, /* pad width */
-                                        multiplier * pad_clearance, /* clearance */
-                                        multiplier * (pad_diameter + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                        }
-                        pin_number++;
-                }
-        }
-        /* Write fiducials if the package seem to have them. */
-        if (fiducial)
-        {
-                fprintf (fp, (_("# Write fiducials\n")));
-                pin_pad_name = g_strdup ("");
-                pin_pad_flags = g_strdup ("");
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * ((silkscreen_length - courtyard_length > 2) ?
-                                (courtyard_length / 2) :
-                                ((courtyard_length / 2 ) + 1)),
-                                /* x0 coordinate */
-                        multiplier * ((silkscreen_width - courtyard_width > 2) ?
-                                (-courtyard_width / 2) :
-                                ((-courtyard_width / 2 ) - 1)),
-                                /* y0 coordinate */
-                        multiplier * ((silkscreen_length - courtyard_length > 2) ?
-                                (courtyard_length / 2) :
-                                ((courtyard_length / 2 ) + 1)),
-                                /* x1 coordinate */
-                        multiplier * ((silkscreen_width - courtyard_width > 2) ?
-                                (-courtyard_width / 2) :
-                                ((-courtyard_width / 2 ) - 1)),
-                                /* y1 coordinate */
-                        multiplier * fiducial_pad_diameter, /* pad width */
-                        multiplier * fiducial_pad_solder_mask_clearance,
-                                /* pad clearance */
-                        multiplier * (fiducial_pad_diameter +
-                                (2 * fiducial_pad_solder_mask_clearance)),
-                                /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                pin_number++;
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * ((silkscreen_length - courtyard_length > 2) ?
-                                (-courtyard_length / 2) :
-                                ((-courtyard_length / 2 ) - 1)),
-                                /* x0 coordinate */
-                        multiplier * ((silkscreen_width - courtyard_width > 2) ?
-                                (courtyard_width / 2) :
-                                ((courtyard_width / 2 ) + 1)),
-                                /* y0 coordinate */
-                        multiplier * ((silkscreen_length - courtyard_length > 2) ?
-                                (-courtyard_length / 2) :
-                                ((-courtyard_length / 2 ) - 1)),
-                                /* x1 coordinate */
-                        multiplier * ((silkscreen_width - courtyard_width > 2) ?
-                                (courtyard_width / 2) :
-                                ((courtyard_width / 2 ) + 1)),
-                                /* y1 coordinate */
-                        multiplier * fiducial_pad_diameter, /* pad width */
-                        multiplier * fiducial_pad_solder_mask_clearance,
-                                /* pad clearance */
-                        multiplier * (fiducial_pad_diameter +
-                                (2 * fiducial_pad_solder_mask_clearance)),
-                                /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-        }
-        /* Write a package body on the silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, (_("# Write a package body on the silkscreen\n")));
-                write_rectangle
-                (
-                        multiplier * (-package_body_length / 2.0),
-                        multiplier * (-package_body_width / 2.0),
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                fprintf (fp, (_("# Write a pin 1 marker on the silkscreen\n")));
-                for (dx = 0.0; dx < (pitch_x / 2.0); dx = dx + silkscreen_line_width)
-                {
-                        write_element_line
-                        (
-                                multiplier * (-package_body_length / 2.0),
-                                multiplier * ((-package_body_width / 2.0) + dx),
-                                multiplier * ((-package_body_length / 2.0) + dx),
-                                multiplier * (-package_body_width / 2.0),
-                                multiplier * (silkscreen_line_width)
-                        );
-                }
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, (_("# Write a courtyard on the silkscreen\n")));
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        (_("[%s] wrote footprint: %s.")),
-                        footprint_type,
-                        footprint_filename);
-        }
-        return (EXIT_SUCCESS);
+        return (write_footprint_element (bga_create_element));
 }
 
 
@@ -0,0 +1,1932 @@
+/*!
+ * \file src/build.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for building a directory of footprints (fpw --build).
+ *
+ * Every row of the footprint libraries and every footprintwizard file in
+ * a directory is built into a footprint file in the output directory.\n
+ * A build manifest in the output directory records for every footprint
+ * file the hash of its input, the version of fpw which built it and the
+ * hash of the footprint file.\n
+ * A rebuild only builds the footprints whose input or generator version
+ * changed, or whose footprint file is missing, and removes the footprint
+ * files of inputs which are gone, like make does for files.\n
+ * The footprints to build are run on a number of worker processes, the
+ * footprints with the most pins first.\n
+ * The footprints can also be built into one archive file instead of a
+ * directory, see archive.c, or streamed to stdout for a pipeline.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "build.h"
+
+
+/*!
+ * \brief The values of the global variables of a footprint before the
+ * first job, in the order of \c fpw_fields[] followed by
+ * \c footprint_cache_extra_fields[].
+ */
+static union
+{
+        gdouble number;
+        gint integer;
+        gchar *string;
+} build_defaults[G_N_ELEMENTS (fpw_fields) + G_N_ELEMENTS (footprint_cache_extra_fields)];
+
+/*!
+ * \brief Whether \c build_defaults holds the default values.
+ */
+static gboolean build_defaults_saved = FALSE;
+
+/*!
+ * \brief Whether the strings of the footprintwizard file fields were
+ * allocated by reading a footprintwizard file, the strings of a library
+ * row point into the library.
+ */
+static gboolean build_strings_allocated = FALSE;
+
+
+/*!
+ * \brief Compare two filenames, for sorting.
+ */
+static gint
+build_compare_filenames
+(
+        const gchar **a,
+                /*!< : the first filename.*/
+        const gchar **b
+                /*!< : the second filename.*/
+)
+{
+        return (strcmp (*a, *b));
+}
+
+
+/*!
+ * \brief Compare two records of the build manifest on name, for sorting.
+ */
+static gint
+build_compare_records
+(
+        const build_record_t **a,
+                /*!< : the first record.*/
+        const build_record_t **b
+                /*!< : the second record.*/
+)
+{
+        return (strcmp ((*a)->name, (*b)->name));
+}
+
+
+/*!
+ * \brief Free a record of the build manifest.
+ */
+static void
+build_free_record
+(
+        build_record_t *record
+                /*!< : the record.*/
+)
+{
+        g_free (record->name);
+        g_free (record->generator_version);
+        g_free (record);
+}
+
+
+/*!
+ * \brief Hash the contents of a file.
+ *
+ * \return \c EXIT_SUCCESS when the file was read, \c EXIT_FAILURE when
+ * it could not be read.
+ */
+static int
+build_hash_file
+(
+        const gchar *filename,
+                /*!< : the name of the file.*/
+        guint64 *hash
+                /*!< : is set to the hash of the contents.*/
+)
+{
+        GMappedFile *file;
+
+        file = g_mapped_file_new (filename, FALSE, NULL);
+        if (!file)
+        {
+                return (EXIT_FAILURE);
+        }
+        *hash = hash_fpw_line (G_GUINT64_CONSTANT (14695981039346656037),
+                g_mapped_file_get_contents (file),
+                g_mapped_file_get_length (file));
+        g_mapped_file_unref (file);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read the build manifest of the previous build.
+ *
+ * A missing or unreadable manifest, or one of another format version,
+ * leaves no previous records, so everything is built.
+ */
+static void
+build_read_manifest
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        FILE *manifest;
+        build_record_t *record;
+        gchar *filename;
+        gchar *line = NULL;
+        gchar **fields;
+        size_t allocated = 0;
+        gint version = 0;
+
+        filename = g_build_filename (build->output_directory,
+                BUILD_MANIFEST_FILENAME, NULL);
+        manifest = fopen (filename, "r");
+        g_free (filename);
+        if (!manifest)
+        {
+                return;
+        }
+        if ((getline (&line, &allocated, manifest) == -1) ||
+                (sscanf (line, "fpw_manifest=%d", &version) != 1) ||
+                (version != BUILD_MANIFEST_VERSION))
+        {
+                free (line);
+                fclose (manifest);
+                return;
+        }
+        while (getline (&line, &allocated, manifest) != -1)
+        {
+                fields = g_strsplit (g_strchomp (line), "\t", 4);
+                if (g_strv_length (fields) == 4)
+                {
+                        record = g_new0 (build_record_t, 1);
+                        record->name = g_strdup (fields[0]);
+                        record->input_hash = g_ascii_strtoull (fields[1], NULL, 16);
+                        record->generator_version = g_strdup (fields[2]);
+                        record->output_hash = g_ascii_strtoull (fields[3], NULL, 16);
+                        g_ptr_array_add (build->previous_records, record);
+                        g_hash_table_insert (build->previous, record->name, record);
+                }
+                g_strfreev (fields);
+        }
+        free (line);
+        fclose (manifest);
+}
+
+
+/*!
+ * \brief Remove the temporary footprint files left behind in the output
+ * directory by an interrupted build.
+ *
+ * A temporary footprint file is named after the footprint file, the
+ * process id and ".tmp", like "name.fp.1234.tmp".
+ */
+static void
+build_remove_temporaries
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        GDir *directory;
+        const gchar *name;
+        gchar *filename;
+        gchar *suffix;
+        gsize length;
+        gsize digits;
+
+        directory = g_dir_open (build->output_directory, 0, NULL);
+        if (!directory)
+        {
+                return;
+        }
+        suffix = g_strconcat (".", fp_suffix, ".", NULL);
+        while ((name = g_dir_read_name (directory)))
+        {
+                if (!g_str_has_suffix (name, ".tmp"))
+                {
+                        continue;
+                }
+                length = strlen (name) - strlen (".tmp");
+                for (digits = 0; (digits < length) && g_ascii_isdigit (name[length - digits - 1]); digits++);
+                length -= digits;
+                if ((digits == 0) || (length < strlen (suffix)) ||
+                        strncmp (name + length - strlen (suffix), suffix, strlen (suffix)))
+                {
+                        continue;
+                }
+                filename = g_build_filename (build->output_directory, name, NULL);
+                if ((unlink (filename) == 0) && (verbose))
+                {
+                        g_log ("", G_LOG_LEVEL_INFO,
+                                _("removed temporary file %s of an interrupted build."),
+                                filename);
+                }
+                g_free (filename);
+        }
+        g_free (suffix);
+        g_dir_close (directory);
+}
+
+
+/*!
+ * \brief Write the build manifest of this build.
+ *
+ * The manifest is written under a temporary name and renamed into
+ * place, so an interrupted build leaves the previous manifest.
+ *
+ * \return \c EXIT_SUCCESS when the manifest was written,
+ * \c EXIT_FAILURE when writing failed.
+ */
+static int
+build_write_manifest
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        FILE *manifest;
+        build_record_t *record;
+        gchar *filename;
+        gchar *temporary;
+        gint failed;
+        guint i;
+
+        filename = g_build_filename (build->output_directory,
+                BUILD_MANIFEST_FILENAME, NULL);
+        temporary = g_strconcat (filename, ".tmp", NULL);
+        manifest = fopen (temporary, "w");
+        failed = !manifest;
+        if (manifest)
+        {
+                fprintf (manifest, "fpw_manifest=%d\n", BUILD_MANIFEST_VERSION);
+                /* The footprints are built in order of cost, the manifest
+                 * is in order of name. */
+                g_ptr_array_sort (build->records, (GCompareFunc) build_compare_records);
+                for (i = 0; i < build->records->len; i++)
+                {
+                        record = build->records->pdata[i];
+                        fprintf (manifest, "%s\t%016" G_GINT64_MODIFIER "x\t%s\t%016" G_GINT64_MODIFIER "x\n",
+                                record->name, record->input_hash,
+                                record->generator_version, record->output_hash);
+                }
+                failed = ferror (manifest);
+                failed |= fclose (manifest);
+                failed = failed || rename (temporary, filename);
+        }
+        if (failed)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not write build manifest %s."),
+                                filename);
+                }
+                unlink (temporary);
+        }
+        g_free (temporary);
+        g_free (filename);
+        return (failed ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Check if a footprint is up to date.
+ *
+ * A footprint is up to date when the previous build built it from the
+ * same input with the same generator version and the footprint file
+ * still exists.\n
+ * An up to date footprint is kept in the manifest of this build.
+ *
+ * \return \c TRUE when the footprint is up to date.
+ */
+static gboolean
+build_is_up_to_date
+(
+        build_t *build,
+                /*!< : the build.*/
+        const gchar *name,
+                /*!< : the name of the footprint file.*/
+        guint64 input_hash
+                /*!< : the hash of the input.*/
+)
+{
+        build_record_t *previous;
+        build_record_t *record;
+        gchar *filename;
+        gboolean up_to_date = FALSE;
+
+        previous = g_hash_table_lookup (build->previous, name);
+        if (!previous)
+        {
+                return (FALSE);
+        }
+        previous->seen = TRUE;
+        if ((previous->input_hash == input_hash) &&
+                !strcmp (previous->generator_version, VERSION))
+        {
+                filename = g_build_filename (build->output_directory, name, NULL);
+                up_to_date = (access (filename, F_OK) == 0);
+                g_free (filename);
+        }
+        if (up_to_date)
+        {
+                record = g_new0 (build_record_t, 1);
+                record->name = g_strdup (name);
+                record->input_hash = input_hash;
+                record->generator_version = g_strdup (VERSION);
+                record->output_hash = previous->output_hash;
+                g_ptr_array_add (build->records, record);
+                g_hash_table_insert (build->current, record->name, record->name);
+                build->unchanged++;
+        }
+        return (up_to_date);
+}
+
+
+/*!
+ * \brief Check if a footprint name was already claimed in this build.
+ *
+ * \return \c TRUE when the name is a duplicate, it is skipped.
+ */
+static gboolean
+build_is_duplicate
+(
+        build_t *build,
+                /*!< : the build.*/
+        const gchar *name,
+                /*!< : the name of the footprint file.*/
+        const gchar *input
+                /*!< : the input, for the message.*/
+)
+{
+        if (!g_hash_table_lookup (build->current, name))
+        {
+                return (FALSE);
+        }
+        if ((verbose) || (!silent))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("skipped %s: footprint %s was built already."),
+                        input, name);
+        }
+        build->failed++;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Add a footprint to the jobs of this build.
+ */
+static void
+build_add_job
+(
+        build_t *build,
+                /*!< : the build.*/
+        const gchar *name,
+                /*!< : the name of the footprint file.*/
+        guint64 input_hash,
+                /*!< : the hash of the input.*/
+        guint row,
+                /*!< : the library row to build.*/
+        const gchar *fpw_filename,
+                /*!< : the footprintwizard file to build, \c NULL to build
+                 * the library row.*/
+        const gchar *name_of_footprint
+                /*!< : the footprint name for a footprintwizard file.*/
+)
+{
+        build_job_t job;
+
+        memset (&job, 0, sizeof (job));
+        job.name = g_strdup (name);
+        job.input_hash = input_hash;
+        job.row = row;
+        job.fpw_filename = g_strdup (fpw_filename);
+        job.footprint_name = g_strdup (name_of_footprint);
+        /* The number of pins is the best guess of the time a footprint
+         * takes, a large BGA takes thousands of times longer than a chip
+         * capacitor. */
+        job.cost = MAX (1, get_total_number_of_pins ());
+        job.result = EXIT_FAILURE;
+        g_array_append_val (build->jobs, job);
+        g_hash_table_insert (build->current, job.name, job.name);
+}
+
+
+/*!
+ * \brief Compare two jobs, for sorting the most costly job first.
+ *
+ * Jobs of the same cost are sorted on name, so the order of a build does
+ * not depend on the order of the input.
+ */
+static gint
+build_compare_jobs
+(
+        const build_job_t *a,
+                /*!< : the first job.*/
+        const build_job_t *b
+                /*!< : the second job.*/
+)
+{
+        if (a->cost != b->cost)
+        {
+                return ((a->cost > b->cost) ? -1 : 1);
+        }
+        return (strcmp (a->name, b->name));
+}
+
+
+/*!
+ * \brief Restore a global variable to its value before the first job.
+ *
+ * The first call saves the value.
+ */
+static void
+build_restore_default
+(
+        guint i,
+                /*!< : the index in \c build_defaults.*/
+        fpw_value_t type,
+                /*!< : the type of the global variable.*/
+        gpointer value,
+                /*!< : the global variable.*/
+        gboolean free_string
+                /*!< : free a string which differs from the default.*/
+)
+{
+        switch (type)
+        {
+                case FPW_IGNORE:
+                        break;
+                case FPW_STRING:
+                        if (!build_defaults_saved)
+                        {
+                                build_defaults[i].string = *(gchar **) value;
+                        }
+                        else if (*(gchar **) value != build_defaults[i].string)
+                        {
+                                if (free_string)
+                                {
+                                        g_free (*(gchar **) value);
+                                }
+                                *(gchar **) value = build_defaults[i].string;
+                        }
+                        break;
+                case FPW_DOUBLE:
+                        if (!build_defaults_saved)
+                        {
+                                build_defaults[i].number = *(gdouble *) value;
+                        }
+                        *(gdouble *) value = build_defaults[i].number;
+                        break;
+                case FPW_INTEGER:
+                        if (!build_defaults_saved)
+                        {
+                                build_defaults[i].integer = *(gint *) value;
+                        }
+                        *(gint *) value = build_defaults[i].integer;
+                        break;
+        }
+}
+
+
+/*!
+ * \brief Restore the global variables of a footprint to their values
+ * before the first job.
+ *
+ * A footprintwizard file only sets the fields it holds and a library row
+ * only sets the library columns, so every job starts from the same
+ * values whatever job ran before it.\n
+ * The first call saves the values.\n
+ * Strings read from a footprintwizard file are freed.
+ */
+static void
+build_restore_defaults ()
+{
+        guint i;
+        guint j;
+
+        for (i = 0; i < G_N_ELEMENTS (fpw_fields); i++)
+        {
+                build_restore_default (i, fpw_fields[i].type,
+                        fpw_fields[i].value, build_strings_allocated);
+        }
+        /* The footprint name is set by the job. */
+        for (j = 0; j < G_N_ELEMENTS (footprint_cache_extra_fields); j++, i++)
+        {
+                build_restore_default (i, footprint_cache_extra_fields[j].type,
+                        footprint_cache_extra_fields[j].value, FALSE);
+        }
+        build_defaults_saved = TRUE;
+        build_strings_allocated = FALSE;
+}
+
+
+/*!
+ * \brief Set the global variables of a footprint from a library row.
+ *
+ * \return \c EXIT_SUCCESS when the row describes a footprint,
+ * \c EXIT_FAILURE when it has no name or an unknown package type, units
+ * or pad shape.
+ */
+static int
+build_set_row_globals
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        guint row
+                /*!< : the row.*/
+)
+{
+        library_set_globals (library, row);
+        if (!footprint_name || !strcmp (footprint_name, "") ||
+                !footprint_type || !footprint_units || !pad_shape ||
+                (get_package_type () == EXIT_FAILURE) ||
+                (update_units_variables () == EXIT_FAILURE) ||
+                (update_pad_shapes_variables () == EXIT_FAILURE))
+        {
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Put a generated footprint in the write queue of a worker.
+ *
+ * Waits while the queue is full, so the generator can not run ahead of
+ * the writers by more than \c BUILD_QUEUE_DEPTH footprints.
+ */
+static void
+build_fifo_push
+(
+        build_fifo_t *fifo,
+                /*!< : the write queue.*/
+        build_item_t *item
+                /*!< : the footprint, the \c job is \c NULL to stop a
+                 * writer.*/
+)
+{
+        pthread_mutex_lock (&fifo->mutex);
+        while (fifo->count == BUILD_QUEUE_DEPTH)
+        {
+                pthread_cond_wait (&fifo->not_full, &fifo->mutex);
+        }
+        fifo->items[fifo->head] = *item;
+        fifo->head = (fifo->head + 1) % BUILD_QUEUE_DEPTH;
+        fifo->count++;
+        pthread_cond_signal (&fifo->not_empty);
+        pthread_mutex_unlock (&fifo->mutex);
+}
+
+
+/*!
+ * \brief Take a generated footprint from the write queue of a worker.
+ *
+ * Waits while the queue is empty.
+ */
+static void
+build_fifo_pop
+(
+        build_fifo_t *fifo,
+                /*!< : the write queue.*/
+        build_item_t *item
+                /*!< : is set to the footprint.*/
+)
+{
+        pthread_mutex_lock (&fifo->mutex);
+        while (fifo->count == 0)
+        {
+                pthread_cond_wait (&fifo->not_empty, &fifo->mutex);
+        }
+        *item = fifo->items[fifo->tail];
+        fifo->tail = (fifo->tail + 1) % BUILD_QUEUE_DEPTH;
+        fifo->count--;
+        pthread_cond_signal (&fifo->not_full);
+        pthread_mutex_unlock (&fifo->mutex);
+}
+
+
+/*!
+ * \brief Take a generated footprint from the write queue of a worker if
+ * there is one.
+ *
+ * \return \c TRUE when a footprint was taken, \c FALSE when the queue
+ * was empty.
+ */
+static gboolean
+build_fifo_try_pop
+(
+        build_fifo_t *fifo,
+                /*!< : the write queue.*/
+        build_item_t *item
+                /*!< : is set to the footprint.*/
+)
+{
+        gboolean taken = FALSE;
+
+        pthread_mutex_lock (&fifo->mutex);
+        if (fifo->count > 0)
+        {
+                *item = fifo->items[fifo->tail];
+                fifo->tail = (fifo->tail + 1) % BUILD_QUEUE_DEPTH;
+                fifo->count--;
+                pthread_cond_signal (&fifo->not_full);
+                taken = TRUE;
+        }
+        pthread_mutex_unlock (&fifo->mutex);
+        return (taken);
+}
+
+
+/*!
+ * \brief Write everything written to the output directory of a build to
+ * disk.
+ *
+ * One syncfs () writes a whole batch of footprints to disk, instead of
+ * one fdatasync () for every footprint.
+ *
+ * \return \c EXIT_SUCCESS when the footprints are on disk,
+ * \c EXIT_FAILURE when they could not be written to disk.
+ */
+static int
+build_sync
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+#ifdef HAVE_SYNCFS
+        if (build->output_fd >= 0)
+        {
+                return ((syncfs (build->output_fd) == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+#endif
+        sync ();
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a batch of footprints into the output directory of a
+ * build.
+ *
+ * The batch is written through io_uring, or with pwrite () when io_uring
+ * is not available, under temporary names in the output directory.\n
+ * The batch is written to disk with one build_sync () and then renamed
+ * into place, so an interrupted build never leaves a half written
+ * footprint file.
+ */
+static void
+build_write_files
+(
+        build_t *build,
+                /*!< : the build.*/
+        uring_t **ring,
+                /*!< : the io_uring of the writer, freed and set to
+                 * \c NULL when it fails.*/
+        guint n,
+                /*!< : the number of footprints.*/
+        gchar **filenames,
+                /*!< : the footprint files.*/
+        gchar **texts,
+                /*!< : the footprint texts.*/
+        gsize *sizes,
+                /*!< : the sizes of the footprint texts.*/
+        gint *errors
+                /*!< : the errno of every footprint, 0 when it was
+                 * written.*/
+)
+{
+        gchar *temporaries[BUILD_QUEUE_DEPTH];
+        gint error;
+        guint written = 0;
+        guint i;
+
+        for (i = 0; i < n; i++)
+        {
+                temporaries[i] = g_strdup_printf ("%s.%d.tmp", filenames[i], (gint) getpid ());
+        }
+        if (*ring && (uring_write_files (*ring, n, temporaries, texts, sizes, errors) == EXIT_FAILURE))
+        {
+                uring_free (*ring);
+                *ring = NULL;
+        }
+        if (!*ring)
+        {
+                for (i = 0; i < n; i++)
+                {
+                        errors[i] = (uring_pwrite_file (temporaries[i], texts[i], sizes[i]) == EXIT_SUCCESS) ? 0 : errno;
+                }
+        }
+        /* Publish the footprints of the batch only after they are on
+         * disk. */
+        for (i = 0; i < n; i++)
+        {
+                written += errors[i] ? 0 : 1;
+        }
+        error = ((written > 0) && (build_sync (build) == EXIT_FAILURE)) ? errno : 0;
+        for (i = 0; i < n; i++)
+        {
+                if (!errors[i])
+                {
+                        errors[i] = error;
+                }
+                if (!errors[i] && (rename (temporaries[i], filenames[i]) != 0))
+                {
+                        errors[i] = errno;
+                }
+                if (errors[i])
+                {
+                        unlink (temporaries[i]);
+                        unlink (filenames[i]);
+                }
+                g_free (temporaries[i]);
+        }
+}
+
+
+/*!
+ * \brief Write a batch of footprints to the stream of a build.
+ *
+ * Every footprint is framed by a header with its name and size:\n
+ * <tt>fpw_footprint=name\\n footprint_size=size\\n \\n</tt>
+ * followed by the footprint text.\n
+ * The workers share the stream, a worker holds the stream mutex while it
+ * writes and flushes a whole batch, so the footprints of the workers are
+ * never mixed up.\n
+ * The mutex is robust, a worker which dies while holding it does not
+ * block the other workers.
+ */
+static void
+build_write_stream
+(
+        build_t *build,
+                /*!< : the build.*/
+        guint n,
+                /*!< : the number of footprints.*/
+        gchar **names,
+                /*!< : the footprint names.*/
+        gchar **texts,
+                /*!< : the footprint texts.*/
+        gsize *sizes,
+                /*!< : the sizes of the footprint texts.*/
+        gint *errors
+                /*!< : the errno of every footprint, 0 when it was
+                 * written.*/
+)
+{
+        gint error;
+        guint i;
+
+        if (pthread_mutex_lock (build->stream_mutex) == EOWNERDEAD)
+        {
+                /* A worker died while writing, for instance of a
+                 * SIGPIPE when the reader of the stream is gone. */
+                pthread_mutex_consistent (build->stream_mutex);
+        }
+        for (i = 0; i < n; i++)
+        {
+                fprintf (build->stream, "fpw_footprint=%s\nfootprint_size=%" G_GSIZE_FORMAT "\n\n",
+                        names[i], sizes[i]);
+                fwrite (texts[i], 1, sizes[i], build->stream);
+        }
+        error = ((fflush (build->stream) != 0) || ferror (build->stream)) ? errno : 0;
+        pthread_mutex_unlock (build->stream_mutex);
+        for (i = 0; i < n; i++)
+        {
+                errors[i] = error;
+        }
+}
+
+
+/*!
+ * \brief Write the footprints from the write queue of a worker until a
+ * stop item is taken.
+ *
+ * A writer takes all footprints waiting in the queue, up to
+ * \c BUILD_QUEUE_DEPTH, and writes them as one batch into the output
+ * directory, see build_write_files ().\n
+ * When building an archive the footprints are appended to the archive
+ * instead, when streaming they are written to the stream.\n
+ * A writer does not touch the global variables, the footprint is written
+ * from the text in the queue, and hashed while it is in memory.\n
+ * The result and the output hash are stored in the job.
+ *
+ * \return \c NULL.
+ */
+static gpointer
+build_run_writer
+(
+        gpointer data
+                /*!< : the build.*/
+)
+{
+        build_t *build = data;
+        build_item_t item;
+        build_item_t items[BUILD_QUEUE_DEPTH];
+        gchar *filenames[BUILD_QUEUE_DEPTH];
+        gchar *texts[BUILD_QUEUE_DEPTH];
+        gsize sizes[BUILD_QUEUE_DEPTH];
+        gint errors[BUILD_QUEUE_DEPTH];
+        uring_t *ring = NULL;
+        gboolean stop = FALSE;
+        gint64 start;
+        guint n;
+        guint i;
+        static gint reported = 0;
+
+        stats_trace_set_thread_name ("writer");
+        if (build->output_directory)
+        {
+                ring = uring_new (2 * BUILD_QUEUE_DEPTH);
+                if (!ring && (verbose) && (build->worker == 0) &&
+                        !__sync_fetch_and_or (&reported, 1))
+                {
+                        g_log ("", G_LOG_LEVEL_INFO,
+                                _("io_uring is not available, writing footprints with pwrite ()."));
+                }
+        }
+        while (!stop)
+        {
+                n = 0;
+                build_fifo_pop (build->fifo, &item);
+                for (;;)
+                {
+                        if (!item.job)
+                        {
+                                stop = TRUE;
+                                break;
+                        }
+                        items[n++] = item;
+                        if ((n == BUILD_QUEUE_DEPTH) ||
+                                !build_fifo_try_pop (build->fifo, &item))
+                        {
+                                break;
+                        }
+                }
+                start = g_get_monotonic_time ();
+                for (i = 0; i < n; i++)
+                {
+                        filenames[i] = build->output_directory ?
+                                g_build_filename (build->output_directory, items[i].job->name, NULL) :
+                                g_strdup (items[i].job->name);
+                        texts[i] = items[i].text;
+                        sizes[i] = items[i].size;
+                }
+                if (build->archive_filename)
+                {
+                        for (i = 0; i < n; i++)
+                        {
+                                errors[i] = (archive_append (build->archive_fd, build->archive_end,
+                                        texts[i], sizes[i], build->compression,
+                                        &items[i].job->entry) == EXIT_SUCCESS) ? 0 : errno;
+                        }
+                }
+                else if (build->stream)
+                {
+                        build_write_stream (build, n, filenames, texts, sizes, errors);
+                }
+                else if (n > 0)
+                {
+                        build_write_files (build, &ring, n, filenames, texts, sizes, errors);
+                }
+                for (i = 0; i < n; i++)
+                {
+                        if (errors[i])
+                        {
+                                if ((verbose) || (!silent))
+                                {
+                                        g_log ("", G_LOG_LEVEL_WARNING,
+                                                _("could not write footprint %s: %s."),
+                                                filenames[i], g_strerror (errors[i]));
+                                }
+                        }
+                        else
+                        {
+                                items[i].job->output_hash = hash_fpw_line (G_GUINT64_CONSTANT (14695981039346656037),
+                                        texts[i], sizes[i]);
+                                items[i].job->result = EXIT_SUCCESS;
+                        }
+                        g_free (filenames[i]);
+                        free (texts[i]);
+                }
+                __sync_fetch_and_add (&build->workers[build->worker].writing,
+                        g_get_monotonic_time () - start);
+                stats_trace ("write", "batch", start);
+        }
+        uring_free (ring);
+        return (NULL);
+}
+
+
+/*!
+ * \brief Generate the footprint of a job in memory and put it in the
+ * write queue.
+ *
+ * A footprint which fails is removed from the output directory, so no
+ * stale footprint is left behind.
+ */
+static void
+build_run_job
+(
+        build_t *build,
+                /*!< : the build.*/
+        build_job_t *job
+                /*!< : the job.*/
+)
+{
+        build_item_t item;
+        gint64 start;
+        gint result;
+
+        start = g_get_monotonic_time ();
+        item.job = job;
+        item.text = NULL;
+        item.size = 0;
+        build_restore_defaults ();
+        if (job->fpw_filename)
+        {
+                result = read_footprintwizard_file (job->fpw_filename);
+                build_strings_allocated = TRUE;
+                footprint_name = job->footprint_name;
+        }
+        else
+        {
+                result = build_set_row_globals (build->library, job->row);
+        }
+        footprint_filename = build->output_directory ?
+                g_build_filename (build->output_directory, job->name, NULL) :
+                g_strdup (job->name);
+        if (result == EXIT_SUCCESS)
+        {
+                footprint_output = open_memstream (&item.text, &item.size);
+                result = footprint_output ? write_footprint () : EXIT_FAILURE;
+                if (footprint_output)
+                {
+                        fclose (footprint_output);
+                        footprint_output = NULL;
+                }
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                build_fifo_push (build->fifo, &item);
+        }
+        else
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not build footprint %s."),
+                                footprint_filename);
+                }
+                if (build->output_directory)
+                {
+                        unlink (footprint_filename);
+                }
+                free (item.text);
+        }
+        g_free (footprint_filename);
+        footprint_filename = NULL;
+        footprint_name = NULL;
+        stats_trace (job->name, "footprint", start);
+}
+
+
+/*!
+ * \brief Run jobs from the queue of a build until it is empty.
+ *
+ * Every worker takes the next job from the one queue, which is sorted
+ * with the most costly job first.\n
+ * The costly jobs are started first and the cheap jobs at the end fill
+ * up the workers which are done early, so all workers finish at about
+ * the same time.\n
+ * A worker is a pipeline of two stages: the worker process reads the
+ * input, checks the DRC and generates the footprint in memory, while its
+ * writer threads write the footprints generated before, in batches
+ * through io_uring.\n
+ * The generating stage works on the global variables, so it can only be
+ * parallel over processes, the writing stage works on the footprint text
+ * only, so it can use threads.
+ */
+static void
+build_run_worker
+(
+        build_t *build,
+                /*!< : the build.*/
+        guint worker
+                /*!< : the number of the worker.*/
+)
+{
+        build_worker_t *statistics;
+        build_item_t stop = {NULL, NULL, 0};
+        build_fifo_t fifo;
+        build_job_t *job;
+        pthread_t *writers;
+        gchar *name;
+        gint64 start;
+        guint i;
+
+        name = g_strdup_printf ("worker %u", worker);
+        stats_trace_set_thread_name (name);
+        g_free (name);
+        memset (&fifo, 0, sizeof (fifo));
+        pthread_mutex_init (&fifo.mutex, NULL);
+        pthread_cond_init (&fifo.not_empty, NULL);
+        pthread_cond_init (&fifo.not_full, NULL);
+        build->fifo = &fifo;
+        build->worker = worker;
+        writers = g_new0 (pthread_t, build->n_writers);
+        for (i = 0; i < build->n_writers; i++)
+        {
+                pthread_create (&writers[i], NULL, build_run_writer, build);
+        }
+        statistics = &build->workers[worker];
+        while ((i = __sync_fetch_and_add (build->next, 1)) < build->jobs->len)
+        {
+                job = &build->queue[i];
+                job->worker = worker;
+                start = g_get_monotonic_time ();
+                build_run_job (build, job);
+                statistics->busy += g_get_monotonic_time () - start;
+                statistics->jobs++;
+                statistics->pins += job->cost;
+        }
+        for (i = 0; i < build->n_writers; i++)
+        {
+                build_fifo_push (&fifo, &stop);
+        }
+        for (i = 0; i < build->n_writers; i++)
+        {
+                pthread_join (writers[i], NULL);
+        }
+        g_free (writers);
+        pthread_mutex_destroy (&fifo.mutex);
+        pthread_cond_destroy (&fifo.not_empty);
+        pthread_cond_destroy (&fifo.not_full);
+        build->fifo = NULL;
+}
+
+
+/*!
+ * \brief Map memory which is shared with the worker processes.
+ *
+ * \return the memory, \c NULL when it could not be mapped.
+ */
+static gpointer
+build_map_shared
+(
+        gsize size
+                /*!< : the size of the memory.*/
+)
+{
+        gpointer memory;
+
+        memory = mmap (NULL, MAX (size, 1), PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        return ((memory == MAP_FAILED) ? NULL : memory);
+}
+
+
+/*!
+ * \brief Run the jobs of a build on a number of worker processes.
+ *
+ * The footprint code works on global variables, so the workers are
+ * processes and not threads.\n
+ * The queue, its position and the statistics of the workers are in
+ * shared memory.\n
+ * A worker which dies leaves its job failed, the other workers take over
+ * the rest of the queue.
+ *
+ * \return \c EXIT_SUCCESS when the jobs were run,
+ * \c EXIT_FAILURE when the shared memory could not be mapped.
+ */
+static int
+build_schedule
+(
+        build_t *build,
+                /*!< : the build.*/
+        gint workers,
+                /*!< : the number of worker processes, 0 for one per
+                 * processor.*/
+        gint writers
+                /*!< : the number of writer threads per worker.*/
+)
+{
+        build_job_t *job;
+        pid_t *pids;
+        gint64 start;
+        gint64 elapsed;
+        gint64 busy = 0;
+        gint status;
+        guint i;
+
+        if (build->jobs->len == 0)
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (workers < 1)
+        {
+                workers = MAX (1, sysconf (_SC_NPROCESSORS_ONLN));
+        }
+        build->n_workers = MIN ((guint) workers, build->jobs->len);
+        build->n_writers = MAX (1, writers);
+        g_array_sort (build->jobs, (GCompareFunc) build_compare_jobs);
+        build->queue = build_map_shared (build->jobs->len * sizeof (build_job_t));
+        build->workers = build_map_shared (build->n_workers * sizeof (build_worker_t));
+        build->next = build_map_shared (sizeof (guint));
+        if (!build->queue || !build->workers || !build->next)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not map shared memory for %u jobs."),
+                                build->jobs->len);
+                }
+                return (EXIT_FAILURE);
+        }
+        memcpy (build->queue, build->jobs->data, build->jobs->len * sizeof (build_job_t));
+        start = g_get_monotonic_time ();
+        if (build->n_workers == 1)
+        {
+                build_run_worker (build, 0);
+        }
+        else
+        {
+                fflush (NULL);
+                pids = g_new0 (pid_t, build->n_workers);
+                for (i = 0; i < build->n_workers; i++)
+                {
+                        if ((pids[i] = fork ()) == 0)
+                        {
+                                build_run_worker (build, i);
+                                stats_flush ();
+                                _exit (EXIT_SUCCESS);
+                        }
+                }
+                for (i = 0; i < build->n_workers; i++)
+                {
+                        if (pids[i] > 0)
+                        {
+                                waitpid (pids[i], &status, 0);
+                        }
+                }
+                g_free (pids);
+                /* Workers which could not be forked are made up for by
+                 * the parent. */
+                if (*build->next < build->jobs->len)
+                {
+                        build_run_worker (build, 0);
+                }
+        }
+        elapsed = MAX (1, g_get_monotonic_time () - start);
+        memcpy (build->jobs->data, build->queue, build->jobs->len * sizeof (build_job_t));
+        for (i = 0; i < build->jobs->len; i++)
+        {
+                job = &g_array_index (build->jobs, build_job_t, i);
+                if (job->result == EXIT_SUCCESS)
+                {
+                        build->built++;
+                }
+                else
+                {
+                        build->failed++;
+                }
+        }
+        if (verbose)
+        {
+                for (i = 0; i < build->n_workers; i++)
+                {
+                        g_log ("", G_LOG_LEVEL_INFO,
+                                _("worker %u: %u footprints, %" G_GINT64_FORMAT " pins, busy %.3f s of %.3f s (%.0f%%), writing %.3f s."),
+                                i, build->workers[i].jobs, build->workers[i].pins,
+                                build->workers[i].busy / 1e6, elapsed / 1e6,
+                                100.0 * build->workers[i].busy / elapsed,
+                                build->workers[i].writing / 1e6);
+                        busy += build->workers[i].busy;
+                }
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("ran %u jobs on %u worker processes in %.3f s, %.0f%% utilisation."),
+                        build->jobs->len, build->n_workers, elapsed / 1e6,
+                        100.0 * busy / (elapsed * build->n_workers));
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Add the jobs of the rows of footprint libraries.
+ *
+ * The input hash of a row is the hash of the parameters of its
+ * footprint.\n
+ * The library is kept for the workers.
+ */
+static void
+build_library_rows
+(
+        build_t *build,
+                /*!< : the build.*/
+        GSList *csv_filenames
+                /*!< : the footprint libraries (csv files).*/
+)
+{
+        GSList *filename;
+        gchar *parameters;
+        gchar *name;
+        guint64 hash;
+        guint row;
+
+        build->library = library_new ();
+        for (filename = csv_filenames; filename; filename = g_slist_next (filename))
+        {
+                if (library_read_csv_file (build->library, filename->data) == EXIT_FAILURE)
+                {
+                        build->failed++;
+                }
+        }
+        for (row = 0; row < build->library->rows; row++)
+        {
+                build_restore_defaults ();
+                if (build_set_row_globals (build->library, row) == EXIT_FAILURE)
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("skipped row %u: unknown footprint name, package type, units or pad shape."),
+                                        row + 1);
+                        }
+                        build->failed++;
+                        continue;
+                }
+                name = g_strconcat (footprint_name, ".", fp_suffix, NULL);
+                if (!build_is_duplicate (build, name, footprint_name))
+                {
+                        parameters = footprint_cache_get_parameters ();
+                        hash = footprint_cache_get_hash (parameters);
+                        g_free (parameters);
+                        if (!build_is_up_to_date (build, name, hash))
+                        {
+                                build_add_job (build, name, hash, row, NULL, NULL);
+                        }
+                }
+                g_free (name);
+        }
+}
+
+
+/*!
+ * \brief Add the jobs of the footprintwizard files in a directory.
+ *
+ * The footprint name is taken from the header of a file, or from the
+ * filename when the header has none.\n
+ * The input hash of a file is the hash of its contents, so an up to date
+ * footprint only costs reading the file.
+ */
+static void
+build_fpw_files
+(
+        build_t *build,
+                /*!< : the build.*/
+        const gchar *fpw_directory
+                /*!< : the directory with footprintwizard files.*/
+)
+{
+        GDir *directory;
+        GPtrArray *filenames;
+        fpw_header_t header;
+        const gchar *entry;
+        gchar *filename;
+        gchar *name;
+        guint64 hash;
+        guint i;
+
+        directory = g_dir_open (fpw_directory, 0, NULL);
+        if (!directory)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not open directory %s."),
+                                fpw_directory);
+                }
+                build->failed++;
+                return;
+        }
+        filenames = g_ptr_array_new ();
+        while ((entry = g_dir_read_name (directory)))
+        {
+                if (g_str_has_suffix (entry, ".fpw"))
+                {
+                        g_ptr_array_add (filenames, g_build_filename (fpw_directory, entry, NULL));
+                }
+        }
+        g_dir_close (directory);
+        /* Build in a fixed order, whatever the order of the directory. */
+        g_ptr_array_sort (filenames, (GCompareFunc) build_compare_filenames);
+        for (i = 0; i < filenames->len; i++)
+        {
+                filename = filenames->pdata[i];
+                if ((build_hash_file (filename, &hash) == EXIT_FAILURE) ||
+                        (read_footprintwizard_file_header (filename, &header) == EXIT_FAILURE))
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("could not read footprintwizard file %s."),
+                                        filename);
+                        }
+                        g_free (header.footprint_type);
+                        g_free (header.footprint_name);
+                        build->failed++;
+                        continue;
+                }
+                if (!header.footprint_name || !strcmp (header.footprint_name, ""))
+                {
+                        g_free (header.footprint_name);
+                        header.footprint_name = g_path_get_basename (filename);
+                        header.footprint_name[strlen (header.footprint_name) - 4] = '\0';
+                }
+                name = g_strconcat (header.footprint_name, ".", fp_suffix, NULL);
+                if (!build_is_duplicate (build, name, filename) &&
+                        !build_is_up_to_date (build, name, hash))
+                {
+                        /* The file is read for the number of pins, the
+                         * worker reads it again. */
+                        build_restore_defaults ();
+                        build_strings_allocated = TRUE;
+                        if (read_footprintwizard_file (filename) == EXIT_SUCCESS)
+                        {
+                                build_add_job (build, name, hash, 0, filename, header.footprint_name);
+                        }
+                        else
+                        {
+                                build->failed++;
+                        }
+                }
+                g_free (name);
+                g_free (header.footprint_type);
+                g_free (header.footprint_name);
+        }
+        g_ptr_array_foreach (filenames, (GFunc) g_free, NULL);
+        g_ptr_array_free (filenames, TRUE);
+}
+
+
+/*!
+ * \brief Start building an archive.
+ *
+ * The names of all jobs are known, so the room for the header, the
+ * index and the names is left at the start of the archive and the
+ * workers append the footprints after it.\n
+ * The archive is built under a temporary name.
+ *
+ * \return \c EXIT_SUCCESS when the archive was created,
+ * \c EXIT_FAILURE when it was not.
+ */
+static int
+build_open_archive
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        guint64 size;
+        guint i;
+
+        size = sizeof (archive_header_t) + build->jobs->len * sizeof (archive_entry_t);
+        for (i = 0; i < build->jobs->len; i++)
+        {
+                size += strlen (g_array_index (build->jobs, build_job_t, i).name) + 1;
+        }
+        build->archive_end = build_map_shared (sizeof (guint64));
+        build->archive_temporary = g_strdup_printf ("%s.%d.tmp", build->archive_filename, getpid ());
+        build->archive_fd = open (build->archive_temporary, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (!build->archive_end || (build->archive_fd < 0))
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create archive %s."),
+                                build->archive_temporary);
+                }
+                return (EXIT_FAILURE);
+        }
+        *build->archive_end = (size + ARCHIVE_ALIGNMENT - 1) / ARCHIVE_ALIGNMENT * ARCHIVE_ALIGNMENT;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Compare the names of two jobs, for sorting.
+ */
+static gint
+build_compare_job_names
+(
+        const build_job_t **a,
+                /*!< : the first job.*/
+        const build_job_t **b
+                /*!< : the second job.*/
+)
+{
+        return (strcmp ((*a)->name, (*b)->name));
+}
+
+
+/*!
+ * \brief Finish building an archive.
+ *
+ * The index of the footprints which were built is written, sorted on
+ * name, and the archive is written to disk and renamed into place.
+ *
+ * \return \c EXIT_SUCCESS when the archive was written,
+ * \c EXIT_FAILURE when it was not.
+ */
+static int
+build_close_archive
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        GPtrArray *built;
+        archive_entry_t *entries;
+        gchar **names;
+        build_job_t *job;
+        gint result;
+        guint i;
+
+        built = g_ptr_array_new ();
+        for (i = 0; i < build->jobs->len; i++)
+        {
+                job = &g_array_index (build->jobs, build_job_t, i);
+                if (job->result == EXIT_SUCCESS)
+                {
+                        g_ptr_array_add (built, job);
+                }
+        }
+        g_ptr_array_sort (built, (GCompareFunc) build_compare_job_names);
+        entries = g_new0 (archive_entry_t, MAX (built->len, 1));
+        names = g_new0 (gchar *, MAX (built->len, 1));
+        for (i = 0; i < built->len; i++)
+        {
+                job = built->pdata[i];
+                entries[i] = job->entry;
+                names[i] = job->name;
+        }
+        result = archive_write_index (build->archive_fd, built->len, entries, names);
+#ifdef HAVE_FDATASYNC
+        if (fdatasync (build->archive_fd) != 0)
+#else
+        if (fsync (build->archive_fd) != 0)
+#endif
+        {
+                result = EXIT_FAILURE;
+        }
+        if (close (build->archive_fd) != 0)
+        {
+                result = EXIT_FAILURE;
+        }
+        build->archive_fd = -1;
+        if ((result == EXIT_SUCCESS) &&
+                (rename (build->archive_temporary, build->archive_filename) != 0))
+        {
+                result = EXIT_FAILURE;
+        }
+        if (result == EXIT_FAILURE)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not write archive %s: %s."),
+                                build->archive_filename, g_strerror (errno));
+                }
+                unlink (build->archive_temporary);
+        }
+        else if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("wrote %u footprints, %" G_GUINT64_FORMAT " bytes, into archive %s."),
+                        built->len, *build->archive_end, build->archive_filename);
+        }
+        g_free (entries);
+        g_free (names);
+        g_ptr_array_free (built, TRUE);
+        return (result);
+}
+
+
+/*!
+ * \brief Initialise a build.
+ */
+static void
+build_init
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        memset (build, 0, sizeof (build_t));
+        build->output_fd = -1;
+        build->archive_fd = -1;
+        build->previous_records = g_ptr_array_new ();
+        build->previous = g_hash_table_new (g_str_hash, g_str_equal);
+        build->records = g_ptr_array_new ();
+        build->current = g_hash_table_new (g_str_hash, g_str_equal);
+        build->jobs = g_array_new (FALSE, FALSE, sizeof (build_job_t));
+}
+
+
+/*!
+ * \brief Collect the jobs of a build and run them.
+ *
+ * \return \c EXIT_SUCCESS when the jobs were run,
+ * \c EXIT_FAILURE when they could not be run.
+ */
+static int
+build_run
+(
+        build_t *build,
+                /*!< : the build.*/
+        GSList *csv_filenames,
+                /*!< : the footprint libraries (csv files) to build every
+                 * row of.*/
+        const gchar *fpw_directory,
+                /*!< : the directory with footprintwizard files to build,
+                 * \c NULL for none.*/
+        gint workers,
+                /*!< : the number of worker processes, 0 for one per
+                 * processor.*/
+        gint writers
+                /*!< : the number of writer threads per worker.*/
+)
+{
+        /* The defaults are saved before the first job, so every job
+         * starts from the same values. */
+        build_restore_defaults ();
+        if (csv_filenames)
+        {
+                build_library_rows (build, csv_filenames);
+        }
+        if (fpw_directory)
+        {
+                build_fpw_files (build, fpw_directory);
+        }
+        if (build->archive_filename &&
+                (build_open_archive (build) == EXIT_FAILURE))
+        {
+                return (EXIT_FAILURE);
+        }
+        return (build_schedule (build, workers, writers));
+}
+
+
+/*!
+ * \brief Free the state of a build.
+ */
+static void
+build_free
+(
+        build_t *build
+                /*!< : the build.*/
+)
+{
+        build_job_t *job;
+        guint i;
+
+        /* The global strings point into the library. */
+        footprint_name = NULL;
+        footprint_type = NULL;
+        footprint_units = NULL;
+        footprint_status = NULL;
+        pin_1_position = NULL;
+        pad_shape = NULL;
+        for (i = 0; i < build->jobs->len; i++)
+        {
+                job = &g_array_index (build->jobs, build_job_t, i);
+                g_free (job->name);
+                g_free (job->fpw_filename);
+                g_free (job->footprint_name);
+        }
+        if (build->queue)
+        {
+                munmap (build->queue, MAX (build->jobs->len * sizeof (build_job_t), 1));
+        }
+        if (build->workers)
+        {
+                munmap (build->workers, MAX (build->n_workers * sizeof (build_worker_t), 1));
+        }
+        if (build->next)
+        {
+                munmap (build->next, sizeof (guint));
+        }
+        if (build->archive_end)
+        {
+                munmap (build->archive_end, sizeof (guint64));
+        }
+        if (build->archive_fd >= 0)
+        {
+                close (build->archive_fd);
+                unlink (build->archive_temporary);
+        }
+        if (build->output_fd >= 0)
+        {
+                close (build->output_fd);
+        }
+        if (build->stream_mutex)
+        {
+                pthread_mutex_destroy (build->stream_mutex);
+                munmap (build->stream_mutex, sizeof (pthread_mutex_t));
+        }
+        g_array_free (build->jobs, TRUE);
+        if (build->library)
+        {
+                library_free (build->library);
+        }
+        g_ptr_array_foreach (build->previous_records, (GFunc) build_free_record, NULL);
+        g_ptr_array_foreach (build->records, (GFunc) build_free_record, NULL);
+        g_ptr_array_free (build->previous_records, TRUE);
+        g_ptr_array_free (build->records, TRUE);
+        g_hash_table_destroy (build->previous);
+        g_hash_table_destroy (build->current);
+        g_free (build->output_directory);
+        g_free (build->archive_filename);
+        g_free (build->archive_temporary);
+}
+
+
+/*!
+ * \brief Build footprints into an archive.
+ *
+ * An archive is always built complete, only the footprint cache saves
+ * generating footprints which did not change.\n
+ * The archive is replaced when it is complete, a failed build leaves
+ * the previous archive.
+ *
+ * \return \c EXIT_SUCCESS when all footprints were built,
+ * \c EXIT_FAILURE when a footprint failed.
+ */
+int
+build_archive
+(
+        const gchar *archive_filename,
+                /*!< : the archive.*/
+        archive_compression_t compression,
+                /*!< : the compression of the footprints.*/
+        GSList *csv_filenames,
+                /*!< : the footprint libraries (csv files) to build every
+                 * row of.*/
+        const gchar *fpw_directory,
+                /*!< : the directory with footprintwizard files to build,
+                 * \c NULL for none.*/
+        gint workers,
+                /*!< : the number of worker processes, 0 for one per
+                 * processor.*/
+        gint writers
+                /*!< : the number of writer threads per worker.*/
+)
+{
+        build_t build;
+        gchar *compressed = NULL;
+        gsize size;
+        gint result;
+
+        if ((compression == ARCHIVE_GZIP) &&
+                (archive_compress ("", 0, &compressed, &size) == EXIT_FAILURE))
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not compress footprints, fpw was built without zlib."));
+                }
+                return (EXIT_FAILURE);
+        }
+        g_free (compressed);
+        build_init (&build);
+        build.archive_filename = g_strdup (archive_filename);
+        build.compression = compression;
+        result = build_run (&build, csv_filenames, fpw_directory, workers, writers);
+        if (result == EXIT_SUCCESS)
+        {
+                result = build_close_archive (&build);
+        }
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("built %u footprints, %u failed."),
+                        build.built, build.failed);
+        }
+        build_free (&build);
+        return (((result == EXIT_SUCCESS) && (build.failed == 0)) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Build footprints into a directory, only building what changed
+ * since the previous build.
+ *
+ * The footprints to build are run on worker processes, the footprints
+ * with the most pins first.\n
+ * Every worker generates footprints while its writer threads write the
+ * footprints it generated before.\n
+ * The footprint files of inputs which are no longer there are removed,
+ * only footprint files recorded in the manifest are ever removed.\n
+ * Footprint files are renamed into place once they are on disk, the
+ * temporary files left behind by an interrupted build are removed.
+ *
+ * \return \c EXIT_SUCCESS when all footprints are up to date,
+ * \c EXIT_FAILURE when a footprint failed.
+ */
+int
+build_footprints
+(
+        const gchar *output_directory,
+                /*!< : the output directory.*/
+        GSList *csv_filenames,
+                /*!< : the footprint libraries (csv files) to build every
+                 * row of.*/
+        const gchar *fpw_directory,
+                /*!< : the directory with footprintwizard files to build,
+                 * \c NULL for none.*/
+        gint workers,
+                /*!< : the number of worker processes, 0 for one per
+                 * processor.*/
+        gint writers
+                /*!< : the number of writer threads per worker.*/
+)
+{
+        build_t build;
+        build_record_t *record;
+        build_job_t *job;
+        gchar *filename;
+        gint result;
+        guint i;
+
+        if (g_mkdir_with_parents (output_directory, 0755) != 0)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create output directory %s."),
+                                output_directory);
+                }
+                return (EXIT_FAILURE);
+        }
+        build_init (&build);
+        build.output_directory = g_strdup (output_directory);
+        build.output_fd = open (output_directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        build_remove_temporaries (&build);
+        build_read_manifest (&build);
+        result = build_run (&build, csv_filenames, fpw_directory, workers, writers);
+        for (i = 0; i < build.jobs->len; i++)
+        {
+                job = &g_array_index (build.jobs, build_job_t, i);
+                if (job->result == EXIT_SUCCESS)
+                {
+                        record = g_new0 (build_record_t, 1);
+                        record->name = g_strdup (job->name);
+                        record->input_hash = job->input_hash;
+                        record->generator_version = g_strdup (VERSION);
+                        record->output_hash = job->output_hash;
+                        g_ptr_array_add (build.records, record);
+                }
+        }
+        /* Remove the footprints of inputs which are gone. */
+        for (i = 0; i < build.previous_records->len; i++)
+        {
+                record = build.previous_records->pdata[i];
+                if (record->seen)
+                {
+                        continue;
+                }
+                filename = g_build_filename (output_directory, record->name, NULL);
+                if ((unlink (filename) == 0) && (verbose))
+                {
+                        g_log ("", G_LOG_LEVEL_INFO,
+                                _("removed footprint %s."),
+                                filename);
+                }
+                g_free (filename);
+                build.removed++;
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                result = build_write_manifest (&build);
+        }
+        /* The footprints were written to disk batch by batch, write the
+         * renames, the removals and the manifest to disk too. */
+        if ((build_sync (&build) == EXIT_FAILURE) && (result == EXIT_SUCCESS))
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not write output directory %s to disk: %s."),
+                                output_directory, g_strerror (errno));
+                }
+                result = EXIT_FAILURE;
+        }
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("built %u footprints, %u up to date, %u removed, %u failed."),
+                        build.built, build.unchanged, build.removed, build.failed);
+        }
+        build_free (&build);
+        return (((result == EXIT_SUCCESS) && (build.failed == 0)) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Build footprints into a stream, like stdout for a pipeline.
+ *
+ * Every footprint is written to the \c stream with a header with its
+ * name and size, in the order in which the footprints are built, see
+ * build_write_stream ().\n
+ * Nothing is written to disk, only the footprint cache saves generating
+ * footprints which did not change.
+ *
+ * \return \c EXIT_SUCCESS when all footprints were built,
+ * \c EXIT_FAILURE when a footprint failed.
+ */
+int
+build_stream
+(
+        FILE *stream,
+                /*!< : the stream.*/
+        GSList *csv_filenames,
+                /*!< : the footprint libraries (csv files) to build every
+                 * row of.*/
+        const gchar *fpw_directory,
+                /*!< : the directory with footprintwizard files to build,
+                 * \c NULL for none.*/
+        gint workers,
+                /*!< : the number of worker processes, 0 for one per
+                 * processor.*/
+        gint writers
+                /*!< : the number of writer threads per worker.*/
+)
+{
+        build_t build;
+        pthread_mutexattr_t attributes;
+        gint result;
+
+        build_init (&build);
+        build.stream = stream;
+        build.stream_mutex = build_map_shared (sizeof (pthread_mutex_t));
+        if (!build.stream_mutex)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not map shared memory for the stream."));
+                }
+                build_free (&build);
+                return (EXIT_FAILURE);
+        }
+        pthread_mutexattr_init (&attributes);
+        pthread_mutexattr_setpshared (&attributes, PTHREAD_PROCESS_SHARED);
+        pthread_mutexattr_setrobust (&attributes, PTHREAD_MUTEX_ROBUST);
+        pthread_mutex_init (build.stream_mutex, &attributes);
+        pthread_mutexattr_destroy (&attributes);
+        result = build_run (&build, csv_filenames, fpw_directory, workers, writers);
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("built %u footprints, %u failed."),
+                        build.built, build.failed);
+        }
+        build_free (&build);
+        return (((result == EXIT_SUCCESS) && (build.failed == 0)) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/* EOF */
@@ -0,0 +1,232 @@
+/*!
+ * \file src/build.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for building a directory of footprints (fpw --build).
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __BUILD_INCLUDED__
+#define __BUILD_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief The name of the build manifest in the output directory.
+ */
+#define BUILD_MANIFEST_FILENAME "fpw_manifest"
+
+/*!
+ * \brief The format version of the build manifest.
+ */
+#define BUILD_MANIFEST_VERSION 1
+
+/*!
+ * \brief The number of generated footprints a worker can have waiting to
+ * be written.
+ */
+#define BUILD_QUEUE_DEPTH 16
+
+/*!
+ * \brief A footprint in the build manifest.
+ */
+typedef struct build_record
+{
+        gchar *name;
+                /*!< : is the name of the footprint file in the output
+                 * directory.*/
+        guint64 input_hash;
+                /*!< : is the hash of the input the footprint was built
+                 * from.*/
+        gchar *generator_version;
+                /*!< : is the version of fpw which built the footprint.*/
+        guint64 output_hash;
+                /*!< : is the hash of the footprint file.*/
+        gboolean seen;
+                /*!< : is set when the footprint is still in the input.*/
+} build_record_t;
+
+/*!
+ * \brief A footprint to build.
+ */
+typedef struct build_job
+{
+        gchar *name;
+                /*!< : is the name of the footprint file in the output
+                 * directory.*/
+        guint64 input_hash;
+                /*!< : is the hash of the input.*/
+        guint row;
+                /*!< : is the library row to build.*/
+        gchar *fpw_filename;
+                /*!< : is the footprintwizard file to build, \c NULL to
+                 * build the library row.*/
+        gchar *footprint_name;
+                /*!< : is the footprint name for a footprintwizard file.*/
+        gint cost;
+                /*!< : is the number of pins, the jobs with the most pins
+                 * are run first.*/
+        gint result;
+                /*!< : is \c EXIT_SUCCESS when the footprint was built.*/
+        guint64 output_hash;
+                /*!< : is the hash of the footprint file.*/
+        guint worker;
+                /*!< : is the worker which ran the job.*/
+        archive_entry_t entry;
+                /*!< : is the footprint in the archive, when building an
+                 * archive.*/
+} build_job_t;
+
+/*!
+ * \brief The statistics of a worker of a build.
+ */
+typedef struct build_worker
+{
+        guint jobs;
+                /*!< : is the number of jobs run.*/
+        gint64 pins;
+                /*!< : is the number of pins of the jobs run.*/
+        gint64 busy;
+                /*!< : is the time spent generating footprints in
+                 * microseconds.*/
+        gint64 writing;
+                /*!< : is the time the writer threads spent writing
+                 * footprints in microseconds.*/
+} build_worker_t;
+
+/*!
+ * \brief A generated footprint waiting to be written.
+ */
+typedef struct build_item
+{
+        build_job_t *job;
+                /*!< : is the job, \c NULL to stop a writer.*/
+        gchar *text;
+                /*!< : is the footprint text.*/
+        size_t size;
+                /*!< : is the size of the footprint text.*/
+} build_item_t;
+
+/*!
+ * \brief The bounded queue between the generating and the writing stage
+ * of a worker.
+ */
+typedef struct build_fifo
+{
+        build_item_t items[BUILD_QUEUE_DEPTH];
+                /*!< : are the footprints waiting to be written.*/
+        guint head;
+                /*!< : is the next item to put.*/
+        guint tail;
+                /*!< : is the next item to take.*/
+        guint count;
+                /*!< : is the number of items in the queue.*/
+        pthread_mutex_t mutex;
+                /*!< : guards the queue.*/
+        pthread_cond_t not_empty;
+                /*!< : is signalled when an item is put.*/
+        pthread_cond_t not_full;
+                /*!< : is signalled when an item is taken.*/
+} build_fifo_t;
+
+/*!
+ * \brief The state of a build.
+ */
+typedef struct build
+{
+        gchar *output_directory;
+                /*!< : is the output directory, \c NULL when building an
+                 * archive or a stream.*/
+        gint output_fd;
+                /*!< : is the output directory opened for syncfs (),
+                 * -1 when building an archive or a stream.*/
+        gchar *archive_filename;
+                /*!< : is the archive to build, \c NULL when building an
+                 * output directory or a stream.*/
+        gchar *archive_temporary;
+                /*!< : is the archive while it is being built.*/
+        gint archive_fd;
+                /*!< : is the file descriptor of the archive.*/
+        guint64 *archive_end;
+                /*!< : is the end of the footprints in the archive, in
+                 * shared memory.*/
+        archive_compression_t compression;
+                /*!< : is the compression of the footprints in the
+                 * archive.*/
+        FILE *stream;
+                /*!< : is the stream to write the footprints to, \c NULL
+                 * when building an output directory or an archive.*/
+        pthread_mutex_t *stream_mutex;
+                /*!< : is held by the worker writing to the \c stream,
+                 * in shared memory.*/
+        GPtrArray *previous_records;
+                /*!< : are the footprints in the manifest of the previous
+                 * build.*/
+        GHashTable *previous;
+                /*!< : are the \c previous_records by name.*/
+        GPtrArray *records;
+                /*!< : are the footprints of this build, in build order.*/
+        GHashTable *current;
+                /*!< : are the names of the footprints of this build,
+                 * up to date or to build.*/
+        library_t *library;
+                /*!< : are the rows of the footprint libraries.*/
+        GArray *jobs;
+                /*!< : are the footprints to build.*/
+        build_job_t *queue;
+                /*!< : are the \c jobs in shared memory, the most costly
+                 * first.*/
+        guint *next;
+                /*!< : is the next job in the \c queue, in shared
+                 * memory.*/
+        build_worker_t *workers;
+                /*!< : are the statistics of the workers, in shared
+                 * memory.*/
+        guint n_workers;
+                /*!< : is the number of workers.*/
+        guint n_writers;
+                /*!< : is the number of writer threads per worker.*/
+        build_fifo_t *fifo;
+                /*!< : is the write queue of this worker.*/
+        guint worker;
+                /*!< : is the number of this worker.*/
+        guint built;
+                /*!< : is the number of footprints (re)built.*/
+        guint unchanged;
+                /*!< : is the number of footprints which were up to
+                 * date.*/
+        guint failed;
+                /*!< : is the number of footprints which failed.*/
+        guint removed;
+                /*!< : is the number of footprints removed from the
+                 * input.*/
+} build_t;
+
+
+int build_archive (const gchar *archive_filename, archive_compression_t compression, GSList *csv_filenames, const gchar *fpw_directory, gint workers, gint writers);
+int build_footprints (const gchar *output_directory, GSList *csv_filenames, const gchar *fpw_directory, gint workers, gint writers);
+int build_stream (FILE *stream, GSList *csv_filenames, const gchar *fpw_directory, gint workers, gint writers);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __BUILD_INCLUDED__ */
+
+
+/* EOF */
@@ -0,0 +1,745 @@
+/*!
+ * \file src/cache.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for the cache of generated footprints.
+ *
+ * The same footprint is often generated many times, by repeated library
+ * builds, by the footprint server and by pressing the "Footprint" button
+ * in the GUI.\n
+ * The cache keeps the most recently generated footprints in memory,
+ * keyed by a hash of the canonical text of all parameters which
+ * influence the footprint, and evicts the least recently used footprint
+ * when it is full.\n
+ * Footprints can also be kept in a cache directory, shared by processes
+ * and machines, with one file per footprint named after the hash of the
+ * parameters and the generator version.\n
+ * A file is written under a unique temporary name in the cache directory
+ * and renamed into place, so a reader sees a complete file or no file at
+ * all, also when processes on several machines share the directory.\n
+ * The header holds a checksum of the footprint text, so a damaged file
+ * is not used.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include "cache.h"
+
+
+/*!
+ * \brief The global variables which influence a footprint but are not
+ * a field of a footprintwizard file.
+ */
+static struct
+{
+        gchar *name;
+        fpw_value_t type;
+        gpointer value;
+} footprint_cache_extra_fields[] =
+{
+        {"footprint_name", FPW_STRING, &footprint_name},
+        {"license_in_footprint", FPW_INTEGER, &license_in_footprint},
+        {"silkscreen_length", FPW_DOUBLE, &silkscreen_length},
+        {"silkscreen_width", FPW_DOUBLE, &silkscreen_width},
+        {"fiducial_pad_clearance", FPW_DOUBLE, &fiducial_pad_clearance},
+        {"c1_state", FPW_INTEGER, &c1_state},
+        {"g1_state", FPW_INTEGER, &g1_state},
+        {"z1_state", FPW_INTEGER, &z1_state},
+        {"c2_state", FPW_INTEGER, &c2_state},
+        {"g2_state", FPW_INTEGER, &g2_state},
+        {"z2_state", FPW_INTEGER, &z2_state}
+};
+
+/*!
+ * \brief The cached footprints, keyed by their hash.
+ */
+static GHashTable *footprint_cache_table = NULL;
+
+/*!
+ * \brief The most recently used footprint.
+ */
+static footprint_cache_entry_t *footprint_cache_newest = NULL;
+
+/*!
+ * \brief The least recently used footprint, the next to be evicted.
+ */
+static footprint_cache_entry_t *footprint_cache_oldest = NULL;
+
+/*!
+ * \brief The maximum number of footprints in the cache.
+ */
+static guint footprint_cache_capacity = FOOTPRINT_CACHE_CAPACITY;
+
+/*!
+ * \brief The number of lookups which found a footprint.
+ */
+static guint64 footprint_cache_hits = 0;
+
+/*!
+ * \brief The number of lookups which did not find a footprint.
+ */
+static guint64 footprint_cache_misses = 0;
+
+/*!
+ * \brief The cache directory, \c NULL when there is none.
+ */
+static gchar *footprint_cache_directory = NULL;
+
+/*!
+ * \brief Whether \c footprint_cache_directory was set, by
+ * footprint_cache_set_directory () or from the \c FPW_CACHE_DIR
+ * environment variable.
+ */
+static gboolean footprint_cache_directory_set = FALSE;
+
+/*!
+ * \brief The number of loads which found a footprint in the cache
+ * directory.
+ */
+static guint64 footprint_cache_directory_hits = 0;
+
+/*!
+ * \brief The number of loads which did not find a footprint in the
+ * cache directory.
+ */
+static guint64 footprint_cache_directory_misses = 0;
+
+
+/*!
+ * \brief Append a parameter to the canonical parameters.
+ */
+static void
+footprint_cache_append_parameter
+(
+        GString *parameters,
+                /*!< : the canonical parameters.*/
+        const gchar *name,
+                /*!< : the name of the parameter.*/
+        fpw_value_t type,
+                /*!< : the type of the parameter.*/
+        gpointer value
+                /*!< : the global variable of the parameter.*/
+)
+{
+        gchar number[G_ASCII_DTOSTR_BUF_SIZE];
+
+        switch (type)
+        {
+                case FPW_STRING:
+                        g_string_append_printf (parameters, "%s=%s\n", name,
+                                *(gchar **) value ? *(gchar **) value : "(null)");
+                        break;
+                case FPW_DOUBLE:
+                        /* A round trip representation, so different
+                         * values never share a key. */
+                        g_string_append_printf (parameters, "%s=%s\n", name,
+                                g_ascii_dtostr (number, sizeof (number), *(gdouble *) value));
+                        break;
+                case FPW_INTEGER:
+                        g_string_append_printf (parameters, "%s=%d\n", name,
+                                *(gint *) value);
+                        break;
+                case FPW_IGNORE:
+                        break;
+        }
+}
+
+
+/*!
+ * \brief Get the checksum of a footprint text in the cache directory.
+ *
+ * \return the 64 bit FNV-1a hash of the text.
+ */
+static guint64
+footprint_cache_get_checksum
+(
+        const gchar *text,
+                /*!< : the footprint text, \c NULL when the DRC failed.*/
+        gsize size
+                /*!< : the size of the footprint text.*/
+)
+{
+        return (hash_fpw_line (G_GUINT64_CONSTANT (14695981039346656037),
+                text, size));
+}
+
+
+/*!
+ * \brief Get the name of the file of a footprint in the cache
+ * directory.
+ *
+ * The generator version is part of the name, so a new version never
+ * finds the footprints of an older version.
+ *
+ * \return the filename, free with g_free (), \c NULL when there is no
+ * cache directory.
+ */
+static gchar *
+footprint_cache_get_filename
+(
+        guint64 hash
+                /*!< : the hash of the parameters.*/
+)
+{
+        if (!footprint_cache_directory_set)
+        {
+                footprint_cache_set_directory (g_getenv ("FPW_CACHE_DIR"));
+        }
+        if (!footprint_cache_directory)
+        {
+                return (NULL);
+        }
+        hash = hash_fpw_line (hash, VERSION, strlen (VERSION));
+        return (g_strdup_printf ("%s%c%016" G_GINT64_MODIFIER "x.fpc",
+                footprint_cache_directory, G_DIR_SEPARATOR, hash));
+}
+
+
+/*!
+ * \brief Unlink a footprint from the list of recently used footprints.
+ */
+static void
+footprint_cache_unlink
+(
+        footprint_cache_entry_t *entry
+                /*!< : the footprint.*/
+)
+{
+        if (entry->newer)
+        {
+                entry->newer->older = entry->older;
+        }
+        else
+        {
+                footprint_cache_newest = entry->older;
+        }
+        if (entry->older)
+        {
+                entry->older->newer = entry->newer;
+        }
+        else
+        {
+                footprint_cache_oldest = entry->newer;
+        }
+        entry->newer = NULL;
+        entry->older = NULL;
+}
+
+
+/*!
+ * \brief Remove a footprint from the cache and free it.
+ */
+static void
+footprint_cache_remove
+(
+        footprint_cache_entry_t *entry
+                /*!< : the footprint.*/
+)
+{
+        footprint_cache_unlink (entry);
+        g_hash_table_remove (footprint_cache_table, &entry->hash);
+        g_free (entry->parameters);
+        free (entry->text);
+        g_free (entry);
+}
+
+
+/*!
+ * \brief Remove all footprints from the cache.
+ *
+ * The hit and miss counters are kept.
+ */
+void
+footprint_cache_free ()
+{
+        while (footprint_cache_newest)
+        {
+                footprint_cache_remove (footprint_cache_newest);
+        }
+        if (footprint_cache_table)
+        {
+                g_hash_table_destroy (footprint_cache_table);
+                footprint_cache_table = NULL;
+        }
+}
+
+
+/*!
+ * \brief Get the statistics of the cache directory.
+ */
+void
+footprint_cache_get_directory_statistics
+(
+        guint64 *hits,
+                /*!< : the number of loads which found a footprint.*/
+        guint64 *misses
+                /*!< : the number of loads which did not find a
+                 * footprint.*/
+)
+{
+        *hits = footprint_cache_directory_hits;
+        *misses = footprint_cache_directory_misses;
+}
+
+
+/*!
+ * \brief Compute the hash of the canonical parameters of a footprint.
+ *
+ * The hash is the 64 bit FNV-1a hash of a footprintwizard file, it does
+ * not change between runs or machines.
+ *
+ * \return the hash.
+ */
+guint64
+footprint_cache_get_hash
+(
+        const gchar *parameters
+                /*!< : the canonical parameters.*/
+)
+{
+        return (hash_fpw_line (G_GUINT64_CONSTANT (14695981039346656037),
+                parameters, strlen (parameters)));
+}
+
+
+/*!
+ * \brief Get the canonical parameters of the footprint described by the
+ * global variables.
+ *
+ * The canonical parameters are a "name=value" line for every field of a
+ * footprintwizard file and for every other global variable which
+ * influences the footprint, in a fixed order.\n
+ * The footprint filename is left out, it does not influence the
+ * footprint text.
+ *
+ * \return the canonical parameters, free with g_free ().
+ */
+gchar *
+footprint_cache_get_parameters ()
+{
+        GString *parameters;
+        guint i;
+
+        parameters = g_string_sized_new (4096);
+        for (i = 0; i < G_N_ELEMENTS (fpw_fields); i++)
+        {
+                if (fpw_fields[i].value == &footprint_filename)
+                {
+                        continue;
+                }
+                footprint_cache_append_parameter (parameters, fpw_fields[i].name,
+                        fpw_fields[i].type, fpw_fields[i].value);
+        }
+        for (i = 0; i < G_N_ELEMENTS (footprint_cache_extra_fields); i++)
+        {
+                footprint_cache_append_parameter (parameters,
+                        footprint_cache_extra_fields[i].name,
+                        footprint_cache_extra_fields[i].type,
+                        footprint_cache_extra_fields[i].value);
+        }
+        return (g_string_free (parameters, FALSE));
+}
+
+
+/*!
+ * \brief Get the statistics of the cache.
+ */
+void
+footprint_cache_get_statistics
+(
+        guint64 *hits,
+                /*!< : the number of lookups which found a footprint.*/
+        guint64 *misses,
+                /*!< : the number of lookups which did not find a
+                 * footprint.*/
+        guint *entries
+                /*!< : the number of footprints in the cache.*/
+)
+{
+        *hits = footprint_cache_hits;
+        *misses = footprint_cache_misses;
+        *entries = footprint_cache_table ? g_hash_table_size (footprint_cache_table) : 0;
+}
+
+
+/*!
+ * \brief Add a generated footprint to the cache.
+ *
+ * The cache takes ownership of the \c parameters and the \c text, they
+ * are freed right away when the cache is disabled.\n
+ * A footprint with the same hash is replaced, the least recently used
+ * footprint is evicted when the cache is full.
+ *
+ * \return \c EXIT_SUCCESS when the footprint was added,
+ * \c EXIT_FAILURE when the cache is disabled.
+ */
+int
+footprint_cache_insert
+(
+        guint64 hash,
+                /*!< : the hash of the parameters.*/
+        gchar *parameters,
+                /*!< : the canonical parameters.*/
+        gboolean drc_passed,
+                /*!< : the DRC verdict.*/
+        gchar *text,
+                /*!< : the footprint text, allocated with malloc (),
+                 * \c NULL when the DRC failed.*/
+        gsize size
+                /*!< : the size of the footprint text.*/
+)
+{
+        footprint_cache_entry_t *entry;
+
+        if (footprint_cache_capacity == 0)
+        {
+                g_free (parameters);
+                free (text);
+                return (EXIT_FAILURE);
+        }
+        if (!footprint_cache_table)
+        {
+                footprint_cache_table = g_hash_table_new (g_int64_hash, g_int64_equal);
+        }
+        entry = g_hash_table_lookup (footprint_cache_table, &hash);
+        if (entry)
+        {
+                footprint_cache_remove (entry);
+        }
+        while (g_hash_table_size (footprint_cache_table) >= footprint_cache_capacity)
+        {
+                footprint_cache_remove (footprint_cache_oldest);
+        }
+        entry = g_new0 (footprint_cache_entry_t, 1);
+        entry->hash = hash;
+        entry->parameters = parameters;
+        entry->drc_passed = drc_passed;
+        entry->text = text;
+        entry->size = size;
+        entry->older = footprint_cache_newest;
+        if (footprint_cache_newest)
+        {
+                footprint_cache_newest->newer = entry;
+        }
+        else
+        {
+                footprint_cache_oldest = entry;
+        }
+        footprint_cache_newest = entry;
+        g_hash_table_insert (footprint_cache_table, &entry->hash, entry);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Load a generated footprint from the cache directory.
+ *
+ * The file is mapped into memory and only accepted when it is complete,
+ * holds the same parameters and generator version and the checksum of
+ * the footprint text matches.\n
+ * A failed DRC verdict is not found when \c verbose is set, so the
+ * footprint is checked again and the DRC messages are logged.
+ *
+ * \return \c EXIT_SUCCESS when the footprint was found,
+ * \c EXIT_FAILURE when there is no cache directory or the footprint is
+ * not in it.
+ */
+int
+footprint_cache_load
+(
+        guint64 hash,
+                /*!< : the hash of the parameters.*/
+        const gchar *parameters,
+                /*!< : the canonical parameters.*/
+        gboolean *drc_passed,
+                /*!< : is set to the DRC verdict.*/
+        gchar **text,
+                /*!< : is set to the footprint text, allocated with
+                 * malloc (), \c NULL when the DRC failed.*/
+        gsize *size
+                /*!< : is set to the size of the footprint text.*/
+)
+{
+        struct stat status;
+        gchar *filename;
+        gchar *map;
+        gchar header[512];
+        gchar version[64];
+        gsize parameters_size;
+        gsize footprint_size;
+        guint64 checksum = 0;
+        gint format = 0;
+        gint passed = 0;
+        gint header_size = 0;
+        gint fd;
+        gint result = EXIT_FAILURE;
+
+        filename = footprint_cache_get_filename (hash);
+        if (!filename)
+        {
+                return (EXIT_FAILURE);
+        }
+        fd = open (filename, O_RDONLY);
+        g_free (filename);
+        if ((fd >= 0) && (fstat (fd, &status) == 0) && (status.st_size > 0))
+        {
+                map = mmap (NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map != MAP_FAILED)
+                {
+                        /* The header is text, the parameters and the
+                         * footprint follow it as they are. */
+                        memcpy (header, map, MIN ((gsize) status.st_size, sizeof (header) - 1));
+                        header[MIN ((gsize) status.st_size, sizeof (header) - 1)] = '\0';
+                        sscanf (header, "fpw_cache=%d\ngenerator_version=%63[^\n]\n"
+                                "drc_passed=%d\nparameters_size=%" G_GSIZE_FORMAT "\n"
+                                "footprint_size=%" G_GSIZE_FORMAT "\n"
+                                "footprint_checksum=%" G_GINT64_MODIFIER "x\n\n%n",
+                                &format, version, &passed, &parameters_size,
+                                &footprint_size, &checksum, &header_size);
+                        if ((header_size > 0)
+                                && (format == FOOTPRINT_CACHE_FORMAT_VERSION)
+                                && !strcmp (version, VERSION)
+                                && (header_size + parameters_size + footprint_size == (gsize) status.st_size)
+                                && (parameters_size == strlen (parameters))
+                                && !memcmp (map + header_size, parameters, parameters_size)
+                                && (checksum == footprint_cache_get_checksum (map + header_size + parameters_size, footprint_size))
+                                && (passed || !verbose))
+                        {
+                                *drc_passed = passed;
+                                *size = footprint_size;
+                                *text = NULL;
+                                if (footprint_size > 0)
+                                {
+                                        *text = malloc (footprint_size);
+                                        memcpy (*text, map + header_size + parameters_size, footprint_size);
+                                }
+                                result = EXIT_SUCCESS;
+                        }
+                        munmap (map, status.st_size);
+                }
+        }
+        if (fd >= 0)
+        {
+                close (fd);
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                footprint_cache_directory_hits++;
+        }
+        else
+        {
+                footprint_cache_directory_misses++;
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Look up a generated footprint in the cache.
+ *
+ * A found footprint becomes the most recently used footprint.\n
+ * A failed DRC verdict is not a hit when \c verbose is set, so the
+ * footprint is checked again and the DRC messages are logged.
+ *
+ * \return the footprint, \c NULL when it is not in the cache.
+ */
+footprint_cache_entry_t *
+footprint_cache_lookup
+(
+        guint64 hash,
+                /*!< : the hash of the parameters.*/
+        const gchar *parameters
+                /*!< : the canonical parameters.*/
+)
+{
+        footprint_cache_entry_t *entry = NULL;
+
+        if (footprint_cache_table)
+        {
+                entry = g_hash_table_lookup (footprint_cache_table, &hash);
+        }
+        if (!entry || strcmp (entry->parameters, parameters) ||
+                (!entry->drc_passed && verbose))
+        {
+                footprint_cache_misses++;
+                return (NULL);
+        }
+        footprint_cache_hits++;
+        if (entry != footprint_cache_newest)
+        {
+                footprint_cache_unlink (entry);
+                entry->older = footprint_cache_newest;
+                footprint_cache_newest->newer = entry;
+                footprint_cache_newest = entry;
+        }
+        return (entry);
+}
+
+
+/*!
+ * \brief Set the maximum number of footprints in the cache.
+ *
+ * A \c capacity of 0 disables the cache.
+ */
+void
+footprint_cache_set_capacity
+(
+        guint capacity
+                /*!< : the maximum number of footprints.*/
+)
+{
+        footprint_cache_capacity = capacity;
+        while (footprint_cache_table &&
+                (g_hash_table_size (footprint_cache_table) > footprint_cache_capacity))
+        {
+                footprint_cache_remove (footprint_cache_oldest);
+        }
+}
+
+
+/*!
+ * \brief Set the cache directory.
+ *
+ * The directory is created when it does not exist.\n
+ * Without a call the \c FPW_CACHE_DIR environment variable is used.
+ *
+ * \return \c EXIT_SUCCESS when the cache directory is set or disabled,
+ * \c EXIT_FAILURE when the directory could not be created.
+ */
+int
+footprint_cache_set_directory
+(
+        const gchar *directory
+                /*!< : the cache directory, \c NULL or an empty string
+                 * disables the cache directory.*/
+)
+{
+        g_free (footprint_cache_directory);
+        footprint_cache_directory = NULL;
+        footprint_cache_directory_set = TRUE;
+        if (!directory || !strcmp (directory, ""))
+        {
+                return (EXIT_SUCCESS);
+        }
+        if (g_mkdir_with_parents (directory, 0755) != 0)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create cache directory %s."),
+                                directory);
+                }
+                return (EXIT_FAILURE);
+        }
+        footprint_cache_directory = g_strdup (directory);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Store a generated footprint in the cache directory.
+ *
+ * The file is written under a unique temporary name, made with
+ * g_mkstemp () in the cache directory, and renamed into place.
+ *
+ * \return \c EXIT_SUCCESS when the footprint was stored,
+ * \c EXIT_FAILURE when there is no cache directory or writing failed.
+ */
+int
+footprint_cache_store
+(
+        guint64 hash,
+                /*!< : the hash of the parameters.*/
+        const gchar *parameters,
+                /*!< : the canonical parameters.*/
+        gboolean drc_passed,
+                /*!< : the DRC verdict.*/
+        const gchar *text,
+                /*!< : the footprint text, \c NULL when the DRC failed.*/
+        gsize size
+                /*!< : the size of the footprint text.*/
+)
+{
+        FILE *file;
+        gchar *filename;
+        gchar *temporary;
+        gint failed;
+        gint fd;
+        gint result = EXIT_FAILURE;
+
+        filename = footprint_cache_get_filename (hash);
+        if (!filename)
+        {
+                return (EXIT_FAILURE);
+        }
+        temporary = g_strdup_printf ("%s.XXXXXX", filename);
+        file = NULL;
+        fd = g_mkstemp (temporary);
+        if (fd >= 0)
+        {
+                /* g_mkstemp () creates the file readable for the owner
+                 * only, the cache directory is shared. */
+                fchmod (fd, 0644);
+                file = fdopen (fd, "wb");
+                if (!file)
+                {
+                        close (fd);
+                        unlink (temporary);
+                }
+        }
+        if (file)
+        {
+                fprintf (file, "fpw_cache=%d\ngenerator_version=%s\n"
+                        "drc_passed=%d\nparameters_size=%" G_GSIZE_FORMAT "\n"
+                        "footprint_size=%" G_GSIZE_FORMAT "\n"
+                        "footprint_checksum=%016" G_GINT64_MODIFIER "x\n\n",
+                        FOOTPRINT_CACHE_FORMAT_VERSION, VERSION, drc_passed ? 1 : 0,
+                        strlen (parameters), size,
+                        footprint_cache_get_checksum (text, size));
+                fputs (parameters, file);
+                if (size > 0)
+                {
+                        fwrite (text, 1, size, file);
+                }
+                failed = ferror (file);
+                failed |= fclose (file);
+                if (!failed && (rename (temporary, filename) == 0))
+                {
+                        result = EXIT_SUCCESS;
+                }
+                else
+                {
+                        unlink (temporary);
+                }
+        }
+        if ((result == EXIT_FAILURE) && (verbose))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not store footprint %s in the cache directory."),
+                        filename);
+        }
+        g_free (temporary);
+        g_free (filename);
+        return (result);
+}
+
+
+/* EOF */
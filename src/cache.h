@@ -0,0 +1,82 @@
+/*!
+ * \file src/cache.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for the cache of generated footprints.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __CACHE_INCLUDED__
+#define __CACHE_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief The default number of footprints in the cache.
+ */
+#define FOOTPRINT_CACHE_CAPACITY 256
+
+/*!
+ * \brief The format version of the files in the cache directory.
+ */
+#define FOOTPRINT_CACHE_FORMAT_VERSION 2
+
+/*!
+ * \brief A generated footprint in the cache.
+ */
+typedef struct footprint_cache_entry
+{
+        guint64 hash;
+                /*!< : is the hash of the parameters.*/
+        gchar *parameters;
+                /*!< : are the canonical parameters, to tell hash
+                 * collisions apart.*/
+        gboolean drc_passed;
+                /*!< : is the DRC verdict.*/
+        gchar *text;
+                /*!< : is the footprint text, \c NULL when the DRC
+                 * failed.*/
+        gsize size;
+                /*!< : is the size of the footprint text.*/
+        struct footprint_cache_entry *newer;
+                /*!< : is the next more recently used entry.*/
+        struct footprint_cache_entry *older;
+                /*!< : is the next less recently used entry.*/
+} footprint_cache_entry_t;
+
+
+void footprint_cache_free ();
+void footprint_cache_get_directory_statistics (guint64 *hits, guint64 *misses);
+guint64 footprint_cache_get_hash (const gchar *parameters);
+gchar *footprint_cache_get_parameters ();
+void footprint_cache_get_statistics (guint64 *hits, guint64 *misses, guint *entries);
+int footprint_cache_insert (guint64 hash, gchar *parameters, gboolean drc_passed, gchar *text, gsize size);
+int footprint_cache_load (guint64 hash, const gchar *parameters, gboolean *drc_passed, gchar **text, gsize *size);
+footprint_cache_entry_t *footprint_cache_lookup (guint64 hash, const gchar *parameters);
+void footprint_cache_set_capacity (guint capacity);
+int footprint_cache_set_directory (const gchar *directory);
+int footprint_cache_store (guint64 hash, const gchar *parameters, gboolean drc_passed, const gchar *text, gsize size);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __CACHE_INCLUDED__ */
+
+
+/* EOF */
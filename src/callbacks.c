@@ -41,10 +41,13 @@
 #define GUI 1
 
 #include "libfpw.c"
+#include "cache.c"
 #include "packages.h"
 #include "dimensions.c"
 #include "preview.c"
 #include "select_exceptions.c"
+#include "library.c"
+#include "stats.c"
 
 
 gboolean main_window_title_has_asterisk = FALSE;
@@ -1107,6 +1110,91 @@ number_of_pins_has_changed
 }
 
 
+/*!
+ * \brief Suggest the predefined packages nearest to the entered
+ * dimensions in the statusbar.
+ *
+ * The package body length, width, height, the pitch and the number of
+ * pins entered are compared with the predefined packages, values which
+ * are not entered (0) are not taken into account.\n
+ * This function is to be called on one of the following events:
+ * <ul>
+ * <li>Package body length entry is changed.
+ * <li>Package body width entry is changed.
+ * <li>Package body height entry is changed.
+ * <li>Pitch X-direction or Y-direction entry is changed.
+ * <li>Number of total pins entry is changed.
+ * </ul>
+ *
+ * \return none.
+ */
+int
+suggest_packages
+(
+        GtkWidget *widget
+                /*!< : is the caller widget.*/
+)
+{
+        static library_t *library = NULL;
+        static library_index_t *index = NULL;
+        gdouble target[LIBRARY_DIMENSIONS];
+        gdouble distances[3];
+        gdouble scale;
+        guint rows[3];
+        guint found;
+        guint i;
+        gchar *deltas;
+        GString *message;
+
+        if (!index)
+        {
+                /* Build the index only once, the predefined packages do
+                 * not change. */
+                library = library_new ();
+                library_add_packages (library);
+                index = library_index_new (library);
+        }
+        switch (units_type)
+        {
+                case MIL:
+                        scale = MIL_TO_MM;
+                        break;
+                case MIL_100:
+                        scale = MIL_TO_MM / 100.0;
+                        break;
+                default:
+                        scale = 1.0;
+                        break;
+        }
+        target[LIBRARY_LENGTH] = package_body_length * scale;
+        target[LIBRARY_WIDTH] = package_body_width * scale;
+        target[LIBRARY_HEIGHT] = package_body_height * scale;
+        target[LIBRARY_PITCH] = ((pitch_x != 0.0) ? pitch_x : pitch_y) * scale;
+        target[LIBRARY_PINS] = number_of_pins;
+        if ((target[LIBRARY_LENGTH] <= 0.0) && (target[LIBRARY_WIDTH] <= 0.0) &&
+                (target[LIBRARY_HEIGHT] <= 0.0) && (target[LIBRARY_PITCH] <= 0.0) &&
+                (target[LIBRARY_PINS] <= 0.0))
+        {
+                return (EXIT_SUCCESS);
+        }
+        found = library_index_nearest (index, target, G_N_ELEMENTS (rows),
+                rows, distances);
+        message = g_string_new (_("Nearest packages:"));
+        for (i = 0; i < found; i++)
+        {
+                deltas = library_get_deltas (library, rows[i], target);
+                g_string_append_printf (message, "%s %s (%s)",
+                        i ? "," : "",
+                        library_get_string (library, LIBRARY_FOOTPRINT_NAME, rows[i]),
+                        deltas);
+                g_free (deltas);
+        }
+        message_to_statusbar (widget, message->str);
+        g_string_free (message, TRUE);
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief The "top to bottom pads/pins center-center distance (C1)"
  * entry is changed.
@@ -2727,6 +2815,18 @@ on_footprint_name_entry_changed
                                         all_entries_need_updated (GTK_WIDGET (editable));
                                 return;
                         }
+                        case QFN:
+                        {
+                                if (qfn_get_default_footprint_values () == EXIT_SUCCESS)
+                                        all_entries_need_updated (GTK_WIDGET (editable));
+                                return;
+                        }
+                        case QFP:
+                        {
+                                if (qfp_get_default_footprint_values () == EXIT_SUCCESS)
+                                        all_entries_need_updated (GTK_WIDGET (editable));
+                                return;
+                        }
                         case RES:
                         {
                                 if (res_get_default_footprint_values () == EXIT_SUCCESS)
@@ -2763,6 +2863,12 @@ on_footprint_name_entry_changed
                                         all_entries_need_updated (GTK_WIDGET (editable));
                                 return;
                         }
+                        case SO:
+                        {
+                                if (so_get_default_footprint_values () == EXIT_SUCCESS)
+                                        all_entries_need_updated (GTK_WIDGET (editable));
+                                return;
+                        }
                         case SOT:
                         {
                                 if (sot_get_default_footprint_values () == EXIT_SUCCESS)
@@ -3073,15 +3179,13 @@ on_footprint_type_entry_changed
                 case QFN:
                 {
                         all_entries_to_default_sensitivity (GTK_WIDGET (combobox));
-                        gchar *message = g_strdup_printf (_("ERROR: footprint type QFN is not yet implemented."));
-                        message_to_statusbar (GTK_WIDGET (combobox), message);
+                        qfn_set_gui_constraints ();
                         break;
                 }
                 case QFP:
                 {
                         all_entries_to_default_sensitivity (GTK_WIDGET (combobox));
-                        gchar *message = g_strdup_printf (_("ERROR: footprint type QFP is not yet implemented."));
-                        message_to_statusbar (GTK_WIDGET (combobox), message);
+                        qfp_set_gui_constraints ();
                         break;
                 }
                 case RES:
@@ -3135,8 +3239,7 @@ on_footprint_type_entry_changed
                 case SO:
                 {
                         all_entries_to_default_sensitivity (GTK_WIDGET (combobox));
-                        gchar *message = g_strdup_printf (_("ERROR: footprint type SO is not yet implemented."));
-                        message_to_statusbar (GTK_WIDGET (combobox), message);
+                        so_set_gui_constraints ();
                         break;
                 }
                 case SOT:
@@ -3388,6 +3491,7 @@ on_number_total_pins_entry_changed
         const gchar* number_of_pins_string = gtk_entry_get_text (GTK_ENTRY (number_total_pins_entry));
         number_of_pins = (int) g_ascii_strtod (number_of_pins_string, &leftovers);
         entry_has_changed (GTK_WIDGET (editable));
+        suggest_packages (GTK_WIDGET (editable));
 }
 
 
@@ -3447,6 +3551,7 @@ on_package_body_height_entry_changed
         const gchar* package_body_height_string = gtk_entry_get_text (GTK_ENTRY (package_body_height_entry));
         package_body_height = g_ascii_strtod (package_body_height_string, &leftovers);
         entry_has_changed (GTK_WIDGET (editable));
+        suggest_packages (GTK_WIDGET (editable));
 }
 
 
@@ -3476,6 +3581,7 @@ on_package_body_length_entry_changed
         const gchar* package_body_length_string = gtk_entry_get_text (GTK_ENTRY (package_body_length_entry));
         package_body_length = g_ascii_strtod (package_body_length_string, &leftovers);
         entry_has_changed (GTK_WIDGET (editable));
+        suggest_packages (GTK_WIDGET (editable));
 }
 
 
@@ -3505,6 +3611,7 @@ on_package_body_width_entry_changed
         const gchar* package_body_width_string = gtk_entry_get_text (GTK_ENTRY (package_body_width_entry));
         package_body_width = g_ascii_strtod (package_body_width_string, &leftovers);
         entry_has_changed (GTK_WIDGET (editable));
+        suggest_packages (GTK_WIDGET (editable));
 }
 
 
@@ -3927,6 +4034,7 @@ on_pitch_x_entry_changed
         const gchar* pitch_x_string = gtk_entry_get_text (GTK_ENTRY (pitch_x_entry));
         pitch_x = g_ascii_strtod (pitch_x_string, &leftovers);
         entry_has_changed (GTK_WIDGET (editable));
+        suggest_packages (GTK_WIDGET (editable));
 }
 
 
@@ -3955,6 +4063,7 @@ on_pitch_y_entry_changed
         const gchar* pitch_y_string = gtk_entry_get_text (GTK_ENTRY (pitch_y_entry));
         pitch_y = g_ascii_strtod (pitch_y_string, &leftovers);
         entry_has_changed (GTK_WIDGET (editable));
+        suggest_packages (GTK_WIDGET (editable));
 }
 
 
@@ -35,10 +35,6 @@
 int
 cappr_create_element ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
         gdouble x_text;
         gdouble y_text;
         gdouble dx;
@@ -47,6 +43,7 @@ cappr_create_element ()
         FlagType pad_flag;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -61,126 +58,6 @@ cappr_create_element ()
          * put the element mark */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        if (pad_shapes_type == ROUND_ELONGATED)
-        {
-                xmin = multiplier *
-                (
-                        (-pitch_x / 2.0) -
-                        (pad_length / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                xmax = multiplier *
-                (
-                        (pitch_x / 2.0) +
-                        (pad_length / 2.0) +
-                        pad_solder_mask_clearance
-                );
-                ymin = multiplier *
-                (
-                        (-pitch_y / 2.0) -
-                        (pad_width / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                ymax = multiplier *
-                (
-                        (pitch_y / 2.0) +
-                        (pad_width / 2.0) +
-                        pad_solder_mask_clearance
-                );
-        }
-        else
-        {
-                xmin = multiplier *
-                (
-                        (-pitch_x / 2.0) -
-                        (pad_diameter / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                xmax = multiplier *
-                (
-                        (pitch_x / 2.0) +
-                        (pad_diameter / 2.0) +
-                        pad_solder_mask_clearance
-                );
-                ymin = multiplier *
-                (
-                        (-pitch_y / 2.0) -
-                        (pad_diameter / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                ymax = multiplier *
-                (
-                        (pitch_y / 2.0) +
-                        (pad_diameter / 2.0) +
-                        pad_solder_mask_clearance
-                );
-        }
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
-        /* Guess for a place where to put the element name */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
-        /* Guess for a place where to put the element refdes */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
-        /* Guess for a place where to put the element value */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
         /* Create pin and/or pad entities */
         if (pad_shapes_type == SQUARE)
         {
@@ -197,12 +74,12 @@ cappr_create_element ()
         create_new_pin
         (
                 element,
-                (int) (multiplier * ((pitch_x + pad_diameter) / 2.0)), /* x0 coordinate */
+                units_to_coord ((pitch_x + pad_diameter) / 2.0), /* x0 coordinate */
                 0, /* y0-coordinate */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                units_to_coord (pad_diameter), /* pad width */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "N", /* pin name */
                 "2", /* pin number */
                 pad_flag /* flags */
@@ -215,12 +92,12 @@ cappr_create_element ()
         create_new_pin
         (
                 element,
-                (int) (multiplier * ((-pitch_x - pad_diameter) / 2.0)), /* x0 coordinate */
+                units_to_coord ((-pitch_x - pad_diameter) / 2.0), /* x0 coordinate */
                 0, /* y0-coordinate */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                units_to_coord (pad_diameter), /* pad width */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "P", /* pin name */
                 "1", /* pin number */
                 pad_flag /* flags */
@@ -232,13 +109,13 @@ cappr_create_element ()
                 create_new_pad
                 (
                         element,
-                        (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
+                        units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
                         0, /* y0-coordinate */
-                        (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
+                        units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
                         0, /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                        units_to_coord (pad_width), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance */
+                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                         "P", /* pin name */
                         "1", /* pin number */
                         pad_flag /* flags */
@@ -246,13 +123,13 @@ cappr_create_element ()
                 create_new_pad
                 (
                         element,
-                        (int) (multiplier * ((pitch_x + pad_length - pad_width) / 2.0)), /* x0 coordinate */
+                        units_to_coord ((pitch_x + pad_length - pad_width) / 2.0), /* x0 coordinate */
                         0, /* y0-coordinate */
-                        (int) (multiplier * ((pitch_x - pad_length + pad_width) / 2.0)), /* x1 coordinate */
+                        units_to_coord ((pitch_x - pad_length + pad_width) / 2.0), /* x1 coordinate */
                         0, /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                        units_to_coord (pad_width), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance */
+                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                         "N", /* pin name */
                         "2", /* pin number */
                         pad_flag /* flags */
@@ -262,13 +139,13 @@ cappr_create_element ()
                 create_new_pad
                 (
                         element,
-                        (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
+                        units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
                         0, /* y0-coordinate */
-                        (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
+                        units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
                         0, /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                        units_to_coord (pad_width), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance */
+                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                         "P", /* pin name */
                         "1", /* pin number */
                         pad_flag /* flags */
@@ -276,18 +153,45 @@ cappr_create_element ()
                 create_new_pad
                 (
                         element,
-                        (int) (multiplier * ((pitch_x + pad_length - pad_width) / 2.0)), /* x0 coordinate */
+                        units_to_coord ((pitch_x + pad_length - pad_width) / 2.0), /* x0 coordinate */
                         0, /* y0-coordinate */
-                        (int) (multiplier * ((pitch_x - pad_length + pad_width) / 2.0)), /* x1 coordinate */
+                        units_to_coord ((pitch_x - pad_length + pad_width) / 2.0), /* x1 coordinate */
                         0, /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                        units_to_coord (pad_width), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance */
+                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                         "N", /* pin name */
                         "2", /* pin number */
                         pad_flag /* flags */
                 );
         }
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
         /* Create a package body on the silkscreen. */
         if (silkscreen_package_outline)
         {
@@ -298,11 +202,11 @@ cappr_create_element ()
                                 element,
                                 0, /* x coordinate */
                                 0, /* y coordinate */
-                                (int) (multiplier * package_body_length), /* width */
-                                (int) (multiplier * package_body_length), /* height */
+                                units_to_coord (package_body_length), /* width */
+                                units_to_coord (package_body_length), /* height */
                                 0, /* start angle */
                                 360, /* delta angle */
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (silkscreen_line_width)
                         );
                 }
                 else
@@ -310,38 +214,38 @@ cappr_create_element ()
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (-package_body_length / 2.0)),
-                                (int) (multiplier * (-package_body_width / 2.0)),
-                                (int) (multiplier * (-package_body_length / 2.0)),
-                                (int) (multiplier * (package_body_width / 2.0)),
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (-package_body_length / 2.0),
+                                units_to_coord (-package_body_width / 2.0),
+                                units_to_coord (-package_body_length / 2.0),
+                                units_to_coord (package_body_width / 2.0),
+                                units_to_coord (silkscreen_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (package_body_length / 2.0)),
-                                (int) (multiplier * (-package_body_width / 2.0)),
-                                (int) (multiplier * (package_body_length / 2.0)),
-                                (int) (multiplier * (package_body_width / 2.0)),
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (package_body_length / 2.0),
+                                units_to_coord (-package_body_width / 2.0),
+                                units_to_coord (package_body_length / 2.0),
+                                units_to_coord (package_body_width / 2.0),
+                                units_to_coord (silkscreen_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (-package_body_length / 2.0)),
-                                (int) (multiplier * (-package_body_width / 2.0)),
-                                (int) (multiplier * (package_body_length / 2.0)),
-                                (int) (multiplier * (-package_body_width / 2.0)),
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (-package_body_length / 2.0),
+                                units_to_coord (-package_body_width / 2.0),
+                                units_to_coord (package_body_length / 2.0),
+                                units_to_coord (-package_body_width / 2.0),
+                                units_to_coord (silkscreen_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (package_body_length / 2.0)),
-                                (int) (multiplier * (package_body_width / 2.0)),
-                                (int) (multiplier * (-package_body_length / 2.0)),
-                                (int) (multiplier * (package_body_width / 2.0)),
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (package_body_length / 2.0),
+                                units_to_coord (package_body_width / 2.0),
+                                units_to_coord (-package_body_length / 2.0),
+                                units_to_coord (package_body_width / 2.0),
+                                units_to_coord (silkscreen_line_width)
                         );
                 }
         }
@@ -354,20 +258,20 @@ cappr_create_element ()
                         create_new_line /* Horizontal line. */
                         (
                                 element,
-                                (int) (multiplier * ((-pitch_x / 2.0) - (3 * silkscreen_line_width))),
-                                (int) (multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (3 * silkscreen_line_width))),
-                                (int) (multiplier * ((-pitch_x / 2.0) + (3 * silkscreen_line_width))),
-                                (int) (multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (3 * silkscreen_line_width))),
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord ((-pitch_x / 2.0) - (3 * silkscreen_line_width)),
+                                units_to_coord (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (3 * silkscreen_line_width)),
+                                units_to_coord ((-pitch_x / 2.0) + (3 * silkscreen_line_width)),
+                                units_to_coord (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (3 * silkscreen_line_width)),
+                                units_to_coord (silkscreen_line_width)
                         );
                         create_new_line /* Vertical line. */
                         (
                                 element,
-                                (int) (multiplier * (-pitch_x / 2.0)),
-                                (int) (multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (silkscreen_line_width))),
-                                (int) (multiplier * (-pitch_x / 2.0)),
-                                (int) (multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (6 * silkscreen_line_width))),
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (-pitch_x / 2.0),
+                                units_to_coord (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (silkscreen_line_width)),
+                                units_to_coord (-pitch_x / 2.0),
+                                units_to_coord (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (6 * silkscreen_line_width)),
+                                units_to_coord (silkscreen_line_width)
                         );
                 }
         }
@@ -381,11 +285,11 @@ cappr_create_element ()
                                 element,
                                 0, /* x coordinate */
                                 0, /* y coordinate */
-                                (int) (2 * xmax), /* width, already in mil/100 */
-                                (int) (2 * ymax), /* height, already in mil/100 */
+                                2 * element->VBox.X2, /* width, already in mil/100 */
+                                2 * element->VBox.Y2, /* height, already in mil/100 */
                                 0, /* start angle */
                                 360, /* delta angle */
-                                (int) (multiplier * courtyard_line_width)
+                                units_to_coord (courtyard_line_width)
                         );
                 }
                 else
@@ -393,38 +297,38 @@ cappr_create_element ()
                         create_new_line
                         (
                                 element,
-                                (int) (xmin), /* already in mil/100 */
-                                (int) (ymin), /* already in mil/100 */
-                                (int) (xmin), /* already in mil/100 */
-                                (int) (ymax), /* already in mil/100 */
-                                (int) (multiplier * courtyard_line_width)
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (xmax), /* already in mil/100 */
-                                (int) (ymin), /* already in mil/100 */
-                                (int) (xmax), /* already in mil/100 */
-                                (int) (ymax), /* already in mil/100 */
-                                (int) (multiplier * courtyard_line_width)
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (xmin), /* already in mil/100 */
-                                (int) (ymin), /* already in mil/100 */
-                                (int) (xmax), /* already in mil/100 */
-                                (int) (ymin), /* already in mil/100 */
-                                (int) (multiplier * courtyard_line_width)
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (xmax), /* already in mil/100 */
-                                (int) (ymax), /* already in mil/100 */
-                                (int) (xmin), /* already in mil/100 */
-                                (int) (ymax), /* already in mil/100 */
-                                (int) (multiplier * courtyard_line_width)
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
                         );
                 }
         }
@@ -441,7 +345,8 @@ cappr_create_element ()
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
@@ -633,7 +538,7 @@ cappr_drc ()
         }
         /* Check for clearance of the package length with regard to the
          * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -645,7 +550,7 @@ cappr_drc ()
         }
         /* Check for clearance of the package width with regard to the
          * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -694,8 +599,8 @@ cappr_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MIL_100:
                 if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
                 {
@@ -706,8 +611,8 @@ cappr_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MM:
                 if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
                 {
@@ -718,8 +623,8 @@ cappr_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 default:
                 {
                         if (verbose)
@@ -870,327 +775,7 @@ cappr_set_gui_constraints ()
 int
 cappr_write_footprint ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
-
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
-        {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        (_("could not open file for %s footprint: %s.")),
-                        footprint_type, footprint_filename);
-                fclose (fp);
-                return (EXIT_FAILURE);
-        }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        if (pad_shapes_type == ROUND_ELONGATED)
-        {
-                xmin = multiplier *
-                (
-                        (-pitch_x / 2.0) -
-                        (pad_length / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                xmax = multiplier *
-                (
-                        (pitch_x / 2.0) +
-                        (pad_length / 2.0) +
-                        pad_solder_mask_clearance
-                );
-                ymin = multiplier *
-                (
-                        (-pitch_y / 2.0) -
-                        (pad_width / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                ymax = multiplier *
-                (
-                        (pitch_y / 2.0) +
-                        (pad_width / 2.0) +
-                        pad_solder_mask_clearance
-                );
-        }
-        else
-        {
-                xmin = multiplier *
-                (
-                        (-pitch_x / 2.0) -
-                        (pad_diameter / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                xmax = multiplier *
-                (
-                        (pitch_x / 2.0) +
-                        (pad_diameter / 2.0) +
-                        pad_solder_mask_clearance
-                );
-                ymin = multiplier *
-                (
-                        (-pitch_y / 2.0) -
-                        (pad_diameter / 2.0) -
-                        pad_solder_mask_clearance
-                );
-                ymax = multiplier *
-                (
-                        (pitch_y / 2.0) +
-                        (pad_diameter / 2.0) +
-                        pad_solder_mask_clearance
-                );
-        }
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (pad_shapes_type == SQUARE)
-        {
-                pin_pad_flags = g_strdup ("square");
-        }
-        else if (pad_shapes_type == OCTAGONAL)
-        {
-                pin_pad_flags = g_strdup ("octagon");
-        }
-        else
-        {
-                pin_pad_flags = g_strdup ("");
-        }
-        write_pin
-        (
-                2, /* pin number */
-                "N", /* pin name */
-                multiplier * ((pitch_x + pad_diameter) / 2.0), /* x0 coordinate */
-                0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        /* Overrule previous settings in favour of pin 1 square setting */
-        if (pin1_square)
-        {
-                pin_pad_flags = g_strdup ("square");
-        }
-        write_pin
-        (
-                1, /* pin number */
-                "P", /* pin name */
-                multiplier * ((-pitch_x - pad_diameter) / 2.0), /* x0 coordinate */
-                0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        if (pad_shapes_type == ROUND_ELONGATED)
-        {
-                /* Add pads on component side */
-                pin_pad_flags = g_strdup ("");
-                write_pad
-                (
-                        1, /* pad number */
-                        "P", /* pad name */
-                        multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                        0, /* y0-coordinate */
-                        multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                        0, /* y1-coordinate */
-                        multiplier * pad_width, /* width of the pad */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                write_pad
-                (
-                        2, /* pad number */
-                        "N", /* pad name */
-                        multiplier * ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                        0, /* y0-coordinate */
-                        multiplier * ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                        0, /* y1-coordinate */
-                        multiplier * pad_width, /* width of the pad */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                /* Add pads on solder side */
-                pin_pad_flags = g_strdup ("onsolder");
-                write_pad
-                (
-                        1, /* pad number */
-                        "P", /* pad name */
-                        multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                        0, /* y0-coordinate */
-                        multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                        0, /* y1-coordinate */
-                        multiplier * pad_width, /* width of the pad */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                write_pad
-                (
-                        2, /* pad number */
-                        "N", /* pad name */
-                        multiplier * ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                        0, /* y0-coordinate */
-                        multiplier * ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                        0, /* y1-coordinate */
-                        multiplier * pad_width, /* width of the pad */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-        }
-        /* Write package body on silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, (_("# Write a package body on the silkscreen\n")));
-                if (package_is_radial)
-                {
-                        
-                        write_element_arc
-                        (
-                                0, /* x coordinate */
-                                0, /* y coordinate */
-                                multiplier * package_body_length, /* width */
-                                multiplier * package_body_length, /* height */
-                                0, /* start angle */
-                                360, /* delta angle */
-                                multiplier * silkscreen_line_width
-                        );
-                }
-                else
-                {
-                        write_rectangle
-                        (
-                                multiplier * (-package_body_length / 2.0),
-                                multiplier * (-package_body_width / 2.0),
-                                multiplier * (package_body_length / 2.0),
-                                multiplier * (package_body_width / 2.0),
-                                multiplier * silkscreen_line_width
-                        );
-                }
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                /* Draw a polarity indicator. */
-                if (package_body_length < ((pitch_x - pad_diameter - pad_solder_mask_clearance) / 2.0) - silkscreen_line_width)
-                {
-                        write_element_line /* Horizontal line. */
-                        (
-                                multiplier * ((-pitch_x / 2.0) - (3 * silkscreen_line_width)),
-                                multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (3 * silkscreen_line_width)),
-                                multiplier * ((-pitch_x / 2.0) + (3 * silkscreen_line_width)),
-                                multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (3 * silkscreen_line_width)),
-                                multiplier * silkscreen_line_width
-                        );
-                        write_element_line /* Vertical line. */
-                        (
-                                multiplier * (-pitch_x / 2.0),
-                                multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (silkscreen_line_width)),
-                                multiplier * (-pitch_x / 2.0),
-                                multiplier * (((-pad_diameter - pad_solder_mask_clearance) / 2.0) - (6 * silkscreen_line_width)),
-                                multiplier * silkscreen_line_width
-                        );
-                }
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, (_("# Write a courtyard on the silkscreen\n")));
-                if (package_is_radial)
-                {
-                        write_element_arc
-                        (
-                                0, /* x coordinate */
-                                0, /* y coordinate */
-                                2 * xmax, /* width, already in mil/100 */
-                                2 * ymax, /* height, already in mil/100 */
-                                0, /* start angle */
-                                360, /* delta angle */
-                                multiplier * courtyard_line_width
-                        );
-                }
-                else
-                {
-                        write_rectangle
-                        (
-                                xmin, /* already in mil/100 */
-                                ymin, /* already in mil/100 */
-                                xmax, /* already in mil/100 */
-                                ymax, /* already in mil/100 */
-                                multiplier * courtyard_line_width
-                        );
-                }
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        (_("wrote a footprint for a %s package: %s.")),
-                        footprint_type,
-                        footprint_filename);
-        }
-        return (EXIT_SUCCESS);
+        return (write_footprint_element (cappr_create_element));
 }
 
 
@@ -35,10 +35,6 @@
 int
 con_sil_create_element ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
         gdouble x_text;
         gdouble y_text;
         gint i;
@@ -47,6 +43,7 @@ con_sil_create_element ()
         FlagType pad_flag;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -61,73 +58,6 @@ con_sil_create_element ()
          * put the element mark */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
-        /* Guess for a place where to put the element name */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
-        /* Guess for a place where to put the element refdes */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
-        /* Guess for a place where to put the element value */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
         /* Create pin and/or pad entities */
         for (i = 0; (i < number_of_rows); i++)
         {
@@ -147,73 +77,100 @@ con_sil_create_element ()
                 create_new_pin
                 (
                         element,
-                        (int) (multiplier * (-pitch_x / 2.0)), /* x0 coordinate */
-                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y0-coordinate */
-                        (int) (multiplier * pad_diameter), /* width of the annulus ring (pad) */
-                        (int) (multiplier * 2 * pad_clearance), /* clearance */
-                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                        (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                        units_to_coord (-pitch_x / 2.0), /* x0 coordinate */
+                        units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
+                        units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                        units_to_coord (2 * pad_clearance), /* clearance */
+                        units_to_coord (pad_diameter + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
+                        units_to_coord (pin_drill_diameter), /* pin drill diameter */
                         pin_pad_name, /* pin name */
                         g_strdup_printf ("%d", pin_number), /* pin number */
                         pad_flag /* flags */
                 );
                 if (!strcmp (pad_shape, "rounded pad, elongated"))
                 {
-                        pad_flag.f = ONSOLDER;
+                        pad_flag.f |= ONSOLDER;
                         create_new_pad
                         (
                                 element,
-                                (int) (multiplier * (-pitch_x - pad_width + pad_length) / 2.0), /* x0 coordinate */
-                                (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y)), /* y0-coordinate */
-                                (int) (multiplier * (-pitch_x + pad_width - pad_length) / 2.0), /* x1 coordinate */
-                                (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y)), /* y1-coordinate */
-                                (int) (multiplier * pad_width), /* pad width */
-                                (int) (multiplier * 2 * pad_clearance), /* clearance */
-                                (int) (multiplier * (pad_width + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                units_to_coord ((-pitch_x - pad_width + pad_length) / 2.0), /* x0 coordinate */
+                                units_to_coord ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
+                                units_to_coord ((-pitch_x + pad_width - pad_length) / 2.0), /* x1 coordinate */
+                                units_to_coord ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y1-coordinate */
+                                units_to_coord (pad_width), /* pad width */
+                                units_to_coord (2 * pad_clearance), /* clearance */
+                                units_to_coord (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                 "", /* pad name */
                                 g_strdup_printf ("%d", pin_number), /* pin number */
                                 pad_flag /* flags */
                         );
                 }
         }
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
         /* Create a package body on the silkscreen. */
         if (silkscreen_package_outline)
         {
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
         }
         /* Create a pin #1 marker on the silkscreen. */
@@ -223,41 +180,41 @@ con_sil_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)), /* x0-coordinate */
-                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1.5) * pitch_y)), /* y0-coordinate */
-                        (int) (multiplier * (package_body_length / 2.0)), /* x1-coordinate */
-                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1.5) * pitch_y)), /* y1-coordinate */
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-package_body_length / 2.0), /* x0-coordinate */
+                        units_to_coord ((((-number_of_rows - 1) / 2.0) + 1.5) * pitch_y), /* y0-coordinate */
+                        units_to_coord (package_body_length / 2.0), /* x1-coordinate */
+                        units_to_coord ((((-number_of_rows - 1) / 2.0) + 1.5) * pitch_y), /* y1-coordinate */
+                        units_to_coord (silkscreen_line_width)
                 );
                 /* Write a triangle shaped marker between package outline and maximum used real estate */
-                if (xmax > ((multiplier * package_body_length) / 2))
+                if (element->VBox.X2 > units_to_coord (package_body_length / 2.0))
                 {
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (-package_body_length / 2.0)), /* x0-coordinate */
-                                (int) (multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)), /* y0-coordinate */
-                                (int) ((multiplier * (-package_body_length / 2.0)) - 2500), /* x1-coordinate */
-                                (int) ((multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) - 1250), /* y1-coordinate */
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (-package_body_length / 2.0), /* x0-coordinate */
+                                units_to_coord (((-number_of_rows + 1) / 2.0) * pitch_y), /* y0-coordinate */
+                                units_to_coord (-package_body_length / 2.0) - 2500, /* x1-coordinate */
+                                units_to_coord (((-number_of_rows + 1) / 2.0) * pitch_y) - 1250, /* y1-coordinate */
+                                units_to_coord (silkscreen_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) (multiplier * (-package_body_length / 2.0)), /* x0-coordinate */
-                                (int) (multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)), /* y0-coordinate */
-                                (int) ((multiplier * (-package_body_length / 2.0)) - 2500), /* x1-coordinate */
-                                (int) ((multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) + 1250), /* y1-coordinate */
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (-package_body_length / 2.0), /* x0-coordinate */
+                                units_to_coord (((-number_of_rows + 1) / 2.0) * pitch_y), /* y0-coordinate */
+                                units_to_coord (-package_body_length / 2.0) - 2500, /* x1-coordinate */
+                                units_to_coord (((-number_of_rows + 1) / 2.0) * pitch_y) + 1250, /* y1-coordinate */
+                                units_to_coord (silkscreen_line_width)
                         );
                         create_new_line
                         (
                                 element,
-                                (int) ((multiplier * (-package_body_length / 2.0)) - 2500), /* x0-coordinate */
-                                (int) ((multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) - 1250), /* y0-coordinate */
-                                (int) ((multiplier * (-package_body_length / 2.0)) - 2500), /* x1-coordinate */
-                                (int) ((multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) + 1250), /* y1-coordinate */
-                                (int) (multiplier * silkscreen_line_width)
+                                units_to_coord (-package_body_length / 2.0) - 2500, /* x0-coordinate */
+                                units_to_coord (((-number_of_rows + 1) / 2.0) * pitch_y) - 1250, /* y0-coordinate */
+                                units_to_coord (-package_body_length / 2.0) - 2500, /* x1-coordinate */
+                                units_to_coord (((-number_of_rows + 1) / 2.0) * pitch_y) + 1250, /* y1-coordinate */
+                                units_to_coord (silkscreen_line_width)
                         );
                 }
         }
@@ -267,38 +224,38 @@ con_sil_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
         }
         /* Create attributes. */
@@ -314,7 +271,8 @@ con_sil_create_element ()
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
@@ -607,7 +565,7 @@ con_sil_drc ()
         }
         /* Check for clearance of the package length with regard to the
          * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -619,7 +577,7 @@ con_sil_drc ()
         }
         /* Check for clearance of the package width with regard to the
          * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -668,8 +626,8 @@ con_sil_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MIL_100:
                 if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
                 {
@@ -680,8 +638,8 @@ con_sil_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MM:
                 if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
                 {
@@ -692,8 +650,8 @@ con_sil_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 default:
                 {
                         if (verbose)
@@ -2431,8 +2389,8 @@ con_sil_get_default_footprint_values ()
         }
         else
         {
-                fprintf (stderr,
-                         _("WARNING: default values for footprint %s not found.\n"),
+                g_log ("", G_LOG_LEVEL_WARNING,
+                         (_("default values for footprint %s not found.\n")),
                          footprint_name);
                 return (EXIT_FAILURE);
         }
@@ -2504,218 +2462,7 @@ con_sil_set_gui_constraints ()
 int
 con_sil_write_footprint ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
-        gchar *pin_pad_flags = g_strdup ("");
-        gint i;
-
-        number_of_columns = 1;
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
-        {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open file for %s footprint: %s."),
-                        footprint_type, footprint_filename);
-                fclose (fp);
-                return (EXIT_FAILURE);
-        }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = multiplier *
-        (
-                (((pad_diameter > pad_length) ? pad_diameter : pad_length) / -2.0) - pad_solder_mask_clearance
-        );
-        xmax = multiplier *
-        (
-                (((pad_diameter > pad_length) ? pad_diameter : pad_length) / 2.0) + pad_solder_mask_clearance
-        );
-        ymin = multiplier *
-        (
-                (((-number_of_rows + 1) / 2.0) * pitch_y) -
-                (((pad_diameter > pad_width) ? pad_diameter : pad_width) / 2.0) -
-                pad_solder_mask_clearance
-        );
-        ymax = multiplier *
-        (
-                (((number_of_rows - 1 ) / 2.0) * pitch_y) +
-                (((pad_diameter > pad_width) ? pad_diameter : pad_width) / 2.0) +
-                pad_solder_mask_clearance
-        );
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        for (i = 0; (i < number_of_rows); i++)
-        {
-                pin_number = 1 + i;
-                write_pin
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        0, /* x0 coordinate */
-                        multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
-                        multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                        multiplier * 2 * pad_clearance, /* clearance */
-                        multiplier * (pad_diameter + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        multiplier * pin_drill_diameter, /* pin drill diameter */
-                        (pin1_square && (pin_number == 1)) ? "square" : pin_pad_flags /* flags */
-                );
-                if (!strcmp (pad_shape, "rounded pad, elongated"))
-                {
-                        if (!strcmp (pin_pad_flags, ""))
-                                pin_pad_flags = g_strconcat (pin_pad_flags, "onsolder", NULL);
-                        else
-                                pin_pad_flags = g_strconcat (pin_pad_flags, ",onsolder", NULL);
-                        write_pad
-                        (
-                                pin_number, /* pad number = pin_number */
-                                pin_pad_name, /* pad name */
-                                multiplier * (-pad_width + pad_length) / 2.0, /* x0 coordinate */
-                                multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
-                                multiplier * (pad_width - pad_length) / 2.0, /* x1 coordinate */
-                                multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y1-coordinate */
-                                multiplier * pad_width, /* width of the pad */
-                                multiplier * 2 * pad_clearance, /* clearance */
-                                multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                pin_pad_flags /* flags */
-                        );
-                }
-        }
-        /* Write a package body on the silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_rectangle
-                (
-                        multiplier * ((-package_body_length) / 2.0), /* xmin-coordinate */
-                        multiplier * ((-package_body_width) / 2.0), /* ymin-coordinate */
-                        multiplier * ((package_body_length) / 2.0), /* xmax-coordinate */
-                        multiplier * ((package_body_width) / 2.0), /* ymax-coordiante */
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                fprintf (fp, "# Write a pin 1 marker on the silkscreen\n");
-                /* Write a marker around pin #1 inside the package outline */
-                write_element_line
-                (
-                        multiplier * (-package_body_length / 2.0), /* x0-coordinate */
-                        multiplier * ((((-number_of_rows - 1) / 2.0) + 1.5) * pitch_y), /* y0-coordinate */
-                        multiplier * (package_body_length / 2.0), /* x1-coordinate */
-                        multiplier * ((((-number_of_rows - 1) / 2.0) + 1.5) * pitch_y), /* y1-coordinate */
-                        multiplier * (silkscreen_line_width)
-                );
-                /* Write a triangle shaped marker between package outline and maximum used real estate */
-                if (xmax > ((multiplier * package_body_length) / 2))
-                {
-                        write_element_line
-                        (
-                                multiplier * (-package_body_length / 2.0), /* x0-coordinate */
-                                multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y), /* y0-coordinate */
-                                (multiplier * (-package_body_length / 2.0)) - 2500 , /* x1-coordinate */
-                                (multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) - 1250, /* y1-coordinate */
-                                multiplier * (silkscreen_line_width)
-                        );
-                        write_element_line
-                        (
-                                multiplier * (-package_body_length / 2.0), /* x0-coordinate */
-                                multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y), /* y0-coordinate */
-                                (multiplier * (-package_body_length / 2.0)) - 2500 , /* x1-coordinate */
-                                (multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) + 1250, /* y1-coordinate */
-                                multiplier * (silkscreen_line_width)
-                        );
-                        write_element_line
-                        (
-                                (multiplier * (-package_body_length / 2.0)) - 2500 , /* x0-coordinate */
-                                (multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) - 1250, /* y0-coordinate */
-                                (multiplier * (-package_body_length / 2.0)) - 2500 , /* x1-coordinate */
-                                (multiplier * (((-number_of_rows + 1) / 2.0) * pitch_y)) + 1250, /* y1-coordinate */
-                                multiplier * (silkscreen_line_width)
-                        );
-                }
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        _("wrote a footprint for a %s package: %s."),
-                        footprint_type,
-                        footprint_filename);
-        }
-        return (EXIT_SUCCESS);
+        return (write_footprint_element (con_sil_create_element));
 }
 
 
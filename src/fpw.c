@@ -74,12 +74,38 @@
 
 
 #include "libfpw.c"
+#include "cache.c"
 #include "packages.h"
+#include "library.c"
+#include "stats.c"
+#include "uring.c"
+#include "archive.c"
+#include "build.c"
+#include "serve.c"
 #include "fpw.h"
 
 
 gchar *program_name = NULL;
 gchar *fpw_filename;
+gchar *query = NULL;
+gchar *sort_column = NULL;
+GSList *library_filenames = NULL;
+gchar *nearest = NULL;
+guint nearest_count = 5;
+gboolean serve = FALSE;
+gchar *socket_path = NULL;
+gint workers = 0;
+gint writers = 1;
+gchar *archive_filename = NULL;
+gboolean compress_archive = FALSE;
+gchar *extract_directory = NULL;
+gboolean output_stdout = FALSE;
+gboolean build_stdout = FALSE;
+gchar *stats_format = NULL;
+pid_t stats_pid = 0;
+gchar *trace_filename = NULL;
+gchar *cache_directory = NULL;
+gchar *build_directory = NULL;
 
 
 /*!
@@ -100,6 +126,22 @@ print_version ()
 }
 
 
+/*!
+ * \brief Print the statistics of --stats to stderr, at exit.
+ *
+ * Only the process which enabled the statistics prints them, the worker
+ * processes add theirs to its statistics in shared memory.
+ */
+void
+print_statistics ()
+{
+        if (stats_is_enabled () && (getpid () == stats_pid))
+        {
+                stats_print (stderr, !strcmp (stats_format, "json"));
+        }
+}
+
+
 /*!
  * \brief Print the usage message for the footprintwizard to stderr.
  *
@@ -122,13 +164,273 @@ print_usage ()
         fprintf (stderr, (_("\t --format <fpw_footprintwizard filename> \n")));
         fprintf (stderr, (_("\t -f <fpw_footprintwizard filename>\n\n")));
         fprintf (stderr, (_("\t --output <footprint name> \n")));
-        fprintf (stderr, (_("\t -o <footprint name>\n\n")));
+        fprintf (stderr, (_("\t -o <footprint name>\n")));
+        fprintf (stderr, (_("\t           : \"-\" writes the footprint to stdout.\n\n")));
+        fprintf (stderr, (_("\t --library <footprint library filename> \n")));
+        fprintf (stderr, (_("\t -l <footprint library filename>\n")));
+        fprintf (stderr, (_("\t           : add a footprint library (csv file) to the\n")));
+        fprintf (stderr, (_("\t             predefined packages for --query and --nearest.\n\n")));
+        fprintf (stderr, (_("\t --query <predicate>[,<predicate>..] \n")));
+        fprintf (stderr, (_("\t -Q <predicate>[,<predicate>..]\n")));
+        fprintf (stderr, (_("\t           : print the packages matching all predicates\n")));
+        fprintf (stderr, (_("\t             (e.g. \"footprint_type=BGA,pitch_x=0.8,package_body_length<=10\")\n")));
+        fprintf (stderr, (_("\t             and exit.\n\n")));
+        fprintf (stderr, (_("\t --sort [-]<column> \n")));
+        fprintf (stderr, (_("\t -S [-]<column>\n")));
+        fprintf (stderr, (_("\t           : sort the --query result on a column,\n")));
+        fprintf (stderr, (_("\t             a leading \"-\" sorts descending.\n\n")));
+        fprintf (stderr, (_("\t --nearest <dimension>=<value>[,<dimension>=<value>..] \n")));
+        fprintf (stderr, (_("\t -n <dimension>=<value>[,<dimension>=<value>..]\n")));
+        fprintf (stderr, (_("\t           : print the packages nearest to the given dimensions\n")));
+        fprintf (stderr, (_("\t             (package_body_length, package_body_width,\n")));
+        fprintf (stderr, (_("\t             package_body_height and pitch in mm, number_of_pins)\n")));
+        fprintf (stderr, (_("\t             with their differences and exit.\n\n")));
+        fprintf (stderr, (_("\t --count <number> \n")));
+        fprintf (stderr, (_("\t -k <number>\n")));
+        fprintf (stderr, (_("\t           : the number of --nearest packages, default 5.\n\n")));
+        fprintf (stderr, (_("\t --serve \n")));
+        fprintf (stderr, (_("\t -s        : serve footprint requests, one JSON object per line,\n")));
+        fprintf (stderr, (_("\t             on stdin and write the footprints or the DRC errors\n")));
+        fprintf (stderr, (_("\t             to stdout, one JSON object per line.\n\n")));
+        fprintf (stderr, (_("\t --socket <socket path> \n")));
+        fprintf (stderr, (_("\t -u <socket path>\n")));
+        fprintf (stderr, (_("\t           : --serve on a Unix socket instead of stdin.\n\n")));
+        fprintf (stderr, (_("\t --workers <number> \n")));
+        fprintf (stderr, (_("\t -w <number>\n")));
+        fprintf (stderr, (_("\t           : the number of --socket or --build worker processes,\n")));
+        fprintf (stderr, (_("\t             default one per processor.\n\n")));
+        fprintf (stderr, (_("\t --cache-dir <directory> \n")));
+        fprintf (stderr, (_("\t -c <directory>\n")));
+        fprintf (stderr, (_("\t           : keep generated footprints in a cache directory\n")));
+        fprintf (stderr, (_("\t             which can be shared by processes and machines,\n")));
+        fprintf (stderr, (_("\t             default the FPW_CACHE_DIR environment variable.\n\n")));
+        fprintf (stderr, (_("\t --build <output directory> \n")));
+        fprintf (stderr, (_("\t -b <output directory>\n")));
+        fprintf (stderr, (_("\t           : build a footprint for every row of the --library\n")));
+        fprintf (stderr, (_("\t             files and every footprintwizard file in the\n")));
+        fprintf (stderr, (_("\t             --format directory into the output directory,\n")));
+        fprintf (stderr, (_("\t             only (re)building what changed since the\n")));
+        fprintf (stderr, (_("\t             previous build, and exit.\n\n")));
+        fprintf (stderr, (_("\t --writers <number> \n")));
+        fprintf (stderr, (_("\t -W <number>\n")));
+        fprintf (stderr, (_("\t           : the number of threads per --build worker writing\n")));
+        fprintf (stderr, (_("\t             the generated footprints, default 1.\n\n")));
+        fprintf (stderr, (_("\t --archive <archive filename> \n")));
+        fprintf (stderr, (_("\t -a <archive filename>\n")));
+        fprintf (stderr, (_("\t           : build all footprints like --build, but into one\n")));
+        fprintf (stderr, (_("\t             archive file with an index sorted on name,\n")));
+        fprintf (stderr, (_("\t             and exit.\n\n")));
+        fprintf (stderr, (_("\t --compress \n")));
+        fprintf (stderr, (_("\t -z        : gzip every footprint in the --archive.\n\n")));
+        fprintf (stderr, (_("\t --extract <directory> \n")));
+        fprintf (stderr, (_("\t -x <directory>\n")));
+        fprintf (stderr, (_("\t           : extract the footprints of the --archive into a\n")));
+        fprintf (stderr, (_("\t             directory, only the --output footprint when given,\n")));
+        fprintf (stderr, (_("\t             and exit.\n\n")));
+        fprintf (stderr, (_("\t --stdout \n")));
+        fprintf (stderr, (_("\t -O        : build all footprints like --build, but write them\n")));
+        fprintf (stderr, (_("\t             to stdout, every footprint after a header\n")));
+        fprintf (stderr, (_("\t             \"fpw_footprint=<name>\", \"footprint_size=<size>\"\n")));
+        fprintf (stderr, (_("\t             and an empty line, and exit.\n\n")));
+        fprintf (stderr, (_("\t --stats[=json] \n")));
+        fprintf (stderr, (_("\t -T[json]  : print the time spent reading, determining the package\n")));
+        fprintf (stderr, (_("\t             type, checking the DRC, creating the geometry and\n")));
+        fprintf (stderr, (_("\t             writing, and the number of footprints, pads, lines,\n")));
+        fprintf (stderr, (_("\t             bytes, allocations and cache hits per package type\n")));
+        fprintf (stderr, (_("\t             to stderr at exit, as a table or as JSON.\n\n")));
+        fprintf (stderr, (_("\t --trace <trace filename> \n")));
+        fprintf (stderr, (_("\t -t <trace filename>\n")));
+        fprintf (stderr, (_("\t           : write the begin and end of every footprint and\n")));
+        fprintf (stderr, (_("\t             every phase (parse, DRC, create element,\n")));
+        fprintf (stderr, (_("\t             serialise, write) per process and thread to a\n")));
+        fprintf (stderr, (_("\t             file in the Chrome trace event format.\n\n")));
         fprintf (stderr, (_("\t --debug \n")));
         fprintf (stderr, (_("\t -d        : turn on debugging output messages.\n\n")));
         return (EXIT_SUCCESS);
 }
 
 
+/*!
+ * \brief Extract the footprints of an archive into a directory.
+ *
+ * Only the footprint named with --output is extracted when it is given,
+ * it is looked up in the index of the archive.
+ *
+ * \return \c EXIT_SUCCESS when the footprints were extracted,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+extract_archive ()
+{
+        archive_t *archive;
+        gchar *name = NULL;
+        gint result;
+
+        archive = archive_open (archive_filename);
+        if (!archive)
+        {
+                return (EXIT_FAILURE);
+        }
+        if (footprint_name)
+        {
+                name = g_str_has_suffix (footprint_name, fp_suffix) ?
+                        g_strdup (footprint_name) :
+                        g_strconcat (footprint_name, ".", fp_suffix, NULL);
+        }
+        result = archive_extract (archive, extract_directory, name);
+        g_free (name);
+        archive_close (archive);
+        return (result);
+}
+
+
+/*!
+ * \brief Query the predefined packages and the footprint libraries.
+ *
+ * The packages matching all predicates in \c query are printed to
+ * stdout, one line per package.
+ *
+ * \return \c EXIT_SUCCESS when the query was done,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+query_library ()
+{
+        library_t *library;
+        GArray *predicates;
+        GArray *rows;
+        GSList *filename;
+        library_predicate_t predicate;
+        gchar **texts;
+        gint column = -1;
+        gboolean descending = FALSE;
+        gint result = EXIT_SUCCESS;
+        guint i;
+
+        if (sort_column)
+        {
+                descending = (sort_column[0] == '-');
+                column = library_get_column (sort_column + (descending ? 1 : 0));
+                if (column < 0)
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("unknown sort column %s."),
+                                        sort_column);
+                        }
+                        return (EXIT_FAILURE);
+                }
+        }
+        predicates = g_array_new (FALSE, FALSE, sizeof (library_predicate_t));
+        texts = g_strsplit (query, ",", 0);
+        for (i = 0; texts[i]; i++)
+        {
+                if (library_parse_predicate (texts[i], &predicate) == EXIT_FAILURE)
+                {
+                        result = EXIT_FAILURE;
+                        continue;
+                }
+                g_array_append_val (predicates, predicate);
+        }
+        g_strfreev (texts);
+        library = library_new ();
+        library_add_packages (library);
+        for (filename = library_filenames; filename; filename = g_slist_next (filename))
+        {
+                if (library_read_csv_file (library, filename->data) == EXIT_FAILURE)
+                {
+                        result = EXIT_FAILURE;
+                }
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                rows = library_query (library,
+                        (library_predicate_t *) predicates->data,
+                        predicates->len);
+                if (column >= 0)
+                {
+                        library_sort (library, rows, column, descending);
+                }
+                library_write_rows (library, rows, stdout);
+                g_array_free (rows, TRUE);
+        }
+        for (i = 0; i < predicates->len; i++)
+        {
+                g_free (g_array_index (predicates, library_predicate_t, i).string);
+        }
+        g_array_free (predicates, TRUE);
+        library_free (library);
+        return (result);
+}
+
+
+/*!
+ * \brief Find the predefined packages and the packages in the footprint
+ * libraries nearest to the dimensions in \c nearest.
+ *
+ * The \c nearest_count nearest packages are printed to stdout, nearest
+ * first, one line per package with the package type, the footprint
+ * name, the relative distance and the differences with the target.
+ *
+ * \return \c EXIT_SUCCESS when the search was done,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+nearest_packages ()
+{
+        library_t *library;
+        library_index_t *index;
+        GSList *filename;
+        gdouble target[LIBRARY_DIMENSIONS];
+        gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+        gchar *deltas;
+        guint *rows;
+        gdouble *distances;
+        guint found;
+        gint result;
+        guint i;
+
+        result = library_parse_target (nearest, target);
+        if (result == EXIT_FAILURE)
+        {
+                return (EXIT_FAILURE);
+        }
+        library = library_new ();
+        library_add_packages (library);
+        for (filename = library_filenames; filename; filename = g_slist_next (filename))
+        {
+                if (library_read_csv_file (library, filename->data) == EXIT_FAILURE)
+                {
+                        result = EXIT_FAILURE;
+                }
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                index = library_index_new (library);
+                rows = g_new (guint, MAX (1, nearest_count));
+                distances = g_new (gdouble, MAX (1, nearest_count));
+                found = library_index_nearest (index, target, nearest_count,
+                        rows, distances);
+                for (i = 0; i < found; i++)
+                {
+                        deltas = library_get_deltas (library, rows[i], target);
+                        fprintf (stdout, "%s\t%s\t%s\t%s\n",
+                                library_get_string (library, LIBRARY_FOOTPRINT_TYPE, rows[i]),
+                                library_get_string (library, LIBRARY_FOOTPRINT_NAME, rows[i]),
+                                g_ascii_formatd (buffer, sizeof (buffer), "%.4g", distances[i]),
+                                deltas);
+                        g_free (deltas);
+                }
+                g_free (rows);
+                g_free (distances);
+                library_index_free (index);
+        }
+        library_free (library);
+        return (result);
+}
+
+
 /*!
  * \brief The CLI for the footprintwizard.
  *
@@ -141,6 +443,9 @@ main
         char **argv /*!< : array of argument variables */
 )
 {
+        fpw_header_t header;
+        stats_span_t startup = {g_get_monotonic_time (), 0};
+
         /* Determine how we are called today */
         program_name = argv[0];
         static const struct option opts[] =
@@ -153,10 +458,27 @@ main
                 {"silent", no_argument, NULL, 'q'},
                 {"format", required_argument, NULL, 'f'},
                 {"output", required_argument, NULL, 'o'},
+                {"library", required_argument, NULL, 'l'},
+                {"query", required_argument, NULL, 'Q'},
+                {"sort", required_argument, NULL, 'S'},
+                {"nearest", required_argument, NULL, 'n'},
+                {"count", required_argument, NULL, 'k'},
+                {"serve", no_argument, NULL, 's'},
+                {"socket", required_argument, NULL, 'u'},
+                {"workers", required_argument, NULL, 'w'},
+                {"cache-dir", required_argument, NULL, 'c'},
+                {"build", required_argument, NULL, 'b'},
+                {"writers", required_argument, NULL, 'W'},
+                {"archive", required_argument, NULL, 'a'},
+                {"compress", no_argument, NULL, 'z'},
+                {"extract", required_argument, NULL, 'x'},
+                {"stdout", no_argument, NULL, 'O'},
+                {"stats", optional_argument, NULL, 'T'},
+                {"trace", required_argument, NULL, 't'},
                 {0, 0, 0, 0}
         };
         int optc;
-        while ((optc = getopt_long (argc, argv, "dhVvqqf:o:", opts, NULL)) != -1)
+        while ((optc = getopt_long (argc, argv, "dhVvqqf:o:l:Q:S:n:k:su:w:c:b:W:a:zx:OT::t:", opts, NULL)) != -1)
         {
                 switch (optc)
                 {
@@ -182,10 +504,67 @@ main
                                         fprintf (stderr, "fpw filename = %s\n", fpw_filename);
                                 break;
                         case 'o':
+                                if (!strcmp (optarg, "-"))
+                                {
+                                        output_stdout = TRUE;
+                                        break;
+                                }
                                 footprint_name = strdup (optarg);
                                 if (debug)
                                         fprintf (stderr, "footprint name = %s\n", footprint_name);
                                 break;
+                        case 'l':
+                                library_filenames = g_slist_append (library_filenames, strdup (optarg));
+                                break;
+                        case 'Q':
+                                query = strdup (optarg);
+                                break;
+                        case 'S':
+                                sort_column = strdup (optarg);
+                                break;
+                        case 'n':
+                                nearest = strdup (optarg);
+                                break;
+                        case 'k':
+                                nearest_count = atoi (optarg);
+                                break;
+                        case 's':
+                                serve = TRUE;
+                                break;
+                        case 'u':
+                                socket_path = strdup (optarg);
+                                serve = TRUE;
+                                break;
+                        case 'w':
+                                workers = atoi (optarg);
+                                break;
+                        case 'c':
+                                cache_directory = strdup (optarg);
+                                break;
+                        case 'b':
+                                build_directory = strdup (optarg);
+                                break;
+                        case 'W':
+                                writers = atoi (optarg);
+                                break;
+                        case 'a':
+                                archive_filename = strdup (optarg);
+                                break;
+                        case 'z':
+                                compress_archive = TRUE;
+                                break;
+                        case 'x':
+                                extract_directory = strdup (optarg);
+                                break;
+                        case 'O':
+                                build_stdout = TRUE;
+                                break;
+                        case 'T':
+                                stats_format = strdup (optarg ? optarg : "table");
+                                break;
+                        case 't':
+                                trace_filename = strdup (optarg);
+                                break;
                         case '?':
                                 print_usage ();
                                 exit (EXIT_FAILURE);
@@ -201,8 +580,72 @@ main
                 print_usage ();
                 exit (EXIT_FAILURE);
         }
+        if (stats_format)
+        {
+                if (strcmp (stats_format, "table") && strcmp (stats_format, "json"))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("unknown statistics format %s, use table or json."),
+                                stats_format);
+                        exit (EXIT_FAILURE);
+                }
+                if (stats_enable () == EXIT_FAILURE)
+                {
+                        exit (EXIT_FAILURE);
+                }
+                stats_pid = getpid ();
+                atexit (print_statistics);
+        }
+        if (trace_filename)
+        {
+                if (stats_trace_open (trace_filename) == EXIT_FAILURE)
+                {
+                        exit (EXIT_FAILURE);
+                }
+                atexit (stats_trace_close);
+        }
+        if (cache_directory &&
+                (footprint_cache_set_directory (cache_directory) == EXIT_FAILURE))
+        {
+                exit (EXIT_FAILURE);
+        }
+        stats_end (&startup, STATS_STARTUP);
+        if (query)
+        {
+                exit (query_library ());
+        }
+        if (nearest)
+        {
+                exit (nearest_packages ());
+        }
+        if (build_stdout)
+        {
+                exit (build_stream (stdout, library_filenames, fpw_filename, workers, writers));
+        }
+        if (archive_filename && extract_directory)
+        {
+                exit (extract_archive ());
+        }
+        if (archive_filename)
+        {
+                exit (build_archive (archive_filename,
+                        compress_archive ? ARCHIVE_GZIP : ARCHIVE_STORED,
+                        library_filenames, fpw_filename, workers, writers));
+        }
+        if (build_directory)
+        {
+                exit (build_footprints (build_directory, library_filenames, fpw_filename, workers, writers));
+        }
+        if (serve)
+        {
+                if (socket_path)
+                {
+                        exit (serve_socket (socket_path, workers));
+                }
+                exit (serve_stream (stdin, stdout));
+        }
         /* Read variables from the fpw file */
-        if (read_footprintwizard_file (fpw_filename))
+        if (read_footprintwizard_file (fpw_filename) == EXIT_SUCCESS)
         {
                 if (verbose)
                 {
@@ -221,6 +664,14 @@ main
                 }
                         exit (EXIT_FAILURE);
         }
+        /* A footprint written to stdout has no --output name, take the
+         * name from the footprintwizard file. */
+        if (output_stdout && !footprint_name &&
+                (read_footprintwizard_file_header (fpw_filename, &header) == EXIT_SUCCESS))
+        {
+                footprint_name = header.footprint_name;
+                g_free (header.footprint_type);
+        }
         /* Check for a null pointer in footprint_name for this might cause a
          * segmentation fault or undefined behaviour. */
         if (!footprint_name)
@@ -254,6 +705,10 @@ main
                 /* Footprintname has no .fp suffix, add a .fp suffix */
                 footprint_filename = g_strconcat (footprint_name, fp_suffix, NULL);
         }
+        if (output_stdout)
+        {
+                footprint_output = stdout;
+        }
         write_footprint ();
         if (verbose)
         {
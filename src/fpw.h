@@ -33,8 +33,11 @@
 
 G_BEGIN_DECLS /* keep c++ happy */
 
+void print_statistics ();
 int print_version ();
 int print_usage ();
+int query_library ();
+int nearest_packages ();
 int main (int , char **);
 
 G_END_DECLS /* keep c++ happy */
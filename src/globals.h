@@ -139,7 +139,9 @@ char *row_letters[] =
         "BA", "BB", "BC", "BD", "BE", "BF", "BG", "BH", "BJ", "BK",
         "BL", "BM", "BN", "BP", "BR", "BT", "BU", "BV", "BW", "BY",
         "CA", "CB", "CC", "CD", "CE", "CF", "CG", "CH", "CJ", "CK",
-        "CL", "CM", "CN", "CP", "CR", "CT", "CU", "CV", "CW", "CY"
+        "CL", "CM", "CN", "CP", "CR", "CT", "CU", "CV", "CW", "CY",
+        "DA", "DB", "DC", "DD", "DE", "DF", "DG", "DH", "DJ", "DK",
+        "DL", "DM", "DN", "DP", "DR", "DT", "DU", "DV", "DW", "DY"
 };
 
 /*!
@@ -187,6 +189,50 @@ typedef enum pad_shapes
         ROUND_ELONGATED
 } pad_shapes_t;
 
+/*!
+ * \brief Some naming schemes for pins/pads in a grid array.
+ */
+typedef enum grid_namings
+{
+        NO_NAMING, /*!< For those living in the void. */
+        ROW_LETTERS, /*!< Pin/pad names are row letters plus a column number ("A1", "A2", ..), numbers are sequential by row. */
+        SEQUENTIAL, /*!< Pin/pad numbers are sequential by row. */
+        ODD_EVEN /*!< Pin/pad numbers are sequential by column, for two rows this puts the odd numbers in the first row and the even numbers in the second row. */
+} grid_naming_t;
+
+/*!
+ * \brief Value types of the lines in a footprintwizard file.
+ */
+typedef enum fpw_value_types
+{
+        FPW_IGNORE, /*!< A line which is skipped while reading. */
+        FPW_STRING, /*!< A string, the whole line including any whitespace. */
+        FPW_DOUBLE, /*!< A floating point number. */
+        FPW_INTEGER /*!< An integer number or a boolean. */
+} fpw_value_t;
+
+/*!
+ * \brief A line in a footprintwizard file.
+ */
+typedef struct fpw_field
+{
+        gchar *name; /*!< Name of the value, used in messages. */
+        fpw_value_t type; /*!< Type of the value. */
+        gpointer value; /*!< Pointer to the global variable holding the value. */
+        gboolean required; /*!< An empty or "(null)" string is an error. */
+} fpw_field_t;
+
+/*!
+ * \brief The header of a footprintwizard file.
+ */
+typedef struct fpw_header
+{
+        gint version; /*!< Format version of the file, 1 for a positional file. */
+        gchar *footprint_type; /*!< Package type of the footprint. */
+        gchar *footprint_name; /*!< Name of the footprint. */
+        guint64 parameter_hash; /*!< Hash of the parameter lines, 0 when unknown. */
+} fpw_header_t;
+
 /* Thin lines are not printed on silkscreen (in the real world) */
 #define THIN_DRAW 1 /*!< Draw with thin lines. */
 
@@ -198,6 +244,8 @@ typedef enum pad_shapes
         /*!< Convert mm to mil. */
 #define NUM_BASE 10
         /*!< Use 10-base for converting string to long (strtol). */
+#define FPW_FORMAT_VERSION 2
+        /*!< Version of the keyed footprintwizard file format. */
 
 #ifndef MAXPATHLEN /* maximum path length */
 #ifdef PATH_MAX
@@ -216,12 +264,18 @@ gboolean verbose = FALSE;
 
 FILE *fp;
         /*!< Global file pointer for the footprint file. */
+FILE *footprint_output = NULL;
+        /*!< Stream the footprints are written to instead of the footprint
+         * file, when not \c NULL. */
 gchar *fpw_pathname = NULL;
         /*!< Path to the footprintwizard file.*/
 gchar *fpw_suffix = "fpw";
         /*!< Suffix of footprintwizard file. */
 gchar *footprint_filename = NULL;
         /*!< Filename of footprint file. */
+gchar *footprint_temporary_filename = NULL;
+        /*!< Filename the footprint file is written to before it is
+         * renamed to \c footprint_filename. */
 gchar *fp_suffix = "fp";
         /*!< Suffix of footprint file. */
 gchar *footprint_name = NULL;
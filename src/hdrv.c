@@ -27,6 +27,223 @@
 #include "hdrv.h"
 
 
+/*!
+ * \brief Create an Element for a HDRV Pin Through Hole package.
+ *
+ * The pin/pad numbering scheme of the HDRV package is: \n
+ * \n
+ * for 2 columns \n
+ * \n
+ * 1 2 \n
+ * 3 4 \n
+ * 5 6 \n
+ * 7 8 \n
+ * \n
+ * Note: the pin #1 orientation is always top-left. \n
+ *
+ * \return \c EXIT_SUCCESS when an element was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+hdrv_create_element ()
+{
+        LocationType marker_offset;
+        PinType pin_template;
+        PinTypePtr pin = NULL;
+        PadType pad_template;
+        ElementTypePtr element;
+        GList *pins;
+
+        element = create_new_element ();
+        if (!element)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create a valid element pointer for a %s package."),
+                                footprint_type);
+                }
+                return (EXIT_FAILURE);
+        }
+        /* Define the center of our universe and guess for a place where to
+         * put the element mark */
+        element->MarkX = 0;
+        element->MarkY = 0;
+        /* Create pin and/or pad entities, numbered column by column. */
+        pin_template.Thickness = units_to_coord (pad_diameter);
+        pin_template.Clearance = units_to_coord (pad_clearance);
+        pin_template.Mask = units_to_coord (pad_diameter + 2 * pad_solder_mask_clearance);
+        pin_template.DrillingHole = units_to_coord (pin_drill_diameter);
+        pin_template.Flags.f = CLEAR;
+        /* An elongated pad on the solder side, centered on the pin. */
+        pad_template.Point1.X = 0;
+        pad_template.Point1.Y = -units_to_coord ((pad_length - pad_width) / 2.0);
+        pad_template.Point2.X = 0;
+        pad_template.Point2.Y = units_to_coord ((pad_length - pad_width) / 2.0);
+        pad_template.Thickness = units_to_coord (pad_width);
+        pad_template.Clearance = units_to_coord (2 * pad_clearance);
+        pad_template.Mask = units_to_coord (pad_width + (2 * pad_solder_mask_clearance));
+        pad_template.Flags.f = ONSOLDER;
+        if (create_grid_array (element, count_y, number_of_columns,
+                pitch_x, pitch_y,
+                ODD_EVEN, NULL, pin1_square, &pin_template,
+                (!strcmp (pad_shape, "rounded pad, elongated")) ? &pad_template : NULL))
+        {
+                free_element (element);
+                return (EXIT_FAILURE);
+        }
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name. */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes. */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value. */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create a package body on the silkscreen. */
+        if (silkscreen_package_outline)
+        {
+                create_new_line
+                (
+                        element,
+                        units_to_coord ((-package_body_length - silkscreen_line_width) / 2.0),
+                        units_to_coord ((-package_body_width - silkscreen_line_width) / 2.0),
+                        units_to_coord ((-package_body_length - silkscreen_line_width) / 2.0),
+                        units_to_coord ((package_body_width + silkscreen_line_width) / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        units_to_coord ((package_body_length + silkscreen_line_width) / 2.0),
+                        units_to_coord ((-package_body_width - silkscreen_line_width) / 2.0),
+                        units_to_coord ((package_body_length + silkscreen_line_width) / 2.0),
+                        units_to_coord ((package_body_width + silkscreen_line_width) / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        units_to_coord ((-package_body_length - silkscreen_line_width) / 2.0),
+                        units_to_coord ((-package_body_width - silkscreen_line_width) / 2.0),
+                        units_to_coord ((package_body_length + silkscreen_line_width) / 2.0),
+                        units_to_coord ((-package_body_width - silkscreen_line_width) / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        units_to_coord ((package_body_length + silkscreen_line_width) / 2.0),
+                        units_to_coord ((package_body_width + silkscreen_line_width) / 2.0),
+                        units_to_coord ((-package_body_length - silkscreen_line_width) / 2.0),
+                        units_to_coord ((package_body_width + silkscreen_line_width) / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+        }
+        /* Create a pin #1 marker at the upper left of pin #1, where
+         * create_grid_array () placed it. */
+        for (pins = element->Pin; pins; pins = g_list_next (pins))
+        {
+                pin = pins->data;
+                if (!strcmp (pin->Number, "1"))
+                {
+                        break;
+                }
+        }
+        if (silkscreen_indicate_1 && pins)
+        {
+                marker_offset = units_to_coord ((pad_diameter / 2.0) +
+                        pad_solder_mask_clearance + pad_clearance);
+                create_new_arc
+                (
+                        element,
+                        pin->X - marker_offset, /* x-coordinate */
+                        pin->Y - marker_offset, /* y-coordinate */
+                        units_to_coord (0.5 * silkscreen_line_width), /* width */
+                        units_to_coord (0.5 * silkscreen_line_width), /* height */
+                        0, /* start angle */
+                        360, /* delta angle */
+                        units_to_coord (silkscreen_line_width) /* line width */
+                );
+        }
+        /* Create a courtyard outline. */
+        if (courtyard)
+        {
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+        }
+        /* Create attributes. */
+        if (attributes_in_footprint)
+        {
+                element = create_attributes_in_element (element);
+        }
+        /* We are ready creating an element. */
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        (_("[%s] created an element for element: %s.")),
+                        footprint_type,
+                        footprint_filename);
+        }
+        free_element (current_element);
+        current_element = element;
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Create a list of HDRV packages with pre-defined values.
  *
@@ -40,7 +257,7 @@ int
 hdrv_create_packages_list ()
 {
         g_list_free (packages_list);
-        packages_list = g_list_append (packages_list, "HDRV");
+        packages_list = g_list_append (packages_list, "HDRV4W60P254_2X2_762L254W254H");
         return (EXIT_SUCCESS);
 }
 
@@ -277,7 +494,7 @@ hdrv_drc ()
         }
         /* Check for clearance of the package length with regard to the
          * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -289,7 +506,7 @@ hdrv_drc ()
         }
         /* Check for clearance of the package width with regard to the
          * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -338,8 +555,8 @@ hdrv_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MIL_100:
                 if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
                 {
@@ -350,8 +567,8 @@ hdrv_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MM:
                 if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
                 {
@@ -362,8 +579,8 @@ hdrv_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 default:
                 {
                         if (verbose)
@@ -446,8 +663,8 @@ hdrv_get_default_footprint_values ()
         }
         else
         {
-                fprintf (stderr,
-                         _("WARNING: default values for footprint %s not found.\n"),
+                g_log ("", G_LOG_LEVEL_WARNING,
+                         (_("default values for footprint %s not found.\n")),
                          footprint_name);
                 return (EXIT_FAILURE);
         }
@@ -536,187 +753,7 @@ hdrv_set_gui_constraints ()
 int
 hdrv_write_footprint ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
-        gchar *pin_pad_flags = g_strdup ("");
-        gint i;
-        gint j;
-
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
-        {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open file for %s footprint: %s."),
-                        footprint_type, footprint_filename);
-                fclose (fp);
-                return (EXIT_FAILURE);
-        }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = multiplier *
-        (
-                (((-number_of_columns + 1) / 2.0) * pitch_x) -
-                (((pad_diameter > pad_length) ? pad_diameter : pad_length) / 2.0) -
-                pad_solder_mask_clearance
-        );
-        xmax = multiplier *
-        (
-                (((number_of_columns - 1) / 2.0) * pitch_x) +
-                (((pad_diameter > pad_length) ? pad_diameter : pad_length) / 2.0) +
-                pad_solder_mask_clearance
-        );
-        ymin = multiplier *
-        (
-                (((-count_y + 1) / 2.0) * pitch_y) -
-                (((pad_diameter > pad_width) ? pad_diameter : pad_width) / 2.0) -
-                pad_solder_mask_clearance
-        );
-        ymax = multiplier *
-        (
-                (((count_y - 1) / 2.0) * pitch_y) +
-                (((pad_diameter > pad_width) ? pad_diameter : pad_width) / 2.0) +
-                pad_solder_mask_clearance
-        );
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        pin_number = 1;
-        for (i = 0; (i < count_y); i++)
-        {
-                for (j = 0; (j < number_of_columns); j++)
-                {
-                        if (pin1_square && (pin_number == 1))
-                                pin_pad_flags = g_strdup ("square");
-                        else
-                                pin_pad_flags = g_strdup ("");
-                        write_pin
-                        (
-                                pin_number, /* pin number */
-                                pin_pad_name, /* pin name */
-                                multiplier * ((((-number_of_columns - 1) / 2.0) + 1 + i) * pitch_x), /* x0-coordinate */
-                                multiplier * ((((count_y - 1) / 2.0) + 1 - j) * (pitch_y / 2.0)), /* y0 coordinate */
-                                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                                multiplier * pad_clearance, /* clearance */
-                                multiplier * (pad_diameter + 2 * pad_solder_mask_clearance), /* solder mask clearance */
-                                multiplier * pin_drill_diameter, /* pin drill diameter */
-                                pin_pad_flags /* flags */
-                        );
-                        if (!strcmp (pad_shape, "rounded pad, elongated"))
-                        {
-                                if (!strcmp (pin_pad_flags, ""))
-                                        pin_pad_flags = g_strconcat (pin_pad_flags, "onsolder", NULL);
-                                else
-                                        pin_pad_flags = g_strconcat (pin_pad_flags, ",onsolder", NULL);
-                                write_pad
-                                (
-                                        pin_number, /* pad number = pin_number */
-                                        pin_pad_name, /* pad name */
-                                        multiplier * ((((-number_of_columns - 1) / 2.0) + 1 + i) * pitch_x), /* x0-coordinate */
-                                        multiplier * (((((count_y - 1) / 2.0) + 1 - j) * (pitch_y / 2.0)) + pad_length - pad_width) / 2.0, /* y0 coordinate */
-                                        multiplier * ((((-number_of_columns - 1) / 2.0) + 1 + i) * pitch_x), /* x1-coordinate */
-                                        multiplier * (((((count_y - 1) / 2.0) + 1 - j) * (pitch_y / 2.0)) - pad_length + pad_width) / 2.0, /* y1 coordinate */
-                                        multiplier * pad_length, /* width of the pad */
-                                        multiplier * 2 * pad_clearance, /* clearance */
-                                        multiplier * (pad_length + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                        }
-                        pin_number++;
-                }
-        }
-        /* Write a package body on the silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_rectangle
-                (
-                        multiplier * ((-package_body_length - silkscreen_line_width) / 2.0) ,
-                        multiplier * ((-package_body_width - silkscreen_line_width) / 2.0) ,
-                        multiplier * ((package_body_length + silkscreen_line_width) / 2.0) ,
-                        multiplier * ((package_body_width + silkscreen_line_width) / 2.0) ,
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                fprintf (fp, "# Write a pin 1 marker on the silkscreen\n");
-                write_element_arc
-                (
-                        xmin - (multiplier * (pad_solder_mask_clearance + pad_clearance)), /* xmin already in mil/100 */
-                        ymax + (multiplier * (pad_solder_mask_clearance + pad_clearance)), /* ymax already in mil/100 */
-                        multiplier * 0.5 * silkscreen_line_width,
-                        multiplier * 0.5 * silkscreen_line_width,
-                        0,
-                        360,
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        _("wrote a footprint for a %s package: %s."),
-                        footprint_type,
-                        footprint_filename);
-        }
-        return (EXIT_SUCCESS);
+        return (write_footprint_element (hdrv_create_element));
 }
 
 
@@ -734,6 +771,12 @@ hdrv_function_list[] =
                 NULL
         },
 #endif /* GUI */
+        {
+                "Create Element",
+                hdrv_create_element,
+                "Create a pcb element for a HDRV package",
+                NULL
+        },
         {
                 "Create Package List",
                 hdrv_create_packages_list,
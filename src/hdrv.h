@@ -28,6 +28,7 @@
 
 G_BEGIN_DECLS /* keep c++ happy */
 
+int hdrv_create_element ();
 int hdrv_create_packages_list ();
 int hdrv_drc ();
 int hdrv_get_default_footprint_values ();
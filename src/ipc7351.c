@@ -0,0 +1,536 @@
+/*!
+ * \file src/ipc7351.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for decoding IPC-7351 footprint names.
+ *
+ * A footprint name like "BGA100C100P10X10_1100X1100X140" encodes the
+ * number of pins, the pitch, the matrix and the body dimensions.\n
+ * Names which are not predefined are decoded with the pattern of their
+ * package family, the values which can not be derived from a name (pad
+ * sizes, clearances) are taken from the nearest predefined package of
+ * the same family.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include "ipc7351.h"
+
+
+/*!
+ * \brief The package families with IPC-7351 footprint names.
+ */
+static ipc7351_family_t ipc7351_families[] =
+{
+        {
+                BGA, "BGA%n%v%pP%cX%r_%xX%yX%h", IPC7351_PINS_GRID,
+                {&pitch_x, &pitch_y},
+                &package_body_length, &package_body_width,
+                {&courtyard_length, &silkscreen_length},
+                {&courtyard_width, &silkscreen_width},
+                {NULL},
+                bga_create_packages_list, bga_get_default_footprint_values
+        },
+        {
+                CAPC, "CAPC%l%wX%h", IPC7351_PINS_TWO,
+                {NULL},
+                &package_body_length, &package_body_width,
+                {&pitch_x, &courtyard_length, &silkscreen_length},
+                {&pad_width, &courtyard_width, &silkscreen_width},
+                {NULL},
+                capc_create_packages_list, capc_get_default_footprint_values
+        },
+        {
+                INDC, "INDC%l%wX%h", IPC7351_PINS_TWO,
+                {NULL},
+                &package_body_length, &package_body_width,
+                {&pitch_x, &courtyard_length, &silkscreen_length},
+                {&pad_width, &courtyard_width, &silkscreen_width},
+                {NULL},
+                indc_create_packages_list, indc_get_default_footprint_values
+        },
+        {
+                QFN, "QFN%pP%xX%yX%h-%n", IPC7351_PINS_QUAD,
+                {&pitch_x, &pitch_y},
+                &package_body_length, &package_body_width,
+                {&c2, &courtyard_length, &silkscreen_length, &thermal_length},
+                {&c1, &courtyard_width, &silkscreen_width, &thermal_width},
+                {NULL},
+                qfn_create_packages_list, qfn_get_default_footprint_values
+        },
+        {
+                QFP, "QFP%pP%xX%yX%h-%n", IPC7351_PINS_QUAD,
+                {&pitch_x, &pitch_y},
+                NULL, NULL,
+                {&c2, &package_body_length, &courtyard_length, &silkscreen_length},
+                {&c1, &package_body_width, &courtyard_width, &silkscreen_width},
+                {NULL},
+                qfp_create_packages_list, qfp_get_default_footprint_values
+        },
+        {
+                SO, "SO%pP%xX%h-%n", IPC7351_PINS_DUAL,
+                {&pitch_y},
+                NULL, NULL,
+                {&c2, &package_body_length, &courtyard_length, &silkscreen_length},
+                {NULL},
+                {&package_body_width, &courtyard_width, &silkscreen_width},
+                so_create_packages_list, so_get_default_footprint_values
+        },
+        {
+                SOT, "SOT%pP%xX%h-%n", IPC7351_PINS_TEMPLATE,
+                {&pitch_y},
+                NULL, NULL,
+                {&pitch_x, &courtyard_length},
+                {NULL},
+                {NULL},
+                sot_create_packages_list, sot_get_default_footprint_values
+        }
+};
+
+/*!
+ * \brief Whether the values of a predefined package are being looked up
+ * for a decoded name, to prevent recursion.
+ */
+static gboolean ipc7351_busy = FALSE;
+
+
+/*!
+ * \brief Find the package family of a package type.
+ *
+ * \return the package family, \c NULL when the package type has no
+ * IPC-7351 footprint names.
+ */
+static ipc7351_family_t *
+ipc7351_find_family
+(
+        package_t type
+                /*!< : the package type.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < G_N_ELEMENTS (ipc7351_families); i++)
+        {
+                if (ipc7351_families[i].type == type)
+                {
+                        return (&ipc7351_families[i]);
+                }
+        }
+        return (NULL);
+}
+
+
+/*!
+ * \brief Match a footprint name with the pattern of a package family.
+ *
+ * \return \c EXIT_SUCCESS when the name matches the pattern,
+ * \c EXIT_FAILURE when it does not.
+ */
+static int
+ipc7351_match_pattern
+(
+        const gchar *pattern,
+                /*!< : the pattern of the package family.*/
+        const gchar *name,
+                /*!< : the footprint name.*/
+        ipc7351_name_t *decoded
+                /*!< : the decoded values.*/
+)
+{
+        const gchar *p = pattern;
+        const gchar *s = name;
+        gchar conversion;
+        gint digits;
+        gint maximum_digits;
+        gint value;
+        guint length = 0;
+
+        memset (decoded, 0, sizeof (ipc7351_name_t));
+        while (*p)
+        {
+                if (*p != '%')
+                {
+                        if (*s++ != *p++)
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        continue;
+                }
+                conversion = p[1];
+                p += 2;
+                if (conversion == 'v')
+                {
+                        if (!g_ascii_isupper (*s))
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        decoded->variant = *s++;
+                        continue;
+                }
+                maximum_digits = ((conversion == 'l') || (conversion == 'w')) ? 2 : 6;
+                value = 0;
+                for (digits = 0; (digits < maximum_digits) && g_ascii_isdigit (*s); digits++)
+                {
+                        value = (value * 10) + (*s++ - '0');
+                }
+                if ((digits == 0) || ((maximum_digits == 2) && (digits != 2)))
+                {
+                        return (EXIT_FAILURE);
+                }
+                switch (conversion)
+                {
+                        case 'n':
+                                decoded->pins = value;
+                                break;
+                        case 'c':
+                                decoded->columns = value;
+                                break;
+                        case 'r':
+                                decoded->rows = value;
+                                break;
+                        case 'p':
+                                decoded->pitch = value / 100.0;
+                                break;
+                        case 'x':
+                                decoded->x = value / 100.0;
+                                break;
+                        case 'y':
+                                decoded->y = value / 100.0;
+                                break;
+                        case 'h':
+                                decoded->height = value / 100.0;
+                                break;
+                        case 'l':
+                                decoded->x = value / 10.0;
+                                break;
+                        case 'w':
+                                decoded->y = value / 10.0;
+                                break;
+                        default:
+                                return (EXIT_FAILURE);
+                }
+        }
+        /* A density level, optionally preceded by a single letter. */
+        while (g_ascii_isupper (*s) && (length < 2))
+        {
+                decoded->suffix[length++] = *s++;
+        }
+        if ((length > 0) && !strchr ("LMN", decoded->suffix[length - 1]))
+        {
+                return (EXIT_FAILURE);
+        }
+        return ((*s == '\0') ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Score how well a predefined package fits as a source of the
+ * values which can not be derived from a decoded name.
+ *
+ * Packages with the same variant and suffix come first, then the
+ * nearest pitch, then the nearest dimensions.
+ *
+ * \return the score, lower is better, a negative score when the
+ * predefined package does not fit at all.
+ */
+static gdouble
+ipc7351_score_template
+(
+        ipc7351_family_t *family,
+                /*!< : the package family.*/
+        ipc7351_name_t *decoded,
+                /*!< : the decoded name.*/
+        ipc7351_name_t *template
+                /*!< : the decoded name of the predefined package.*/
+)
+{
+        gdouble score = 0.0;
+        gint length = strlen (decoded->suffix);
+        gint template_length = strlen (template->suffix);
+
+        if ((family->pins == IPC7351_PINS_TEMPLATE) &&
+                (decoded->pins != template->pins))
+        {
+                return (-1.0);
+        }
+        if (decoded->variant != template->variant)
+        {
+                score += 1e7;
+        }
+        /* The last letter is the density level (L, M or N). */
+        if ((length > 0) && (template_length > 0) &&
+                (decoded->suffix[length - 1] != template->suffix[template_length - 1]))
+        {
+                score += 1e7;
+        }
+        if (strcmp (decoded->suffix, template->suffix))
+        {
+                score += 1e6;
+        }
+        score += 1e3 * fabs (decoded->pitch - template->pitch);
+        score += fabs (decoded->x - template->x) + fabs (decoded->y - template->y);
+        return (score);
+}
+
+
+/*!
+ * \brief Decode an IPC-7351 footprint name.
+ *
+ * \return \c EXIT_SUCCESS when the name is a well-formed name of the
+ * package type, \c EXIT_FAILURE when it is not.
+ */
+int
+ipc7351_decode_name
+(
+        package_t type,
+                /*!< : the package type.*/
+        const gchar *name,
+                /*!< : the footprint name, without a leading "?".*/
+        ipc7351_name_t *decoded
+                /*!< : the decoded values.*/
+)
+{
+        ipc7351_family_t *family;
+
+        family = ipc7351_find_family (type);
+        if (!family || !name ||
+                (ipc7351_match_pattern (family->pattern, name, decoded) == EXIT_FAILURE))
+        {
+                return (EXIT_FAILURE);
+        }
+        switch (family->pins)
+        {
+                case IPC7351_PINS_TWO:
+                        decoded->pins = 2;
+                        break;
+                case IPC7351_PINS_GRID:
+                        if ((decoded->pins == 0) ||
+                                (decoded->pins > (decoded->columns * decoded->rows)))
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        break;
+                case IPC7351_PINS_DUAL:
+                        if ((decoded->pins == 0) || (decoded->pins % 2))
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        break;
+                case IPC7351_PINS_QUAD:
+                        if ((decoded->pins < 4) || ((decoded->pins % 4) > 1))
+                        {
+                                return (EXIT_FAILURE);
+                        }
+                        break;
+                default:
+                        break;
+        }
+        if ((decoded->height <= 0.0) || (decoded->x <= 0.0) ||
+                (strstr (family->pattern, "%p") && (decoded->pitch <= 0.0)))
+        {
+                return (EXIT_FAILURE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Look up default values for a footprint with an IPC-7351 name
+ * which is not predefined.
+ *
+ * The \c footprint_name (with a leading "?") is decoded with the
+ * pattern of the package family of \c type.\n
+ * The values which can not be derived from the name are loaded from the
+ * predefined package of the same family which fits best, dimensions
+ * which depend on the body size (courtyard, silkscreen) keep their
+ * distance to the body.\n
+ * Then the values encoded in the name are set.
+ *
+ * \return \c EXIT_SUCCESS when default values for the footprint were
+ * derived, \c EXIT_FAILURE when the name could not be decoded or the
+ * pin/pad exceptions of a grid with missing pins can not be derived.
+ */
+int
+ipc7351_get_default_footprint_values
+(
+        package_t type
+                /*!< : the package type.*/
+)
+{
+        ipc7351_family_t *family;
+        ipc7351_name_t decoded;
+        ipc7351_name_t template;
+        ipc7351_name_t best_template = {0};
+        const gchar *best_name = NULL;
+        gchar *name;
+        GList *names;
+        GList *saved_packages_list;
+        gdouble best_score = -1.0;
+        gdouble score;
+        gdouble dx;
+        gdouble dy;
+        gdouble dpins = 0.0;
+        gboolean saved_verbose = verbose;
+        gint result;
+        gint i;
+
+        if (ipc7351_busy || !footprint_name || (footprint_name[0] != '?'))
+        {
+                return (EXIT_FAILURE);
+        }
+        family = ipc7351_find_family (type);
+        if (ipc7351_decode_name (type, footprint_name + 1, &decoded) == EXIT_FAILURE)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* The caller may be walking the packages list, build a list of
+         * our own. */
+        saved_packages_list = packages_list;
+        packages_list = NULL;
+        family->create_packages_list ();
+        for (names = packages_list; names; names = g_list_next (names))
+        {
+                if (ipc7351_decode_name (type, names->data, &template) == EXIT_FAILURE)
+                {
+                        continue;
+                }
+                score = ipc7351_score_template (family, &decoded, &template);
+                if ((score >= 0.0) && ((best_score < 0.0) || (score < best_score)))
+                {
+                        best_score = score;
+                        best_name = names->data;
+                        best_template = template;
+                }
+        }
+        g_list_free (packages_list);
+        packages_list = saved_packages_list;
+        if (!best_name)
+        {
+                return (EXIT_FAILURE);
+        }
+        /* A grid with missing pins takes its pin/pad exceptions from a
+         * predefined package with the same grid and number of pins, there
+         * is no other way to tell which pins are missing. */
+        if ((family->pins == IPC7351_PINS_GRID) &&
+                (decoded.pins != (decoded.columns * decoded.rows)) &&
+                ((decoded.pins != best_template.pins) ||
+                (decoded.columns != best_template.columns) ||
+                (decoded.rows != best_template.rows)))
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("%s: the pin/pad exceptions can not be derived from the footprint name.")),
+                                footprint_name + 1);
+                }
+                return (EXIT_FAILURE);
+        }
+        /* Load the predefined package quietly, its messages are not
+         * about this footprint. */
+        name = footprint_name;
+        footprint_name = g_strconcat ("?", best_name, NULL);
+        ipc7351_busy = TRUE;
+        verbose = FALSE;
+        result = family->get_default_footprint_values ();
+        verbose = saved_verbose;
+        ipc7351_busy = FALSE;
+        if (result == EXIT_FAILURE)
+        {
+                g_free (footprint_name);
+                footprint_name = name;
+                return (EXIT_FAILURE);
+        }
+        /* Shift from the actual body of the predefined package, its
+         * name is rounded. */
+        dx = decoded.x - (family->x ? *family->x : best_template.x);
+        dy = decoded.y - (family->y ? *family->y : best_template.y);
+        for (i = 0; family->x_relative[i]; i++)
+        {
+                if (*family->x_relative[i] != 0.0)
+                {
+                        *family->x_relative[i] += dx;
+                }
+        }
+        for (i = 0; family->y_relative[i]; i++)
+        {
+                if (*family->y_relative[i] != 0.0)
+                {
+                        *family->y_relative[i] += dy;
+                }
+        }
+        switch (family->pins)
+        {
+                case IPC7351_PINS_GRID:
+                        if (decoded.pins == (decoded.columns * decoded.rows))
+                        {
+                                pin_pad_exceptions_string = g_strdup ("");
+                        }
+                        number_of_columns = decoded.columns;
+                        number_of_rows = decoded.rows;
+                        break;
+                case IPC7351_PINS_DUAL:
+                        dpins = (decoded.pins - best_template.pins) / 2;
+                        number_of_rows = decoded.pins / 2;
+                        count_y = decoded.pins / 2;
+                        break;
+                case IPC7351_PINS_QUAD:
+                        count_x = decoded.pins / 4;
+                        count_y = decoded.pins / 4;
+                        thermal = ((decoded.pins % 4) == 1);
+                        break;
+                default:
+                        break;
+        }
+        for (i = 0; family->pins_relative[i]; i++)
+        {
+                if (*family->pins_relative[i] != 0.0)
+                {
+                        *family->pins_relative[i] += dpins * decoded.pitch;
+                }
+        }
+        for (i = 0; i < G_N_ELEMENTS (family->pitch); i++)
+        {
+                if (family->pitch[i])
+                {
+                        *family->pitch[i] = decoded.pitch;
+                }
+        }
+        if (family->x)
+        {
+                *family->x = decoded.x;
+        }
+        if (family->y)
+        {
+                *family->y = decoded.y;
+        }
+        package_body_height = decoded.height;
+        number_of_pins = decoded.pins;
+        g_free (footprint_name);
+        footprint_name = g_strdup (name + 1);
+        g_free (name);
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        (_("%s: values derived from the footprint name, other values taken from %s.")),
+                        footprint_name, best_name);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
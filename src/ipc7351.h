@@ -0,0 +1,137 @@
+/*!
+ * \file src/ipc7351.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for the IPC-7351 footprint name decoder.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __IPC7351_INCLUDED__
+#define __IPC7351_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief How the pins of a package family follow from the footprint
+ * name.
+ */
+typedef enum ipc7351_pins
+{
+        IPC7351_PINS_TWO, /*!< Two pins, a chip package. */
+        IPC7351_PINS_GRID, /*!< Pins, columns and rows in the name. */
+        IPC7351_PINS_DUAL, /*!< Half of the pins on each of two sides. */
+        IPC7351_PINS_QUAD, /*!< A quarter of the pins on each of four
+                                * sides, an odd pin is a thermal pad. */
+        IPC7351_PINS_TEMPLATE /*!< The pin layout can not be derived, a
+                                * predefined package with the same number
+                                * of pins is required. */
+} ipc7351_pins_t;
+
+/*!
+ * \brief The values encoded in an IPC-7351 footprint name.
+ *
+ * All dimensions are in mm.
+ */
+typedef struct ipc7351_name
+{
+        gint pins;
+                /*!< : is the number of pins.*/
+        gint columns;
+                /*!< : is the number of columns of a grid array.*/
+        gint rows;
+                /*!< : is the number of rows of a grid array.*/
+        gdouble pitch;
+                /*!< : is the pitch.*/
+        gdouble x;
+                /*!< : is the body length or the lead span in the
+                 * X-direction.*/
+        gdouble y;
+                /*!< : is the body width or the lead span in the
+                 * Y-direction.*/
+        gdouble height;
+                /*!< : is the body height.*/
+        gchar variant;
+                /*!< : is the letter between the number of pins and the
+                 * pitch, like the "C" (collapsing balls) of a BGA.*/
+        gchar suffix[4];
+                /*!< : are the trailing letters, like the "AN" of
+                 * "CAPC2012X100AN".*/
+} ipc7351_name_t;
+
+/*!
+ * \brief A package family with IPC-7351 footprint names.
+ *
+ * The \c pattern describes the name with literal characters and
+ * conversions:
+ * - "%n" is the number of pins,
+ * - "%c" and "%r" are the number of columns and rows,
+ * - "%v" is a single variant letter,
+ * - "%p", "%x", "%y" and "%h" are the pitch, the X and Y dimensions
+ *   and the height in 1/100 mm,
+ * - "%l" and "%w" are the X and Y dimensions of a chip package in
+ *   1/10 mm, two digits each.
+ *
+ * After the pattern only a suffix of a density level letter (L, M or
+ * N), optionally preceded by a single letter like the "A" of "AN", is
+ * accepted.
+ */
+typedef struct ipc7351_family
+{
+        package_t type;
+                /*!< : is the package type.*/
+        gchar *pattern;
+                /*!< : is the pattern of the footprint names.*/
+        ipc7351_pins_t pins;
+                /*!< : is how the pins follow from the name.*/
+        gdouble *pitch[2];
+                /*!< : are the global variables set to the pitch.*/
+        gdouble *x;
+                /*!< : is the global variable set to the X dimension,
+                 * \c NULL when the X dimension is a lead span.*/
+        gdouble *y;
+                /*!< : is the global variable set to the Y dimension,
+                 * \c NULL when the Y dimension is a lead span.*/
+        gdouble *x_relative[5];
+                /*!< : are the global variables which keep their distance
+                 * to the X dimension.*/
+        gdouble *y_relative[5];
+                /*!< : are the global variables which keep their distance
+                 * to the Y dimension.*/
+        gdouble *pins_relative[4];
+                /*!< : are the global variables which grow with one pitch
+                 * per pin on a side.*/
+        int (*create_packages_list) ();
+                /*!< : is the function creating the list of predefined
+                 * packages.*/
+        int (*get_default_footprint_values) ();
+                /*!< : is the function looking up the values of a
+                 * predefined package.*/
+} ipc7351_family_t;
+
+
+int ipc7351_decode_name (package_t type, const gchar *name, ipc7351_name_t *decoded);
+int ipc7351_get_default_footprint_values (package_t type);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __IPC7351_INCLUDED__ */
+
+
+/* EOF */
@@ -49,6 +49,105 @@
 #include "globals.h"
 #include "pcb_globals.h"
 #include "libfpw.h"
+#include "cache.h"
+#include "stats.h"
+
+/* The DRC and write functions of the packages for generate_footprint (),
+ * the packages themselves are included after libfpw.c. */
+#include "bga.h"
+#include "capa.h"
+#include "capad.h"
+#include "capc.h"
+#include "capm.h"
+#include "capmp.h"
+#include "cappr.h"
+#include "con_dil.h"
+#include "con_dip.h"
+#include "con_hdr.h"
+#include "con_sil.h"
+#include "dioad.h"
+#include "diom.h"
+#include "diomelf.h"
+#include "dip.h"
+#include "dips.h"
+#include "hdrv.h"
+#include "indad.h"
+#include "indc.h"
+#include "indm.h"
+#include "indp.h"
+#include "jump.h"
+#include "mtgnp.h"
+#include "mtgp.h"
+#include "pga.h"
+#include "plcc.h"
+#include "qfn.h"
+#include "qfp.h"
+#include "res.h"
+#include "resad.h"
+#include "resar.h"
+#include "resc.h"
+#include "resm.h"
+#include "resmelf.h"
+#include "sil.h"
+#include "sip.h"
+#include "so.h"
+#include "sot.h"
+#include "to.h"
+
+
+/*!
+ * \brief The span of writing the footprint text, from
+ * open_footprint_file () to close_footprint_file ().
+ */
+static stats_span_t footprint_write_span;
+
+
+/*!
+ * \brief Close the footprint file \c fp opened with
+ * open_footprint_file ().
+ *
+ * A \c footprint_output stream is flushed, not closed, it is owned by
+ * whoever set it.\n
+ * A footprint file is renamed from its temporary filename to
+ * \c footprint_filename, so the footprint file is never seen half
+ * written.\n
+ * The file is not synced to disk here, a build syncs a whole batch of
+ * footprints at once with build_sync ().\n
+ * When writing failed the temporary file is removed and a previous
+ * footprint file is left as it was.
+ *
+ * \return \c EXIT_SUCCESS when the footprint was written,
+ * \c EXIT_FAILURE when there is no open footprint file or writing
+ * failed.
+ */
+int
+close_footprint_file ()
+{
+        gint result;
+
+        if (!fp)
+        {
+                return (EXIT_FAILURE);
+        }
+        if (fp == footprint_output)
+        {
+                result = fflush (fp);
+        }
+        else
+        {
+                result = fclose (fp);
+                result = result || rename (footprint_temporary_filename, footprint_filename);
+                if (result)
+                {
+                        unlink (footprint_temporary_filename);
+                }
+                g_free (footprint_temporary_filename);
+                footprint_temporary_filename = NULL;
+        }
+        fp = NULL;
+        stats_end (&footprint_write_span, STATS_WRITE);
+        return (result ? EXIT_FAILURE : EXIT_SUCCESS);
+}
 
 
 /*!
@@ -71,8 +170,13 @@ create_attributes_in_element
         create_new_attribute (&element->Attributes, "author", g_strdup_printf ("%s", footprint_author));
         create_new_attribute (&element->Attributes, "dist-license", g_strdup_printf ("%s", footprint_dist_license));
         create_new_attribute (&element->Attributes, "use-license", g_strdup_printf ("%s", footprint_use_license));
-        create_new_attribute (&element->Attributes, "status\" \"%s\")\n", footprint_status);
+        create_new_attribute (&element->Attributes, "status", g_strdup_printf ("%s", footprint_status));
         create_new_attribute (&element->Attributes, "attributes in footprint", g_strdup_printf ("%d", (int) attributes_in_footprint));
+        create_new_attribute (&element->Attributes, "footprint type", g_strdup_printf ("%s", footprint_type));
+        create_new_attribute (&element->Attributes, "footprint name", g_strdup_printf ("%s", footprint_name));
+        create_new_attribute (&element->Attributes, "footprint units", g_strdup_printf ("%s", footprint_units));
+        create_new_attribute (&element->Attributes, "footprint refdes", g_strdup_printf ("%s", footprint_refdes));
+        create_new_attribute (&element->Attributes, "footprint value", g_strdup_printf ("%s", footprint_value));
         create_new_attribute (&element->Attributes, "package body length", g_strdup_printf ("%f", package_body_length));
         create_new_attribute (&element->Attributes, "package body width", g_strdup_printf ("%f", package_body_width));
         create_new_attribute (&element->Attributes, "package height", g_strdup_printf ("%f", package_body_height));
@@ -83,7 +187,7 @@ create_attributes_in_element
         create_new_attribute (&element->Attributes, "pitch_x", g_strdup_printf ("%f", pitch_x));
         create_new_attribute (&element->Attributes, "pitch_y", g_strdup_printf ("%f", pitch_y));
         create_new_attribute (&element->Attributes, "count_x", g_strdup_printf ("%d", (int) count_x));
-        create_new_attribute (&element->Attributes, "count_x", g_strdup_printf ("%d", (int) count_y));
+        create_new_attribute (&element->Attributes, "count_y", g_strdup_printf ("%d", (int) count_y));
         create_new_attribute (&element->Attributes, "pad_shape", g_strdup_printf ("%s", pad_shape));
         create_new_attribute (&element->Attributes, "pin_pad_exceptions", g_strdup_printf ("%s", pin_pad_exceptions_string));
         create_new_attribute (&element->Attributes, "pin_1_position", g_strdup_printf ("%s", pin_1_position));
@@ -118,9 +222,218 @@ create_attributes_in_element
 }
 
 
+/*!
+ * \brief Create the pins and/or pads of a grid array in the \c element.
+ *
+ * The grid is centered around the origin of the \c element, with the
+ * first row on top and the first column on the left.\n
+ * For every grid position a pin is created from the \c pin template
+ * and/or a pad is created from the \c pad template, the pad end points
+ * of the template are relative to the grid position.\n
+ * The column positions are determined once, every position is rounded
+ * on its own with units_to_coord (), so the rounding of the pitch does
+ * not add up towards the outer rows and columns.\n
+ * Grid positions flagged in the \c exceptions bitmap are skipped, but
+ * do consume a pin/pad number.
+ *
+ * \return \c EXIT_SUCCESS when the grid array was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+create_grid_array
+(
+        ElementTypePtr element,
+                /*!< : the \c element to add the pins/pads to.*/
+        gint rows,
+                /*!< : the number of rows.*/
+        gint columns,
+                /*!< : the number of columns.*/
+        gdouble pitch_x,
+                /*!< : the pitch between columns in footprint units.*/
+        gdouble pitch_y,
+                /*!< : the pitch between rows in footprint units.*/
+        grid_naming_t naming,
+                /*!< : the naming scheme for the pins/pads.*/
+        gboolean *exceptions,
+                /*!< : a bitmap with \c rows times \c columns entries, a
+                 * \c TRUE entry skips the grid position, may be \c NULL.*/
+        gboolean pin1_is_square,
+                /*!< : create pin/pad #1 with a square shape.*/
+        PinTypePtr pin,
+                /*!< : the template for the pins, may be \c NULL.*/
+        PadTypePtr pad
+                /*!< : the template for the pads, may be \c NULL.*/
+)
+{
+        LocationType *x;
+        LocationType y;
+        GList *pins;
+        GList *pads;
+        GList *new_pins = NULL;
+        GList *new_pads = NULL;
+        FlagType flags;
+        gchar name[16];
+        gchar number[16];
+        gint pin_number;
+        gint i;
+        gint j;
+
+        if (!element)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        (_("[%s] no valid element to create a grid array in.")),
+                        footprint_type);
+                return (EXIT_FAILURE);
+        }
+        if ((rows < 1) || (columns < 1))
+        {
+                return (EXIT_SUCCESS);
+        }
+        if ((naming == ROW_LETTERS) && (rows > (gint) G_N_ELEMENTS (row_letters)))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        (_("[%s] number of rows (%d) exceeds the number of row letters (%d).")),
+                        footprint_type, rows, (gint) G_N_ELEMENTS (row_letters));
+                return (EXIT_FAILURE);
+        }
+        /* Determine the column positions once, they are the same for
+         * every row. */
+        x = g_new (LocationType, columns);
+        for (j = 0; j < columns; j++)
+        {
+                x[j] = units_to_coord ((j - ((columns - 1) / 2.0)) * pitch_x);
+        }
+        /* create_new_pin () and create_new_pad () append to the lists of
+         * the element, which walks the whole list for every object.
+         * Collect the new objects in reversed order and append them in
+         * one go when done. */
+        pins = element->Pin;
+        pads = element->Pad;
+        element->Pin = NULL;
+        element->Pad = NULL;
+        name[0] = '\0';
+        for (i = 0; i < rows; i++)
+        {
+                y = units_to_coord ((i - ((rows - 1) / 2.0)) * pitch_y);
+                for (j = 0; j < columns; j++)
+                {
+                        if (exceptions && exceptions[i * columns + j])
+                        {
+                                continue;
+                        }
+                        switch (naming)
+                        {
+                                case ROW_LETTERS:
+                                        g_snprintf (name, sizeof (name), "%s%d", row_letters[i], j + 1);
+                                        pin_number = i * columns + j + 1;
+                                        break;
+                                case ODD_EVEN:
+                                        pin_number = j * rows + i + 1;
+                                        break;
+                                case SEQUENTIAL:
+                                default:
+                                        pin_number = i * columns + j + 1;
+                                        break;
+                        }
+                        g_snprintf (number, sizeof (number), "%d", pin_number);
+                        if (pin)
+                        {
+                                flags = pin->Flags;
+                                if (pin1_is_square && (pin_number == 1))
+                                {
+                                        flags.f |= SQUARE;
+                                }
+                                create_new_pin
+                                (
+                                        element,
+                                        x[j], /* x-coordinate */
+                                        y, /* y-coordinate */
+                                        pin->Thickness, /* width of the annulus ring (pad) */
+                                        pin->Clearance, /* clearance */
+                                        pin->Mask, /* solder mask clearance */
+                                        pin->DrillingHole, /* pin drill diameter */
+                                        name, /* pin name */
+                                        number, /* pin number */
+                                        flags /* flags */
+                                );
+                                new_pins = g_list_concat (element->Pin, new_pins);
+                                element->Pin = NULL;
+                        }
+                        if (pad)
+                        {
+                                flags = pad->Flags;
+                                if (pin1_is_square && (pin_number == 1))
+                                {
+                                        flags.f |= SQUARE;
+                                }
+                                create_new_pad
+                                (
+                                        element,
+                                        x[j] + pad->Point1.X, /* x0 coordinate */
+                                        y + pad->Point1.Y, /* y0-coordinate */
+                                        x[j] + pad->Point2.X, /* x1 coordinate */
+                                        y + pad->Point2.Y, /* y1-coordinate */
+                                        pad->Thickness, /* pad width */
+                                        pad->Clearance, /* clearance */
+                                        pad->Mask, /* solder mask clearance */
+                                        name, /* pad name */
+                                        number, /* pad number */
+                                        flags /* flags */
+                                );
+                                new_pads = g_list_concat (element->Pad, new_pads);
+                                element->Pad = NULL;
+                        }
+                }
+        }
+        element->Pin = g_list_concat (pins, g_list_reverse (new_pins));
+        element->Pad = g_list_concat (pads, g_list_reverse (new_pads));
+        g_free (x);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Grow the \c BoundingBox of an \c element with the
+ * \c BoundingBox of a newly added object.
+ *
+ * The \c BoundingBox of the \c element is maintained incrementally, so
+ * callers (courtyard, preview, DRC) can read the extents of the
+ * \c element without walking all the pins, pads, lines and arcs.\n
+ * This function has to be called before the object counter of the
+ * \c element is incremented, the first object initialises the
+ * \c BoundingBox.
+ *
+ * \return \c EXIT_SUCCESS when the function is completed.
+ */
+static int
+element_bounding_box_add
+(
+        ElementTypePtr element,
+                /*!< : the \c element to grow the \c BoundingBox of.*/
+        BoxTypePtr box
+                /*!< : the \c BoundingBox of the added object.*/
+)
+{
+        if ((element->PinN + element->PadN + element->LineN + element->ArcN) == 0)
+        {
+                element->BoundingBox = *box;
+                return (EXIT_SUCCESS);
+        }
+        element->BoundingBox.X1 = MIN (element->BoundingBox.X1, box->X1);
+        element->BoundingBox.Y1 = MIN (element->BoundingBox.Y1, box->Y1);
+        element->BoundingBox.X2 = MAX (element->BoundingBox.X2, box->X2);
+        element->BoundingBox.Y2 = MAX (element->BoundingBox.Y2, box->Y2);
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Creates a new \c arc entity in the \c element.
  *
+ * The \c BoundingBox of the \c arc is taken from the full ellipse
+ * (including half the line thickness), which is conservative for arcs
+ * with a sweep of less than 360 degrees.
+ *
  * \todo Check all existing \c Arc entities in the \c element to avoid
  * duplication.
  *
@@ -147,24 +460,9 @@ create_new_arc
                 /*!< : line thickness.*/
 {
         ArcTypePtr arc;
-        /* Reallocate new memory if necessary and clear it. */
-        if (element->ArcN >= element->ArcMax)
-        {
-                element->ArcMax += 5;
-                size_t size = element->ArcMax * sizeof (ArcType);
-                if (size == 0)
-                {
-                        size = 1;
-                }
-                void *p;
-                p = arc ? realloc (arc, size) : malloc (size);
-                if (!p)
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("out of memory during realloc() in create_new_arc()."));
-                arc = realloc (arc, element->ArcMax * sizeof (ArcType));
-                element->Arc = arc;
-                memset ((arc + element->ArcN), 0, (5 * sizeof (ArcType)));
-        }
+
+        arc = g_new0 (ArcType, 1);
+        stats_count (STATS_ALLOCATIONS, 1);
         /* Set Delta (0,360], StartAngle in [0,360). */
         if ((delta = delta % 360) == 0)
                 delta = 360;
@@ -176,7 +474,6 @@ create_new_arc
         if ((angle = angle % 360) < 0)
                 angle += 360;
         /* copy values */
-        arc = arc + element->ArcN++;
         arc->X = X;
         arc->Y = Y;
         arc->Width = width;
@@ -185,6 +482,14 @@ create_new_arc
         arc->Delta = delta;
         arc->Thickness = thickness;
         arc->ID = ID++;
+        /* Determine the bounding box of the arc. */
+        arc->BoundingBox.X1 = X - width - (thickness / 2);
+        arc->BoundingBox.Y1 = Y - height - (thickness / 2);
+        arc->BoundingBox.X2 = X + width + (thickness / 2);
+        arc->BoundingBox.Y2 = Y + height + (thickness / 2);
+        element_bounding_box_add (element, &arc->BoundingBox);
+        element->Arc = g_list_append (element->Arc, arc);
+        element->ArcN++;
         return (arc);
 }
 
@@ -211,17 +516,9 @@ create_new_attribute
         if (list->Number >= list->Max)
         {
                 list->Max += 10;
-                size_t size = list->Max * sizeof (AttributeType);
-                if (size == 0)
-                {
-                        size = 1;
-                }
-                void *p;
-                p = list->List ? realloc (list, size) : malloc (size);
-                if (!p)
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("out of memory during realloc() in create_new_attribute()."));
+                list->List = g_renew (AttributeType, list->List, list->Max);
         }
+        stats_count (STATS_ALLOCATIONS, 1);
         list->List[list->Number].name = g_strdup (name);
         list->List[list->Number].value = g_strdup (value);
         list->Number++;
@@ -229,6 +526,27 @@ create_new_attribute
 }
 
 
+/*!
+ * \brief Creates a new \c element.
+ *
+ * All counters, lists and boxes of the \c element are cleared, the
+ * \c BoundingBox of the \c element is updated by the create_new_*
+ * functions whenever an object is added.
+ *
+ * \return a newly created \c element.
+ */
+ElementTypePtr
+create_new_element ()
+{
+        ElementTypePtr element;
+
+        element = g_new0 (ElementType, 1);
+        stats_count (STATS_ALLOCATIONS, 1);
+        element->ID = ID++;
+        return (element);
+}
+
+
 /*!
  * \brief Creates a new \c Line in an \c Element.
  *
@@ -254,27 +572,17 @@ create_new_line
                 /*!< : the line thickness.*/
 {
         LineTypePtr line;
+
+        /* If thickness is 0 do not create a line. */
         if (thickness == 0)
                 return (NULL);
-        /* Reallocate new memory if necessary and clear it. */
-        if (element->LineN >= element->LineMax)
-        {
-                element->LineMax += 10;
-                size_t size = element->LineMax * sizeof (LineType);
-                if (size == 0)
-                {
-                        size = 1;
-                }
-                void *p;
-                p = line ? realloc (line, size) : malloc (size);
-                if (!p)
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("out of memory during realloc() in create_new_line()."));
-                element->Line = line;
-                memset ((line + element->LineN), 0, (10 * sizeof (LineType)));
-        }
+        /* If thickness is < 0 a line with a thickness of 1/100 of
+         * a mil is created (#define THIN_DRAW 1). */
+        if (thickness < 0)
+                thickness = THIN_DRAW;
+        line = g_new0 (LineType, 1);
+        stats_count (STATS_ALLOCATIONS, 1);
         /* copy values */
-        line = line + element->LineN++;
         line->Point1.X = X1;
         line->Point1.Y = Y1;
         line->Point2.X = X2;
@@ -282,6 +590,15 @@ create_new_line
         line->Thickness = thickness;
 //        line->Flags = NoFlags ();
         line->ID = ID++;
+        /* Determine the bounding box of the line, including the round
+         * caps at both ends. */
+        line->BoundingBox.X1 = MIN (X1, X2) - (thickness / 2);
+        line->BoundingBox.Y1 = MIN (Y1, Y2) - (thickness / 2);
+        line->BoundingBox.X2 = MAX (X1, X2) + (thickness / 2);
+        line->BoundingBox.Y2 = MAX (Y1, Y2) + (thickness / 2);
+        element_bounding_box_add (element, &line->BoundingBox);
+        element->Line = g_list_append (element->Line, line);
+        element->LineN++;
         return (line);
 }
 
@@ -289,6 +606,9 @@ create_new_line
 /*!
  * \brief Creates a new \c pad in an \c element.
  *
+ * The \c BoundingBox of the \c pad encloses the copper and the solder
+ * mask opening, whichever is the largest.
+ *
  * \todo Check all existing \c Pad entities in the \c element to avoid
  * duplication.
  *
@@ -335,6 +655,10 @@ create_new_pad
 )
 {
         PadTypePtr pad;
+        BDimension half_width;
+
+        pad = g_new0 (PadType, 1);
+        stats_count (STATS_ALLOCATIONS, 1);
         /* copy values */
         if (X1 > X2 || (X1 == X2 && Y1 > Y2))
         {
@@ -358,6 +682,15 @@ create_new_pad
         pad->Flags = flags;
         pad->ID = ID++;
         pad->Element = element;
+        /* Determine the bounding box of the pad. */
+        half_width = MAX (thickness, mask) / 2;
+        pad->BoundingBox.X1 = MIN (X1, X2) - half_width;
+        pad->BoundingBox.Y1 = MIN (Y1, Y2) - half_width;
+        pad->BoundingBox.X2 = MAX (X1, X2) + half_width;
+        pad->BoundingBox.Y2 = MAX (Y1, Y2) + half_width;
+        element_bounding_box_add (element, &pad->BoundingBox);
+        element->Pad = g_list_append (element->Pad, pad);
+        element->PadN++;
         return (pad);
 }
 
@@ -365,6 +698,9 @@ create_new_pad
 /*!
  * \brief Creates a new pin in an element.
  *
+ * The \c BoundingBox of the \c pin encloses the annulus and the solder
+ * mask opening, whichever is the largest.
+ *
  * \todo Check all existing \c Pin entities in the \c element to avoid
  * duplication.
  *
@@ -409,6 +745,10 @@ create_new_pin
 )
 {
         PinTypePtr pin;
+        BDimension half_width;
+
+        pin = g_new0 (PinType, 1);
+        stats_count (STATS_ALLOCATIONS, 1);
         /* copy values */
         pin->X = X;
         pin->Y = Y;
@@ -421,10 +761,285 @@ create_new_pin
         pin->Flags = flags;
         pin->ID = ID++;
         pin->Element = element;
+        /* Determine the bounding box of the pin, an unplated hole may be
+         * larger than the (absent) annulus. */
+        half_width = MAX (MAX (thickness, mask), drillinghole) / 2;
+        pin->BoundingBox.X1 = X - half_width;
+        pin->BoundingBox.Y1 = Y - half_width;
+        pin->BoundingBox.X2 = X + half_width;
+        pin->BoundingBox.Y2 = Y + half_width;
+        element_bounding_box_add (element, &pin->BoundingBox);
+        element->Pin = g_list_append (element->Pin, pin);
+        element->PinN++;
         return (pin);
 }
 
 
+/*!
+ * \brief Create the pads of a perimeter array in the \c element.
+ *
+ * The pads are placed on four sides around the origin of the
+ * \c element: \c count_y pads on the left side and on the right side,
+ * and \c count_x pads on the top side and on the bottom side.\n
+ * Pads are numbered counter clockwise, starting at the top of the left
+ * side for \c UPPER_LEFT (QFP, QFN, SO), or at the middle of the top
+ * side for \c UPPER_MIDDLE (PLCC).\n
+ * The pad template supplies the width (\c Thickness), clearance, solder
+ * mask clearance and flags, the pads are oriented perpendicular to their
+ * side of the package.\n
+ * Pad numbers flagged in the \c exceptions bitmap (by pad number - 1)
+ * are skipped, but do consume a pad number, this way corner pads can be
+ * excluded.\n
+ * When \c thermal is set, a centered thermal pad is created from the
+ * thermal pad variables with the next free pad number.
+ *
+ * \return \c EXIT_SUCCESS when the perimeter array was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+create_perimeter_array
+(
+        ElementTypePtr element,
+                /*!< : the \c element to add the pads to.*/
+        gint count_x,
+                /*!< : the number of pads on the top and on the bottom side.*/
+        gint count_y,
+                /*!< : the number of pads on the left and on the right side.*/
+        gdouble pitch_x,
+                /*!< : the pitch between pads on the top and bottom side in
+                 * footprint units.*/
+        gdouble pitch_y,
+                /*!< : the pitch between pads on the left and right side in
+                 * footprint units.*/
+        gdouble row_distance,
+                /*!< : the center-center distance between the top and the
+                 * bottom pad rows in footprint units.*/
+        gdouble column_distance,
+                /*!< : the center-center distance between the left and the
+                 * right pad columns in footprint units.*/
+        LocationType length,
+                /*!< : the length of the pads in mil/100.*/
+        location_t pin1_location,
+                /*!< : the location of pad #1.*/
+        gboolean *exceptions,
+                /*!< : a bitmap with an entry for every pad number, a
+                 * \c TRUE entry skips the pad, may be \c NULL.*/
+        gboolean pin1_is_square,
+                /*!< : create pad #1 with a square shape.*/
+        gboolean thermal_pad,
+                /*!< : create a thermal pad.*/
+        PadTypePtr pad
+                /*!< : the template for the pads.*/
+)
+{
+        GList *pads;
+        GList *new_pads = NULL;
+        FlagType flags;
+        LocationType x;
+        LocationType y;
+        LocationType dx;
+        LocationType dy;
+        LocationType half_length;
+        LocationType thermal_size;
+        gchar number[16];
+        gint total;
+        gint start;
+        gint pin_number;
+        gint k;
+
+        if (!element || !pad)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        (_("[%s] no valid element or pad template to create a perimeter array.")),
+                        footprint_type);
+                return (EXIT_FAILURE);
+        }
+        if ((count_x < 0) || (count_y < 0))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        (_("[%s] negative number of pads for a perimeter array.")),
+                        footprint_type);
+                return (EXIT_FAILURE);
+        }
+        total = 2 * (count_x + count_y);
+        /* The pads are walked counter clockwise from the top of the left
+         * side, pad #1 determines where the numbering starts. */
+        switch (pin1_location)
+        {
+                case UPPER_MIDDLE:
+                        start = (count_x > 0) ? (2 * count_y) + count_x + ((count_x - 1) / 2) : 0;
+                        break;
+                case UPPER_LEFT:
+                case LEFT_TOP:
+                default:
+                        start = 0;
+                        break;
+        }
+        /* A line pad of the pad width, long enough to cover the pad
+         * length. */
+        half_length = MAX (0, length - pad->Thickness) / 2;
+        /* create_new_pad () appends to the list of the element, which walks
+         * the whole list for every pad.
+         * Collect the new pads in reversed order and append them in one go
+         * when done. */
+        pads = element->Pad;
+        element->Pad = NULL;
+        for (pin_number = 1; pin_number <= total; pin_number++)
+        {
+                if (exceptions && exceptions[pin_number - 1])
+                {
+                        continue;
+                }
+                /* Determine the position on the perimeter, every position
+                 * is rounded on its own, so the rounding of the pitch does
+                 * not add up towards the corners. */
+                k = (start + pin_number - 1) % total;
+                if (k < count_y)
+                {
+                        /* Left side, from top to bottom. */
+                        x = units_to_coord (-column_distance / 2.0);
+                        y = units_to_coord ((k - ((count_y - 1) / 2.0)) * pitch_y);
+                        dx = half_length;
+                        dy = 0;
+                }
+                else if (k < (count_y + count_x))
+                {
+                        /* Bottom side, from left to right. */
+                        k -= count_y;
+                        x = units_to_coord ((k - ((count_x - 1) / 2.0)) * pitch_x);
+                        y = units_to_coord (row_distance / 2.0);
+                        dx = 0;
+                        dy = half_length;
+                }
+                else if (k < ((2 * count_y) + count_x))
+                {
+                        /* Right side, from bottom to top. */
+                        k -= count_y + count_x;
+                        x = units_to_coord (column_distance / 2.0);
+                        y = units_to_coord ((((count_y - 1) / 2.0) - k) * pitch_y);
+                        dx = half_length;
+                        dy = 0;
+                }
+                else
+                {
+                        /* Top side, from right to left. */
+                        k -= (2 * count_y) + count_x;
+                        x = units_to_coord ((((count_x - 1) / 2.0) - k) * pitch_x);
+                        y = units_to_coord (-row_distance / 2.0);
+                        dx = 0;
+                        dy = half_length;
+                }
+                flags = pad->Flags;
+                if (pin1_is_square && (pin_number == 1))
+                {
+                        flags.f |= SQUARE;
+                }
+                g_snprintf (number, sizeof (number), "%d", pin_number);
+                create_new_pad
+                (
+                        element,
+                        x - dx, /* x0 coordinate */
+                        y - dy, /* y0-coordinate */
+                        x + dx, /* x1 coordinate */
+                        y + dy, /* y1-coordinate */
+                        pad->Thickness, /* pad width */
+                        pad->Clearance, /* clearance */
+                        pad->Mask, /* solder mask clearance */
+                        "", /* pad name */
+                        number, /* pad number */
+                        flags /* flags */
+                );
+                new_pads = g_list_concat (element->Pad, new_pads);
+                element->Pad = NULL;
+        }
+        element->Pad = g_list_concat (pads, g_list_reverse (new_pads));
+        /* Create a centered thermal pad with the next free pad number. */
+        if (thermal_pad)
+        {
+                thermal_size = units_to_coord (MIN (thermal_length, thermal_width));
+                dx = MAX (0, units_to_coord (thermal_length) - thermal_size) / 2;
+                dy = MAX (0, units_to_coord (thermal_width) - thermal_size) / 2;
+                flags.f = SQUARE;
+                if (thermal_nopaste)
+                {
+                        flags.f |= NOPASTE;
+                }
+                g_snprintf (number, sizeof (number), "%d", total + 1);
+                create_new_pad
+                (
+                        element,
+                        -dx, /* x0 coordinate */
+                        -dy, /* y0-coordinate */
+                        dx, /* x1 coordinate */
+                        dy, /* y1-coordinate */
+                        thermal_size, /* pad width */
+                        units_to_coord (thermal_clearance), /* clearance */
+                        thermal_size + units_to_coord (2 * thermal_solder_mask_clearance), /* solder mask clearance */
+                        "", /* pad name */
+                        number, /* pad number */
+                        flags /* flags */
+                );
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free an \c element and all the objects it contains.
+ *
+ * Passing a \c NULL pointer is allowed, nothing is done in that case.
+ *
+ * \return \c EXIT_SUCCESS when the function is completed.
+ */
+int
+free_element
+(
+        ElementTypePtr element
+                /*!< : the \c element to free.*/
+)
+{
+        GList *iter;
+        gint i;
+
+        if (!element)
+                return (EXIT_SUCCESS);
+        for (iter = element->Pin; iter != NULL; iter = g_list_next (iter))
+        {
+                PinTypePtr pin = (PinTypePtr) iter->data;
+                g_free (pin->Name);
+                g_free (pin->Number);
+                g_free (pin);
+        }
+        g_list_free (element->Pin);
+        for (iter = element->Pad; iter != NULL; iter = g_list_next (iter))
+        {
+                PadTypePtr pad = (PadTypePtr) iter->data;
+                g_free (pad->Name);
+                g_free (pad->Number);
+                g_free (pad);
+        }
+        g_list_free (element->Pad);
+        for (iter = element->Line; iter != NULL; iter = g_list_next (iter))
+        {
+                g_free (iter->data);
+        }
+        g_list_free (element->Line);
+        for (iter = element->Arc; iter != NULL; iter = g_list_next (iter))
+        {
+                g_free (iter->data);
+        }
+        g_list_free (element->Arc);
+        for (i = 0; i < element->Attributes.Number; i++)
+        {
+                g_free (element->Attributes.List[i].name);
+                g_free (element->Attributes.List[i].value);
+        }
+        g_free (element->Attributes.List);
+        g_free (element);
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Determine the package type.
  *
@@ -434,6 +1049,9 @@ create_new_pin
 int
 get_package_type ()
 {
+        stats_span_t span;
+
+        stats_begin (&span);
         /* Determine the package type */
         if (!footprint_type)
         {
@@ -556,18 +1174,10 @@ get_package_type ()
         else if (!strcmp (footprint_type, "QFN"))
         {
                 package_type = QFN;
-                g_log ("", G_LOG_LEVEL_CRITICAL,
-                        _("footprint type %s not yet implemented."),
-                        footprint_type);
-                return (EXIT_FAILURE);
         }
         else if (!strcmp (footprint_type, "QFP"))
         {
                 package_type = QFP;
-                g_log ("", G_LOG_LEVEL_CRITICAL,
-                        _("footprint type %s not yet implemented."),
-                        footprint_type);
-                return (EXIT_FAILURE);
         }
         else if (!strcmp (footprint_type, "RES"))
         {
@@ -596,10 +1206,6 @@ get_package_type ()
         else if (!strcmp (footprint_type, "SO"))
         {
                 package_type = SO;
-                g_log ("", G_LOG_LEVEL_CRITICAL,
-                        _("footprint type %s not yet implemented."),
-                        footprint_type);
-                return (EXIT_FAILURE);
         }
         else if (!strcmp (footprint_type, "SOT"))
         {
@@ -633,10 +1239,155 @@ get_package_type ()
                         footprint_type);
                 return (EXIT_FAILURE);
         }
+        stats_end (&span, STATS_PACKAGE_TYPE);
         return (EXIT_SUCCESS);
 }
 
 
+/*!
+ * \brief Get a bitmap of the pin/pad exceptions in a grid array.
+ *
+ * The \c pin_pad_exceptions_string is tokenized once, every token is
+ * looked up as a pin/pad name ("A1") for the \c ROW_LETTERS naming
+ * scheme, or as a pin/pad number for the other naming schemes.\n
+ * Tokens that do not match a grid position are ignored.\n
+ * The caller has to free the bitmap with g_free ().
+ *
+ * \return a bitmap with \c rows times \c columns entries (row by row)
+ * where excepted grid positions are \c TRUE, or \c NULL when there are no
+ * exceptions.
+ */
+gboolean *
+get_grid_exceptions
+(
+        gint rows,
+                /*!< : the number of rows.*/
+        gint columns,
+                /*!< : the number of columns.*/
+        grid_naming_t naming
+                /*!< : the naming scheme for the pins/pads.*/
+)
+{
+        gboolean *exceptions;
+        gchar **tokens;
+        gchar *column_string;
+        gchar *end;
+        gint row;
+        gint column;
+        gint pin_number;
+        gint i;
+
+        if (!pin_pad_exceptions_string
+                || !strcmp (pin_pad_exceptions_string, "")
+                || (rows < 1)
+                || (columns < 1))
+        {
+                return (NULL);
+        }
+        exceptions = g_new0 (gboolean, rows * columns);
+        tokens = g_strsplit_set (pin_pad_exceptions_string, ", ", -1);
+        for (i = 0; tokens[i]; i++)
+        {
+                if (!strcmp (tokens[i], ""))
+                {
+                        continue;
+                }
+                if (naming == ROW_LETTERS)
+                {
+                        /* Split the token in row letters and a column
+                         * number. */
+                        column_string = tokens[i];
+                        while (g_ascii_isalpha (*column_string))
+                        {
+                                column_string++;
+                        }
+                        column = strtol (column_string, &end, NUM_BASE) - 1;
+                        if ((end == column_string) || (*end != '\0'))
+                        {
+                                continue;
+                        }
+                        *column_string = '\0';
+                        for (row = 0; (row < rows) && (row < (gint) G_N_ELEMENTS (row_letters)); row++)
+                        {
+                                if (!strcmp (tokens[i], row_letters[row]))
+                                {
+                                        break;
+                                }
+                        }
+                }
+                else
+                {
+                        pin_number = strtol (tokens[i], &end, NUM_BASE) - 1;
+                        if ((*end != '\0') || (pin_number < 0))
+                        {
+                                continue;
+                        }
+                        if (naming == ODD_EVEN)
+                        {
+                                row = pin_number % rows;
+                                column = pin_number / rows;
+                        }
+                        else
+                        {
+                                row = pin_number / columns;
+                                column = pin_number % columns;
+                        }
+                }
+                if ((row >= 0) && (row < rows) && (column >= 0) && (column < columns))
+                {
+                        exceptions[row * columns + column] = TRUE;
+                }
+        }
+        g_strfreev (tokens);
+        return (exceptions);
+}
+
+
+/*!
+ * \brief Determine the center-center distance between two opposite pad
+ * rows.
+ *
+ * Depending on which of the center-center (c), inner-inner (g) or
+ * outer-outer (z) distances is entered by the user, the center-center
+ * distance is derived with the pad length.\n
+ * \c row 1 returns the distance between the top and the bottom pads
+ * (c1, g1, z1), \c row 2 returns the distance between the left and the
+ * right pads (c2, g2, z2).
+ *
+ * \return the center-center distance in footprint units.
+ */
+gdouble
+get_pad_row_distance
+(
+        gint row
+                /*!< : 1 for the top and bottom rows, 2 for the left and
+                 * right rows.*/
+)
+{
+        if (row == 1)
+        {
+                if (g1_state) /* inner-inner distance */
+                {
+                        return (g1 + pad_length);
+                }
+                if (z1_state) /* outer-outer distance */
+                {
+                        return (z1 - pad_length);
+                }
+                return (c1); /* center-center distance */
+        }
+        if (g2_state) /* inner-inner distance */
+        {
+                return (g2 + pad_length);
+        }
+        if (z2_state) /* outer-outer distance */
+        {
+                return (z2 - pad_length);
+        }
+        return (c2); /* center-center distance */
+}
+
+
 /*!
  * \brief Determine if the pin/pad is a non-existing pin or pad.
  *
@@ -860,6 +1611,7 @@ get_total_number_of_pins ()
                         number_of_pins = number_of_rows;
                         break;
                 case SO :
+                        number_of_pins = (number_of_columns * count_y) + thermal;
                         break;
                 case SOT :
                         break;
@@ -874,1165 +1626,828 @@ get_total_number_of_pins ()
 
 
 /*!
- * \brief Read a footprintwizard file into the global variables.
+ * \brief Open the footprint file for writing.
  *
- * \return EXIT_SUCCESS if footprintwizard is completely read and parsed,
- * EXIT_FAILURE if an error was encountered.
+ * The footprint is written to \c footprint_output when it is set, for
+ * instance by a server which returns the footprint text, otherwise to
+ * the file \c footprint_filename.\n
+ * The file is written under a temporary name in the same directory,
+ * close_footprint_file () renames it into place.\n
+ * Close it with close_footprint_file ().
+ *
+ * \return the stream to write the footprint to, \c NULL when the file
+ * could not be opened.
  */
-int
-read_footprintwizard_file
-(
-        gchar *fpw_filename
-                /*!< : name of the footprintwizard file. */
-)
+FILE *
+open_footprint_file ()
 {
-        /* Get global variables from footprintwizard file with .fpw suffix */
-        FILE *fpw = fopen (fpw_filename, "r");
-        if (!fpw)
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("could not open footprint wizard file: %s for reading.\n"),
-                                fpw_filename);
-                }
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%s\n", footprint_filename);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_filename value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_filename || (!strcmp (footprint_filename, "(null)")))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("footprint filename with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_filename = g_strdup ("");
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%s\n", dummy); /* do not (re)use this value ! */
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading a dummy value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%s\n", footprint_type);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_type value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_type || (!strcmp (footprint_type, "(null)")))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("footprint type with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_type = g_strdup ("");
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Determine the package type */
-        if (get_package_type () == EXIT_FAILURE)
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("footprint type contains an unknown package type."));
-                }
-                footprint_type = g_strdup ("");
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        else
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_INFO,
-                                _("determined the package type successful."));
-                }
-        }
-        fscanf (fpw, "%s\n", footprint_units);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_units value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_units || (!strcmp (footprint_units, "(null)")))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("footprint units with null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_units = g_strdup ("");
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Update the units related variables. */
-        if (update_units_variables () == EXIT_FAILURE)
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("footprint units contains an unknown units type."));
-                }
-                footprint_units = g_strdup ("");
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        else
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_INFO,
-                                _("footprint units variables updated successful."));
-                }
-        }
-        fscanf (fpw, "%s\n", footprint_refdes);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_refdes value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_refdes || (!strcmp (footprint_refdes, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("footprint refdes with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_refdes = g_strdup ("");
-        }
-        fscanf (fpw, "%s\n", footprint_value);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_value value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_value || (!strcmp (footprint_value, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("footprint value with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_value = g_strdup ("");
-        }
-        fscanf (fpw, "%f\n", package_body_length);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading package_body_length value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (package_body_length)) || (isinf (package_body_length)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN found in package body length, in: %s.\n"),
-                                fpw_filename);
-                }
-                package_body_length = 0.0;
-        }
-        fscanf (fpw, "%f\n", package_body_width);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading package_body_width value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (package_body_width)) || (isinf (package_body_width)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN found in package body width, in: %s.\n"),
-                                fpw_filename);
-                }
-                package_body_width = 0.0;
-        }
-        fscanf (fpw, "%f\n", package_body_height);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading package_body_height value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (package_body_height)) || (isinf (package_body_height)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN found in package body heigth, in: %s.\n"),
-                                fpw_filename);
-                }
-                package_body_height = 0.0;
-        }
-        fscanf (fpw, "%d\n", package_is_radial);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading package_is_radial value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%s\n", footprint_author);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_author value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_author || (!strcmp (footprint_author, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("footprint author with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_author = g_strdup ("");
-        }
-        fscanf (fpw, "%s\n", footprint_dist_license);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_dist_license value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_dist_license
-                || (!strcmp (footprint_dist_license, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("footprint distribution license with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_dist_license = g_strdup ("");
-        }
-        fscanf (fpw, "%s\n", footprint_use_license);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_use_license value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_use_license
-                || (!strcmp (footprint_use_license, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("footprint usage license with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_use_license = g_strdup ("");
-        }
-        fscanf (fpw, "%s\n", footprint_status);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading footprint_status value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!footprint_status || (!strcmp (footprint_status, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("footprint status with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                footprint_status = g_strdup ("");
-        }
-        fscanf (fpw, "%d\n", attributes_in_footprint);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading attributes_in_footprint value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%d\n", number_of_pins);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading number_of_pins value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%d\n", number_of_columns);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading number_of_columns value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%d\n", number_of_rows);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading number_of_rows value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%f\n", pitch_x);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pitch_x value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pitch_x)) || (isinf (pitch_x)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number of pitch in X-direction found in: %s.\n"),
-                                fpw_filename);
-                }
-                pitch_x = 0.0;
-        }
-        fscanf (fpw, "%f\n", pitch_y);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pitch_y value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pitch_y)) || (isinf (pitch_y)))
-        {
-                if (verbose)
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number of pitch in Y-direction found in: %s.\n"),
-                                fpw_filename);
-                pitch_y = 0.0;
-        }
-        fscanf (fpw, "%d\n", count_x);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading count_x value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%d\n", count_y);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading count_y value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%s\n", pad_shape);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pad_shape value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!pad_shape || (!strcmp (pad_shape, "(null)")))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("pad shape with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                pad_shape = g_strdup ("");
-                return (EXIT_FAILURE);
-        }
-        /* Update the pad shape related variables. */
-        if (update_pad_shapes_variables () == EXIT_FAILURE)
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("pad shape contains an unknown pad shape type."));
-                }
-                return (EXIT_FAILURE);
-        }
-        else
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_INFO,
-                                _("pad shape variables updated successful."));
-                }
-        }
-        fscanf (fpw, "%s\n", pin_pad_exceptions_string);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pin_pad_exceptions_string value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!pin_pad_exceptions_string || (!strcmp (pin_pad_exceptions_string, "(null)")))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("pin/pad exceptions with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                pin_pad_exceptions_string = g_strdup ("");
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%s\n", pin_1_position);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pin_1_position value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        /* Check for null pointers or meaningless values. */
-        if (!pin_1_position || (!strcmp (pin_1_position, "(null)")))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("pin #1 position with a null pointer found in: %s.\n"),
-                                fpw_filename);
-                }
-                pin_1_position = g_strdup ("");
-        }
-        fscanf (fpw, "%f\n", pad_length);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pad_length value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pad_length)) || (isinf (pad_length)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in pad length found in: %s.\n"),
-                                fpw_filename);
-                }
-                pad_length = 0.0;
-        }
-        fscanf (fpw, "%f\n", pad_width);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pad_width value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pad_width)) || (isinf (pad_width)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in pad width found in: %s.\n"),
-                                fpw_filename);
-                }
-                pad_width = 0.0;
-        }
-        fscanf (fpw, "%f\n", pad_diameter);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pad_diameter value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pad_diameter)) || (isinf (pad_diameter)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in pad diameter found in: %s.\n"),
-                                fpw_filename);
-                }
-                pad_diameter = 0.0;
-        }
-        fscanf (fpw, "%f\n", pin_drill_diameter);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pin_drill_diameter value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pin_drill_diameter)) || (isinf (pin_drill_diameter)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in pin drill diameter found in: %s.\n"),
-                                fpw_filename);
-                }
-                pin_drill_diameter = 0.0;
-        }
-        fscanf (fpw, "%d\n", pin1_square);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pin1_square value in: %s.\n"),
-                                fpw_filename);
-                }
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%f\n", pad_clearance);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pad_clearance value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (pad_clearance)) || (isinf (pad_clearance)))
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in pad clearance found in: %s.\n"),
-                                fpw_filename);
-                }
-                pad_clearance = 0.0;
-        }
-        fscanf (fpw, "%f\n", pad_solder_mask_clearance);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+        stats_span_t span;
+        FILE *file = footprint_output;
+
+        stats_begin (&span);
+        if (!file)
+        {
+                g_free (footprint_temporary_filename);
+                footprint_temporary_filename = g_strdup_printf ("%s.%d.tmp",
+                        footprint_filename, (gint) getpid ());
+                file = fopen (footprint_temporary_filename, "w");
+                if (!file)
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading pad_solder_mask_clearance value in: %s.\n"),
-                                fpw_filename);
+                        g_free (footprint_temporary_filename);
+                        footprint_temporary_filename = NULL;
+                        return (NULL);
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
         }
-        if ((isnan (pad_solder_mask_clearance)) ||
-                (isinf (pad_solder_mask_clearance)))
+        /* Only an open file has a write span, close_footprint_file ()
+         * ends it. */
+        footprint_write_span = span;
+        return (file);
+}
+
+
+/*!
+ * \brief Parse a number in a footprintwizard file.
+ *
+ * The number is parsed from a line of \c length characters which is not
+ * required to be \c NULL terminated, as is the case with a memory mapped
+ * file.\n
+ * The parser is locale independent: the decimal separator is always a
+ * "." as written by write_footprintwizard_file (), no matter what the
+ * locale of the user says.\n
+ * Leading and trailing whitespace is allowed, anything else that is not
+ * part of a number is an error.
+ *
+ * \return \c TRUE when a finite number was parsed, \c FALSE when the
+ * line does not contain a valid number.
+ */
+static gboolean
+parse_fpw_number
+(
+        const gchar *text,
+                /*!< : the start of the line.*/
+        gsize length,
+                /*!< : the number of characters in the line.*/
+        gdouble *value
+                /*!< : the parsed value.*/
+)
+{
+        static const gdouble powers_of_ten[] =
+        {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+                1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+                1e21, 1e22
+        };
+        const gchar *end = text + length;
+        const gchar *start;
+        gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+        guint64 mantissa = 0;
+        gint digits = 0;
+        gint exponent = 0;
+        gint exponent_value = 0;
+        gboolean negative = FALSE;
+        gboolean negative_exponent = FALSE;
+
+        while ((text < end) && g_ascii_isspace (*text))
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in pad solder mask clearance found in: %s.\n"),
-                                fpw_filename);
-                }
-                pad_solder_mask_clearance = 0.0;
+                text++;
         }
-        fscanf (fpw, "%d\n", thermal);
-        if (ferror (fpw))
+        while ((end > text) && g_ascii_isspace (*(end - 1)))
         {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading thermal value in: %s.\n"),
-                                fpw_filename);
-                }
-                return (EXIT_FAILURE);
+                end--;
         }
-        fscanf (fpw, "%d\n", thermal_nopaste);
-        if (ferror (fpw))
+        start = text;
+        if ((text < end) && ((*text == '-') || (*text == '+')))
         {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading thermal_nopaste value in: %s.\n"),
-                                fpw_filename);
-                }
-                return (EXIT_FAILURE);
+                negative = (*text == '-');
+                text++;
         }
-        fscanf (fpw, "%f\n", thermal_length);
-        if (ferror (fpw))
+        /* Collect the significant digits of the integer part and the
+         * fraction in one mantissa. */
+        while ((text < end) && g_ascii_isdigit (*text))
         {
-                if ((verbose) || (!silent))
+                if (mantissa < (G_MAXUINT64 / 10) - 10)
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading thermal_length value in: %s.\n"),
-                                fpw_filename);
+                        mantissa = (mantissa * 10) + (*text - '0');
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (thermal_length)) || (isinf (thermal_length)))
-        {
-                if (verbose)
+                else
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in thermal length found in: %s.\n"),
-                                fpw_filename);
+                        exponent++;
                 }
-                thermal_length = 0.0;
+                digits++;
+                text++;
         }
-        fscanf (fpw, "%f\n", thermal_width);
-        if (ferror (fpw))
+        if ((text < end) && (*text == '.'))
         {
-                if ((verbose) || (!silent))
+                text++;
+                while ((text < end) && g_ascii_isdigit (*text))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading thermal_width value in: %s.\n"),
-                                fpw_filename);
+                        if (mantissa < (G_MAXUINT64 / 10) - 10)
+                        {
+                                mantissa = (mantissa * 10) + (*text - '0');
+                                exponent--;
+                        }
+                        digits++;
+                        text++;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
         }
-        if ((isnan (thermal_width)) || (isinf (thermal_width)))
+        if (digits == 0)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in thermal width found in: %s.\n"),
-                                fpw_filename);
-                }
-                thermal_width = 0.0;
+                return (FALSE);
         }
-        fscanf (fpw, "%f\n", thermal_clearance);
-        if (ferror (fpw))
+        if ((text < end) && ((*text == 'e') || (*text == 'E')))
         {
-                if ((verbose) || (!silent))
+                text++;
+                if ((text < end) && ((*text == '-') || (*text == '+')))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading thermal_clearance value in: %s.\n"),
-                                fpw_filename);
+                        negative_exponent = (*text == '-');
+                        text++;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (thermal_clearance)) || (isinf (thermal_clearance)))
-        {
-                if (verbose)
+                if ((text == end) || !g_ascii_isdigit (*text))
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in thermal clearance found in: %s.\n"),
-                                fpw_filename);
+                        return (FALSE);
                 }
-                thermal_clearance = 0.0;
-        }
-        fscanf (fpw, "%f\n", thermal_solder_mask_clearance);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                while ((text < end) && g_ascii_isdigit (*text))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading thermal_solder_mask value in: %s.\n"),
-                                fpw_filename);
+                        if (exponent_value < 10000)
+                        {
+                                exponent_value = (exponent_value * 10) + (*text - '0');
+                        }
+                        text++;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
+                exponent += (negative_exponent) ? -exponent_value : exponent_value;
         }
-        if ((isnan (thermal_solder_mask_clearance)) ||
-                (isinf (thermal_solder_mask_clearance)))
+        if (text != end)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in thermal solder mask clearance found in: %s.\n"),
-                                fpw_filename);
-                }
-                thermal_solder_mask_clearance = 0.0;
+                return (FALSE);
         }
-        fscanf (fpw, "%d\n", fiducial);
-        if (ferror (fpw))
+        /* A mantissa and power of ten which are both exact in a double
+         * give a correctly rounded result, this covers all values written
+         * by write_footprintwizard_file ().
+         * Leave anything else to the (slower) GLib parser. */
+        if ((mantissa < ((guint64) 1 << 53)) && (exponent >= -22) && (exponent <= 22))
         {
-                if ((verbose) || (!silent))
+                *value = (exponent < 0)
+                        ? (gdouble) mantissa / powers_of_ten[-exponent]
+                        : (gdouble) mantissa * powers_of_ten[exponent];
+                if (negative)
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading fiducial value in: %s.\n"),
-                                fpw_filename);
+                        *value = -*value;
                 }
-                return (EXIT_FAILURE);
         }
-        fscanf (fpw, "%f\n", fiducial_pad_diameter);
-        if (ferror (fpw))
+        else
         {
-                if ((verbose) || (!silent))
+                if ((gsize) (end - start) >= sizeof (buffer))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading fiducial_pad_diameter value in: %s.\n"),
-                                fpw_filename);
+                        return (FALSE);
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
+                memcpy (buffer, start, end - start);
+                buffer[end - start] = '\0';
+                *value = g_ascii_strtod (buffer, NULL);
         }
-        if ((isnan (fiducial_pad_diameter)) || (isinf (fiducial_pad_diameter)))
+        return (!isnan (*value) && !isinf (*value));
+}
+
+
+/*!
+ * \brief The fields of a footprintwizard file.
+ *
+ * The order is the order of the lines in a positional (version 1)
+ * footprintwizard file, the names are the keys in a keyed (version 2)
+ * footprintwizard file.
+ */
+static fpw_field_t
+fpw_fields[] =
+{
+        {"footprint_filename", FPW_STRING, &footprint_filename, TRUE},
+        {"footprint_name", FPW_IGNORE, &footprint_name, FALSE},
+        {"footprint_type", FPW_STRING, &footprint_type, TRUE},
+        {"footprint_units", FPW_STRING, &footprint_units, TRUE},
+        {"footprint_refdes", FPW_STRING, &footprint_refdes, FALSE},
+        {"footprint_value", FPW_STRING, &footprint_value, FALSE},
+        {"package_body_length", FPW_DOUBLE, &package_body_length, FALSE},
+        {"package_body_width", FPW_DOUBLE, &package_body_width, FALSE},
+        {"package_body_height", FPW_DOUBLE, &package_body_height, FALSE},
+        {"package_is_radial", FPW_INTEGER, &package_is_radial, FALSE},
+        {"footprint_author", FPW_STRING, &footprint_author, FALSE},
+        {"footprint_dist_license", FPW_STRING, &footprint_dist_license, FALSE},
+        {"footprint_use_license", FPW_STRING, &footprint_use_license, FALSE},
+        {"footprint_status", FPW_STRING, &footprint_status, FALSE},
+        {"attributes_in_footprint", FPW_INTEGER, &attributes_in_footprint, FALSE},
+        {"number_of_pins", FPW_INTEGER, &number_of_pins, FALSE},
+        {"number_of_columns", FPW_INTEGER, &number_of_columns, FALSE},
+        {"number_of_rows", FPW_INTEGER, &number_of_rows, FALSE},
+        {"pitch_x", FPW_DOUBLE, &pitch_x, FALSE},
+        {"pitch_y", FPW_DOUBLE, &pitch_y, FALSE},
+        {"count_x", FPW_INTEGER, &count_x, FALSE},
+        {"count_y", FPW_INTEGER, &count_y, FALSE},
+        {"pad_shape", FPW_STRING, &pad_shape, TRUE},
+        {"pin_pad_exceptions_string", FPW_STRING, &pin_pad_exceptions_string, FALSE},
+        {"pin_1_position", FPW_STRING, &pin_1_position, FALSE},
+        {"pad_diameter", FPW_DOUBLE, &pad_diameter, FALSE},
+        {"pin_drill_diameter", FPW_DOUBLE, &pin_drill_diameter, FALSE},
+        {"pin1_square", FPW_INTEGER, &pin1_square, FALSE},
+        {"pad_length", FPW_DOUBLE, &pad_length, FALSE},
+        {"pad_width", FPW_DOUBLE, &pad_width, FALSE},
+        {"pad_clearance", FPW_DOUBLE, &pad_clearance, FALSE},
+        {"pad_solder_mask_clearance", FPW_DOUBLE, &pad_solder_mask_clearance, FALSE},
+        {"thermal", FPW_INTEGER, &thermal, FALSE},
+        {"thermal_nopaste", FPW_INTEGER, &thermal_nopaste, FALSE},
+        {"thermal_length", FPW_DOUBLE, &thermal_length, FALSE},
+        {"thermal_width", FPW_DOUBLE, &thermal_width, FALSE},
+        {"thermal_clearance", FPW_DOUBLE, &thermal_clearance, FALSE},
+        {"thermal_solder_mask_clearance", FPW_DOUBLE, &thermal_solder_mask_clearance, FALSE},
+        {"fiducial", FPW_INTEGER, &fiducial, FALSE},
+        {"fiducial_pad_diameter", FPW_DOUBLE, &fiducial_pad_diameter, FALSE},
+        {"fiducial_pad_solder_mask_clearance", FPW_DOUBLE, &fiducial_pad_solder_mask_clearance, FALSE},
+        {"silkscreen_package_outline", FPW_INTEGER, &silkscreen_package_outline, FALSE},
+        {"silkscreen_indicate_1", FPW_INTEGER, &silkscreen_indicate_1, FALSE},
+        {"silkscreen_line_width", FPW_DOUBLE, &silkscreen_line_width, FALSE},
+        {"courtyard", FPW_INTEGER, &courtyard, FALSE},
+        {"courtyard_length", FPW_DOUBLE, &courtyard_length, FALSE},
+        {"courtyard_width", FPW_DOUBLE, &courtyard_width, FALSE},
+        {"courtyard_line_width", FPW_DOUBLE, &courtyard_line_width, FALSE},
+        {"courtyard_clearance_with_package", FPW_DOUBLE, &courtyard_clearance_with_package, FALSE},
+        {"c1", FPW_DOUBLE, &c1, FALSE},
+        {"g1", FPW_DOUBLE, &g1, FALSE},
+        {"z1", FPW_DOUBLE, &z1, FALSE},
+        {"c2", FPW_DOUBLE, &c2, FALSE},
+        {"g2", FPW_DOUBLE, &g2, FALSE},
+        {"z2", FPW_DOUBLE, &z2, FALSE}
+};
+
+
+/*!
+ * \brief Find the next line in a memory mapped footprintwizard file.
+ *
+ * \return the start of the line following the current line, the
+ * \c length of the current line is returned without the line end (a DOS
+ * line end is stripped as well).
+ */
+static const gchar *
+get_fpw_line
+(
+        const gchar *line,
+                /*!< : the start of the current line.*/
+        const gchar *end,
+                /*!< : the end of the mapped file.*/
+        gsize *length
+                /*!< : the length of the current line.*/
+)
+{
+        const gchar *line_end;
+
+        line_end = memchr (line, '\n', end - line);
+        if (!line_end)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in fiducial pad diameter found in: %s.\n"),
-                                fpw_filename);
-                }
-                fiducial_pad_diameter = 0.0;
+                line_end = end;
         }
-        fscanf (fpw, "%f\n", fiducial_pad_solder_mask_clearance);
-        if (ferror (fpw))
+        *length = line_end - line;
+        if ((*length > 0) && (line[*length - 1] == '\r'))
         {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading fiducial_pad_solder_mask value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
-                return (EXIT_FAILURE);
+                (*length)--;
         }
-        if ((isnan (fiducial_pad_solder_mask_clearance)) ||
-                (isinf (fiducial_pad_solder_mask_clearance)))
+        return (line_end + 1);
+}
+
+
+/*!
+ * \brief Add a line to the hash of the parameters in a footprintwizard
+ * file.
+ *
+ * The hash is a 64 bit FNV-1a hash over the parameter lines, including a
+ * "\n" line end for every line.
+ *
+ * \return the updated hash.
+ */
+static guint64
+hash_fpw_line
+(
+        guint64 hash,
+                /*!< : the hash of the lines so far.*/
+        const gchar *text,
+                /*!< : the start of the line.*/
+        gsize length
+                /*!< : the length of the line without the line end.*/
+)
+{
+        gsize i;
+
+        for (i = 0; i < length; i++)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in fiducial pad solder mask clearance found in: %s.\n"),
-                                fpw_filename);
-                }
-                fiducial_pad_solder_mask_clearance = 0.0;
+                hash = (hash ^ (guchar) text[i]) * G_GUINT64_CONSTANT (1099511628211);
         }
-        fscanf (fpw, "%d\n", silkscreen_package_outline);
-        if (ferror (fpw))
+        hash = (hash ^ (guchar) '\n') * G_GUINT64_CONSTANT (1099511628211);
+        return (hash);
+}
+
+
+/*!
+ * \brief Convert the text of a line into the global variable of a
+ * footprintwizard file field.
+ *
+ * \return \c EXIT_SUCCESS when the value was stored, \c EXIT_FAILURE
+ * when a required string value is missing or a number is not valid.
+ */
+static int
+read_fpw_value
+(
+        fpw_field_t *field,
+                /*!< : the field to store the value in.*/
+        const gchar *text,
+                /*!< : the text of the value, not \c NULL terminated.*/
+        gsize length,
+                /*!< : the length of the text.*/
+        gchar *fpw_filename
+                /*!< : name of the footprintwizard file, used in messages.*/
+)
+{
+        gdouble number;
+        gchar *string;
+
+        switch (field->type)
         {
-                if ((verbose) || (!silent))
+                case FPW_STRING:
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading silkscreen_package_outline value in: %s.\n"),
-                                fpw_filename);
+                        string = g_strndup (text, length);
+                        /* Check for null pointers or meaningless values. */
+                        if (!strcmp (string, "(null)") ||
+                                (field->required && !strcmp (string, "")))
+                        {
+                                g_free (string);
+                                *(gchar **) field->value = g_strdup ("");
+                                if (field->required)
+                                {
+                                        if ((verbose) || (!silent))
+                                        {
+                                                g_log ("", G_LOG_LEVEL_CRITICAL,
+                                                        _("%s with a null pointer found in: %s.\n"),
+                                                        field->name,
+                                                        fpw_filename);
+                                        }
+                                        return (EXIT_FAILURE);
+                                }
+                                if (verbose)
+                                {
+                                        g_log ("", G_LOG_LEVEL_WARNING,
+                                                _("%s with a null pointer found in: %s.\n"),
+                                                field->name,
+                                                fpw_filename);
+                                }
+                                break;
+                        }
+                        *(gchar **) field->value = string;
+                        break;
                 }
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%d\n", silkscreen_indicate_1);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                case FPW_DOUBLE:
+                case FPW_INTEGER:
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading silkscreen_indicate_1 value in: %s.\n"),
-                                fpw_filename);
+                        if (!parse_fpw_number (text, length, &number))
+                        {
+                                if ((verbose) || (!silent))
+                                {
+                                        g_log ("", G_LOG_LEVEL_CRITICAL,
+                                                _("invalid number in %s found in: %s.\n"),
+                                                field->name,
+                                                fpw_filename);
+                                }
+                                return (EXIT_FAILURE);
+                        }
+                        /* Integers may have been written with a fraction by
+                         * older versions. */
+                        if (field->type == FPW_DOUBLE)
+                        {
+                                *(gdouble *) field->value = number;
+                        }
+                        else
+                        {
+                                *(gint *) field->value = (gint) CLAMP (number, G_MININT, G_MAXINT);
+                        }
+                        break;
                 }
-                return (EXIT_FAILURE);
-        }
-        fscanf (fpw, "%f\n", silkscreen_line_width);
-        if ((isnan (silkscreen_line_width)) || (isinf (silkscreen_line_width)))
-        {
-                if (verbose)
+                case FPW_IGNORE:
+                default:
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in silkscreen line width found in: %s.\n"),
-                                fpw_filename);
+                        break;
                 }
-                silkscreen_line_width = 0.0;
         }
-        fscanf (fpw, "%d\n", courtyard);
-        if (ferror (fpw))
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read a footprintwizard file into the global variables.
+ *
+ * The file is memory mapped and split into lines in a single pass.\n
+ * A keyed file (format version 2, see write_footprintwizard_file ())
+ * holds a "key=value" line for every entry in \c fpw_fields[], in any
+ * order, unknown keys are skipped and missing keys leave the global
+ * variables involved untouched.
+ * The parameter hash in the header is verified against the parameter
+ * lines read.\n
+ * A positional file (format version 1) holds the values in the order of
+ * \c fpw_fields[], missing lines at the end of the file leave the global
+ * variables involved untouched.\n
+ * String values are the whole value, so they may contain whitespace.\n
+ * Numbers are parsed locale independent, an invalid number is an error.
+ *
+ * \return EXIT_SUCCESS if footprintwizard is completely read and parsed,
+ * EXIT_FAILURE if an error was encountered.
+ */
+int
+read_footprintwizard_file
+(
+        gchar *fpw_filename
+                /*!< : name of the footprintwizard file. */
+)
+{
+        GMappedFile *fpw;
+        GError *error = NULL;
+        const gchar *line;
+        const gchar *next_line;
+        const gchar *end;
+        const gchar *key_end;
+        gsize length;
+        gsize key_length;
+        guint64 hash = G_GUINT64_CONSTANT (14695981039346656037);
+        guint64 header_hash = 0;
+        gdouble number;
+        gboolean keyed;
+        guint i;
+        guint j;
+        stats_span_t span;
+
+        stats_begin (&span);
+        /* Get global variables from footprintwizard file with .fpw suffix */
+        fpw = g_mapped_file_new (fpw_filename, FALSE, &error);
+        if (!fpw)
         {
                 if ((verbose) || (!silent))
                 {
                         g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading courtyard value in: %s.\n"),
+                                _("could not open footprint wizard file: %s for reading.\n"),
                                 fpw_filename);
                 }
+                g_error_free (error);
                 return (EXIT_FAILURE);
         }
-        fscanf (fpw, "%f\n", courtyard_length);
-        if (ferror (fpw))
+        line = g_mapped_file_get_contents (fpw);
+        end = line + g_mapped_file_get_length (fpw);
+        keyed = ((end - line) > 12) && !strncmp (line, "fpw_version=", 12);
+        i = 0;
+        while (line < end)
         {
-                if ((verbose) || (!silent))
+                next_line = get_fpw_line (line, end, &length);
+                if (!keyed)
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading courtyard_length value in: %s.\n"),
-                                fpw_filename);
+                        /* Positional file, the line number is the key. */
+                        if (read_fpw_value (&fpw_fields[i], line, length, fpw_filename))
+                        {
+                                g_mapped_file_unref (fpw);
+                                return (EXIT_FAILURE);
+                        }
+                        line = next_line;
+                        if (++i == G_N_ELEMENTS (fpw_fields))
+                        {
+                                break;
+                        }
+                        continue;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (courtyard_length)) || (isinf (courtyard_length)))
-        {
-                if (verbose)
+                key_end = memchr (line, '=', length);
+                if ((length == 0) || (line[0] == '#') || !key_end)
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in courtyard length found in: %s.\n"),
-                                fpw_filename);
+                        /* Skip empty lines and comments. */
+                        line = next_line;
+                        continue;
                 }
-                courtyard_length = 0.0;
-        }
-        fscanf (fpw, "%f\n", courtyard_width);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                key_length = key_end - line;
+                if ((key_length == 14) && !strncmp (line, "parameter_hash", 14))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading courtyard_width value in: %s.\n"),
-                                fpw_filename);
+                        header_hash = g_ascii_strtoull (key_end + 1, NULL, 16);
+                        line = next_line;
+                        continue;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (courtyard_width)) || (isinf (courtyard_width)))
-        {
-                if (verbose)
+                /* Keys are usually in the order of fpw_fields[], so look at
+                 * the entry after the previous key first. */
+                for (j = 0; j < G_N_ELEMENTS (fpw_fields); j++)
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in courtyard width found in: %s.\n"),
-                                fpw_filename);
+                        if ((strlen (fpw_fields[i].name) == key_length) &&
+                                !strncmp (fpw_fields[i].name, line, key_length))
+                        {
+                                break;
+                        }
+                        i = (i + 1) % G_N_ELEMENTS (fpw_fields);
                 }
-                courtyard_width = 0.0;
-        }
-        fscanf (fpw, "%f\n", courtyard_line_width);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                if (j == G_N_ELEMENTS (fpw_fields))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading courtyard_line_width value in: %s.\n"),
-                                fpw_filename);
+                        if ((key_length == 11) && !strncmp (line, "fpw_version", 11))
+                        {
+                                /* Newer versions only add keys, read what
+                                 * we know about. */
+                                if (parse_fpw_number (key_end + 1, length - key_length - 1, &number) &&
+                                        (number > FPW_FORMAT_VERSION) && (verbose))
+                                {
+                                        g_log ("", G_LOG_LEVEL_WARNING,
+                                                _("footprint wizard file: %s has a newer format version %d.\n"),
+                                                fpw_filename, (gint) number);
+                                }
+                        }
+                        else if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("unknown key %.*s found in: %s.\n"),
+                                        (gint) key_length, line,
+                                        fpw_filename);
+                        }
+                        line = next_line;
+                        continue;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (courtyard_line_width)) || (isinf (courtyard_line_width)))
-        {
-                if (verbose)
+                if (read_fpw_value (&fpw_fields[i], key_end + 1, length - key_length - 1, fpw_filename))
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in courtyard line width found in: %s.\n"),
-                                fpw_filename);
+                        g_mapped_file_unref (fpw);
+                        return (EXIT_FAILURE);
                 }
-                courtyard_line_width = 0.0;
+                /* The header values are not part of the parameter hash. */
+                if ((fpw_fields[i].value != &footprint_type) &&
+                        (fpw_fields[i].value != &footprint_name))
+                {
+                        hash = hash_fpw_line (hash, line, length);
+                }
+                i = (i + 1) % G_N_ELEMENTS (fpw_fields);
+                line = next_line;
+        }
+        g_mapped_file_unref (fpw);
+        if (!keyed && (i < G_N_ELEMENTS (fpw_fields)) && (verbose))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("no %s value and beyond found in: %s.\n"),
+                        fpw_fields[i].name,
+                        fpw_filename);
+        }
+        if (keyed && (header_hash != hash) && (verbose))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("parameter hash does not match the parameters in: %s.\n"),
+                        fpw_filename);
         }
-        fscanf (fpw, "%f\n", courtyard_clearance_with_package);
-        if (ferror (fpw))
+        /* Determine the package type */
+        if (get_package_type () == EXIT_FAILURE)
         {
                 if ((verbose) || (!silent))
                 {
                         g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading courtyard_clearance_with_package value in: %s.\n"),
-                                fpw_filename);
+                                _("footprint type contains an unknown package type."));
                 }
-                fclose (fpw);
+                footprint_type = g_strdup ("");
                 return (EXIT_FAILURE);
         }
-        if ((isnan (courtyard_clearance_with_package)) ||
-                (isinf (courtyard_clearance_with_package)))
+        /* The read is counted for the package type which was read. */
+        stats_end (&span, STATS_READ);
+        /* Update the units related variables. */
+        if (update_units_variables () == EXIT_FAILURE)
         {
-                if (verbose)
+                if ((verbose) || (!silent))
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in courtyard clearance with package found in: %s.\n"),
-                                fpw_filename);
+                        g_log ("", G_LOG_LEVEL_CRITICAL,
+                                _("footprint units contains an unknown units type."));
                 }
-                courtyard_clearance_with_package = 0.0;
+                footprint_units = g_strdup ("");
+                return (EXIT_FAILURE);
         }
-
-        fscanf (fpw, "%f\n", c1);
-        if (ferror (fpw))
+        /* Update the pad shape related variables. */
+        if (update_pad_shapes_variables () == EXIT_FAILURE)
         {
                 if ((verbose) || (!silent))
                 {
                         g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading c1 value in: %s.\n"),
-                                fpw_filename);
+                                _("pad shape contains an unknown pad shape type."));
                 }
-                fclose (fpw);
                 return (EXIT_FAILURE);
         }
-        if ((isnan (c1)) || (isinf (c1)))
+        if (verbose)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in top to bottom center-center distance found in: %s.\n"),
-                                fpw_filename);
-                }
-                c1 = 0.0;
+                g_log ("", G_LOG_LEVEL_INFO,
+                        "read footprint wizard file: %s.\n",
+                        fpw_filename);
         }
-        fscanf (fpw, "%f\n", g1);
-        if (ferror (fpw))
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Read the header of a footprintwizard file.
+ *
+ * Only the header lines at the start of the file are read, which makes
+ * this cheap enough for scanning a directory full of footprintwizard
+ * files.\n
+ * For a positional file (format version 1) the package type and the
+ * footprint name are taken from their fixed lines, the parameter hash
+ * is unknown (0).\n
+ * The strings in the \c header are newly allocated and are to be freed
+ * with g_free () by the caller.
+ *
+ * \return \c EXIT_SUCCESS when the header was read, \c EXIT_FAILURE
+ * when the file could not be read or has no package type.
+ */
+int
+read_footprintwizard_file_header
+(
+        gchar *fpw_filename,
+                /*!< : name of the footprintwizard file. */
+        fpw_header_t *header
+                /*!< : the header to fill in. */
+)
+{
+        GMappedFile *fpw;
+        const gchar *line;
+        const gchar *end;
+        const gchar *value;
+        gsize length;
+        gint line_number;
+
+        header->version = 0;
+        header->footprint_type = NULL;
+        header->footprint_name = NULL;
+        header->parameter_hash = 0;
+        fpw = g_mapped_file_new (fpw_filename, FALSE, NULL);
+        if (!fpw)
         {
-                if ((verbose) || (!silent))
-                {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading g1 value in: %s.\n"),
-                                fpw_filename);
-                }
-                fclose (fpw);
                 return (EXIT_FAILURE);
         }
-        if ((isnan (g1)) || (isinf (g1)))
+        line = g_mapped_file_get_contents (fpw);
+        end = line + g_mapped_file_get_length (fpw);
+        header->version = (((end - line) > 12) && !strncmp (line, "fpw_version=", 12)) ? FPW_FORMAT_VERSION : 1;
+        for (line_number = 1; line < end; line_number++)
         {
-                if (verbose)
+                value = line;
+                line = get_fpw_line (line, end, &length);
+                if (header->version == 1)
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in top to bottom inner-inner distance found in: %s.\n"),
-                                fpw_filename);
+                        /* Line 2 is the footprint name, line 3 the
+                         * footprint type. */
+                        if (line_number == 2)
+                        {
+                                header->footprint_name = g_strndup (value, length);
+                        }
+                        if (line_number == 3)
+                        {
+                                header->footprint_type = g_strndup (value, length);
+                                break;
+                        }
+                        continue;
                 }
-                g1 = 0.0;
-        }
-        fscanf (fpw, "%f\n", z1);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                if ((length > 12) && !strncmp (value, "fpw_version=", 12))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading z1 value in: %s.\n"),
-                                fpw_filename);
+                        header->version = (gint) g_ascii_strtoll (value + 12, NULL, NUM_BASE);
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (z1)) || (isinf (z1)))
-        {
-                if (verbose)
+                else if ((length > 15) && !strncmp (value, "footprint_type=", 15))
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in top to bottom outer-outer distance found in: %s.\n"),
-                                fpw_filename);
+                        header->footprint_type = g_strndup (value + 15, length - 15);
                 }
-                z1 = 0.0;
-        }
-        fscanf (fpw, "%f\n", c2);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                else if ((length > 15) && !strncmp (value, "footprint_name=", 15))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading c2 value in: %s.\n"),
-                                fpw_filename);
+                        header->footprint_name = g_strndup (value + 15, length - 15);
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
-        }
-        if ((isnan (c2)) || (isinf (c2)))
-        {
-                if (verbose)
+                else if ((length > 15) && !strncmp (value, "parameter_hash=", 15))
                 {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in left to right center-center distance found in: %s.\n"),
-                                fpw_filename);
+                        header->parameter_hash = g_ascii_strtoull (value + 15, NULL, 16);
                 }
-                c2 = 0.0;
-        }
-        fscanf (fpw, "%f\n", g2);
-        if (ferror (fpw))
-        {
-                if ((verbose) || (!silent))
+                else if ((length > 0) && (value[0] != '#'))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading g2 value in: %s.\n"),
-                                fpw_filename);
+                        /* The header ends at the first parameter. */
+                        break;
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
         }
-        if ((isnan (g2)) || (isinf (g2)))
+        g_mapped_file_unref (fpw);
+        if (!header->footprint_type || !strcmp (header->footprint_type, ""))
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in left to right inner-inner distance found in: %s.\n"),
-                                fpw_filename);
-                }
-                g2 = 0.0;
+                return (EXIT_FAILURE);
         }
-        fscanf (fpw, "%f\n", z2);
-        if (ferror (fpw))
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Set a global variable of a footprintwizard file field by the
+ * name of the field.
+ *
+ * The text of the value is converted as if it was read from a
+ * footprintwizard file, so this sets the same variables as a
+ * "key=value" line.\n
+ * The units and pad shape related variables are not updated, that is
+ * up to the caller after the last value.
+ *
+ * \return \c EXIT_SUCCESS when the value was stored, \c EXIT_FAILURE
+ * when the name is unknown or a required string value is missing.
+ */
+int
+set_footprintwizard_value
+(
+        const gchar *name,
+                /*!< : the name of the field.*/
+        const gchar *text,
+                /*!< : the text of the value, not \c NULL terminated.*/
+        gsize length,
+                /*!< : the length of the text.*/
+        gchar *source
+                /*!< : where the value comes from, used in messages.*/
+)
+{
+        guint i;
+
+        for (i = 0; i < G_N_ELEMENTS (fpw_fields); i++)
         {
-                if ((verbose) || (!silent))
+                if ((fpw_fields[i].type != FPW_IGNORE) &&
+                        !strcmp (fpw_fields[i].name, name))
                 {
-                        g_log ("", G_LOG_LEVEL_CRITICAL,
-                                _("error while reading z2 value in: %s.\n"),
-                                fpw_filename);
+                        return (read_fpw_value (&fpw_fields[i], text, length, source));
                 }
-                fclose (fpw);
-                return (EXIT_FAILURE);
         }
-        if ((isnan (z2)) || (isinf (z2)))
+        return (EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Convert a dimension in footprint units into a coordinate in
+ * mil/100.
+ *
+ * The dimension is scaled with the units \c multiplier and rounded half
+ * away from zero, instead of being truncated by an (int) cast, so equal
+ * dimensions always end up as equal integer coordinates.\n
+ * Generators should convert every position on its own, and not multiply
+ * a converted pitch, so the rounding does not add up over the pins of a
+ * large array.
+ *
+ * \return the coordinate in mil/100.
+ */
+LocationType
+units_to_coord
+(
+        gdouble value
+                /*!< : the dimension in footprint units.*/
+)
+{
+        gdouble coord;
+
+        coord = multiplier * value;
+        if (coord < 0.0)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("NaN number in left to right outer-outer distance found in: %s.\n"),
-                                fpw_filename);
-                }
-                z2 = 0.0;
+                return ((LocationType) (coord - 0.5));
         }
-        if (feof (fpw))
+        return ((LocationType) (coord + 0.5));
+}
+
+
+/*!
+ * \brief Update the courtyard of an \c element.
+ *
+ * The courtyard is derived from the \c BoundingBox of the \c element,
+ * which is kept up to date by the create_new_* functions, thus
+ * enclosing all objects created so far.\n
+ * The package body plus the courtyard clearance with the package, and
+ * the user specified courtyard dimensions are used if they claim even
+ * more real-estate.\n
+ * The result is stored in the Virtual (bounding) Box of the \c element.
+ *
+ * \return \c EXIT_SUCCESS when the courtyard was updated,
+ * \c EXIT_FAILURE when an invalid \c element was passed.
+ */
+int
+update_element_courtyard
+(
+        ElementTypePtr element
+                /*!< : the \c element to update the courtyard of.*/
+)
+{
+        BoxType courtyard_box;
+
+        if (!element)
         {
-                fclose (fpw);
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_INFO,
-                                "read footprint wizard file: %s.\n",
-                                fpw_filename);
-                }
+                return (EXIT_FAILURE);
         }
+        /* Determine (extreme) courtyard dimensions based on the objects
+         * created so far. */
+        courtyard_box = element->BoundingBox;
+        /* Determine (extreme) courtyard dimensions based on package
+         * properties. */
+        courtyard_box.X1 = MIN (courtyard_box.X1,
+                units_to_coord ((-package_body_length / 2.0) - courtyard_clearance_with_package));
+        courtyard_box.X2 = MAX (courtyard_box.X2,
+                units_to_coord ((package_body_length / 2.0) + courtyard_clearance_with_package));
+        courtyard_box.Y1 = MIN (courtyard_box.Y1,
+                units_to_coord ((-package_body_width / 2.0) - courtyard_clearance_with_package));
+        courtyard_box.Y2 = MAX (courtyard_box.Y2,
+                units_to_coord ((package_body_width / 2.0) + courtyard_clearance_with_package));
+        /* If the user input is using even more real-estate then use it. */
+        courtyard_box.X1 = MIN (courtyard_box.X1,
+                units_to_coord (-courtyard_length / 2.0));
+        courtyard_box.X2 = MAX (courtyard_box.X2,
+                units_to_coord (courtyard_length / 2.0));
+        courtyard_box.Y1 = MIN (courtyard_box.Y1,
+                units_to_coord (-courtyard_width / 2.0));
+        courtyard_box.Y2 = MAX (courtyard_box.Y2,
+                units_to_coord (courtyard_width / 2.0));
+        /* Store the courtyard dimensions in Virtual (bounding) Box. */
+        element->VBox = courtyard_box;
         return (EXIT_SUCCESS);
 }
 
@@ -2236,7 +2651,6 @@ int
 write_attributes ()
 {
         /* Attributes in the form "Attribute("name" "value")" */
-        fprintf (fp, "# Write attributes\n");
         fprintf (fp, "\tAttribute(\"author\" \"%s\")\n", footprint_author);
         fprintf (fp, "\tAttribute(\"dist-license\" \"%s\")\n", footprint_dist_license);
         fprintf (fp, "\tAttribute(\"use-license\" \"%s\")\n", footprint_use_license);
@@ -2292,6 +2706,185 @@ write_attributes ()
 }
 
 
+/*!
+ * \brief Translate the \c Flags of a pin or pad into the comma
+ * separated string as used in a footprint file.
+ *
+ * \return a newly allocated string, to be freed with g_free().
+ */
+static gchar *
+write_flags_string
+(
+        FlagType flags
+                /*!< : the flags of a pin or pad.*/
+)
+{
+        GString *flags_string;
+
+        flags_string = g_string_new ("");
+        if (flags.f & SQUARE)
+                g_string_append (flags_string, ",square");
+        if (flags.f & OCTAGON)
+                g_string_append (flags_string, ",octagon");
+        if (flags.f & HOLE)
+                g_string_append (flags_string, ",hole");
+        if (flags.f & ONSOLDER)
+                g_string_append (flags_string, ",onsolder");
+        if (flags.f & NOPASTE)
+                g_string_append (flags_string, ",nopaste");
+        if (flags.f & EDGE2)
+                g_string_append (flags_string, ",edge2");
+        if (flags.f & LOCK)
+                g_string_append (flags_string, ",lock");
+        /* Strip the leading comma. */
+        if (flags_string->len > 0)
+                g_string_erase (flags_string, 0, 1);
+        return (g_string_free (flags_string, FALSE));
+}
+
+
+/*!
+ * \brief Write an \c element to the footprint file.
+ *
+ * This is the generic serializer for every package type: the
+ * *_write_footprint functions build their \c element with the
+ * corresponding *_create_element function and pass it here, so the
+ * footprint file contains exactly the geometry shown in the preview.\n
+ * The caller is responsible for opening (and closing) the footprint
+ * file \c fp and for writing an optional license.
+ *
+ * \return \c EXIT_SUCCESS when the function is completed,
+ * \c EXIT_FAILURE when no valid \c element was passed.
+ */
+int
+write_element
+(
+        ElementTypePtr element
+                /*!< : the \c element to write.*/
+)
+{
+        GList *iter;
+        gchar *flags;
+        guint64 pads = 0;
+        guint64 lines = 0;
+        gint i;
+
+        if (!element)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        (_("[%s] no valid element to write to file: %s.")),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
+        /* Write the element header with the refdes text position. */
+        fprintf
+        (
+                fp,
+                "Element[\"\" \"%s\" \"%s?\" \"%s\" 0 0 %d %d 0 100 \"\"]\n(\n",
+                element->Name[DESCRIPTION_INDEX].TextString,
+                element->Name[NAMEONPCB_INDEX].TextString,
+                element->Name[VALUE_INDEX].TextString,
+                (int) element->Name[NAMEONPCB_INDEX].X,
+                (int) element->Name[NAMEONPCB_INDEX].Y
+        );
+        for (iter = element->Pin; iter != NULL; iter = g_list_next (iter))
+        {
+                PinTypePtr pin = (PinTypePtr) iter->data;
+                flags = write_flags_string (pin->Flags);
+                fprintf
+                (
+                        fp,
+                        "\tPin[%d %d %d %d %d %d \"%s\" \"%s\" \"%s\"]\n",
+                        (int) pin->X,
+                        (int) pin->Y,
+                        (int) pin->Thickness,
+                        (int) pin->Clearance,
+                        (int) pin->Mask,
+                        (int) pin->DrillingHole,
+                        pin->Name,
+                        pin->Number,
+                        flags
+                );
+                g_free (flags);
+                pads++;
+        }
+        for (iter = element->Pad; iter != NULL; iter = g_list_next (iter))
+        {
+                PadTypePtr pad = (PadTypePtr) iter->data;
+                flags = write_flags_string (pad->Flags);
+                fprintf
+                (
+                        fp,
+                        "\tPad[%d %d %d %d %d %d %d \"%s\" \"%s\" \"%s\"]\n",
+                        (int) pad->Point1.X,
+                        (int) pad->Point1.Y,
+                        (int) pad->Point2.X,
+                        (int) pad->Point2.Y,
+                        (int) pad->Thickness,
+                        (int) pad->Clearance,
+                        (int) pad->Mask,
+                        pad->Name,
+                        pad->Number,
+                        flags
+                );
+                g_free (flags);
+                pads++;
+        }
+        for (iter = element->Line; iter != NULL; iter = g_list_next (iter))
+        {
+                LineTypePtr line = (LineTypePtr) iter->data;
+                fprintf
+                (
+                        fp,
+                        "\tElementLine[%d %d %d %d %d]\n",
+                        (int) line->Point1.X,
+                        (int) line->Point1.Y,
+                        (int) line->Point2.X,
+                        (int) line->Point2.Y,
+                        (int) line->Thickness
+                );
+                lines++;
+        }
+        for (iter = element->Arc; iter != NULL; iter = g_list_next (iter))
+        {
+                ArcTypePtr arc = (ArcTypePtr) iter->data;
+                fprintf
+                (
+                        fp,
+                        "\tElementArc[%d %d %d %d %d %d %d]\n",
+                        (int) arc->X,
+                        (int) arc->Y,
+                        (int) arc->Width,
+                        (int) arc->Height,
+                        (int) arc->StartAngle,
+                        (int) arc->Delta,
+                        (int) arc->Thickness
+                );
+                lines++;
+        }
+        stats_count (STATS_PADS, pads);
+        stats_count (STATS_LINES, lines);
+        /* Attributes in the form "Attribute("name" "value")" */
+        if (element->Attributes.Number > 0)
+        {
+                for (i = 0; i < element->Attributes.Number; i++)
+                {
+                        fprintf
+                        (
+                                fp,
+                                "\tAttribute(\"%s\" \"%s\")\n",
+                                element->Attributes.List[i].name,
+                                element->Attributes.List[i].value
+                        );
+                }
+        }
+        /* Finishing touch. */
+        fprintf (fp, "\n");
+        fprintf (fp, ")\n");
+        return (EXIT_SUCCESS);
+}
+
+
 /*!
  * \brief Write an element arc.
  *
@@ -2752,6 +3345,12 @@ write_rectangle
  * \brief Write a footprintwizard file based on the current global
  * variables.
  *
+ * The file is written in the keyed format (version
+ * \c FPW_FORMAT_VERSION): a header with the format version, the package
+ * type, the footprint name and a hash of the parameters, followed by a
+ * "key=value" line for every parameter in \c fpw_fields[].\n
+ * Numbers are written locale independent.
+ *
  * \return \c EXIT_SUCCESS when the function is completed.
  */
 int
@@ -2761,15 +3360,13 @@ write_footprintwizard_file
                 /*!< : a \c NULL terminated fpw_filename.*/
 )
 {
-        /* Write global variables to footprintwizard file with .fpw suffix */
-        FILE *fpw = fopen (fpw_filename, "w");
-        if (!fpw)
-        {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open footprint wizard file: %s for writing."),
-                        fpw_filename);
-                return (EXIT_FAILURE);
-        }
+        FILE *fpw;
+        GString *parameters;
+        gchar number[G_ASCII_DTOSTR_BUF_SIZE];
+        gsize line_start;
+        guint64 hash = G_GUINT64_CONSTANT (14695981039346656037);
+        guint i;
+
         /* Footprint filename may not be null or empty. */
         if (!footprint_filename || (!strcmp (footprint_filename, "")))
         {
@@ -2811,75 +3408,60 @@ write_footprintwizard_file
                         _("could not write footprint wizard file (null or empty pin/pad exception string)."));
                 return (EXIT_FAILURE);
         }
-        /* These variables have been checked for valid content above. */
-        fprintf (fpw, "%s\n", footprint_filename);
-        fprintf (fpw, "%s\n", footprint_name);
-        fprintf (fpw, "%s\n", footprint_type);
-        fprintf (fpw, "%s\n", footprint_units);
-        /* The following string values may contain an empty string.
-         * If a null pointer is encountered an empty string is written as to
-         * prevent "(null)" string values from emerging in the fpw file.
-         * The following values of type double are allowed to be 0.0 .
-         * The following values of type integer are allowed to be 0 .
-         */
-        (!footprint_refdes) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", footprint_refdes);
-        (!footprint_value) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", footprint_value);
-        fprintf (fpw, "%f\n", package_body_length);
-        fprintf (fpw, "%f\n", package_body_width);
-        fprintf (fpw, "%f\n", package_body_height);
-        fprintf (fpw, "%d\n", package_is_radial);
-        (!footprint_author) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", footprint_author);
-        (!footprint_dist_license) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", footprint_dist_license);
-        (!footprint_use_license) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", footprint_use_license);
-        (!footprint_status) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", footprint_status);
-        fprintf (fpw, "%d\n", attributes_in_footprint);
-        fprintf (fpw, "%d\n", number_of_pins);
-        fprintf (fpw, "%d\n", number_of_columns);
-        fprintf (fpw, "%d\n", number_of_rows);
-        fprintf (fpw, "%f\n", pitch_x);
-        fprintf (fpw, "%f\n", pitch_y);
-        fprintf (fpw, "%f\n", count_x);
-        fprintf (fpw, "%f\n", count_y);
-        fprintf (fpw, "%s\n", pad_shape);
-        fprintf (fpw, "%s\n", pin_pad_exceptions_string);
-        (!pin_1_position) ? fprintf (fpw, "\n") :
-                fprintf (fpw, "%s\n", pin_1_position);
-        fprintf (fpw, "%f\n", pad_diameter);
-        fprintf (fpw, "%f\n", pin_drill_diameter);
-        fprintf (fpw, "%d\n", pin1_square);
-        fprintf (fpw, "%f\n", pad_length);
-        fprintf (fpw, "%f\n", pad_width);
-        fprintf (fpw, "%f\n", pad_clearance);
-        fprintf (fpw, "%f\n", pad_solder_mask_clearance);
-        fprintf (fpw, "%d\n", thermal);
-        fprintf (fpw, "%d\n", thermal_nopaste);
-        fprintf (fpw, "%f\n", thermal_length);
-        fprintf (fpw, "%f\n", thermal_width);
-        fprintf (fpw, "%f\n", thermal_clearance);
-        fprintf (fpw, "%f\n", thermal_solder_mask_clearance);
-        fprintf (fpw, "%d\n", fiducial);
-        fprintf (fpw, "%f\n", fiducial_pad_diameter);
-        fprintf (fpw, "%f\n", fiducial_pad_solder_mask_clearance);
-        fprintf (fpw, "%d\n", silkscreen_package_outline);
-        fprintf (fpw, "%d\n", silkscreen_indicate_1);
-        fprintf (fpw, "%f\n", silkscreen_line_width);
-        fprintf (fpw, "%d\n", courtyard);
-        fprintf (fpw, "%f\n", courtyard_length);
-        fprintf (fpw, "%f\n", courtyard_width);
-        fprintf (fpw, "%f\n", courtyard_line_width);
-        fprintf (fpw, "%f\n", courtyard_clearance_with_package);
-        fprintf (fpw, "%f\n", c1);
-        fprintf (fpw, "%f\n", g1);
-        fprintf (fpw, "%f\n", z1);
-        fprintf (fpw, "%f\n", c2);
-        fprintf (fpw, "%f\n", g2);
-        fprintf (fpw, "%f\n", z2);
+        /* Write global variables to footprintwizard file with .fpw suffix */
+        fpw = fopen (fpw_filename, "w");
+        if (!fpw)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not open footprint wizard file: %s for writing."),
+                        fpw_filename);
+                return (EXIT_FAILURE);
+        }
+        /* Collect the parameter lines first, the hash of the parameters
+         * goes into the header.
+         * String values may contain an empty string, if a null pointer is
+         * encountered an empty string is written as to prevent "(null)"
+         * string values from emerging in the fpw file. */
+        parameters = g_string_sized_new (2048);
+        for (i = 0; i < G_N_ELEMENTS (fpw_fields); i++)
+        {
+                if ((fpw_fields[i].value == &footprint_type) ||
+                        (fpw_fields[i].value == &footprint_name))
+                {
+                        /* These are written in the header. */
+                        continue;
+                }
+                line_start = parameters->len;
+                g_string_append (parameters, fpw_fields[i].name);
+                g_string_append_c (parameters, '=');
+                switch (fpw_fields[i].type)
+                {
+                        case FPW_STRING:
+                                if (*(gchar **) fpw_fields[i].value)
+                                {
+                                        g_string_append (parameters, *(gchar **) fpw_fields[i].value);
+                                }
+                                break;
+                        case FPW_DOUBLE:
+                                g_string_append (parameters, g_ascii_formatd (number,
+                                        sizeof (number), "%f", *(gdouble *) fpw_fields[i].value));
+                                break;
+                        case FPW_INTEGER:
+                                g_string_append_printf (parameters, "%d", *(gint *) fpw_fields[i].value);
+                                break;
+                        default:
+                                break;
+                }
+                hash = hash_fpw_line (hash, parameters->str + line_start,
+                        parameters->len - line_start);
+                g_string_append_c (parameters, '\n');
+        }
+        fprintf (fpw, "fpw_version=%d\n", FPW_FORMAT_VERSION);
+        fprintf (fpw, "footprint_type=%s\n", footprint_type);
+        fprintf (fpw, "footprint_name=%s\n", footprint_name);
+        fprintf (fpw, "parameter_hash=%016" G_GINT64_MODIFIER "x\n", hash);
+        fputs (parameters->str, fpw);
+        g_string_free (parameters, TRUE);
         fclose (fpw);
         fprintf (stderr, "SUCCESS: wrote Footprintwizard file %s.\n",
                 fpw_filename);
@@ -2888,16 +3470,22 @@ write_footprintwizard_file
 
 
 /*!
- * \brief Write a footprint based on the global variables.
+ * \brief Generate a footprint based on the global variables.
  *
  * This function does not write the footprint file itself.\n
  * It is a dispatcher for helper functions who <b>actually</b> do write
- * the contents for the footprint to file.
+ * the contents for the footprint to file, after a DRC of the package.
  *
- * \return \c EXIT_SUCCESS when the function is completed.
+ * \return \c EXIT_SUCCESS when the package type is known,
+ * \c EXIT_FAILURE when the package type is unknown.
  */
 int
-write_footprint()
+generate_footprint
+(
+        gboolean *drc_passed
+                /*!< : is set to the DRC verdict, the footprint is only
+                 * written when the DRC passed.*/
+)
 {
         int error_found;
         error_found = FALSE;
@@ -2905,9 +3493,9 @@ write_footprint()
         switch (package_type)
         {
                 case BGA:
-                        if (bga_drc() == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, bga_drc) == EXIT_SUCCESS)
                         {
-                                bga_write_footprint ();
+                                stats_run (STATS_GEOMETRY, bga_write_footprint);
                         }
                         else
                         {
@@ -2915,9 +3503,9 @@ write_footprint()
                         }
                         break;
                 case CAPA:
-                        if (capa_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, capa_drc) == EXIT_SUCCESS)
                         {
-                                capa_write_footprint ();
+                                stats_run (STATS_GEOMETRY, capa_write_footprint);
                         }
                         else
                         {
@@ -2925,9 +3513,9 @@ write_footprint()
                         }
                         break;
                 case CAPAD:
-                        if (capad_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, capad_drc) == EXIT_SUCCESS)
                         {
-                                capad_write_footprint ();
+                                stats_run (STATS_GEOMETRY, capad_write_footprint);
                         }
                         else
                         {
@@ -2935,9 +3523,9 @@ write_footprint()
                         }
                         break;
                 case CAPC:
-                        if (capc_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, capc_drc) == EXIT_SUCCESS)
                         {
-                                capc_write_footprint ();
+                                stats_run (STATS_GEOMETRY, capc_write_footprint);
                         }
                         else
                         {
@@ -2945,9 +3533,9 @@ write_footprint()
                         }
                         break;
                 case CAPM:
-                        if (capm_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, capm_drc) == EXIT_SUCCESS)
                         {
-                                capm_write_footprint ();
+                                stats_run (STATS_GEOMETRY, capm_write_footprint);
                         }
                         else
                         {
@@ -2955,9 +3543,9 @@ write_footprint()
                         }
                         break;
                 case CAPMP:
-                        if (capmp_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, capmp_drc) == EXIT_SUCCESS)
                         {
-                                capmp_write_footprint ();
+                                stats_run (STATS_GEOMETRY, capmp_write_footprint);
                         }
                         else
                         {
@@ -2965,9 +3553,9 @@ write_footprint()
                         }
                         break;
                 case CAPPR:
-                        if (cappr_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, cappr_drc) == EXIT_SUCCESS)
                         {
-                                cappr_write_footprint ();
+                                stats_run (STATS_GEOMETRY, cappr_write_footprint);
                         }
                         else
                         {
@@ -2975,9 +3563,9 @@ write_footprint()
                         }
                         break;
                 case CON_DIL:
-                        if (con_dil_drc() == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, con_dil_drc) == EXIT_SUCCESS)
                         {
-                                con_dil_write_footprint ();
+                                stats_run (STATS_GEOMETRY, con_dil_write_footprint);
                         }
                         else
                         {
@@ -2985,9 +3573,9 @@ write_footprint()
                         }
                         break;
                 case CON_DIP:
-                        if (con_dip_drc() == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, con_dip_drc) == EXIT_SUCCESS)
                         {
-                                con_dip_write_footprint ();
+                                stats_run (STATS_GEOMETRY, con_dip_write_footprint);
                         }
                         else
                         {
@@ -2995,9 +3583,9 @@ write_footprint()
                         }
                         break;
                 case CON_HDR:
-                        if (con_hdr_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, con_hdr_drc) == EXIT_SUCCESS)
                         {
-                                con_hdr_write_footprint ();
+                                stats_run (STATS_GEOMETRY, con_hdr_write_footprint);
                         }
                         else
                         {
@@ -3005,9 +3593,9 @@ write_footprint()
                         }
                         break;
                 case CON_SIL:
-                        if (con_sil_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, con_sil_drc) == EXIT_SUCCESS)
                         {
-                                con_sil_write_footprint ();
+                                stats_run (STATS_GEOMETRY, con_sil_write_footprint);
                         }
                         else
                         {
@@ -3018,9 +3606,9 @@ write_footprint()
                         return (EXIT_FAILURE);
                         break;
                 case DIOAD:
-                        if (dioad_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, dioad_drc) == EXIT_SUCCESS)
                         {
-                                dioad_write_footprint ();                        break;
+                                stats_run (STATS_GEOMETRY, dioad_write_footprint);                        break;
                         }
                         else
                         {
@@ -3028,9 +3616,9 @@ write_footprint()
                         }
                         break;
                 case DIOM:
-                        if (diom_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, diom_drc) == EXIT_SUCCESS)
                         {
-                                diom_write_footprint ();                        break;
+                                stats_run (STATS_GEOMETRY, diom_write_footprint);                        break;
                         }
                         else
                         {
@@ -3038,9 +3626,9 @@ write_footprint()
                         }
                         break;
                 case DIOMELF:
-                        if (diomelf_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, diomelf_drc) == EXIT_SUCCESS)
                         {
-                                diomelf_write_footprint ();
+                                stats_run (STATS_GEOMETRY, diomelf_write_footprint);
                         }
                         else
                         {
@@ -3048,9 +3636,9 @@ write_footprint()
                         }
                         break;
                 case DIP:
-                        if (dip_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, dip_drc) == EXIT_SUCCESS)
                         {
-                                dip_write_footprint ();
+                                stats_run (STATS_GEOMETRY, dip_write_footprint);
                         }
                         else
                         {
@@ -3058,9 +3646,9 @@ write_footprint()
                         }
                         break;
                 case DIPS:
-                        if (dips_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, dips_drc) == EXIT_SUCCESS)
                         {
-                                dips_write_footprint ();
+                                stats_run (STATS_GEOMETRY, dips_write_footprint);
                         }
                         else
                         {
@@ -3068,9 +3656,9 @@ write_footprint()
                         }
                         break;
                 case HDRV:
-                        if (hdrv_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, hdrv_drc) == EXIT_SUCCESS)
                         {
-                                hdrv_write_footprint ();
+                                stats_run (STATS_GEOMETRY, hdrv_write_footprint);
                         }
                         else
                         {
@@ -3078,9 +3666,9 @@ write_footprint()
                         }
                         break;
                 case INDAD:
-                        if (indad_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, indad_drc) == EXIT_SUCCESS)
                         {
-                                indad_write_footprint ();
+                                stats_run (STATS_GEOMETRY, indad_write_footprint);
                         }
                         else
                         {
@@ -3088,9 +3676,9 @@ write_footprint()
                         }
                         break;
                 case INDC:
-                        if (indc_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, indc_drc) == EXIT_SUCCESS)
                         {
-                                indc_write_footprint ();
+                                stats_run (STATS_GEOMETRY, indc_write_footprint);
                         }
                         else
                         {
@@ -3098,9 +3686,9 @@ write_footprint()
                         }
                         break;
                 case INDM:
-                        if (indm_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, indm_drc) == EXIT_SUCCESS)
                         {
-                                indm_write_footprint ();
+                                stats_run (STATS_GEOMETRY, indm_write_footprint);
                         }
                         else
                         {
@@ -3108,9 +3696,9 @@ write_footprint()
                         }
                         break;
                 case INDP:
-                        if (indp_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, indp_drc) == EXIT_SUCCESS)
                         {
-                                indp_write_footprint ();
+                                stats_run (STATS_GEOMETRY, indp_write_footprint);
                         }
                         else
                         {
@@ -3118,9 +3706,9 @@ write_footprint()
                         }
                         break;
                 case JUMP:
-                        if (jump_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, jump_drc) == EXIT_SUCCESS)
                         {
-                                jump_write_footprint ();
+                                stats_run (STATS_GEOMETRY, jump_write_footprint);
                         }
                         else
                         {
@@ -3128,9 +3716,9 @@ write_footprint()
                         }
                         break;
                 case MTGNP:
-                        if (mtgnp_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, mtgnp_drc) == EXIT_SUCCESS)
                         {
-                                mtgnp_write_footprint ();
+                                stats_run (STATS_GEOMETRY, mtgnp_write_footprint);
                         }
                         else
                         {
@@ -3138,9 +3726,9 @@ write_footprint()
                         }
                         break;
                 case MTGP:
-                        if (mtgp_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, mtgp_drc) == EXIT_SUCCESS)
                         {
-                                mtgp_write_footprint ();
+                                stats_run (STATS_GEOMETRY, mtgp_write_footprint);
                         }
                         else
                         {
@@ -3148,9 +3736,9 @@ write_footprint()
                         }
                         break;
                 case PGA:
-                        if (pga_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, pga_drc) == EXIT_SUCCESS)
                         {
-                                pga_write_footprint ();
+                                stats_run (STATS_GEOMETRY, pga_write_footprint);
                         }
                         else
                         {
@@ -3158,9 +3746,9 @@ write_footprint()
                         }
                         break;
                 case PLCC:
-                        if (plcc_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, plcc_drc) == EXIT_SUCCESS)
                         {
-                                plcc_write_footprint ();
+                                stats_run (STATS_GEOMETRY, plcc_write_footprint);
                         }
                         else
                         {
@@ -3168,15 +3756,29 @@ write_footprint()
                         }
                         break;
                 case QFN:
-                        return (EXIT_FAILURE);
+                        if (stats_run (STATS_DRC, qfn_drc) == EXIT_SUCCESS)
+                        {
+                                stats_run (STATS_GEOMETRY, qfn_write_footprint);
+                        }
+                        else
+                        {
+                                error_found = TRUE;
+                        }
                         break;
                 case QFP:
-                        return (EXIT_FAILURE);
+                        if (stats_run (STATS_DRC, qfp_drc) == EXIT_SUCCESS)
+                        {
+                                stats_run (STATS_GEOMETRY, qfp_write_footprint);
+                        }
+                        else
+                        {
+                                error_found = TRUE;
+                        }
                         break;
                 case RES:
-                        if (res_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, res_drc) == EXIT_SUCCESS)
                         {
-                                res_write_footprint ();
+                                stats_run (STATS_GEOMETRY, res_write_footprint);
                         }
                         else
                         {
@@ -3184,9 +3786,9 @@ write_footprint()
                         }
                         break;
                 case RESAD:
-                        if (resad_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, resad_drc) == EXIT_SUCCESS)
                         {
-                                resad_write_footprint ();
+                                stats_run (STATS_GEOMETRY, resad_write_footprint);
                         }
                         else
                         {
@@ -3194,9 +3796,9 @@ write_footprint()
                         }
                         break;
                 case RESAR:
-                        if (resar_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, resar_drc) == EXIT_SUCCESS)
                         {
-                                resar_write_footprint ();
+                                stats_run (STATS_GEOMETRY, resar_write_footprint);
                         }
                         else
                         {
@@ -3204,9 +3806,9 @@ write_footprint()
                         }
                         break;
                 case RESC:
-                        if (resc_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, resc_drc) == EXIT_SUCCESS)
                         {
-                                resc_write_footprint ();
+                                stats_run (STATS_GEOMETRY, resc_write_footprint);
                         }
                         else
                         {
@@ -3214,9 +3816,9 @@ write_footprint()
                         }
                         break;
                 case RESM:
-                        if (resm_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, resm_drc) == EXIT_SUCCESS)
                         {
-                                resm_write_footprint ();
+                                stats_run (STATS_GEOMETRY, resm_write_footprint);
                         }
                         else
                         {
@@ -3224,9 +3826,9 @@ write_footprint()
                         }
                         break;
                 case RESMELF:
-                        if (resmelf_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, resmelf_drc) == EXIT_SUCCESS)
                         {
-                                resmelf_write_footprint ();
+                                stats_run (STATS_GEOMETRY, resmelf_write_footprint);
                         }
                         else
                         {
@@ -3234,9 +3836,9 @@ write_footprint()
                         }
                         break;
                 case SIL:
-                        if (sil_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, sil_drc) == EXIT_SUCCESS)
                         {
-                                sil_write_footprint ();
+                                stats_run (STATS_GEOMETRY, sil_write_footprint);
                         }
                         else
                         {
@@ -3244,9 +3846,9 @@ write_footprint()
                         }
                         break;
                 case SIP:
-                        if (sip_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, sip_drc) == EXIT_SUCCESS)
                         {
-                                sip_write_footprint ();
+                                stats_run (STATS_GEOMETRY, sip_write_footprint);
                         }
                         else
                         {
@@ -3254,12 +3856,19 @@ write_footprint()
                         }
                         break;
                 case SO:
-                        return (EXIT_FAILURE);
+                        if (stats_run (STATS_DRC, so_drc) == EXIT_SUCCESS)
+                        {
+                                stats_run (STATS_GEOMETRY, so_write_footprint);
+                        }
+                        else
+                        {
+                                error_found = TRUE;
+                        }
                         break;
                 case SOT:
-                        if (sot_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, sot_drc) == EXIT_SUCCESS)
                         {
-                                sot_write_footprint ();
+                                stats_run (STATS_GEOMETRY, sot_write_footprint);
                         }
                         else
                         {
@@ -3267,9 +3876,9 @@ write_footprint()
                         }
                         break;
                 case TO92:
-                        if (to_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, to_drc) == EXIT_SUCCESS)
                         {
-                                to_write_footprint_to92 ();
+                                stats_run (STATS_GEOMETRY, to_write_footprint_to92);
                         }
                         else
                         {
@@ -3277,9 +3886,9 @@ write_footprint()
                         }
                         break;
                 case TO220:
-                        if (to_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, to_drc) == EXIT_SUCCESS)
                         {
-                                to_write_footprint_to220 ();
+                                stats_run (STATS_GEOMETRY, to_write_footprint_to220);
                         }
                         else
                         {
@@ -3287,9 +3896,9 @@ write_footprint()
                         }
                         break;
                 case TO220S:
-                        if (to_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, to_drc) == EXIT_SUCCESS)
                         {
-                                to_write_footprint_to220_staggered ();
+                                stats_run (STATS_GEOMETRY, to_write_footprint_to220_staggered);
                         }
                         else
                         {
@@ -3297,9 +3906,9 @@ write_footprint()
                         }
                         break;
                 case TO220SW:
-                        if (to_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, to_drc) == EXIT_SUCCESS)
                         {
-                                to_write_footprint_to220_standing_staggered ();
+                                stats_run (STATS_GEOMETRY, to_write_footprint_to220_standing_staggered);
                         }
                         else
                         {
@@ -3307,9 +3916,9 @@ write_footprint()
                         }
                         break;
                 case TO220W:
-                        if (to_drc () == EXIT_SUCCESS)
+                        if (stats_run (STATS_DRC, to_drc) == EXIT_SUCCESS)
                         {
-                                to_write_footprint_to220_standing ();
+                                stats_run (STATS_GEOMETRY, to_write_footprint_to220_standing);
                         }
                         else
                         {
@@ -3325,13 +3934,171 @@ write_footprint()
                         return (EXIT_FAILURE);
                         break;
         }
-        if (error_found)
+        *drc_passed = !error_found;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a footprint based on the global variables.
+ *
+ * A footprint which was generated before with the same parameters is
+ * taken from the cache of generated footprints in memory or in the cache
+ * directory, otherwise the footprint is generated with
+ * generate_footprint () and added to both caches.
+ *
+ * \return \c EXIT_SUCCESS when the footprint is written,
+ * \c EXIT_FAILURE when the package type is unknown, the DRC found
+ * errors or writing failed.
+ */
+int
+write_footprint ()
+{
+        footprint_cache_entry_t *entry;
+        FILE *output;
+        gchar *parameters;
+        gchar *text = NULL;
+        gsize size = 0;
+        guint64 hash;
+        gboolean drc_passed = FALSE;
+        gint result = EXIT_FAILURE;
+
+        parameters = footprint_cache_get_parameters ();
+        hash = footprint_cache_get_hash (parameters);
+        entry = footprint_cache_lookup (hash, parameters);
+        if (entry)
+        {
+                g_free (parameters);
+                drc_passed = entry->drc_passed;
+                text = entry->text;
+                size = entry->size;
+                stats_count (STATS_CACHE_HITS, 1);
+        }
+        else if (footprint_cache_load (hash, parameters, &drc_passed, &text, &size) == EXIT_SUCCESS)
+        {
+                /* Generated before by this or another process, found in
+                 * the cache directory. */
+                stats_count (STATS_CACHE_HITS, 1);
+        }
+        else
+        {
+                /* Generate the footprint in memory. */
+                output = footprint_output;
+                footprint_output = open_memstream (&text, &size);
+                if (!footprint_output
+                        || (generate_footprint (&drc_passed) == EXIT_FAILURE))
+                {
+                        if (footprint_output)
+                        {
+                                fclose (footprint_output);
+                        }
+                        footprint_output = output;
+                        g_free (parameters);
+                        free (text);
+                        return (EXIT_FAILURE);
+                }
+                fclose (footprint_output);
+                footprint_output = output;
+                if (!drc_passed)
+                {
+                        free (text);
+                        text = NULL;
+                        size = 0;
+                }
+                footprint_cache_store (hash, parameters, drc_passed, text, size);
+        }
+        if (!drc_passed)
         {
                 g_log ("", G_LOG_LEVEL_WARNING,
                         (_("no [%s] footprint written: found DRC errors while checking package %s.")),
                         footprint_type, footprint_name);
         }
+        else if (!(fp = open_footprint_file ()))
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not open footprint file %s for writing."),
+                                footprint_filename);
+                }
+        }
+        else
+        {
+                fwrite (text, 1, size, fp);
+                result = close_footprint_file ();
+                if (result == EXIT_SUCCESS)
+                {
+                        stats_count (STATS_FOOTPRINTS, 1);
+                        stats_count (STATS_BYTES, size);
+                }
+        }
+        if (!entry)
+        {
+                /* The cache takes ownership of the parameters and text. */
+                footprint_cache_insert (hash, parameters, drc_passed, text, size);
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Write a footprint from the element of a package type.
+ *
+ * The element is created with the \c create_element function of the
+ * package type, optionally preceded by a license and serialized with
+ * write_element () to the file opened with open_footprint_file ().
+ *
+ * \return \c EXIT_FAILURE when errors were encountered,
+ * \c EXIT_SUCCESS when OK.
+ */
+int
+write_footprint_element
+(
+        int (*create_element) ()
+                /*!< : creates \c current_element from the current
+                 * footprint values.*/
+)
+{
+        /* Create the element from the current footprint values. */
+        if (create_element () == EXIT_FAILURE)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not create an element for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
+        /* Attempt to open a file with write permission. */
+        fp = open_footprint_file ();
+        if (!fp)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not open file for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
+        /* Print a license if requested. */
+        if (license_in_footprint)
+        {
+                write_license ();
+        }
+        /* Serialize the element. */
+        write_element (current_element);
+        if (close_footprint_file () == EXIT_FAILURE)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not write file for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("wrote a footprint for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
+        }
         return (EXIT_SUCCESS);
 }
 
+
 /* EOF */
@@ -36,6 +36,7 @@
 
 G_BEGIN_DECLS /* keep c++ happy */
 
+int close_footprint_file ();
 AttributeTypePtr create_new_attribute (AttributeListTypePtr list, char *name, char *value);
 
 ElementTypePtr current_element;
@@ -43,6 +44,19 @@ ElementTypePtr current_element;
 GList *packages_list;
 
 ElementTypePtr create_attributes_in_element (ElementTypePtr element);
+int create_grid_array
+(
+        ElementTypePtr element,
+        gint rows,
+        gint columns,
+        gdouble pitch_x,
+        gdouble pitch_y,
+        grid_naming_t naming,
+        gboolean *exceptions,
+        gboolean pin1_is_square,
+        PinTypePtr pin,
+        PadTypePtr pad
+);
 ArcTypePtr create_new_arc 
 (
         ElementTypePtr element,
@@ -60,6 +74,7 @@ AttributeTypePtr create_new_attribute
         char *name,
         char *value
 );
+ElementTypePtr create_new_element ();
 LineTypePtr create_new_line
 (
         ElementTypePtr element,
@@ -96,15 +111,40 @@ PinTypePtr create_new_pin
         char *number,
         FlagType flags
 );
+int create_perimeter_array
+(
+        ElementTypePtr element,
+        gint count_x,
+        gint count_y,
+        gdouble pitch_x,
+        gdouble pitch_y,
+        gdouble row_distance,
+        gdouble column_distance,
+        LocationType length,
+        location_t pin1_location,
+        gboolean *exceptions,
+        gboolean pin1_is_square,
+        gboolean thermal_pad,
+        PadTypePtr pad
+);
+int free_element (ElementTypePtr element);
 int get_package_type ();
+gboolean *get_grid_exceptions (gint rows, gint columns, grid_naming_t naming);
+gdouble get_pad_row_distance (gint row);
 int get_pin_pad_exception (gchar *pin_pad_name);
 int get_status_type ();
 int get_total_number_of_pins ();
+FILE *open_footprint_file ();
 int read_footprintwizard_file (gchar *fpw_filename);
+int read_footprintwizard_file_header (gchar *fpw_filename, fpw_header_t *header);
+int set_footprintwizard_value (const gchar *name, const gchar *text, gsize length, gchar *source);
+LocationType units_to_coord (gdouble value);
+int update_element_courtyard (ElementTypePtr element);
 int update_location_variables ();
 int update_pad_shapes_variables ();
 int update_units_variables ();
 int write_attributes ();
+int write_element (ElementTypePtr element);
 int write_element_arc
 (
         gdouble x,
@@ -164,7 +204,9 @@ int write_rectangle
 );
 int
 write_footprintwizard_file (gchar *fpw_filename);
+int generate_footprint (gboolean *drc_passed);
 int write_footprint ();
+int write_footprint_element (int (*create_element) ());
 
 G_END_DECLS /* keep c++ happy */
 
@@ -0,0 +1,2140 @@
+/*!
+ * \file src/library.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for the footprint library (fpw_data.csv and
+ * user_data.csv).
+ *
+ * A footprint library is a semicolon separated csv file with a header
+ * line and one footprint per line, the columns mirror the global
+ * variables of a footprint.\n
+ * The library is read into a table which is stored column wise, so a
+ * search on a few columns only touches the memory of those columns.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include "library.h"
+
+
+/*!
+ * \brief The columns of a footprint library, in the order of
+ * library_column_t, with the global variable each column mirrors.
+ */
+static library_column_definition_t library_columns[] =
+{
+        {"footprint_id", LIBRARY_INTEGER, NULL},
+        {"footprint_type", LIBRARY_PACKAGE, &package_type},
+        {"footprint_name", LIBRARY_STRING, &footprint_name},
+        {"footprint_units", LIBRARY_UNITS, &units_type},
+        {"footprint_status", LIBRARY_STATUS, &status_type},
+        {"package_body_length", LIBRARY_DOUBLE, &package_body_length},
+        {"package_body_width", LIBRARY_DOUBLE, &package_body_width},
+        {"package_body_height", LIBRARY_DOUBLE, &package_body_height},
+        {"package_is_radial", LIBRARY_BOOLEAN, &package_is_radial},
+        {"number_of_pins", LIBRARY_INTEGER, &number_of_pins},
+        {"number_of_columns", LIBRARY_INTEGER, &number_of_columns},
+        {"number_of_rows", LIBRARY_INTEGER, &number_of_rows},
+        {"pin1_location", LIBRARY_LOCATION, &pin1_location},
+        {"pitch_x", LIBRARY_DOUBLE, &pitch_x},
+        {"pitch_y", LIBRARY_DOUBLE, &pitch_y},
+        {"count_x", LIBRARY_INTEGER, &count_x},
+        {"count_y", LIBRARY_INTEGER, &count_y},
+        {"pin_pad_exceptions_string", LIBRARY_STRING, &pin_pad_exceptions_string},
+        {"number_of_exceptions", LIBRARY_INTEGER, &number_of_exceptions},
+        {"pin_drill_diameter", LIBRARY_DOUBLE, &pin_drill_diameter},
+        {"pad_diameter", LIBRARY_DOUBLE, &pad_diameter},
+        {"pad_length", LIBRARY_DOUBLE, &pad_length},
+        {"pad_width", LIBRARY_DOUBLE, &pad_width},
+        {"pad_shapes_type", LIBRARY_PAD_SHAPE, &pad_shapes_type},
+        {"pin1_square", LIBRARY_BOOLEAN, &pin1_square},
+        {"pad_solder_mask_clearance", LIBRARY_DOUBLE, &pad_solder_mask_clearance},
+        {"pad_clearance", LIBRARY_DOUBLE, &pad_clearance},
+        {"silkscreen_package_outline", LIBRARY_BOOLEAN, &silkscreen_package_outline},
+        {"silkscreen_indicate_1", LIBRARY_BOOLEAN, &silkscreen_indicate_1},
+        {"silkscreen_length", LIBRARY_DOUBLE, &silkscreen_length},
+        {"silkscreen_width", LIBRARY_DOUBLE, &silkscreen_width},
+        {"silkscreen_line_width", LIBRARY_DOUBLE, &silkscreen_line_width},
+        {"courtyard", LIBRARY_BOOLEAN, &courtyard},
+        {"courtyard_length", LIBRARY_DOUBLE, &courtyard_length},
+        {"courtyard_width", LIBRARY_DOUBLE, &courtyard_width},
+        {"courtyard_line_width", LIBRARY_DOUBLE, &courtyard_line_width},
+        {"courtyard_clearance_with_package", LIBRARY_DOUBLE, &courtyard_clearance_with_package},
+        {"thermal", LIBRARY_BOOLEAN, &thermal},
+        {"thermal_nopaste", LIBRARY_BOOLEAN, &thermal_nopaste},
+        {"thermal_length", LIBRARY_DOUBLE, &thermal_length},
+        {"thermal_width", LIBRARY_DOUBLE, &thermal_width},
+        {"thermal_solder_mask_clearance", LIBRARY_DOUBLE, &thermal_solder_mask_clearance},
+        {"thermal_clearance", LIBRARY_DOUBLE, &thermal_clearance},
+        {"fiducial", LIBRARY_BOOLEAN, &fiducial},
+        {"fiducial_pad_diameter", LIBRARY_DOUBLE, &fiducial_pad_diameter},
+        {"fiducial_pad_solder_mask_clearance", LIBRARY_DOUBLE, &fiducial_pad_solder_mask_clearance},
+        {"fiducial_clearance", LIBRARY_DOUBLE, &fiducial_pad_clearance},
+        {"c1", LIBRARY_DOUBLE, &c1},
+        {"g1", LIBRARY_DOUBLE, &g1},
+        {"z1", LIBRARY_DOUBLE, &z1},
+        {"c2", LIBRARY_DOUBLE, &c2},
+        {"g2", LIBRARY_DOUBLE, &g2},
+        {"z2", LIBRARY_DOUBLE, &z2},
+        {"remarks", LIBRARY_STRING, NULL},
+        {"warning", LIBRARY_STRING, NULL}
+};
+
+/*!
+ * \brief Names of the package types in a footprint library, in the order
+ * of package_t.
+ */
+static gchar *library_package_names[] =
+{
+        "NO_TYPE", "BGA", "CAPA", "CAPAD", "CAPAE", "CAPC", "CAPM", "CAPMP",
+        "CAPPR", "CON_DIL", "CON_DIP", "CON_HDR", "CON_SIL", "DIL", "DIOAD",
+        "DIOM", "DIOMELF", "DIP", "DIPS", "DO", "HDRV", "INDAD", "INDC",
+        "INDM", "INDP", "JUMP", "MTGNP", "MTGP", "PGA", "PLCC", "QFN", "QFP",
+        "RES", "RESAD", "RESAR", "RESC", "RESM", "RESMELF", "SIL", "SIP",
+        "SO", "SOT", "TO", "TO92", "TO220", "TO220S", "TO220SW", "TO220W"
+};
+
+/*!
+ * \brief Names of the units types in a footprint library, in the order
+ * of units_t.
+ */
+static gchar *library_units_names[] =
+{
+        "NO_UNITS", "mil", "mil/100", "mm"
+};
+
+/*!
+ * \brief Names of the status types in a footprint library, in the order
+ * of status_t.
+ */
+static gchar *library_status_names[] =
+{
+        "NO_STATUS", "EXPERIMENTAL", "PRIVATE", "PUBLIC", "STABLE"
+};
+
+/*!
+ * \brief Names of the pin #1 locations in a footprint library, in the
+ * order of location_t.
+ */
+static gchar *library_location_names[] =
+{
+        "NO_LOCATION", "UPPER_LEFT", "MIDDLE_LEFT", "LOWER_LEFT",
+        "UPPER_MIDDLE", "MIDDLE_MIDDLE", "LOWER_MIDDLE", "UPPER_RIGHT",
+        "MIDDLE_RIGHT", "LOWER_RIGHT", "LEFT_TOP", "RIGHT_TOP",
+        "LEFT_BOTTOM", "RIGHT_BOTTOM"
+};
+
+/*!
+ * \brief Names of the pad shapes in a footprint library, in the order of
+ * pad_shapes_t.
+ */
+static gchar *library_pad_shape_names[] =
+{
+        "NO_SHAPE", "ROUND", "SQUARE", "OCTAGONAL", "ROUND_ELONGATED"
+};
+
+/*!
+ * \brief The footprint_status strings of a footprintwizard file, in the
+ * order of status_t.
+ */
+static gchar *library_status_strings[] =
+{
+        "", "Experimental", "Private (not published)", "Public (released)",
+        "Stable (confirmed by peers)"
+};
+
+/*!
+ * \brief The pin_1_position strings of a footprintwizard file, in the
+ * order of location_t.
+ */
+static gchar *library_location_strings[] =
+{
+        "", "Upper left", "Middle left", "Lower left", "Upper middle",
+        "Middle middle", "Lower middle", "Upper right", "Middle right",
+        "Lower right", "Left topside", "Right topside", "Left bottomside",
+        "Right bottomside"
+};
+
+/*!
+ * \brief The pad_shape strings of a footprintwizard file, in the order
+ * of pad_shapes_t.
+ */
+static gchar *library_pad_shape_strings[] =
+{
+        "", "circular pad", "rectangular pad", "octagonal pad",
+        "rounded pad, elongated"
+};
+
+/*!
+ * \brief Names of the dimensions of a nearest package search, in the
+ * order of library_dimension_t.
+ */
+static gchar *library_dimension_names[] =
+{
+        "package_body_length", "package_body_width", "package_body_height",
+        "pitch", "number_of_pins"
+};
+
+/*!
+ * \brief The package types with a list of predefined packages.
+ */
+static struct
+{
+        package_t type;
+                /*!< : is the package type.*/
+        int (*create_packages_list) ();
+                /*!< : creates the list of predefined packages.*/
+        int (*get_default_footprint_values) ();
+                /*!< : sets the values of a predefined package.*/
+} library_packages[] =
+{
+        {BGA, bga_create_packages_list, bga_get_default_footprint_values},
+        {CAPA, capa_create_packages_list, capa_get_default_footprint_values},
+        {CAPAD, capad_create_packages_list, capad_get_default_footprint_values},
+        {CAPC, capc_create_packages_list, capc_get_default_footprint_values},
+        {CAPM, capm_create_packages_list, capm_get_default_footprint_values},
+        {CAPMP, capmp_create_packages_list, capmp_get_default_footprint_values},
+        {CAPPR, cappr_create_packages_list, cappr_get_default_footprint_values},
+        {CON_DIL, con_dil_create_packages_list, con_dil_get_default_footprint_values},
+        {CON_DIP, con_dip_create_packages_list, con_dip_get_default_footprint_values},
+        {CON_HDR, con_hdr_create_packages_list, con_hdr_get_default_footprint_values},
+        {CON_SIL, con_sil_create_packages_list, con_sil_get_default_footprint_values},
+        {DIOAD, dioad_create_packages_list, dioad_get_default_footprint_values},
+        {DIOM, diom_create_packages_list, diom_get_default_footprint_values},
+        {DIOMELF, diomelf_create_packages_list, diomelf_get_default_footprint_values},
+        {DIP, dip_create_packages_list, dip_get_default_footprint_values},
+        {DIPS, dips_create_packages_list, dips_get_default_footprint_values},
+        {HDRV, hdrv_create_packages_list, hdrv_get_default_footprint_values},
+        {INDAD, indad_create_packages_list, indad_get_default_footprint_values},
+        {INDC, indc_create_packages_list, indc_get_default_footprint_values},
+        {INDM, indm_create_packages_list, indm_get_default_footprint_values},
+        {INDP, indp_create_packages_list, indp_get_default_footprint_values},
+        {JUMP, jump_create_packages_list, jump_get_default_footprint_values},
+        {MTGNP, mtgnp_create_packages_list, mtgnp_get_default_footprint_values},
+        {MTGP, mtgp_create_packages_list, mtgp_get_default_footprint_values},
+        {PGA, pga_create_packages_list, pga_get_default_footprint_values},
+        {PLCC, plcc_create_packages_list, plcc_get_default_footprint_values},
+        {QFN, qfn_create_packages_list, qfn_get_default_footprint_values},
+        {QFP, qfp_create_packages_list, qfp_get_default_footprint_values},
+        {RES, res_create_packages_list, res_get_default_footprint_values},
+        {RESAD, resad_create_packages_list, resad_get_default_footprint_values},
+        {RESAR, resar_create_packages_list, resar_get_default_footprint_values},
+        {RESC, resc_create_packages_list, resc_get_default_footprint_values},
+        {RESM, resm_create_packages_list, resm_get_default_footprint_values},
+        {RESMELF, resmelf_create_packages_list, resmelf_get_default_footprint_values},
+        {SIL, sil_create_packages_list, sil_get_default_footprint_values},
+        {SIP, sip_create_packages_list, sip_get_default_footprint_values},
+        {SO, so_create_packages_list, so_get_default_footprint_values},
+        {SOT, sot_create_packages_list, sot_get_default_footprint_values},
+        {TO, to_create_packages_list, to_get_default_footprint_values}
+};
+
+/*!
+ * \brief Two values are equal when they differ less than this.
+ */
+#define LIBRARY_EPSILON 1e-9
+
+
+/*!
+ * \brief Compare a value of a column with another value, for sorting.
+ *
+ * Strings are compared with strcmp (), enumerated values by their value,
+ * numbers that differ less than \c LIBRARY_EPSILON are equal.
+ *
+ * \return a negative value, 0 or a positive value when the value in
+ * \c row is less than, equal to or greater than the other value.
+ */
+static gint
+library_compare_value
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        library_column_t column,
+                /*!< : the column.*/
+        guint row,
+                /*!< : the row of the value.*/
+        gdouble number,
+                /*!< : the other value of a numeric column.*/
+        const gchar *string
+                /*!< : the other value of a string column.*/
+)
+{
+        gdouble difference;
+
+        if (library_columns[column].type == LIBRARY_STRING)
+        {
+                return (strcmp (library_get_string (library, column, row), string));
+        }
+        difference = library_get_double (library, column, row) - number;
+        if (fabs (difference) < LIBRARY_EPSILON)
+        {
+                return (0);
+        }
+        return ((difference < 0.0) ? -1 : 1);
+}
+
+
+/*!
+ * \brief Sort order for library_sort ().
+ */
+typedef struct library_sort_order
+{
+        library_t *library;
+                /*!< : is the footprint library.*/
+        library_column_t column;
+                /*!< : is the column to sort on.*/
+        gboolean descending;
+                /*!< : sort from high to low.*/
+} library_sort_order_t;
+
+
+/*!
+ * \brief Compare two rows of a footprint library for library_sort ().
+ *
+ * Rows with equal values keep their order.
+ *
+ * \return a negative value, 0 or a positive value when row \c a is to
+ * be sorted before, at the same place or after row \c b.
+ */
+static gint
+library_compare_rows
+(
+        gconstpointer a,
+                /*!< : the first row.*/
+        gconstpointer b,
+                /*!< : the second row.*/
+        gpointer user_data
+                /*!< : the sort order.*/
+)
+{
+        library_sort_order_t *order = user_data;
+        guint row_a = *(const guint *) a;
+        guint row_b = *(const guint *) b;
+        gint result;
+
+        result = library_compare_value (order->library, order->column, row_a,
+                library_get_double (order->library, order->column, row_b),
+                library_get_string (order->library, order->column, row_b));
+        if (result == 0)
+        {
+                return ((row_a > row_b) - (row_a < row_b));
+        }
+        return (order->descending ? -result : result);
+}
+
+
+/*!
+ * \brief Find the end of an unquoted value in a csv file.
+ *
+ * The text is scanned eight characters at a time, a word with a ";",
+ * "\n" or "\r" in it is found with a few integer operations
+ * (the "has zero byte" trick on the word xor'ed with the delimiter),
+ * which keeps the scanner portable and still skips the bulk of a long
+ * value without looking at each character.
+ *
+ * \return a pointer to the delimiter, or \c end when the value runs to
+ * the end of the file.
+ */
+static const gchar *
+library_find_delimiter
+(
+        const gchar *text,
+                /*!< : the start of the value.*/
+        const gchar *end
+                /*!< : the end of the file.*/
+)
+{
+        const guint64 ones = G_GUINT64_CONSTANT (0x0101010101010101);
+        const guint64 highs = G_GUINT64_CONSTANT (0x8080808080808080);
+        guint64 word;
+        guint64 semicolons;
+        guint64 newlines;
+        guint64 returns;
+
+        while ((text + sizeof (word)) <= end)
+        {
+                memcpy (&word, text, sizeof (word));
+                semicolons = word ^ (ones * ';');
+                newlines = word ^ (ones * '\n');
+                returns = word ^ (ones * '\r');
+                if ((((semicolons - ones) & ~semicolons) |
+                        ((newlines - ones) & ~newlines) |
+                        ((returns - ones) & ~returns)) & highs)
+                {
+                        break;
+                }
+                text += sizeof (word);
+        }
+        while ((text < end) && (*text != ';') && (*text != '\n') && (*text != '\r'))
+        {
+                text++;
+        }
+        return (text);
+}
+
+
+/*!
+ * \brief Find a name in a table of names.
+ *
+ * The names are compared case insensitive, an empty text is the first
+ * name ("For those living in the void").
+ *
+ * \return the index of the name, -1 when the name is not in the table.
+ */
+static gint
+library_find_name
+(
+        gchar **names,
+                /*!< : the table of names.*/
+        gint number_of_names,
+                /*!< : the number of names in the table.*/
+        const gchar *text,
+                /*!< : the name to find, not nul terminated.*/
+        gsize length
+                /*!< : the length of the name.*/
+)
+{
+        gint i;
+
+        if (length == 0)
+        {
+                return (0);
+        }
+        for (i = 0; i < number_of_names; i++)
+        {
+                if ((strlen (names[i]) == length) &&
+                        !g_ascii_strncasecmp (names[i], text, length))
+                {
+                        return (i);
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Get the table of names of an enumerated column type.
+ *
+ * \return the table of names, \c NULL for a column type that is not
+ * enumerated.
+ */
+static gchar **
+library_get_names
+(
+        library_column_type_t type,
+                /*!< : the column type.*/
+        gint *number_of_names
+                /*!< : the number of names in the table.*/
+)
+{
+        switch (type)
+        {
+                case LIBRARY_PACKAGE:
+                        *number_of_names = G_N_ELEMENTS (library_package_names);
+                        return (library_package_names);
+                case LIBRARY_UNITS:
+                        *number_of_names = G_N_ELEMENTS (library_units_names);
+                        return (library_units_names);
+                case LIBRARY_STATUS:
+                        *number_of_names = G_N_ELEMENTS (library_status_names);
+                        return (library_status_names);
+                case LIBRARY_LOCATION:
+                        *number_of_names = G_N_ELEMENTS (library_location_names);
+                        return (library_location_names);
+                case LIBRARY_PAD_SHAPE:
+                        *number_of_names = G_N_ELEMENTS (library_pad_shape_names);
+                        return (library_pad_shape_names);
+                default:
+                        *number_of_names = 0;
+                        return (NULL);
+        }
+}
+
+
+/*!
+ * \brief Allocate room for more rows in all columns of a footprint
+ * library.
+ *
+ * The number of allocated rows is doubled, so appending rows one by one
+ * costs an amortized constant time.
+ */
+static void
+library_grow
+(
+        library_t *library
+                /*!< : the footprint library.*/
+)
+{
+        gsize size;
+        gint i;
+
+        library->allocated_rows = MAX (256, library->allocated_rows * 2);
+        for (i = 0; i < LIBRARY_COLUMNS; i++)
+        {
+                switch (library_columns[i].type)
+                {
+                        case LIBRARY_DOUBLE:
+                                size = sizeof (gdouble);
+                                break;
+                        case LIBRARY_STRING:
+                                size = sizeof (gchar *);
+                                break;
+                        default:
+                                size = sizeof (gint);
+                                break;
+                }
+                library->columns[i] = g_realloc (library->columns[i],
+                        library->allocated_rows * size);
+        }
+}
+
+
+/*!
+ * \brief Append a row with the values of the global variables to a
+ * footprint library.
+ *
+ * The \c footprint_id of the row is its row number, counting from 1.
+ */
+static void
+library_append_globals
+(
+        library_t *library
+                /*!< : the footprint library.*/
+)
+{
+        gpointer value;
+        gint shape;
+        gint i;
+
+        if (library->rows == library->allocated_rows)
+        {
+                library_grow (library);
+        }
+        for (i = 0; i < LIBRARY_COLUMNS; i++)
+        {
+                value = library_columns[i].value;
+                switch (library_columns[i].type)
+                {
+                        case LIBRARY_DOUBLE:
+                                ((gdouble *) library->columns[i])[library->rows] =
+                                        value ? *(gdouble *) value : 0.0;
+                                break;
+                        case LIBRARY_STRING:
+                                ((gchar **) library->columns[i])[library->rows] =
+                                        (value && *(gchar **) value) ?
+                                        g_string_chunk_insert_len (library->strings, *(gchar **) value, -1) :
+                                        NULL;
+                                break;
+                        case LIBRARY_PAD_SHAPE:
+                                /* SQUARE is the flag of pcb_globals.h here,
+                                 * store the index of its name. */
+                                shape = value ? *(gint *) value : NO_SHAPE;
+                                ((gint *) library->columns[i])[library->rows] =
+                                        (shape == SQUARE) ? 2 :
+                                        ((shape < (gint) G_N_ELEMENTS (library_pad_shape_strings)) ? shape : NO_SHAPE);
+                                break;
+                        default:
+                                ((gint *) library->columns[i])[library->rows] =
+                                        value ? *(gint *) value : 0;
+                                break;
+                }
+        }
+        ((gint *) library->columns[LIBRARY_FOOTPRINT_ID])[library->rows] = library->rows + 1;
+        library->rows++;
+}
+
+
+/*!
+ * \brief Check if a number matches a query predicate.
+ *
+ * \return \c TRUE when the number matches.
+ */
+static gboolean
+library_match_number
+(
+        gdouble number,
+                /*!< : the number.*/
+        library_predicate_t *predicate
+                /*!< : the query predicate.*/
+)
+{
+        gdouble difference = number - predicate->number;
+        gint result;
+
+        result = (fabs (difference) < LIBRARY_EPSILON) ? 0 : ((difference < 0.0) ? -1 : 1);
+        switch (predicate->comparison)
+        {
+                case LIBRARY_EQUAL:
+                        return (result == 0);
+                case LIBRARY_NOT_EQUAL:
+                        return (result != 0);
+                case LIBRARY_LESS:
+                        return (result < 0);
+                case LIBRARY_LESS_OR_EQUAL:
+                        return (result <= 0);
+                case LIBRARY_GREATER:
+                        return (result > 0);
+                case LIBRARY_GREATER_OR_EQUAL:
+                        return (result >= 0);
+                default:
+                        return (FALSE);
+        }
+}
+
+
+/*!
+ * \brief Check if a row of a footprint library matches a query
+ * predicate on a string column.
+ *
+ * "=" and "!=" match a pattern with "*" and "?" wildcards, the other
+ * comparisons compare with strcmp ().
+ *
+ * \return \c TRUE when the row matches.
+ */
+static gboolean
+library_match_string
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        library_predicate_t *predicate,
+                /*!< : the query predicate.*/
+        guint row
+                /*!< : the row.*/
+)
+{
+        const gchar *value = library_get_string (library, predicate->column, row);
+        gint result;
+
+        switch (predicate->comparison)
+        {
+                case LIBRARY_EQUAL:
+                        return (g_pattern_match_simple (predicate->string, value));
+                case LIBRARY_NOT_EQUAL:
+                        return (!g_pattern_match_simple (predicate->string, value));
+                default:
+                        break;
+        }
+        result = strcmp (value, predicate->string);
+        switch (predicate->comparison)
+        {
+                case LIBRARY_LESS:
+                        return (result < 0);
+                case LIBRARY_LESS_OR_EQUAL:
+                        return (result <= 0);
+                case LIBRARY_GREATER:
+                        return (result > 0);
+                case LIBRARY_GREATER_OR_EQUAL:
+                        return (result >= 0);
+                default:
+                        return (FALSE);
+        }
+}
+
+
+/*!
+ * \brief Swap two rows of a footprint library index.
+ */
+static void
+library_index_swap
+(
+        library_index_t *index,
+                /*!< : the footprint library index.*/
+        guint a,
+                /*!< : the first row.*/
+        guint b
+                /*!< : the second row.*/
+)
+{
+        gdouble point[LIBRARY_DIMENSIONS];
+        guint row;
+
+        row = index->rows[a];
+        index->rows[a] = index->rows[b];
+        index->rows[b] = row;
+        memcpy (point, &index->points[a * LIBRARY_DIMENSIONS], sizeof (point));
+        memcpy (&index->points[a * LIBRARY_DIMENSIONS],
+                &index->points[b * LIBRARY_DIMENSIONS], sizeof (point));
+        memcpy (&index->points[b * LIBRARY_DIMENSIONS], point, sizeof (point));
+}
+
+
+/*!
+ * \brief Build the k-d tree of a range of rows of a footprint library
+ * index.
+ *
+ * The rows are split at the median of the dimension \c depth modulo
+ * \c LIBRARY_DIMENSIONS, which is moved to the middle of the range by a
+ * quickselect, and both halves are built likewise.
+ */
+static void
+library_index_build
+(
+        library_index_t *index,
+                /*!< : the footprint library index.*/
+        guint low,
+                /*!< : the first row of the range.*/
+        guint high,
+                /*!< : the row after the last row of the range.*/
+        guint depth
+                /*!< : the depth of the range in the tree.*/
+)
+{
+        guint dimension = depth % LIBRARY_DIMENSIONS;
+        guint middle = low + ((high - low) / 2);
+        guint left = low;
+        guint right = high - 1;
+        guint store;
+        guint i;
+        gdouble pivot;
+
+        if ((high - low) < 2)
+        {
+                return;
+        }
+        while (left < right)
+        {
+                /* Partition around the middle value (Lomuto), then
+                 * continue in the part holding the median. */
+                library_index_swap (index, (left + right) / 2, right);
+                pivot = index->points[(right * LIBRARY_DIMENSIONS) + dimension];
+                store = left;
+                for (i = left; i < right; i++)
+                {
+                        if (index->points[(i * LIBRARY_DIMENSIONS) + dimension] < pivot)
+                        {
+                                library_index_swap (index, i, store);
+                                store++;
+                        }
+                }
+                library_index_swap (index, store, right);
+                if (store == middle)
+                {
+                        break;
+                }
+                else if (store < middle)
+                {
+                        left = store + 1;
+                }
+                else
+                {
+                        right = store - 1;
+                }
+        }
+        library_index_build (index, low, middle, depth + 1);
+        library_index_build (index, middle + 1, high, depth + 1);
+}
+
+
+/*!
+ * \brief Search a range of the k-d tree of a footprint library index
+ * for the rows nearest to a target.
+ *
+ * A side of a split is skipped when the distance to the split plane is
+ * larger than the \c k th best distance found so far.
+ */
+static void
+library_index_search
+(
+        library_index_t *index,
+                /*!< : the footprint library index.*/
+        guint low,
+                /*!< : the first row of the range.*/
+        guint high,
+                /*!< : the row after the last row of the range.*/
+        guint depth,
+                /*!< : the depth of the range in the tree.*/
+        const gdouble *target,
+                /*!< : the target dimensions.*/
+        const gdouble *weights,
+                /*!< : the weights of the dimensions.*/
+        guint k,
+                /*!< : the number of rows to find.*/
+        guint *found,
+                /*!< : the number of rows found so far.*/
+        guint *rows,
+                /*!< : the rows found so far, nearest first.*/
+        gdouble *distances
+                /*!< : the squared distances of the rows found so far.*/
+)
+{
+        guint dimension = depth % LIBRARY_DIMENSIONS;
+        guint middle;
+        const gdouble *point;
+        gdouble distance = 0.0;
+        gdouble difference;
+        guint i;
+
+        if (low >= high)
+        {
+                return;
+        }
+        middle = low + ((high - low) / 2);
+        point = &index->points[middle * LIBRARY_DIMENSIONS];
+        for (i = 0; i < LIBRARY_DIMENSIONS; i++)
+        {
+                difference = (point[i] - target[i]) * weights[i];
+                distance += difference * difference;
+        }
+        if ((*found < k) || (distance < distances[*found - 1]))
+        {
+                /* Insert into the sorted list of the best rows. */
+                i = (*found < k) ? (*found)++ : (k - 1);
+                for (; (i > 0) && (distances[i - 1] > distance); i--)
+                {
+                        rows[i] = rows[i - 1];
+                        distances[i] = distances[i - 1];
+                }
+                rows[i] = index->rows[middle];
+                distances[i] = distance;
+        }
+        difference = (target[dimension] - point[dimension]) * weights[dimension];
+        if (difference < 0.0)
+        {
+                library_index_search (index, low, middle, depth + 1, target,
+                        weights, k, found, rows, distances);
+                if ((*found < k) || ((difference * difference) < distances[*found - 1]))
+                {
+                        library_index_search (index, middle + 1, high, depth + 1,
+                                target, weights, k, found, rows, distances);
+                }
+        }
+        else
+        {
+                library_index_search (index, middle + 1, high, depth + 1, target,
+                        weights, k, found, rows, distances);
+                if ((*found < k) || ((difference * difference) < distances[*found - 1]))
+                {
+                        library_index_search (index, low, middle, depth + 1,
+                                target, weights, k, found, rows, distances);
+                }
+        }
+}
+
+
+/*!
+ * \brief Log handler which drops all messages.
+ */
+static void
+library_log_nothing
+(
+        const gchar *log_domain,
+                /*!< : the log domain of the message.*/
+        GLogLevelFlags log_level,
+                /*!< : the log level of the message.*/
+        const gchar *message,
+                /*!< : the message.*/
+        gpointer user_data
+                /*!< : the user data.*/
+)
+{
+}
+
+
+/*!
+ * \brief Store a value in a footprint library.
+ *
+ * The value is validated against the type of the \c column.
+ *
+ * \return \c TRUE when the value is valid, \c FALSE when it is not.
+ */
+static gboolean
+library_set_value
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        gint column,
+                /*!< : the column of the value.*/
+        guint row,
+                /*!< : the row of the value.*/
+        const gchar *text,
+                /*!< : the value, not nul terminated.*/
+        gsize length
+                /*!< : the length of the value.*/
+)
+{
+        gchar **names;
+        gint number_of_names;
+        gdouble number;
+        gint index;
+
+        switch (library_columns[column].type)
+        {
+                case LIBRARY_STRING:
+                        ((gchar **) library->columns[column])[row] =
+                                g_string_chunk_insert_len (library->strings, text, length);
+                        return (TRUE);
+                case LIBRARY_DOUBLE:
+                        if (!parse_fpw_number (text, length, &number))
+                        {
+                                return (FALSE);
+                        }
+                        ((gdouble *) library->columns[column])[row] = number;
+                        return (TRUE);
+                case LIBRARY_INTEGER:
+                case LIBRARY_BOOLEAN:
+                        if (!parse_fpw_number (text, length, &number) ||
+                                (number != floor (number)) ||
+                                (number < G_MININT) ||
+                                (number > G_MAXINT) ||
+                                ((library_columns[column].type == LIBRARY_BOOLEAN) &&
+                                (number != 0) && (number != 1)))
+                        {
+                                return (FALSE);
+                        }
+                        ((gint *) library->columns[column])[row] = (gint) number;
+                        return (TRUE);
+                default:
+                        names = library_get_names (library_columns[column].type,
+                                &number_of_names);
+                        index = library_find_name (names, number_of_names, text, length);
+                        break;
+        }
+        if (index < 0)
+        {
+                return (FALSE);
+        }
+        ((gint *) library->columns[column])[row] = index;
+        return (TRUE);
+}
+
+
+/*!
+ * \brief Add the predefined packages of all package types to a
+ * footprint library.
+ *
+ * For every package in the packages list of a package type the default
+ * values are looked up with the get_default_footprint_values () function
+ * of the package type and appended as a row.\n
+ * A package without default values, or with default values which are
+ * only a placeholder (no package body, or no pitch for more than one
+ * pin), is left out; these packages are logged when \c verbose is set.\n
+ * The global variables of the footprint are used for this, they are
+ * saved before and restored afterwards.
+ *
+ * \return \c EXIT_SUCCESS.
+ */
+int
+library_add_packages
+(
+        library_t *library
+                /*!< : the footprint library to append the rows to.*/
+)
+{
+        union
+        {
+                gdouble number;
+                gint integer;
+                gpointer string;
+        } saved_values[LIBRARY_COLUMNS];
+        gchar *saved_footprint_units = footprint_units;
+        gchar *saved_pad_shape = pad_shape;
+        gdouble saved_multiplier = multiplier;
+        gboolean saved_states[6] = {c1_state, g1_state, z1_state, c2_state, g2_state, z2_state};
+        gboolean saved_silent = silent;
+        gboolean saved_verbose = verbose;
+        GPtrArray *unresolved;
+        gpointer value;
+        GList *names;
+        guint log_handler;
+        guint i;
+        gint j;
+
+        for (j = 0; j < LIBRARY_COLUMNS; j++)
+        {
+                if (!(value = library_columns[j].value))
+                {
+                        continue;
+                }
+                switch (library_columns[j].type)
+                {
+                        case LIBRARY_DOUBLE:
+                                saved_values[j].number = *(gdouble *) value;
+                                break;
+                        case LIBRARY_STRING:
+                                saved_values[j].string = *(gchar **) value;
+                                break;
+                        default:
+                                saved_values[j].integer = *(gint *) value;
+                                break;
+                }
+        }
+        /* Predefined packages which fail are not worth a message here. */
+        silent = TRUE;
+        verbose = FALSE;
+        log_handler = g_log_set_handler ("", G_LOG_LEVEL_MASK,
+                library_log_nothing, NULL);
+        /* Pairs of a package name and its package type name. */
+        unresolved = g_ptr_array_new ();
+        for (i = 0; i < G_N_ELEMENTS (library_packages); i++)
+        {
+                /* The create_packages_list () functions free the old list
+                 * but append to the old pointer. */
+                g_list_free (packages_list);
+                packages_list = NULL;
+                library_packages[i].create_packages_list ();
+                for (names = packages_list; names; names = g_list_next (names))
+                {
+                        /* Start every package from scratch, the default
+                         * values only set what is relevant for the
+                         * package type. */
+                        for (j = 0; j < LIBRARY_COLUMNS; j++)
+                        {
+                                if (!(value = library_columns[j].value) ||
+                                        (library_columns[j].type == LIBRARY_STRING))
+                                {
+                                        continue;
+                                }
+                                if (library_columns[j].type == LIBRARY_DOUBLE)
+                                {
+                                        *(gdouble *) value = 0.0;
+                                }
+                                else
+                                {
+                                        *(gint *) value = 0;
+                                }
+                        }
+                        pin_pad_exceptions_string = "";
+                        footprint_units = "";
+                        footprint_name = g_strconcat ("?", names->data, NULL);
+                        if ((library_packages[i].get_default_footprint_values () == EXIT_FAILURE) ||
+                                ((package_body_length == 0.0) && (package_body_width == 0.0)) ||
+                                ((number_of_pins > 1) && (pitch_x == 0.0) && (pitch_y == 0.0)))
+                        {
+                                g_ptr_array_add (unresolved, names->data);
+                                g_ptr_array_add (unresolved, library_package_names[library_packages[i].type]);
+                        }
+                        else
+                        {
+                                package_type = library_packages[i].type;
+                                update_units_variables ();
+                                update_pad_shapes_variables ();
+                                get_status_type ();
+                                library_append_globals (library);
+                        }
+                        g_free (footprint_name);
+                }
+        }
+        for (j = 0; j < LIBRARY_COLUMNS; j++)
+        {
+                if (!(value = library_columns[j].value))
+                {
+                        continue;
+                }
+                switch (library_columns[j].type)
+                {
+                        case LIBRARY_DOUBLE:
+                                *(gdouble *) value = saved_values[j].number;
+                                break;
+                        case LIBRARY_STRING:
+                                *(gchar **) value = saved_values[j].string;
+                                break;
+                        default:
+                                *(gint *) value = saved_values[j].integer;
+                                break;
+                }
+        }
+        g_log_remove_handler ("", log_handler);
+        /* Leave no list of the last package type behind for the GUI. */
+        g_list_free (packages_list);
+        packages_list = NULL;
+        footprint_units = saved_footprint_units;
+        pad_shape = saved_pad_shape;
+        multiplier = saved_multiplier;
+        c1_state = saved_states[0];
+        g1_state = saved_states[1];
+        z1_state = saved_states[2];
+        c2_state = saved_states[3];
+        g2_state = saved_states[4];
+        z2_state = saved_states[5];
+        silent = saved_silent;
+        verbose = saved_verbose;
+        for (i = 0; (verbose) && (i < unresolved->len); i += 2)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("no default values for predefined package %s of package type %s, it is left out of the catalog."),
+                        (gchar *) unresolved->pdata[i],
+                        (gchar *) unresolved->pdata[i + 1]);
+        }
+        g_ptr_array_free (unresolved, TRUE);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Free a footprint library and all of its values.
+ */
+void
+library_free
+(
+        library_t *library
+                /*!< : the footprint library.*/
+)
+{
+        gint i;
+
+        if (!library)
+        {
+                return;
+        }
+        for (i = 0; i < LIBRARY_COLUMNS; i++)
+        {
+                g_free (library->columns[i]);
+        }
+        g_string_chunk_free (library->strings);
+        g_free (library);
+}
+
+
+/*!
+ * \brief Look up a column of a footprint library by its name.
+ *
+ * \return the column, -1 when there is no column with this \c name.
+ */
+gint
+library_get_column
+(
+        const gchar *name
+                /*!< : the name of the column, as in the csv header.*/
+)
+{
+        gint i;
+
+        for (i = 0; i < LIBRARY_COLUMNS; i++)
+        {
+                if (!strcmp (library_columns[i].name, name))
+                {
+                        return (i);
+                }
+        }
+        return (-1);
+}
+
+
+/*!
+ * \brief Get the type of the values in a column of a footprint library.
+ *
+ * \return the type of the column.
+ */
+library_column_type_t
+library_get_column_type
+(
+        library_column_t column
+                /*!< : the column.*/
+)
+{
+        return (library_columns[column].type);
+}
+
+
+/*!
+ * \brief Describe how far a row of a footprint library is from a target.
+ *
+ * For every dimension of the \c target that is not 0 the difference of
+ * the row with the target is given, like "pitch=+0.15".
+ *
+ * \return a newly allocated string, to be freed with g_free () by the
+ * caller.
+ */
+gchar *
+library_get_deltas
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        guint row,
+                /*!< : the row.*/
+        const gdouble *target
+                /*!< : the target dimensions.*/
+)
+{
+        gdouble dimensions[LIBRARY_DIMENSIONS];
+        gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+        GString *deltas;
+        gint i;
+
+        library_get_dimensions (library, row, dimensions);
+        deltas = g_string_new ("");
+        for (i = 0; i < LIBRARY_DIMENSIONS; i++)
+        {
+                if (target[i] == 0.0)
+                {
+                        continue;
+                }
+                g_string_append_printf (deltas, "%s%s=%s%s",
+                        deltas->len ? " " : "",
+                        library_dimension_names[i],
+                        (dimensions[i] >= target[i]) ? "+" : "",
+                        g_ascii_formatd (buffer, sizeof (buffer), "%g",
+                        dimensions[i] - target[i]));
+        }
+        return (g_string_free (deltas, FALSE));
+}
+
+
+/*!
+ * \brief Get the dimensions of a row of a footprint library for a
+ * nearest package search.
+ *
+ * Lengths are converted to mm, so rows in mil and in mm can be compared.
+ */
+void
+library_get_dimensions
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        guint row,
+                /*!< : the row.*/
+        gdouble *dimensions
+                /*!< : the \c LIBRARY_DIMENSIONS dimensions of the row.*/
+)
+{
+        gdouble scale;
+        gdouble pitch;
+
+        switch (library_get_integer (library, LIBRARY_FOOTPRINT_UNITS, row))
+        {
+                case MIL:
+                        scale = MIL_TO_MM;
+                        break;
+                case MIL_100:
+                        scale = MIL_TO_MM / 100.0;
+                        break;
+                default:
+                        scale = 1.0;
+                        break;
+        }
+        pitch = library_get_double (library, LIBRARY_PITCH_X, row);
+        if (pitch == 0.0)
+        {
+                pitch = library_get_double (library, LIBRARY_PITCH_Y, row);
+        }
+        dimensions[LIBRARY_LENGTH] = library_get_double (library, LIBRARY_PACKAGE_BODY_LENGTH, row) * scale;
+        dimensions[LIBRARY_WIDTH] = library_get_double (library, LIBRARY_PACKAGE_BODY_WIDTH, row) * scale;
+        dimensions[LIBRARY_HEIGHT] = library_get_double (library, LIBRARY_PACKAGE_BODY_HEIGHT, row) * scale;
+        dimensions[LIBRARY_PITCH] = pitch * scale;
+        dimensions[LIBRARY_PINS] = library_get_integer (library, LIBRARY_NUMBER_OF_PINS, row);
+}
+
+
+/*!
+ * \brief Get a value of a numeric column of a footprint library as a
+ * double.
+ *
+ * \return the value, 0.0 for a string column.
+ */
+gdouble
+library_get_double
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        library_column_t column,
+                /*!< : the column.*/
+        guint row
+                /*!< : the row.*/
+)
+{
+        switch (library_columns[column].type)
+        {
+                case LIBRARY_DOUBLE:
+                        return (((gdouble *) library->columns[column])[row]);
+                case LIBRARY_STRING:
+                        return (0.0);
+                default:
+                        return (((gint *) library->columns[column])[row]);
+        }
+}
+
+
+/*!
+ * \brief Get a value of an integer, boolean or enumerated column of a
+ * footprint library.
+ *
+ * \return the value, a double value is truncated, 0 for a string column.
+ */
+gint
+library_get_integer
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        library_column_t column,
+                /*!< : the column.*/
+        guint row
+                /*!< : the row.*/
+)
+{
+        switch (library_columns[column].type)
+        {
+                case LIBRARY_DOUBLE:
+                        return ((gint) ((gdouble *) library->columns[column])[row]);
+                case LIBRARY_STRING:
+                        return (0);
+                default:
+                        return (((gint *) library->columns[column])[row]);
+        }
+}
+
+
+/*!
+ * \brief Get a value of a footprint library as a string.
+ *
+ * For an enumerated column the name of the value is returned, for a
+ * numeric column an empty string.
+ *
+ * \return the value, owned by the footprint library.
+ */
+const gchar *
+library_get_string
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        library_column_t column,
+                /*!< : the column.*/
+        guint row
+                /*!< : the row.*/
+)
+{
+        const gchar *value;
+        gchar **names;
+        gint number_of_names;
+        gint index;
+
+        if (library_columns[column].type == LIBRARY_STRING)
+        {
+                value = ((gchar **) library->columns[column])[row];
+                return (value ? value : "");
+        }
+        names = library_get_names (library_columns[column].type, &number_of_names);
+        index = ((gint *) library->columns[column])[row];
+        if (!names || (index < 0) || (index >= number_of_names))
+        {
+                return ("");
+        }
+        return (names[index]);
+}
+
+
+/*!
+ * \brief Free a footprint library index.
+ *
+ * The footprint library itself is not freed.
+ */
+void
+library_index_free
+(
+        library_index_t *index
+                /*!< : the footprint library index.*/
+)
+{
+        if (!index)
+        {
+                return;
+        }
+        g_free (index->rows);
+        g_free (index->points);
+        g_free (index);
+}
+
+
+/*!
+ * \brief Find the rows of a footprint library nearest to a target.
+ *
+ * The distance is the relative difference with the target: every
+ * dimension is divided by its target value, a dimension with a target
+ * value of 0 is not taken into account.\n
+ * So 1 mm off on a 10 mm body counts as much as 10 pins off on a 100
+ * pin package.
+ *
+ * \return the number of rows found, at most \c k.
+ */
+guint
+library_index_nearest
+(
+        library_index_t *index,
+                /*!< : the footprint library index.*/
+        const gdouble *target,
+                /*!< : the \c LIBRARY_DIMENSIONS target dimensions.*/
+        guint k,
+                /*!< : the number of rows to find.*/
+        guint *rows,
+                /*!< : the rows found, nearest first.*/
+        gdouble *distances
+                /*!< : the distances of the rows found.*/
+)
+{
+        gdouble weights[LIBRARY_DIMENSIONS];
+        guint found = 0;
+        guint i;
+
+        if (k == 0)
+        {
+                return (0);
+        }
+        for (i = 0; i < LIBRARY_DIMENSIONS; i++)
+        {
+                weights[i] = (target[i] > 0.0) ? (1.0 / target[i]) : 0.0;
+        }
+        library_index_search (index, 0, index->size, 0, target, weights, k,
+                &found, rows, distances);
+        for (i = 0; i < found; i++)
+        {
+                distances[i] = sqrt (distances[i]);
+        }
+        return (found);
+}
+
+
+/*!
+ * \brief Create an index for finding the nearest packages in a
+ * footprint library.
+ *
+ * The index covers the rows in the library at the time of creation.
+ *
+ * \return the footprint library index, to be freed with
+ * library_index_free ().
+ */
+library_index_t *
+library_index_new
+(
+        library_t *library
+                /*!< : the footprint library.*/
+)
+{
+        library_index_t *index;
+        guint i;
+
+        index = g_new0 (library_index_t, 1);
+        index->library = library;
+        index->size = library->rows;
+        index->rows = g_new (guint, MAX (1, library->rows));
+        index->points = g_new (gdouble, MAX (1, library->rows) * LIBRARY_DIMENSIONS);
+        for (i = 0; i < library->rows; i++)
+        {
+                index->rows[i] = i;
+                library_get_dimensions (library, i,
+                        &index->points[i * LIBRARY_DIMENSIONS]);
+        }
+        library_index_build (index, 0, index->size, 0);
+        return (index);
+}
+
+
+/*!
+ * \brief Create a new, empty footprint library.
+ *
+ * \return the footprint library, to be freed with library_free ().
+ */
+library_t *
+library_new ()
+{
+        library_t *library;
+
+        library = g_new0 (library_t, 1);
+        library->strings = g_string_chunk_new (4096);
+        return (library);
+}
+
+
+/*!
+ * \brief Parse a query predicate like "pitch_x<=0.8" or
+ * "footprint_name=BGA*".
+ *
+ * The predicate is a column name, a comparison ("=", "!=", "<", "<=",
+ * ">" or ">=") and a value.\n
+ * Enumerated values are given by their name ("footprint_type=BGA"),
+ * numbers are compared in the units of the row.\n
+ * The \c string of the \c predicate is newly allocated and is to be
+ * freed with g_free () by the caller.
+ *
+ * \return \c EXIT_SUCCESS when the predicate is valid, \c EXIT_FAILURE
+ * when it is not.
+ */
+int
+library_parse_predicate
+(
+        const gchar *text,
+                /*!< : the predicate.*/
+        library_predicate_t *predicate
+                /*!< : the parsed predicate.*/
+)
+{
+        const gchar *comparison = text + strcspn (text, "=!<>");
+        const gchar *value;
+        gchar *name;
+        gchar **names;
+        gint number_of_names;
+        gint column;
+        gint index;
+
+        name = g_strstrip (g_strndup (text, comparison - text));
+        column = library_get_column (name);
+        if (column < 0)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("unknown column %s in query predicate: %s.\n"),
+                                name, text);
+                }
+                g_free (name);
+                return (EXIT_FAILURE);
+        }
+        g_free (name);
+        predicate->column = column;
+        predicate->number = 0.0;
+        predicate->string = NULL;
+        if (!strncmp (comparison, "!=", 2))
+        {
+                predicate->comparison = LIBRARY_NOT_EQUAL;
+                value = comparison + 2;
+        }
+        else if (!strncmp (comparison, "<=", 2))
+        {
+                predicate->comparison = LIBRARY_LESS_OR_EQUAL;
+                value = comparison + 2;
+        }
+        else if (!strncmp (comparison, ">=", 2))
+        {
+                predicate->comparison = LIBRARY_GREATER_OR_EQUAL;
+                value = comparison + 2;
+        }
+        else if (*comparison == '<')
+        {
+                predicate->comparison = LIBRARY_LESS;
+                value = comparison + 1;
+        }
+        else if (*comparison == '>')
+        {
+                predicate->comparison = LIBRARY_GREATER;
+                value = comparison + 1;
+        }
+        else if (*comparison == '=')
+        {
+                predicate->comparison = LIBRARY_EQUAL;
+                value = comparison + 1;
+        }
+        else
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("no comparison in query predicate: %s.\n"),
+                                text);
+                }
+                return (EXIT_FAILURE);
+        }
+        switch (library_columns[column].type)
+        {
+                case LIBRARY_STRING:
+                        predicate->string = g_strdup (value);
+                        return (EXIT_SUCCESS);
+                case LIBRARY_DOUBLE:
+                case LIBRARY_INTEGER:
+                case LIBRARY_BOOLEAN:
+                        if (parse_fpw_number (value, strlen (value), &predicate->number))
+                        {
+                                return (EXIT_SUCCESS);
+                        }
+                        break;
+                default:
+                        names = library_get_names (library_columns[column].type,
+                                &number_of_names);
+                        index = library_find_name (names, number_of_names,
+                                value, strlen (value));
+                        if (index >= 0)
+                        {
+                                predicate->number = index;
+                                return (EXIT_SUCCESS);
+                        }
+                        break;
+        }
+        if ((verbose) || (!silent))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("invalid %s value in query predicate: %s.\n"),
+                        library_columns[column].name, text);
+        }
+        return (EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Parse the target of a nearest package search like
+ * "package_body_length=10,pitch=0.8,number_of_pins=100".
+ *
+ * The target is a comma separated list of dimensions
+ * ("package_body_length", "package_body_width", "package_body_height",
+ * "pitch" and "number_of_pins") with their values, lengths in mm.
+ * Dimensions which are not given are 0.
+ *
+ * \return \c EXIT_SUCCESS when the target is valid, \c EXIT_FAILURE
+ * when it is not.
+ */
+int
+library_parse_target
+(
+        const gchar *text,
+                /*!< : the target.*/
+        gdouble *target
+                /*!< : the \c LIBRARY_DIMENSIONS parsed target dimensions.*/
+)
+{
+        gchar **values;
+        gchar *value;
+        gint result = EXIT_SUCCESS;
+        gint dimension;
+        gint i;
+
+        for (i = 0; i < LIBRARY_DIMENSIONS; i++)
+        {
+                target[i] = 0.0;
+        }
+        values = g_strsplit (text, ",", 0);
+        for (i = 0; values[i]; i++)
+        {
+                value = strchr (values[i], '=');
+                dimension = -1;
+                if (value)
+                {
+                        *value++ = '\0';
+                        g_strstrip (values[i]);
+                        if (*values[i])
+                        {
+                                dimension = library_find_name (library_dimension_names,
+                                        G_N_ELEMENTS (library_dimension_names),
+                                        values[i], strlen (values[i]));
+                        }
+                }
+                if (dimension < 0)
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("unknown dimension in nearest package target: %s.\n"),
+                                        values[i]);
+                        }
+                        result = EXIT_FAILURE;
+                        continue;
+                }
+                g_strstrip (value);
+                if (!parse_fpw_number (value, strlen (value), &target[dimension]) ||
+                        (target[dimension] < 0.0))
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("invalid %s value in nearest package target: %s.\n"),
+                                        values[i], value);
+                        }
+                        target[dimension] = 0.0;
+                        result = EXIT_FAILURE;
+                }
+        }
+        g_strfreev (values);
+        return (result);
+}
+
+
+/*!
+ * \brief Query a footprint library.
+ *
+ * The predicates are applied one after the other, each one scans only
+ * its own column and only the rows that passed the predicates before
+ * it, so the most selective predicate is best given first.
+ *
+ * \return a newly allocated array with the row numbers (guint) of the
+ * rows which match all \c predicates, in library order, to be freed
+ * with g_array_free () by the caller.
+ */
+GArray *
+library_query
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        library_predicate_t *predicates,
+                /*!< : the query predicates.*/
+        guint number_of_predicates
+                /*!< : the number of query predicates.*/
+)
+{
+        GArray *rows;
+        const gdouble *doubles;
+        const gint *integers;
+        guint *row;
+        guint matches;
+        guint i;
+        guint j;
+
+        rows = g_array_sized_new (FALSE, FALSE, sizeof (guint), library->rows);
+        g_array_set_size (rows, library->rows);
+        row = (guint *) rows->data;
+        for (i = 0; i < library->rows; i++)
+        {
+                row[i] = i;
+        }
+        for (i = 0; i < number_of_predicates; i++)
+        {
+                matches = 0;
+                /* Work on the column array itself, the type of the
+                 * column is looked at once per predicate. */
+                switch (library_columns[predicates[i].column].type)
+                {
+                        case LIBRARY_DOUBLE:
+                                doubles = library->columns[predicates[i].column];
+                                for (j = 0; j < rows->len; j++)
+                                {
+                                        if (library_match_number (doubles[row[j]], &predicates[i]))
+                                        {
+                                                row[matches++] = row[j];
+                                        }
+                                }
+                                break;
+                        case LIBRARY_STRING:
+                                for (j = 0; j < rows->len; j++)
+                                {
+                                        if (library_match_string (library, &predicates[i], row[j]))
+                                        {
+                                                row[matches++] = row[j];
+                                        }
+                                }
+                                break;
+                        default:
+                                integers = library->columns[predicates[i].column];
+                                for (j = 0; j < rows->len; j++)
+                                {
+                                        if (library_match_number (integers[row[j]], &predicates[i]))
+                                        {
+                                                row[matches++] = row[j];
+                                        }
+                                }
+                                break;
+                }
+                g_array_set_size (rows, matches);
+        }
+        return (rows);
+}
+
+
+/*!
+ * \brief Read a footprint library csv file.
+ *
+ * The rows of the file are appended to the \c library.\n
+ * The file is memory mapped and read in a single pass: every value is
+ * validated and stored into its column as soon as it is found, no line
+ * is copied and no value is split off into a temporary string, except
+ * for quoted values with doubled quotes in them.\n
+ * The columns are found by the names in the header line, so a file may
+ * have its columns in any order; unknown columns are skipped, missing
+ * columns are 0 or an empty string.\n
+ * Values may be quoted, a quoted value may contain semicolons, newlines
+ * and doubled quotes.\n
+ * A row with an invalid value, or with the wrong number of values, is
+ * reported with its line number and the column involved, and is left
+ * out of the library (counted in \c library->errors).
+ *
+ * \return \c EXIT_SUCCESS when the file is read, also when some rows
+ * are rejected, \c EXIT_FAILURE when the file could not be read or has
+ * no known columns.
+ */
+int
+library_read_csv_file
+(
+        library_t *library,
+                /*!< : the footprint library to append the rows to.*/
+        const gchar *csv_filename
+                /*!< : the name of the csv file.*/
+)
+{
+        GMappedFile *csv;
+        GError *error = NULL;
+        GArray *header;
+        GString *buffer;
+        const gchar *text;
+        const gchar *end;
+        const gchar *value;
+        const gchar *value_end;
+        const gchar *quote;
+        gsize length;
+        gint column;
+        gint line = 1;
+        gint record_line;
+        guint number_of_values;
+        guint errors = library->errors;
+        guint rows = library->rows;
+        gboolean escaped;
+        gboolean quoted;
+        gboolean row_valid;
+        gboolean in_header = TRUE;
+        gint i;
+
+        csv = g_mapped_file_new (csv_filename, FALSE, &error);
+        if (!csv)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_CRITICAL,
+                                _("could not open footprint library file: %s for reading.\n"),
+                                csv_filename);
+                }
+                g_error_free (error);
+                return (EXIT_FAILURE);
+        }
+        text = g_mapped_file_get_contents (csv);
+        end = text + g_mapped_file_get_length (csv);
+        header = g_array_new (FALSE, FALSE, sizeof (gint));
+        buffer = g_string_new ("");
+        while (text < end)
+        {
+                record_line = line;
+                number_of_values = 0;
+                row_valid = TRUE;
+                if (!in_header)
+                {
+                        if (library->rows == library->allocated_rows)
+                        {
+                                library_grow (library);
+                        }
+                        /* Missing columns are 0 (or NULL). */
+                        for (i = 0; i < LIBRARY_COLUMNS; i++)
+                        {
+                                switch (library_columns[i].type)
+                                {
+                                        case LIBRARY_DOUBLE:
+                                                ((gdouble *) library->columns[i])[library->rows] = 0.0;
+                                                break;
+                                        case LIBRARY_STRING:
+                                                ((gchar **) library->columns[i])[library->rows] = NULL;
+                                                break;
+                                        default:
+                                                ((gint *) library->columns[i])[library->rows] = 0;
+                                                break;
+                                }
+                        }
+                }
+                while (TRUE)
+                {
+                        /* Split off the next value. */
+                        escaped = FALSE;
+                        quoted = ((text < end) && (*text == '"'));
+                        if (quoted)
+                        {
+                                value = text + 1;
+                                quote = value;
+                                while ((quote = memchr (quote, '"', end - quote)) &&
+                                        ((quote + 1) < end) && (quote[1] == '"'))
+                                {
+                                        escaped = TRUE;
+                                        quote += 2;
+                                }
+                                if (!quote)
+                                {
+                                        if ((verbose) || (!silent))
+                                        {
+                                                g_log ("", G_LOG_LEVEL_WARNING,
+                                                        _("%s, line %d: missing closing quote.\n"),
+                                                        csv_filename, line);
+                                        }
+                                        quote = end;
+                                        row_valid = FALSE;
+                                }
+                                value_end = quote;
+                                for (text = value; (text = memchr (text, '\n', value_end - text)); text++)
+                                {
+                                        line++;
+                                }
+                                text = MIN (value_end + 1, end);
+                                if ((text < end) && (*text != ';') && (*text != '\n') && (*text != '\r'))
+                                {
+                                        if ((verbose) || (!silent))
+                                        {
+                                                g_log ("", G_LOG_LEVEL_WARNING,
+                                                        _("%s, line %d: unexpected text after a quoted value.\n"),
+                                                        csv_filename, line);
+                                        }
+                                        row_valid = FALSE;
+                                        text = library_find_delimiter (text, end);
+                                }
+                        }
+                        else
+                        {
+                                value = text;
+                                value_end = library_find_delimiter (text, end);
+                                text = value_end;
+                        }
+                        length = value_end - value;
+                        if (escaped)
+                        {
+                                /* Replace the doubled quotes by single quotes. */
+                                g_string_truncate (buffer, 0);
+                                for (; value < value_end; value++)
+                                {
+                                        g_string_append_c (buffer, *value);
+                                        if (*value == '"')
+                                        {
+                                                value++;
+                                        }
+                                }
+                                value = buffer->str;
+                                length = buffer->len;
+                        }
+                        /* Store the value. */
+                        if (in_header)
+                        {
+                                column = -1;
+                                for (i = 0; i < LIBRARY_COLUMNS; i++)
+                                {
+                                        if ((strlen (library_columns[i].name) == length) &&
+                                                !strncmp (library_columns[i].name, value, length))
+                                        {
+                                                column = i;
+                                                break;
+                                        }
+                                }
+                                if ((column < 0) && (length > 0) && (verbose))
+                                {
+                                        g_log ("", G_LOG_LEVEL_WARNING,
+                                                _("%s, line %d: unknown column %.*s skipped.\n"),
+                                                csv_filename, line, (gint) length, value);
+                                }
+                                g_array_append_val (header, column);
+                        }
+                        else if ((number_of_values < header->len) &&
+                                ((column = g_array_index (header, gint, number_of_values)) >= 0) &&
+                                !library_set_value (library, column, library->rows, value, length))
+                        {
+                                if ((verbose) || (!silent))
+                                {
+                                        g_log ("", G_LOG_LEVEL_WARNING,
+                                                _("%s, line %d: invalid %s value: \"%.*s\".\n"),
+                                                csv_filename, record_line,
+                                                library_columns[column].name,
+                                                (gint) length, value);
+                                }
+                                row_valid = FALSE;
+                        }
+                        number_of_values++;
+                        /* Go to the next value or to the next row. */
+                        if ((text < end) && (*text == ';'))
+                        {
+                                text++;
+                                continue;
+                        }
+                        if ((text < end) && (*text == '\r'))
+                        {
+                                text++;
+                        }
+                        if ((text < end) && (*text == '\n'))
+                        {
+                                text++;
+                                line++;
+                        }
+                        break;
+                }
+                if (in_header)
+                {
+                        in_header = FALSE;
+                        for (i = 0; i < (gint) header->len; i++)
+                        {
+                                if (g_array_index (header, gint, i) >= 0)
+                                {
+                                        break;
+                                }
+                        }
+                        if (i == (gint) header->len)
+                        {
+                                if ((verbose) || (!silent))
+                                {
+                                        g_log ("", G_LOG_LEVEL_CRITICAL,
+                                                _("%s: no footprint library columns found in the header.\n"),
+                                                csv_filename);
+                                }
+                                g_array_free (header, TRUE);
+                                g_string_free (buffer, TRUE);
+                                g_mapped_file_unref (csv);
+                                return (EXIT_FAILURE);
+                        }
+                        continue;
+                }
+                if ((number_of_values == 1) && (length == 0) && !quoted)
+                {
+                        /* Skip an empty line. */
+                        continue;
+                }
+                if (number_of_values != header->len)
+                {
+                        if ((verbose) || (!silent))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("%s, line %d: found %d values instead of %d.\n"),
+                                        csv_filename, record_line,
+                                        number_of_values, header->len);
+                        }
+                        row_valid = FALSE;
+                }
+                if (row_valid)
+                {
+                        library->rows++;
+                }
+                else
+                {
+                        library->errors++;
+                }
+        }
+        g_array_free (header, TRUE);
+        g_string_free (buffer, TRUE);
+        g_mapped_file_unref (csv);
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("read %d footprints from footprint library file: %s, rejected %d.\n"),
+                        library->rows - rows, csv_filename,
+                        library->errors - errors);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Set the global variables of a footprint to the values of a row
+ * of a footprint library.
+ *
+ * The footprint type, units, status, pin #1 position and pad shape
+ * strings are set from the enumerated columns as well, as if the
+ * footprint was read from a footprintwizard file.\n
+ * The strings point into the library, they are valid as long as the
+ * library is.
+ */
+void
+library_set_globals
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        guint row
+                /*!< : the row.*/
+)
+{
+        gpointer value;
+        gint i;
+
+        for (i = 0; i < LIBRARY_COLUMNS; i++)
+        {
+                if (!(value = library_columns[i].value))
+                {
+                        continue;
+                }
+                switch (library_columns[i].type)
+                {
+                        case LIBRARY_DOUBLE:
+                                *(gdouble *) value = ((gdouble *) library->columns[i])[row];
+                                break;
+                        case LIBRARY_STRING:
+                                *(gchar **) value = ((gchar **) library->columns[i])[row];
+                                break;
+                        default:
+                                *(gint *) value = ((gint *) library->columns[i])[row];
+                                break;
+                }
+        }
+        footprint_type = library_package_names[package_type];
+        footprint_units = library_units_names[units_type];
+        footprint_status = library_status_strings[status_type];
+        pin_1_position = library_location_strings[pin1_location];
+        pad_shape = library_pad_shape_strings[pad_shapes_type];
+}
+
+
+/*!
+ * \brief Sort rows of a footprint library on the values of a column.
+ *
+ * Strings are sorted with strcmp (), enumerated values by their value,
+ * rows with equal values keep their order.
+ */
+void
+library_sort
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        GArray *rows,
+                /*!< : the row numbers (guint) to sort.*/
+        library_column_t column,
+                /*!< : the column to sort on.*/
+        gboolean descending
+                /*!< : sort from high to low.*/
+)
+{
+        library_sort_order_t order;
+
+        order.library = library;
+        order.column = column;
+        order.descending = descending;
+        g_array_sort_with_data (rows, library_compare_rows, &order);
+}
+
+
+/*!
+ * \brief Write rows of a footprint library, one line per row.
+ *
+ * A line holds the package type, the footprint name, the units, the
+ * pitch in X and Y-direction, the package body length, width and height
+ * and the number of pins, separated by tabs.
+ *
+ * \return \c EXIT_SUCCESS.
+ */
+int
+library_write_rows
+(
+        library_t *library,
+                /*!< : the footprint library.*/
+        GArray *rows,
+                /*!< : the row numbers (guint) to write.*/
+        FILE *output
+                /*!< : the stream to write to.*/
+)
+{
+        static const library_column_t dimensions[] =
+        {
+                LIBRARY_PITCH_X,
+                LIBRARY_PITCH_Y,
+                LIBRARY_PACKAGE_BODY_LENGTH,
+                LIBRARY_PACKAGE_BODY_WIDTH,
+                LIBRARY_PACKAGE_BODY_HEIGHT
+        };
+        gchar buffer[G_ASCII_DTOSTR_BUF_SIZE];
+        guint row;
+        guint i;
+        guint j;
+
+        for (i = 0; i < rows->len; i++)
+        {
+                row = g_array_index (rows, guint, i);
+                fprintf (output, "%s\t%s\t%s",
+                        library_get_string (library, LIBRARY_FOOTPRINT_TYPE, row),
+                        library_get_string (library, LIBRARY_FOOTPRINT_NAME, row),
+                        library_get_string (library, LIBRARY_FOOTPRINT_UNITS, row));
+                /* Numbers are written locale independent. */
+                for (j = 0; j < G_N_ELEMENTS (dimensions); j++)
+                {
+                        fprintf (output, "\t%s", g_ascii_formatd (buffer, sizeof (buffer),
+                                "%g", library_get_double (library, dimensions[j], row)));
+                }
+                fprintf (output, "\t%d\n",
+                        library_get_integer (library, LIBRARY_NUMBER_OF_PINS, row));
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/* EOF */
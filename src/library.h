@@ -0,0 +1,229 @@
+/*!
+ * \file src/library.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for the footprint library (fpw_data.csv and
+ * user_data.csv) functions.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __LIBRARY_INCLUDED__
+#define __LIBRARY_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief Value types of the columns in a footprint library.
+ */
+typedef enum library_column_types
+{
+        LIBRARY_INTEGER, /*!< An integer number, stored as a gint. */
+        LIBRARY_DOUBLE, /*!< A floating point number, stored as a gdouble. */
+        LIBRARY_BOOLEAN, /*!< "0" or "1", stored as a gint. */
+        LIBRARY_STRING, /*!< A string, stored as a gchar pointer. */
+        LIBRARY_PACKAGE, /*!< A package type, stored as a gint (package_t). */
+        LIBRARY_UNITS, /*!< A units type, stored as a gint (units_t). */
+        LIBRARY_STATUS, /*!< A status type, stored as a gint (status_t). */
+        LIBRARY_LOCATION, /*!< A pin #1 location, stored as a gint (location_t). */
+        LIBRARY_PAD_SHAPE /*!< A pad shape, stored as a gint (pad_shapes_t). */
+} library_column_type_t;
+
+/*!
+ * \brief The columns of a footprint library, in the order of the
+ * columns in fpw_data.csv.
+ */
+typedef enum library_columns
+{
+        LIBRARY_FOOTPRINT_ID,
+        LIBRARY_FOOTPRINT_TYPE,
+        LIBRARY_FOOTPRINT_NAME,
+        LIBRARY_FOOTPRINT_UNITS,
+        LIBRARY_FOOTPRINT_STATUS,
+        LIBRARY_PACKAGE_BODY_LENGTH,
+        LIBRARY_PACKAGE_BODY_WIDTH,
+        LIBRARY_PACKAGE_BODY_HEIGHT,
+        LIBRARY_PACKAGE_IS_RADIAL,
+        LIBRARY_NUMBER_OF_PINS,
+        LIBRARY_NUMBER_OF_COLUMNS,
+        LIBRARY_NUMBER_OF_ROWS,
+        LIBRARY_PIN1_LOCATION,
+        LIBRARY_PITCH_X,
+        LIBRARY_PITCH_Y,
+        LIBRARY_COUNT_X,
+        LIBRARY_COUNT_Y,
+        LIBRARY_PIN_PAD_EXCEPTIONS_STRING,
+        LIBRARY_NUMBER_OF_EXCEPTIONS,
+        LIBRARY_PIN_DRILL_DIAMETER,
+        LIBRARY_PAD_DIAMETER,
+        LIBRARY_PAD_LENGTH,
+        LIBRARY_PAD_WIDTH,
+        LIBRARY_PAD_SHAPES_TYPE,
+        LIBRARY_PIN1_SQUARE,
+        LIBRARY_PAD_SOLDER_MASK_CLEARANCE,
+        LIBRARY_PAD_CLEARANCE,
+        LIBRARY_SILKSCREEN_PACKAGE_OUTLINE,
+        LIBRARY_SILKSCREEN_INDICATE_1,
+        LIBRARY_SILKSCREEN_LENGTH,
+        LIBRARY_SILKSCREEN_WIDTH,
+        LIBRARY_SILKSCREEN_LINE_WIDTH,
+        LIBRARY_COURTYARD,
+        LIBRARY_COURTYARD_LENGTH,
+        LIBRARY_COURTYARD_WIDTH,
+        LIBRARY_COURTYARD_LINE_WIDTH,
+        LIBRARY_COURTYARD_CLEARANCE_WITH_PACKAGE,
+        LIBRARY_THERMAL,
+        LIBRARY_THERMAL_NOPASTE,
+        LIBRARY_THERMAL_LENGTH,
+        LIBRARY_THERMAL_WIDTH,
+        LIBRARY_THERMAL_SOLDER_MASK_CLEARANCE,
+        LIBRARY_THERMAL_CLEARANCE,
+        LIBRARY_FIDUCIAL,
+        LIBRARY_FIDUCIAL_PAD_DIAMETER,
+        LIBRARY_FIDUCIAL_PAD_SOLDER_MASK_CLEARANCE,
+        LIBRARY_FIDUCIAL_CLEARANCE,
+        LIBRARY_C1,
+        LIBRARY_G1,
+        LIBRARY_Z1,
+        LIBRARY_C2,
+        LIBRARY_G2,
+        LIBRARY_Z2,
+        LIBRARY_REMARKS,
+        LIBRARY_WARNING,
+        LIBRARY_COLUMNS /*!< Number of columns, not a column. */
+} library_column_t;
+
+/*!
+ * \brief A column of a footprint library.
+ */
+typedef struct library_column_definition
+{
+        gchar *name; /*!< Name of the column in the header of a csv file. */
+        library_column_type_t type; /*!< Type of the values in the column. */
+        gpointer value; /*!< Global variable of the column, \c NULL when there is none. */
+} library_column_definition_t;
+
+/*!
+ * \brief Comparisons of a query predicate.
+ */
+typedef enum library_comparisons
+{
+        LIBRARY_EQUAL, /*!< "=", a string may contain "*" and "?" wildcards. */
+        LIBRARY_NOT_EQUAL, /*!< "!=". */
+        LIBRARY_LESS, /*!< "<". */
+        LIBRARY_LESS_OR_EQUAL, /*!< "<=". */
+        LIBRARY_GREATER, /*!< ">". */
+        LIBRARY_GREATER_OR_EQUAL /*!< ">=". */
+} library_comparison_t;
+
+/*!
+ * \brief A predicate of a query on a footprint library, for instance
+ * "pitch_x<=0.8".
+ */
+typedef struct library_predicate
+{
+        library_column_t column; /*!< Column to compare. */
+        library_comparison_t comparison; /*!< The comparison. */
+        gdouble number; /*!< Value to compare with for a numeric or enumerated column. */
+        gchar *string; /*!< Value to compare with for a string column. */
+} library_predicate_t;
+
+/*!
+ * \brief Dimensions of a nearest package search.
+ */
+typedef enum library_dimensions
+{
+        LIBRARY_LENGTH, /*!< Package body length in mm. */
+        LIBRARY_WIDTH, /*!< Package body width in mm. */
+        LIBRARY_HEIGHT, /*!< Package body height in mm. */
+        LIBRARY_PITCH, /*!< Pitch in mm, pitch_x or pitch_y when pitch_x is 0. */
+        LIBRARY_PINS, /*!< Number of pins. */
+        LIBRARY_DIMENSIONS /*!< Number of dimensions, not a dimension. */
+} library_dimension_t;
+
+/*!
+ * \brief A footprint library, stored column wise.
+ *
+ * Every column is one array with \c rows values, see
+ * library_column_type_t for the C type of the values.\n
+ * The strings are owned by the \c strings chunk.
+ */
+typedef struct library
+{
+        guint rows;
+                /*!< : is the number of valid rows.*/
+        guint allocated_rows;
+                /*!< : is the number of rows allocated in each column.*/
+        gpointer columns[LIBRARY_COLUMNS];
+                /*!< : are the column arrays.*/
+        GStringChunk *strings;
+                /*!< : holds the string values.*/
+        guint errors;
+                /*!< : is the number of rejected rows.*/
+} library_t;
+
+/*!
+ * \brief A k-d tree over the dimensions of the rows of a footprint
+ * library, for finding the nearest packages.
+ *
+ * The tree is stored implicit: the root of a range of \c rows is the
+ * middle one, the rows before it are on the low side of the split and
+ * the rows after it on the high side.
+ */
+typedef struct library_index
+{
+        library_t *library;
+                /*!< : is the footprint library.*/
+        guint size;
+                /*!< : is the number of rows in the tree.*/
+        guint *rows;
+                /*!< : are the rows in tree order.*/
+        gdouble *points;
+                /*!< : are the dimensions of the rows, \c LIBRARY_DIMENSIONS
+                 * values per row, in tree order.*/
+} library_index_t;
+
+
+int library_add_packages (library_t *library);
+void library_free (library_t *library);
+gint library_get_column (const gchar *name);
+library_column_type_t library_get_column_type (library_column_t column);
+gchar *library_get_deltas (library_t *library, guint row, const gdouble *target);
+void library_get_dimensions (library_t *library, guint row, gdouble *dimensions);
+gdouble library_get_double (library_t *library, library_column_t column, guint row);
+gint library_get_integer (library_t *library, library_column_t column, guint row);
+const gchar *library_get_string (library_t *library, library_column_t column, guint row);
+void library_index_free (library_index_t *index);
+guint library_index_nearest (library_index_t *index, const gdouble *target, guint k, guint *rows, gdouble *distances);
+library_index_t *library_index_new (library_t *library);
+library_t *library_new ();
+int library_parse_predicate (const gchar *text, library_predicate_t *predicate);
+int library_parse_target (const gchar *text, gdouble *target);
+GArray *library_query (library_t *library, library_predicate_t *predicates, guint number_of_predicates);
+int library_read_csv_file (library_t *library, const gchar *csv_filename);
+void library_set_globals (library_t *library, guint row);
+void library_sort (library_t *library, GArray *rows, library_column_t column, gboolean descending);
+int library_write_rows (library_t *library, GArray *rows, FILE *output);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __LIBRARY_INCLUDED__ */
+
+
+/* EOF */
@@ -24,6 +24,7 @@
 
 G_BEGIN_DECLS /* keep c++ happy */
 
+#include "ipc7351.h"
 #include "bga.c"
 #include "capa.c"
 #include "capad.c"
@@ -50,6 +51,8 @@ G_BEGIN_DECLS /* keep c++ happy */
 #include "mtgp.c"
 #include "pga.c"
 #include "plcc.c"
+#include "qfn.c"
+#include "qfp.c"
 #include "res.c"
 #include "resad.c"
 #include "resar.c"
@@ -58,8 +61,10 @@ G_BEGIN_DECLS /* keep c++ happy */
 #include "resmelf.c"
 #include "sil.c"
 #include "sip.c"
+#include "so.c"
 #include "sot.c"
 #include "to.c"
+#include "ipc7351.c"
 
 G_END_DECLS /* keep c++ happy */
 
@@ -35,24 +35,13 @@
 int
 plcc_create_element ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
         gdouble x_text;
         gdouble y_text;
-        gdouble x0;
-        gdouble x1;
-        gdouble y0;
-        gdouble y1;
         gdouble y_dot;
-        gdouble dx;
-        gint i;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
-        FlagType pad_flag;
+        PadType pad_template;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -65,279 +54,54 @@ plcc_create_element ()
          * put the element mark */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
+        /* Create pin and/or pad entities */
+        /* Pad #1 is located in the middle of the top side, pads number
+         * counter clockwise. */
+        pad_template.Point1.X = 0;
+        pad_template.Point1.Y = 0;
+        pad_template.Point2.X = 0;
+        pad_template.Point2.Y = 0;
+        pad_template.Thickness = units_to_coord (pad_width);
+        pad_template.Clearance = units_to_coord (pad_clearance);
+        pad_template.Mask = units_to_coord (pad_width + (2 * pad_solder_mask_clearance));
+        pad_template.Flags.f = (pad_shapes_type == SQUARE) ? SQUARE : CLEAR;
+        if (create_perimeter_array (element, count_x, count_y,
+                pitch_x, pitch_y,
+                get_pad_row_distance (1),
+                get_pad_row_distance (2),
+                units_to_coord (pad_length), UPPER_MIDDLE, NULL,
+                pin1_square, FALSE, &pad_template))
+        {
+                free_element (element);
+                return (EXIT_FAILURE);
         }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
         /* Guess for a place where to put the element name */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
         /* Guess for a place where to put the element refdes */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
         /* Guess for a place where to put the element value */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
-        /* Create pin and/or pad entities */
-        /* Start with left top half side pads,
-         * pads number from right to left,
-         * pads itself are drawn from top (x0,y0) to bottom (x1,y1) */
-        if (c1_state) /* center-center distance */
-        {
-                y0 = ((-c1 - pad_length + pad_width) / 2.0);
-                y1 = ((-c1 + pad_length - pad_width) / 2.0);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                y0 = ((-g1 + pad_width) / 2.0) - pad_length;
-                y1 = ((-g1 - pad_width) / 2.0);
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                y0 = ((-z1 + pad_width) / 2.0);
-                y1 = ((-z1 - pad_width) / 2.0) + pad_length;
-        }
-        for (pin_number = 1;
-                pin_number < ((count_x / 2) + 1.5);
-                pin_number++)
-        {
-                if (pin1_square && (pin_number == 1))
-                {
-                        pad_flag.f = SQUARE;
-                }
-                else if (pad_shapes_type == SQUARE)
-                {
-                        pad_flag.f = SQUARE;
-                }
-                else
-                {
-                        pad_flag.f = CLEAR;
-                }
-                create_new_pad
-                (
-                        element,
-                        (int) (multiplier * ((-pin_number + 1) * pitch_x)), /* x0 coordinate */
-                        (int) (multiplier * y0), /* y0-coordinate */
-                        (int) (multiplier * ((-pin_number + 1) * pitch_x)), /* x1 coordinate */
-                        (int) (multiplier * y1), /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                        pin_pad_name, /* pin name */
-                        g_strdup_printf ("%d", pin_number), /* pin number */
-                        pad_flag /* flags */
-                );
-        }
-        /* Left side pads,
-         * pads number from top to bottom,
-         * pads itself are drawn from left (x0,y0) to right (x1,y1) */
-        if (c2_state) /* center-center distance */
-        {
-                x0 = ((-c2 - pad_length + pad_width) / 2.0);
-                x1 = ((-c2 + pad_length - pad_width) / 2.0);
-        }
-        if (g2_state) /* inner-inner distance */
-        {
-                x0 = ((-g2 + pad_width) / 2.0) - pad_length;
-                x1 = ((-g2 - pad_width) / 2.0);
-        }
-        if (z2_state) /* outer-outer distance */
-        {
-                x0 = ((-z2 + pad_width) / 2.0);
-                x1 = ((-z2 - pad_width) / 2.0) + pad_length;
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5);
-                pin_number < ((count_x / 2) + 1.5 + count_y);
-                pin_number++)
-        {
-                create_new_pad
-                (
-                        element,
-                        (int) (multiplier * x0), /* x0 coordinate */
-                        (int) (multiplier * ((-count_y / 2) - 1 + i) * pitch_y), /* y0-coordinate */
-                        (int) (multiplier * x1), /* x1 coordinate */
-                        (int) (multiplier * ((-count_y / 2) - 1 + i) * pitch_y), /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                        pin_pad_name, /* pin name */
-                        g_strdup_printf ("%d", pin_number), /* pin number */
-                        pad_flag /* flags */
-                );
-                i++;
-        }
-        /* Bottom side pads,
-         * pads number from left to right,
-         * pads itself are drawn from top (x0,y0) to bottom (x1,y1) */
-        if (c1_state) /* center-center distance */
-        {
-                y0 = ((c1 - pad_length + pad_width) / 2.0);
-                y1 = ((c1 + pad_length - pad_width) / 2.0);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                y0 = ((g1 + pad_width) / 2.0);
-                y1 = ((g1 - pad_width) / 2.0) + pad_length;
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                y0 = ((z1 + pad_width) / 2.0) - pad_length;
-                y1 = ((z1 - pad_width) / 2.0);
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5 + count_y);
-                pin_number < ((count_x / 2) + 1.5 + count_y + count_x);
-                pin_number++)
-        {
-                create_new_pad
-                (
-                        element,
-                        (int) (multiplier * ((-count_x / 2) - 1 + i) * pitch_x), /* x0 coordinate */
-                        (int) (multiplier * y0), /* y0-coordinate */
-                        (int) (multiplier * ((-count_x / 2) - 1 + i) * pitch_x), /* x1 coordinate */
-                        (int) (multiplier * y1), /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                        pin_pad_name, /* pin name */
-                        g_strdup_printf ("%d", pin_number), /* pin number */
-                        pad_flag /* flags */
-                );
-                i++;
-        }
-        /* right side of the pads,
-         * pads number from bottom to top,
-         * pads itself are drawn from left (x0,y0) to right (x1,y1) */
-        if (c2_state) /* center-center distance */
-        {
-                x0 = ((c2 - pad_length + pad_width) / 2.0);
-                x1 = ((c2 + pad_length - pad_width) / 2.0);
-        }
-        if (g2_state) /* inner-inner distance */
-        {
-                x0 = ((g2 + pad_width) / 2.0);
-                x1 = ((g2 - pad_width) / 2.0) + pad_length;
-        }
-        if (z2_state) /* outer-outer distance */
-        {
-                x0 = ((z2 + pad_width) / 2.0) - pad_length;
-                x1 = ((z2 - pad_width) / 2.0);
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5 + count_y + count_x);
-                pin_number < ((count_x / 2) + 1.5 + (2 * count_y) + count_x);
-                pin_number++)
-        {
-                create_new_pad
-                (
-                        element,
-                        (int) (multiplier * x0), /* x0 coordinate */
-                        (int) (multiplier * ((count_y / 2) + 1 - i) * pitch_y), /* y0-coordinate */
-                        (int) (multiplier * x1), /* x1 coordinate */
-                        (int) (multiplier * ((count_y / 2) + 1 - i) * pitch_y), /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                        pin_pad_name, /* pin name */
-                        g_strdup_printf ("%d", pin_number), /* pin number */
-                        pad_flag /* flags */
-                );
-                i++;
-        }
-        /* right top half of the pads,
-         * pads number from right to left,
-         * pads itself are drawn from top (x0,y0) to bottom (x1,y1) */
-        if (c1_state) /* center-center distance */
-        {
-                y0 = ((-c1 - pad_length + pad_width) / 2.0);
-                y1 = ((-c1 + pad_length - pad_width) / 2.0);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                y0 = ((-g1 + pad_width) / 2.0) - pad_length;
-                y1 = ((-g1 - pad_width) / 2.0);
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                y0 = ((-z1 + pad_width) / 2.0);
-                y1 = ((-z1 - pad_width) / 2.0) + pad_length;
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5 + (2 * count_y) + count_x);
-                pin_number < (2 * (count_y + count_x) + 1);
-                pin_number++)
-        {
-                create_new_pad
-                (
-                        element,
-                        (int) (multiplier * ((count_x / 2) + 1 - i) * pitch_x), /* x0 coordinate */
-                        (int) (multiplier * y0), /* y0-coordinate */
-                        (int) (multiplier * ((count_x / 2) + 1 - i) * pitch_x), /* x1 coordinate */
-                        (int) (multiplier * y1), /* y1-coordinate */
-                        (int) (multiplier * pad_width), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * (pad_diameter + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
-                        pin_pad_name, /* pin name */
-                        g_strdup_printf ("%d", pin_number), /* pin number */
-                        pad_flag /* flags */
-                );
-                i++;
-        }
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
         /* Create a package body. */
         if (silkscreen_package_outline)
         {
@@ -345,68 +109,68 @@ plcc_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-1 * ((((count_y - 1) * pitch_y) + pad_length) / 2.0) - pad_solder_mask_clearance)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-1 * ((((count_y - 1) * pitch_y) + pad_length) / 2.0) - pad_solder_mask_clearance),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (((((count_x - 1) * pitch_x) + pad_length) / 2.0) + pad_solder_mask_clearance)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (((((count_x - 1) * pitch_x) + pad_length) / 2.0) + pad_solder_mask_clearance),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 /* Lower right corner */
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (((((count_y - 1) * pitch_y) + pad_length) / 2.0) + pad_solder_mask_clearance)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (((((count_y - 1) * pitch_y) + pad_length) / 2.0) + pad_solder_mask_clearance),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (((((count_x - 1) * pitch_x) + pad_length) / 2.0) + pad_solder_mask_clearance)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (((((count_x - 1) * pitch_x) + pad_length) / 2.0) + pad_solder_mask_clearance),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 /* Lower left corner */
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (((((count_y - 1) * pitch_y) + pad_length) / 2.0) + pad_solder_mask_clearance)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (((((count_y - 1) * pitch_y) + pad_length) / 2.0) + pad_solder_mask_clearance),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (-1 * ((((count_x - 1) * pitch_x) + pad_length) / 2.0) - pad_solder_mask_clearance)),
-                        (int) (multiplier * (package_body_width / 2.0)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (-1 * ((((count_x - 1) * pitch_x) + pad_length) / 2.0) - pad_solder_mask_clearance),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 /* Upper left corner */
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-1 * ((((count_x - 1) * pitch_x) + pad_length) / 2.0) - pad_solder_mask_clearance)),
-                        (int) (multiplier * (-package_body_width / 2.0)),
-                        (int) (multiplier * (-package_body_length / 2.0)),
-                        (int) (multiplier * (-1 * ((((count_y - 1) * pitch_y) + pad_length) / 2.0) - pad_solder_mask_clearance)),
-                        (int) (multiplier * (silkscreen_line_width))
+                        units_to_coord (-1 * ((((count_x - 1) * pitch_x) + pad_length) / 2.0) - pad_solder_mask_clearance),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (-1 * ((((count_y - 1) * pitch_y) + pad_length) / 2.0) - pad_solder_mask_clearance),
+                        units_to_coord (silkscreen_line_width)
                 );
         }
         /* Create a pin #1 marker. */
@@ -434,12 +198,12 @@ plcc_create_element ()
                 (
                         element,
                         0,
-                        (int) (multiplier * y_dot),
-                        (int) (multiplier * 0.5 * silkscreen_line_width),
-                        (int) (multiplier * 0.5 * silkscreen_line_width),
+                        units_to_coord (y_dot),
+                        units_to_coord (0.5 * silkscreen_line_width),
+                        units_to_coord (0.5 * silkscreen_line_width),
                         0,
                         360,
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (silkscreen_line_width)
                 );
         }
         /* Create a courtyard outline. */
@@ -448,38 +212,38 @@ plcc_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
         }
         /* Create attributes. */
@@ -495,7 +259,8 @@ plcc_create_element ()
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
@@ -513,7 +278,7 @@ int
 plcc_create_packages_list ()
 {
         g_list_free (packages_list);
-        packages_list = g_list_append (packages_list, "PLCC");
+        packages_list = g_list_append (packages_list, "PLCC84");
         return (EXIT_SUCCESS);
 }
 
@@ -739,7 +504,7 @@ plcc_drc ()
         }
         /* Check for clearance of the package length with regard to the
          * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -751,7 +516,7 @@ plcc_drc ()
         }
         /* Check for clearance of the package width with regard to the
          * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -800,8 +565,8 @@ plcc_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MIL_100:
                 if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
                 {
@@ -812,8 +577,8 @@ plcc_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MM:
                 if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
                 {
@@ -824,8 +589,8 @@ plcc_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 default:
                 {
                         if (verbose)
@@ -894,8 +659,8 @@ plcc_get_default_footprint_values ()
         }
         else
         {
-                fprintf (stderr,
-                         _("WARNING: default values for footprint %s not found.\n"),
+                g_log ("", G_LOG_LEVEL_WARNING,
+                         (_("default values for footprint %s not found.\n")),
                          footprint_name);
                 return (EXIT_FAILURE);
         }
@@ -952,417 +717,7 @@ plcc_set_gui_constraints ()
 int
 plcc_write_footprint ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
-        gchar *pin_pad_flags = g_strdup ("");
-        gint i;
-        gdouble x0;
-        gdouble x1;
-        gdouble y0;
-        gdouble y1;
-        gdouble y_dot;
-
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
-        {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open file for %s footprint: %s."),
-                        footprint_type, footprint_filename);
-                fclose (fp);
-                return (EXIT_FAILURE);
-        }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        if (c1_state) /* center-center distance */
-        {
-                ymin = multiplier * (((-c1 - pad_length) / 2.0) - pad_solder_mask_clearance);
-                ymax = multiplier * (((c1 + pad_length) / 2.0) + pad_solder_mask_clearance);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                ymin = multiplier * ((-g1 / 2.0) - pad_length - pad_solder_mask_clearance);
-                ymax = multiplier * ((g1 / 2.0) + pad_length + pad_solder_mask_clearance);
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                ymin = multiplier * ((-z1 / 2.0) - pad_solder_mask_clearance);
-                ymax = multiplier * ((z1 / 2.0) + pad_solder_mask_clearance);
-        }
-        if (c2_state) /* center-center distance */
-        {
-                xmin = multiplier * (((-c2 - pad_length) / 2.0) - pad_solder_mask_clearance);
-                xmax = multiplier * (((c2 + pad_length) / 2.0) + pad_solder_mask_clearance);
-        }
-        if (g2_state) /* inner-inner distance */
-        {
-                xmin = multiplier * ((-g2 / 2.0) - pad_length - pad_solder_mask_clearance);
-                xmax = multiplier * ((g2 / 2.0) + pad_length + pad_solder_mask_clearance);
-        }
-        if (z2_state) /* outer-outer distance */
-        {
-                xmin = multiplier * ((-z2 / 2.0) - pad_solder_mask_clearance);
-                xmax = multiplier * ((z2 / 2.0) + pad_solder_mask_clearance);
-        }
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        /* Start with left top half side pads,
-         * pads number from right to left,
-         * pads itself are drawn from top (x0,y0) to bottom (x1,y1) */
-        if (c1_state) /* center-center distance */
-        {
-                y0 = ((-c1 - pad_length + pad_width) / 2.0);
-                y1 = ((-c1 + pad_length - pad_width) / 2.0);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                y0 = ((-g1 + pad_width) / 2.0) - pad_length;
-                y1 = ((-g1 - pad_width) / 2.0);
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                y0 = ((-z1 + pad_width) / 2.0);
-                y1 = ((-z1 - pad_width) / 2.0) + pad_length;
-        }
-        for (pin_number = 1;
-                pin_number < ((count_x / 2) + 1.5);
-                pin_number++)
-        {
-                if (pin1_square && (pin_number == 1))
-                        pin_pad_flags = g_strdup ("square");
-                else if (!strcmp (pad_shape, "rectangular pad"))
-                        pin_pad_flags = g_strdup ("square");
-                else
-                        pin_pad_flags = g_strdup ("");
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * ((-pin_number + 1) * pitch_x), /* x0 coordinate */
-                        multiplier * y0, /* y0-coordinate */
-                        multiplier * ((-pin_number + 1) * pitch_x), /* x1 coordinate */
-                        multiplier * y1, /* y1-coordinate */
-                        multiplier * pad_width, /* pad width */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-        }
-        /* Left side pads,
-         * pads number from top to bottom,
-         * pads itself are drawn from left (x0,y0) to right (x1,y1) */
-        if (c2_state) /* center-center distance */
-        {
-                x0 = ((-c2 - pad_length + pad_width) / 2.0);
-                x1 = ((-c2 + pad_length - pad_width) / 2.0);
-        }
-        if (g2_state) /* inner-inner distance */
-        {
-                x0 = ((-g2 + pad_width) / 2.0) - pad_length;
-                x1 = ((-g2 - pad_width) / 2.0);
-        }
-        if (z2_state) /* outer-outer distance */
-        {
-                x0 = ((-z2 + pad_width) / 2.0);
-                x1 = ((-z2 - pad_width) / 2.0) + pad_length;
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5);
-                pin_number < ((count_x / 2) + 1.5 + count_y);
-                pin_number++)
-        {
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * x0, /* x0 coordinate */
-                        multiplier * ((-count_y / 2) - 1 + i) * pitch_y, /* y0-coordinate */
-                        multiplier * x1, /* x1 coordinate */
-                        multiplier * ((-count_y / 2) - 1 + i) * pitch_y, /* y1-coordinate */
-                        multiplier * pad_width, /* pad width */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                i++;
-        }
-        /* Bottom side pads,
-         * pads number from left to right,
-         * pads itself are drawn from top (x0,y0) to bottom (x1,y1) */
-        if (c1_state) /* center-center distance */
-        {
-                y0 = ((c1 - pad_length + pad_width) / 2.0);
-                y1 = ((c1 + pad_length - pad_width) / 2.0);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                y0 = ((g1 + pad_width) / 2.0);
-                y1 = ((g1 - pad_width) / 2.0) + pad_length;
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                y0 = ((z1 + pad_width) / 2.0) - pad_length;
-                y1 = ((z1 - pad_width) / 2.0);
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5 + count_y);
-                pin_number < ((count_x / 2) + 1.5 + count_y + count_x);
-                pin_number++)
-        {
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * ((-count_x / 2) - 1 + i) * pitch_x, /* x0 coordinate */
-                        multiplier * y0, /* y0-coordinate */
-                        multiplier * ((-count_x / 2) - 1 + i) * pitch_x, /* x1 coordinate */
-                        multiplier * y1, /* y1-coordinate */
-                        multiplier * pad_width, /* pad width */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                i++;
-        }
-        /* right side of the pads,
-         * pads number from bottom to top,
-         * pads itself are drawn from left (x0,y0) to right (x1,y1) */
-        if (c2_state) /* center-center distance */
-        {
-                x0 = ((c2 - pad_length + pad_width) / 2.0);
-                x1 = ((c2 + pad_length - pad_width) / 2.0);
-        }
-        if (g2_state) /* inner-inner distance */
-        {
-                x0 = ((g2 + pad_width) / 2.0);
-                x1 = ((g2 - pad_width) / 2.0) + pad_length;
-        }
-        if (z2_state) /* outer-outer distance */
-        {
-                x0 = ((z2 + pad_width) / 2.0) - pad_length;
-                x1 = ((z2 - pad_width) / 2.0);
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5 + count_y + count_x);
-                pin_number < ((count_x / 2) + 1.5 + (2 * count_y) + count_x);
-                pin_number++)
-        {
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * x0, /* x0 coordinate */
-                        multiplier * ((count_y / 2) + 1 - i) * pitch_y, /* y0-coordinate */
-                        multiplier * x1, /* x1 coordinate */
-                        multiplier * ((count_y / 2) + 1 - i) * pitch_y, /* y1-coordinate */
-                        multiplier * pad_width, /* pad width */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                i++;
-        }
-        /* right top half of the pads,
-         * pads number from right to left,
-         * pads itself are drawn from top (x0,y0) to bottom (x1,y1) */
-        if (c1_state) /* center-center distance */
-        {
-                y0 = ((-c1 - pad_length + pad_width) / 2.0);
-                y1 = ((-c1 + pad_length - pad_width) / 2.0);
-        }
-        if (g1_state) /* inner-inner distance */
-        {
-                y0 = ((-g1 + pad_width) / 2.0) - pad_length;
-                y1 = ((-g1 - pad_width) / 2.0);
-        }
-        if (z1_state) /* outer-outer distance */
-        {
-                y0 = ((-z1 + pad_width) / 2.0);
-                y1 = ((-z1 - pad_width) / 2.0) + pad_length;
-        }
-        i = 1;
-        for (pin_number = ((count_x / 2) + 2.5 + (2 * count_y) + count_x);
-                pin_number < (2 * (count_y + count_x) + 1);
-                pin_number++)
-        {
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        pin_pad_name, /* pin name */
-                        multiplier * ((count_x / 2) + 1 - i) * pitch_x, /* x0 coordinate */
-                        multiplier * y0, /* y0-coordinate */
-                        multiplier * ((count_x / 2) + 1 - i) * pitch_x, /* x1 coordinate */
-                        multiplier * y1, /* y1-coordinate */
-                        multiplier * pad_width, /* pad width */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * (pad_width + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-                i++;
-        }
-        /* Write package body on silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                /* Upper right corner */
-                write_element_line
-                (
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (-package_body_width / 2.0),
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (-1 * ((((count_y - 1) * pitch_y) + pad_length) / 2.0) - pad_solder_mask_clearance),
-                        multiplier * silkscreen_line_width
-                );
-                write_element_line
-                (
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (-package_body_width / 2.0),
-                        multiplier * (((((count_x - 1) * pitch_x) + pad_length) / 2.0) + pad_solder_mask_clearance),
-                        multiplier * (-package_body_width / 2.0),
-                        multiplier * silkscreen_line_width
-                );
-                /* Lower right corner */
-                write_element_line
-                (
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (((((count_y - 1) * pitch_y) + pad_length) / 2.0) + pad_solder_mask_clearance),
-                        multiplier * silkscreen_line_width
-                );
-                write_element_line
-                (
-                        multiplier * (package_body_length / 2.0),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * (((((count_x - 1) * pitch_x) + pad_length) / 2.0) + pad_solder_mask_clearance),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * silkscreen_line_width
-                );
-                /* Lower left corner */
-                write_element_line
-                (
-                        multiplier * (-package_body_length / 2.0),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * (-package_body_length / 2.0),
-                        multiplier * (((((count_y - 1) * pitch_y) + pad_length) / 2.0) + pad_solder_mask_clearance),
-                        multiplier * silkscreen_line_width
-                );
-                write_element_line
-                (
-                        multiplier * (-package_body_length / 2.0),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * (-1 * ((((count_x - 1) * pitch_x) + pad_length) / 2.0) - pad_solder_mask_clearance),
-                        multiplier * (package_body_width / 2.0),
-                        multiplier * silkscreen_line_width
-                );
-                /* Upper left corner */
-                write_element_line
-                (
-                        multiplier * (-1 * ((((count_x - 1) * pitch_x) + pad_length) / 2.0) - pad_solder_mask_clearance),
-                        multiplier * (-package_body_width / 2.0),
-                        multiplier * (-package_body_length / 2.0),
-                        multiplier * (-1 * ((((count_y - 1) * pitch_y) + pad_length) / 2.0) - pad_solder_mask_clearance),
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                fprintf (fp, "# Write a pin 1 marker on the silkscreen\n");
-                if (c1_state) /* center-center distance */
-                {
-                        y_dot = ((-c1 + pad_length - pad_width) / 2.0) +
-                                pad_width + pad_solder_mask_clearance +
-                                (2 * silkscreen_line_width);
-                }
-                if (g1_state) /* inner-inner distance */
-                {
-                        y_dot = ((-g1 - pad_width) / 2.0) +
-                                pad_width + pad_solder_mask_clearance +
-                                (2 * silkscreen_line_width);
-                }
-                if (z1_state) /* outer-outer distance */
-                {
-                        y_dot = ((-z1 - pad_width) / 2.0) + pad_length +
-                                pad_width + pad_solder_mask_clearance +
-                                (2 * silkscreen_line_width);
-                }
-                write_element_arc
-                (
-                        0,
-                        multiplier * y_dot,
-                        multiplier * 0.5 * silkscreen_line_width,
-                        multiplier * 0.5 * silkscreen_line_width,
-                        0,
-                        360,
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        _("wrote a footprint for a %s package: %s."),
-                        footprint_type,
-                        footprint_filename);
-        }
-        return (EXIT_SUCCESS);
+        return (write_footprint_element (plcc_create_element));
 }
 
 
@@ -0,0 +1,734 @@
+/*!
+ * \file src/qfp.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for QFP footprints.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include "register_functions.c"
+#include "qfp.h"
+
+
+/*!
+ * \brief Create an Element for a QFP package.
+ *
+ * Pads are located on all four sides of the package, pad #1 is located
+ * at the top of the left side and pads number counter clockwise.
+ *
+ * \return \c EXIT_SUCCESS when an element was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+qfp_create_element ()
+{
+        gdouble x_corner;
+        gdouble y_corner;
+        gdouble x_dot;
+        gdouble y_dot;
+        gboolean *exceptions;
+        PadType pad_template;
+        ElementTypePtr element;
+
+        element = create_new_element ();
+        if (!element)
+        {
+                if (verbose)
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create a valid element pointer for a %s package."),
+                                footprint_type);
+                return (EXIT_FAILURE);
+        }
+        /* Define the center of our universe and guess for a place where to
+         * put the element mark */
+        element->MarkX = 0;
+        element->MarkY = 0;
+        /* Create the pads on all four sides of the package, pads number
+         * counter clockwise starting at the top of the left side. */
+        pad_template.Point1.X = 0;
+        pad_template.Point1.Y = 0;
+        pad_template.Point2.X = 0;
+        pad_template.Point2.Y = 0;
+        pad_template.Thickness = units_to_coord (pad_width);
+        pad_template.Clearance = units_to_coord (pad_clearance);
+        pad_template.Mask = units_to_coord (pad_width + (2 * pad_solder_mask_clearance));
+        pad_template.Flags.f = (pad_shapes_type == SQUARE) ? SQUARE : CLEAR;
+        exceptions = get_grid_exceptions (1, 2 * (count_x + count_y), SEQUENTIAL);
+        if (create_perimeter_array (element, count_x, count_y,
+                pitch_x, pitch_y,
+                get_pad_row_distance (1),
+                get_pad_row_distance (2),
+                units_to_coord (pad_length), UPPER_LEFT, exceptions,
+                pin1_square, thermal, &pad_template))
+        {
+                g_free (exceptions);
+                free_element (element);
+                return (EXIT_FAILURE);
+        }
+        g_free (exceptions);
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name. */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes. */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value. */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create a package body on the silkscreen, only the corners are
+         * drawn to keep clear of the pads. */
+        if (silkscreen_package_outline)
+        {
+                x_corner = (((count_x - 1) * pitch_x) + pad_width) / 2.0 +
+                        pad_solder_mask_clearance + silkscreen_line_width;
+                y_corner = (((count_y - 1) * pitch_y) + pad_width) / 2.0 +
+                        pad_solder_mask_clearance + silkscreen_line_width;
+                /* Upper right corner */
+                create_new_line
+                (
+                        element,
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-y_corner),
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (x_corner),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+                /* Lower right corner */
+                create_new_line
+                (
+                        element,
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (y_corner),
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        units_to_coord (package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (x_corner),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+                /* Lower left corner */
+                create_new_line
+                (
+                        element,
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (y_corner),
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (-x_corner),
+                        units_to_coord (package_body_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
+                );
+                /* Upper left corner, bevelled to indicate pin #1 */
+                create_new_line
+                (
+                        element,
+                        units_to_coord (-x_corner),
+                        units_to_coord (-package_body_width / 2.0),
+                        units_to_coord (-package_body_length / 2.0),
+                        units_to_coord (-y_corner),
+                        units_to_coord (silkscreen_line_width)
+                );
+        }
+        /* Create a pin #1 marker next to the outer end of pad #1. */
+        if (silkscreen_indicate_1)
+        {
+                x_dot = (-get_pad_row_distance (2) - pad_length) / 2.0 -
+                        pad_solder_mask_clearance - (2 * silkscreen_line_width);
+                y_dot = -((count_y - 1) * pitch_y) / 2.0;
+                create_new_arc
+                (
+                        element,
+                        units_to_coord (x_dot),
+                        units_to_coord (y_dot),
+                        units_to_coord (0.5 * silkscreen_line_width),
+                        units_to_coord (0.5 * silkscreen_line_width),
+                        0,
+                        360,
+                        units_to_coord (silkscreen_line_width)
+                );
+        }
+        /* Create a courtyard outline. */
+        if (courtyard)
+        {
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+        }
+        /* Create attributes. */
+        if (attributes_in_footprint)
+        {
+                element = create_attributes_in_element (element);
+        }
+        /* We are ready creating an element. */
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("created an element for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
+        }
+        free_element (current_element);
+        current_element = element;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Create a list of known QFP packages.
+ *
+ * The data in this list can be used in a combobox to select a
+ * pre-defined package.
+ *
+ * \return \c EXIT_SUCCESS when a packages list was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+qfp_create_packages_list ()
+{
+        g_list_free (packages_list);
+        packages_list = g_list_append (packages_list, "QFP50P900X900X120-64N");
+        packages_list = g_list_append (packages_list, "QFP50P1200X1200X120-80N");
+        packages_list = g_list_append (packages_list, "QFP80P1200X1200X120-44N");
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Do some Design Rule Checking for the QFP package type.
+ *
+ * <ul>
+ * <li> check for allowed pad shapes.
+ * <li> check for a valid number of pads on each side.
+ * <li> check for zero sized packages.
+ * <li> check for zero sized pads.
+ * <li> check for a zero sized courtyard.
+ * <li> check for minimum clearance between copper (X-direction).
+ * <li> check for minimum clearance between copper (Y-direction).
+ * <li> check for a reasonable silk line width.
+ * </ul>
+ *
+ * \return \c EXIT_SUCCESS when no DRC violations were encountered,
+ * \c EXIT_FAILURE when DRC violations were found.
+ */
+int
+qfp_drc ()
+{
+        int result = EXIT_SUCCESS;
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        (_("[%s] DRC Check: checking package %s.")),
+                        footprint_type, footprint_name);
+        }
+        /* Check for allowed pad shapes. */
+        switch (pad_shapes_type)
+        {
+                case SQUARE:
+                case ROUND_ELONGATED:
+                {
+                        break;
+                }
+                default:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: no valid pad shape type specified.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
+        }
+        /* Check for a valid number of pads on each side. */
+        if ((count_x < 1) || (count_y < 1))
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for number of pads on each side is < 1.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for zero sized packages. */
+        if (package_body_length <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for package body length is <= 0.0.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        if (package_body_width <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for package body width is <= 0.0.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for zero sized pads. */
+        if ((pad_length <= 0.0) || (pad_width <= 0.0))
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for pad length or pad width is <= 0.0.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for a zero sized courtyard. */
+        if (courtyard_length <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for courtyard length is <= 0.0.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        if (courtyard_width <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for courtyard width is <= 0.0.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for minimum clearance between copper (X-direction). */
+        if (pitch_x - pad_width < pad_clearance)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for minimum clearance between copper (X-direction).")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for minimum clearance between copper (Y-direction). */
+        if (pitch_y - pad_width < pad_clearance)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: check for minimum clearance between copper (Y-direction).")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for a reasonable silk line width. */
+        if (silkscreen_package_outline && (silkscreen_line_width == 0.0))
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: line width 0.0 specified for check for a reasonable silk line width.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* No failures on DRC found. */
+        if (verbose && (result == EXIT_SUCCESS))
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        (_("[%s] DRC Check: no errors while checking package %s.")),
+                        footprint_type, footprint_name);
+        }
+        return (result);
+}
+
+
+/*!
+ * \brief Look up default values for QFP footprints.
+ *
+ * Footprint values can be looked up by placing a question mark "?" in front
+ * of the footprint name.\n
+ * If the footprint name is recognised the values will be loaded and the
+ * entries involved in the GUI will be updated accordingly.\n
+ * Currently the following footprints are supported:\n
+ * - QFP50P900X900X120-64N,
+ * - QFP50P1200X1200X120-80N,
+ * - QFP80P1200X1200X120-44N.
+ *
+ * Other well-formed IPC-7351 footprint names are decoded by
+ * ipc7351_get_default_footprint_values ().
+ *
+ * \return \c EXIT_SUCCESS when default values for a footprint were
+ * found, \c EXIT_FAILURE when the footprint name was not found.
+ */
+int
+qfp_get_default_footprint_values ()
+{
+        if (!strcmp (footprint_name, "?QFP50P900X900X120-64N"))
+        {
+                footprint_units = g_strdup ("mm");
+                number_of_pins = 64;
+                pin_pad_exceptions_string = g_strdup ("");
+                package_body_length = 7.00;
+                package_body_width = 7.00;
+                package_body_height = 1.20;
+                package_is_radial = FALSE;
+                number_of_columns = 2;
+                number_of_rows = 2;
+                count_x = 16;
+                count_y = 16;
+                pitch_x = 0.50;
+                pitch_y = 0.50;
+                pad_length = 1.50;
+                pad_width = 0.30;
+                pad_shape = g_strdup ("rectangular pad");
+                pad_shapes_type = SQUARE;
+                pad_clearance = 0.10;
+                pad_solder_mask_clearance = 0.05;
+                c1 = 8.40;
+                c1_state = TRUE;
+                g1_state = FALSE;
+                z1_state = FALSE;
+                c2 = 8.40;
+                c2_state = TRUE;
+                g2_state = FALSE;
+                z2_state = FALSE;
+                thermal = FALSE;
+                thermal_length = 0.0;
+                thermal_width = 0.0;
+                fiducial = FALSE;
+                fiducial_pad_diameter = 0.00;
+                fiducial_pad_solder_mask_clearance = 0.00;
+                silkscreen_package_outline = TRUE;
+                silkscreen_length = 7.00;
+                silkscreen_width = 7.00;
+                silkscreen_line_width = 0.20;
+                courtyard_length = 9.90;
+                courtyard_width = 9.90;
+                courtyard_line_width = 0.05;
+                g_free (footprint_name);
+                footprint_name = g_strdup ("QFP50P900X900X120-64N");
+                return (EXIT_SUCCESS);
+        }
+        else if (!strcmp (footprint_name, "?QFP50P1200X1200X120-80N"))
+        {
+                footprint_units = g_strdup ("mm");
+                number_of_pins = 80;
+                pin_pad_exceptions_string = g_strdup ("");
+                package_body_length = 10.00;
+                package_body_width = 10.00;
+                package_body_height = 1.20;
+                package_is_radial = FALSE;
+                number_of_columns = 2;
+                number_of_rows = 2;
+                count_x = 20;
+                count_y = 20;
+                pitch_x = 0.50;
+                pitch_y = 0.50;
+                pad_length = 1.50;
+                pad_width = 0.30;
+                pad_shape = g_strdup ("rectangular pad");
+                pad_shapes_type = SQUARE;
+                pad_clearance = 0.10;
+                pad_solder_mask_clearance = 0.05;
+                c1 = 11.40;
+                c1_state = TRUE;
+                g1_state = FALSE;
+                z1_state = FALSE;
+                c2 = 11.40;
+                c2_state = TRUE;
+                g2_state = FALSE;
+                z2_state = FALSE;
+                thermal = FALSE;
+                thermal_length = 0.0;
+                thermal_width = 0.0;
+                fiducial = FALSE;
+                fiducial_pad_diameter = 0.00;
+                fiducial_pad_solder_mask_clearance = 0.00;
+                silkscreen_package_outline = TRUE;
+                silkscreen_length = 10.00;
+                silkscreen_width = 10.00;
+                silkscreen_line_width = 0.20;
+                courtyard_length = 12.90;
+                courtyard_width = 12.90;
+                courtyard_line_width = 0.05;
+                g_free (footprint_name);
+                footprint_name = g_strdup ("QFP50P1200X1200X120-80N");
+                return (EXIT_SUCCESS);
+        }
+        else if (!strcmp (footprint_name, "?QFP80P1200X1200X120-44N"))
+        {
+                footprint_units = g_strdup ("mm");
+                number_of_pins = 44;
+                pin_pad_exceptions_string = g_strdup ("");
+                package_body_length = 10.00;
+                package_body_width = 10.00;
+                package_body_height = 1.20;
+                package_is_radial = FALSE;
+                number_of_columns = 2;
+                number_of_rows = 2;
+                count_x = 11;
+                count_y = 11;
+                pitch_x = 0.80;
+                pitch_y = 0.80;
+                pad_length = 1.50;
+                pad_width = 0.55;
+                pad_shape = g_strdup ("rectangular pad");
+                pad_shapes_type = SQUARE;
+                pad_clearance = 0.10;
+                pad_solder_mask_clearance = 0.05;
+                c1 = 11.40;
+                c1_state = TRUE;
+                g1_state = FALSE;
+                z1_state = FALSE;
+                c2 = 11.40;
+                c2_state = TRUE;
+                g2_state = FALSE;
+                z2_state = FALSE;
+                thermal = FALSE;
+                thermal_length = 0.0;
+                thermal_width = 0.0;
+                fiducial = FALSE;
+                fiducial_pad_diameter = 0.00;
+                fiducial_pad_solder_mask_clearance = 0.00;
+                silkscreen_package_outline = TRUE;
+                silkscreen_length = 10.00;
+                silkscreen_width = 10.00;
+                silkscreen_line_width = 0.20;
+                courtyard_length = 12.90;
+                courtyard_width = 12.90;
+                courtyard_line_width = 0.05;
+                g_free (footprint_name);
+                footprint_name = g_strdup ("QFP80P1200X1200X120-44N");
+                return (EXIT_SUCCESS);
+        }
+        else
+        {
+                /* Not a predefined footprint, try to derive the values
+                 * from the IPC-7351 footprint name. */
+                if (ipc7351_get_default_footprint_values (QFP) == EXIT_SUCCESS)
+                {
+                        return (EXIT_SUCCESS);
+                }
+                g_log ("", G_LOG_LEVEL_WARNING,
+                         (_("default values for footprint %s not found.\n")),
+                         footprint_name);
+                return (EXIT_FAILURE);
+        }
+}
+
+
+#if GUI
+/*!
+ * \brief Set GUI constraints for the QFP package type.
+ *
+ * This function is only to be compiled for GUI targets.
+ *
+ * \return \c EXIT_SUCCESS when the function is completed.
+ */
+int
+qfp_set_gui_constraints ()
+{
+        /* Widgets on tab "Footprint" */
+        GtkWidget *package_is_radial_checkbutton = lookup_widget (GTK_WIDGET (widget),
+                "package_is_radial_checkbutton");
+        gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (package_is_radial_checkbutton), FALSE);
+        gtk_widget_set_sensitive (package_is_radial_checkbutton, FALSE);
+
+        /* Widgets on tab "Pins/Pads" */
+        GtkWidget *number_of_columns_entry = lookup_widget (GTK_WIDGET (widget),
+                "number_of_columns_entry");
+        gtk_entry_set_text (GTK_ENTRY (number_of_columns_entry), "2");
+        gtk_widget_set_sensitive (number_of_columns_entry, FALSE);
+        GtkWidget *number_of_rows_entry = lookup_widget (GTK_WIDGET (widget),
+                "number_of_rows_entry");
+        gtk_entry_set_text (GTK_ENTRY (number_of_rows_entry), "2");
+        gtk_widget_set_sensitive (number_of_rows_entry, FALSE);
+        GtkWidget *number_1_position_entry = lookup_widget (GTK_WIDGET (widget),
+                "number_1_position_entry");
+        gtk_combo_box_set_active (GTK_COMBO_BOX (number_1_position_entry), UPPER_LEFT);
+        gtk_widget_set_sensitive (number_1_position_entry, FALSE);
+        GtkWidget *pad_diameter_entry = lookup_widget (GTK_WIDGET (widget),
+                "pad_diameter_entry");
+        gtk_entry_set_text (GTK_ENTRY (pad_diameter_entry), "");
+        gtk_widget_set_sensitive (pad_diameter_entry, FALSE);
+        GtkWidget *pin_drill_diameter_entry = lookup_widget (GTK_WIDGET (widget),
+                "pin_drill_diameter_entry");
+        gtk_entry_set_text (GTK_ENTRY (pin_drill_diameter_entry), "");
+        gtk_widget_set_sensitive (pin_drill_diameter_entry, FALSE);
+        return (EXIT_SUCCESS);
+}
+#endif /* GUI */
+
+
+/*!
+ * \brief Write a SMT footprint for a QFP package.
+ *
+ * \return \c EXIT_FAILURE when errors were encountered,
+ * \c EXIT_SUCCESS when OK.
+ */
+int
+qfp_write_footprint ()
+{
+        return (write_footprint_element (qfp_create_element));
+}
+
+
+/*!
+ * \brief A list containing all QFP related functions.
+ */
+static fpw_function_t
+qfp_function_list[] =
+{
+#if GUI
+        {
+                "Set GUI constraints",
+                qfp_set_gui_constraints,
+                "Set GUI constraints for a QFP package",
+                NULL
+        },
+#endif /* GUI */
+        {
+                "Create element",
+                qfp_create_element,
+                "Create an element for a QFP package",
+                NULL
+        },
+        {
+                "Create Packages List",
+                qfp_create_packages_list,
+                "Create a list of known QFP packages",
+                NULL
+        },
+        {
+                "DRC QFP Element",
+                qfp_drc,
+                "Design Rule Check for a QFP package",
+                NULL
+        },
+        {
+                "Default Element Values",
+                qfp_get_default_footprint_values,
+                "Get default values for a QFP package",
+                NULL
+        },
+        {
+                "Write footprint",
+                qfp_write_footprint,
+                "Write a footprint for a QFP package",
+                NULL
+        }
+};
+
+
+/*!
+ * \brief A list containing all QFP related functions.
+ */
+REGISTER_FUNCTIONS (qfp_function_list)
+
+
+/*!
+ * \brief Initialise by registering all QFP related functions.
+ */
+void
+qfp_init ()
+{
+        register_qfp_function_list ();
+}
+
+
+/* EOF */
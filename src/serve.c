@@ -0,0 +1,915 @@
+/*!
+ * \file src/serve.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for the footprint server (fpw --serve).
+ *
+ * The server reads requests, one JSON object per line, and answers every
+ * request with one JSON object on one line.\n
+ * A request holds a parameter set with the names of the lines in a
+ * footprintwizard file as keys, or the name of a footprintwizard file:
+ * <pre>
+ * {"id": 1, "fpw": "bga.fpw", "footprint_name": "BGA100"}
+ * {"id": 2, "footprint_type": "CAPC", "footprint_name": "CAPC1608X90N",
+ *  "footprint_units": "mm", "package_body_length": 1.6, ...}
+ * </pre>
+ * Values given with a footprintwizard file override the values in the
+ * file.\n
+ * The answer holds the footprint text, or the DRC errors:
+ * <pre>
+ * {"id": 1, "status": "ok", "footprint": "Element[...]\n(\n..."}
+ * {"id": 2, "status": "error", "errors": ["[CAPC] DRC Error: ..."]}
+ * </pre>
+ * Every request starts from the same default values, so requests do not
+ * depend on each other.\n
+ * The footprint functions work on global variables, so a process serves
+ * one request at a time; a Unix socket is served by a pool of worker
+ * processes forked from a warm parent.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "serve.h"
+
+
+/*!
+ * \brief The values of the footprintwizard file fields before the first
+ * request, in the order of \c fpw_fields[].
+ */
+static union
+{
+        gdouble number;
+        gint integer;
+        gchar *string;
+} serve_defaults[G_N_ELEMENTS (fpw_fields)];
+
+/*!
+ * \brief Whether \c serve_defaults holds the default values.
+ */
+static gboolean serve_defaults_saved = FALSE;
+
+/*!
+ * \brief Set by a signal to stop the server.
+ */
+static volatile sig_atomic_t serve_stop = 0;
+
+
+/*!
+ * \brief Append a string as a JSON string to a response.
+ */
+static void
+serve_append_string
+(
+        GString *response,
+                /*!< : the response.*/
+        const gchar *text
+                /*!< : the string.*/
+)
+{
+        const gchar *s;
+
+        g_string_append_c (response, '"');
+        for (s = text; *s; s++)
+        {
+                switch (*s)
+                {
+                        case '"':
+                                g_string_append (response, "\\\"");
+                                break;
+                        case '\\':
+                                g_string_append (response, "\\\\");
+                                break;
+                        case '\n':
+                                g_string_append (response, "\\n");
+                                break;
+                        case '\r':
+                                g_string_append (response, "\\r");
+                                break;
+                        case '\t':
+                                g_string_append (response, "\\t");
+                                break;
+                        default:
+                                if ((guchar) *s < 0x20)
+                                {
+                                        g_string_append_printf (response, "\\u%04x", (guchar) *s);
+                                }
+                                else
+                                {
+                                        g_string_append_c (response, *s);
+                                }
+                                break;
+                }
+        }
+        g_string_append_c (response, '"');
+}
+
+
+/*!
+ * \brief Log handler which collects the warnings and errors of a
+ * request.
+ */
+static void
+serve_log_handler
+(
+        const gchar *log_domain,
+                /*!< : the log domain.*/
+        GLogLevelFlags log_level,
+                /*!< : the log level.*/
+        const gchar *message,
+                /*!< : the message.*/
+        gpointer user_data
+                /*!< : the array of collected messages.*/
+)
+{
+        if (log_level & (G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_WARNING))
+        {
+                g_ptr_array_add ((GPtrArray *) user_data,
+                        g_strstrip (g_strdup (message)));
+        }
+}
+
+
+/*!
+ * \brief Parse a JSON string.
+ *
+ * \return the position after the closing quote, \c NULL when the string
+ * is not valid.
+ */
+static const gchar *
+serve_parse_string
+(
+        const gchar *p,
+                /*!< : the position of the opening quote.*/
+        GString *string
+                /*!< : the decoded string.*/
+)
+{
+        gunichar character;
+        gunichar low;
+        gchar *end;
+        gchar digits[5];
+        gchar utf8[6];
+
+        g_string_truncate (string, 0);
+        for (p++; *p != '"'; p++)
+        {
+                if ((guchar) *p < 0x20)
+                {
+                        return (NULL);
+                }
+                if (*p != '\\')
+                {
+                        g_string_append_c (string, *p);
+                        continue;
+                }
+                switch (*++p)
+                {
+                        case '"':
+                        case '\\':
+                        case '/':
+                                g_string_append_c (string, *p);
+                                break;
+                        case 'b':
+                                g_string_append_c (string, '\b');
+                                break;
+                        case 'f':
+                                g_string_append_c (string, '\f');
+                                break;
+                        case 'n':
+                                g_string_append_c (string, '\n');
+                                break;
+                        case 'r':
+                                g_string_append_c (string, '\r');
+                                break;
+                        case 't':
+                                g_string_append_c (string, '\t');
+                                break;
+                        case 'u':
+                                g_strlcpy (digits, p + 1, sizeof (digits));
+                                character = strtoul (digits, &end, 16);
+                                if (end != digits + 4)
+                                {
+                                        return (NULL);
+                                }
+                                p += 4;
+                                if ((character >= 0xd800) && (character < 0xdc00) &&
+                                        (p[1] == '\\') && (p[2] == 'u'))
+                                {
+                                        /* A surrogate pair. */
+                                        g_strlcpy (digits, p + 3, sizeof (digits));
+                                        low = strtoul (digits, &end, 16);
+                                        if (end != digits + 4)
+                                        {
+                                                return (NULL);
+                                        }
+                                        character = 0x10000 + ((character - 0xd800) << 10) + (low - 0xdc00);
+                                        p += 6;
+                                }
+                                g_string_append_len (string, utf8,
+                                        g_unichar_to_utf8 (character, utf8));
+                                break;
+                        default:
+                                return (NULL);
+                }
+        }
+        return (p + 1);
+}
+
+
+/*!
+ * \brief Check a number against the JSON grammar.
+ *
+ * \return \c TRUE when the text from \c p to \c end is a JSON number.
+ */
+static gboolean
+serve_is_number
+(
+        const gchar *p,
+                /*!< : the start of the number.*/
+        const gchar *end
+                /*!< : the end of the number.*/
+)
+{
+        if ((p < end) && (*p == '-'))
+        {
+                p++;
+        }
+        if ((p < end) && (*p == '0'))
+        {
+                p++;
+        }
+        else if ((p < end) && g_ascii_isdigit (*p))
+        {
+                while ((p < end) && g_ascii_isdigit (*p))
+                {
+                        p++;
+                }
+        }
+        else
+        {
+                return (FALSE);
+        }
+        if ((p < end) && (*p == '.'))
+        {
+                if ((++p == end) || !g_ascii_isdigit (*p))
+                {
+                        return (FALSE);
+                }
+                while ((p < end) && g_ascii_isdigit (*p))
+                {
+                        p++;
+                }
+        }
+        if ((p < end) && ((*p == 'e') || (*p == 'E')))
+        {
+                p++;
+                if ((p < end) && ((*p == '+') || (*p == '-')))
+                {
+                        p++;
+                }
+                if ((p == end) || !g_ascii_isdigit (*p))
+                {
+                        return (FALSE);
+                }
+                while ((p < end) && g_ascii_isdigit (*p))
+                {
+                        p++;
+                }
+        }
+        return (p == end);
+}
+
+
+/*!
+ * \brief Parse a JSON value which is not an object or an array.
+ *
+ * A string is decoded, a number is checked against the JSON grammar and
+ * taken as is, \c true and \c false become "1" and "0", as they are
+ * written in a footprintwizard file.
+ *
+ * \return the position after the value, \c NULL when the value is not
+ * valid.
+ */
+static const gchar *
+serve_parse_value
+(
+        const gchar *p,
+                /*!< : the position of the value.*/
+        GString *value,
+                /*!< : the value.*/
+        gboolean *is_null
+                /*!< : whether the value is \c null.*/
+)
+{
+        const gchar *start = p;
+
+        *is_null = FALSE;
+        if (*p == '"')
+        {
+                return (serve_parse_string (p, value));
+        }
+        g_string_truncate (value, 0);
+        if (!strncmp (p, "true", 4))
+        {
+                g_string_append_c (value, '1');
+                return (p + 4);
+        }
+        if (!strncmp (p, "false", 5))
+        {
+                g_string_append_c (value, '0');
+                return (p + 5);
+        }
+        if (!strncmp (p, "null", 4))
+        {
+                *is_null = TRUE;
+                return (p + 4);
+        }
+        while (*p && strchr ("+-.0123456789eE", *p))
+        {
+                p++;
+        }
+        if (!serve_is_number (start, p))
+        {
+                return (NULL);
+        }
+        g_string_append_len (value, start, p - start);
+        return (p);
+}
+
+
+/*!
+ * \brief Restore the footprintwizard file fields to their values before
+ * the first request.
+ *
+ * The first call saves the values.\n
+ * Strings set by a request are freed.
+ */
+static void
+serve_restore_defaults ()
+{
+        gpointer value;
+        guint i;
+
+        for (i = 0; i < G_N_ELEMENTS (fpw_fields); i++)
+        {
+                value = fpw_fields[i].value;
+                switch (fpw_fields[i].type)
+                {
+                        case FPW_IGNORE:
+                                break;
+                        case FPW_STRING:
+                                if (!serve_defaults_saved)
+                                {
+                                        serve_defaults[i].string = *(gchar **) value;
+                                }
+                                else if (*(gchar **) value != serve_defaults[i].string)
+                                {
+                                        g_free (*(gchar **) value);
+                                        *(gchar **) value = serve_defaults[i].string;
+                                }
+                                break;
+                        case FPW_DOUBLE:
+                                if (!serve_defaults_saved)
+                                {
+                                        serve_defaults[i].number = *(gdouble *) value;
+                                }
+                                *(gdouble *) value = serve_defaults[i].number;
+                                break;
+                        case FPW_INTEGER:
+                                if (!serve_defaults_saved)
+                                {
+                                        serve_defaults[i].integer = *(gint *) value;
+                                }
+                                *(gint *) value = serve_defaults[i].integer;
+                                break;
+                }
+        }
+        serve_defaults_saved = TRUE;
+}
+
+
+/*!
+ * \brief Stop the server on a signal.
+ */
+static void
+serve_signal_handler
+(
+        int signal_number
+                /*!< : the signal.*/
+)
+{
+        serve_stop = 1;
+}
+
+
+/*!
+ * \brief Serve the connections on a listening socket, in a worker
+ * process.
+ *
+ * \return never, the worker process is stopped by a signal.
+ */
+static void
+serve_worker
+(
+        gint listener
+                /*!< : the listening socket.*/
+)
+{
+        FILE *input;
+        FILE *output;
+        gint connection;
+
+        signal (SIGINT, SIG_DFL);
+        signal (SIGTERM, SIG_DFL);
+        for (;;)
+        {
+                connection = accept (listener, NULL, NULL);
+                if (connection < 0)
+                {
+                        if (errno == EINTR)
+                        {
+                                continue;
+                        }
+                        _exit (EXIT_FAILURE);
+                }
+                input = fdopen (connection, "r");
+                output = fdopen (dup (connection), "w");
+                if (input && output)
+                {
+                        serve_stream (input, output);
+                }
+                if (input)
+                {
+                        fclose (input);
+                }
+                if (output)
+                {
+                        fclose (output);
+                }
+        }
+}
+
+
+/*!
+ * \brief Serve one request.
+ *
+ * \return \c EXIT_SUCCESS when a footprint was generated,
+ * \c EXIT_FAILURE when the request failed, the reason is in the
+ * response.
+ */
+int
+serve_request
+(
+        const gchar *request,
+                /*!< : the request, a JSON object.*/
+        GString *response
+                /*!< : the response, a JSON object is appended.*/
+)
+{
+        GPtrArray *keys;
+        GPtrArray *values;
+        GPtrArray *messages;
+        GString *key;
+        GString *value;
+        GString *id_string;
+        const gchar *p;
+        const gchar *start;
+        gchar *id = NULL;
+        gchar *fpw = NULL;
+        gchar *name = NULL;
+        gchar *text = NULL;
+        gsize size = 0;
+        gboolean saved_verbose = verbose;
+        gboolean saved_silent = silent;
+        gdouble number;
+        gboolean is_null;
+        guint log_handler;
+        gint result = EXIT_FAILURE;
+        guint i;
+        guint j;
+
+        keys = g_ptr_array_new ();
+        values = g_ptr_array_new ();
+        messages = g_ptr_array_new ();
+        key = g_string_new ("");
+        value = g_string_new ("");
+        /* Parse the request, a flat JSON object. */
+        p = request;
+        while (g_ascii_isspace (*p))
+        {
+                p++;
+        }
+        if (*p++ != '{')
+        {
+                p = NULL;
+        }
+        while (p)
+        {
+                while (g_ascii_isspace (*p))
+                {
+                        p++;
+                }
+                if ((*p == '}') && (keys->len == 0) && !id && !fpw)
+                {
+                        p++;
+                        break;
+                }
+                if ((*p != '"') || !(p = serve_parse_string (p, key)))
+                {
+                        p = NULL;
+                        break;
+                }
+                while (g_ascii_isspace (*p))
+                {
+                        p++;
+                }
+                if (*p++ != ':')
+                {
+                        p = NULL;
+                        break;
+                }
+                while (g_ascii_isspace (*p))
+                {
+                        p++;
+                }
+                start = p;
+                if (!(p = serve_parse_value (p, value, &is_null)))
+                {
+                        break;
+                }
+                if (!strcmp (key->str, "id"))
+                {
+                        /* The id is echoed in the response, a string is
+                         * encoded again, anything else is a valid JSON
+                         * literal by now. */
+                        g_free (id);
+                        if (*start == '"')
+                        {
+                                id_string = g_string_new ("");
+                                serve_append_string (id_string, value->str);
+                                id = g_string_free (id_string, FALSE);
+                        }
+                        else
+                        {
+                                id = g_strndup (start, p - start);
+                        }
+                }
+                else if (!strcmp (key->str, "fpw"))
+                {
+                        g_free (fpw);
+                        fpw = g_strdup (value->str);
+                }
+                else if (!is_null)
+                {
+                        g_ptr_array_add (keys, g_strdup (key->str));
+                        g_ptr_array_add (values, g_strdup (value->str));
+                }
+                while (g_ascii_isspace (*p))
+                {
+                        p++;
+                }
+                if (*p == ',')
+                {
+                        p++;
+                        continue;
+                }
+                if (*p++ != '}')
+                {
+                        p = NULL;
+                }
+                break;
+        }
+        while (p && g_ascii_isspace (*p))
+        {
+                p++;
+        }
+        if (!p || *p)
+        {
+                g_ptr_array_add (messages, g_strdup (_("invalid request, expected a JSON object on one line.")));
+        }
+        else
+        {
+                /* Generate the footprint, collecting the messages. */
+                serve_restore_defaults ();
+                verbose = TRUE;
+                silent = FALSE;
+                log_handler = g_log_set_handler ("",
+                        G_LOG_LEVEL_CRITICAL | G_LOG_LEVEL_WARNING |
+                        G_LOG_LEVEL_MESSAGE | G_LOG_LEVEL_INFO | G_LOG_LEVEL_DEBUG,
+                        serve_log_handler, messages);
+                result = EXIT_SUCCESS;
+                if (fpw)
+                {
+                        result = read_footprintwizard_file (fpw);
+                }
+                for (i = 0; (result == EXIT_SUCCESS) && (i < keys->len); i++)
+                {
+                        if (!strcmp (keys->pdata[i], "footprint_name"))
+                        {
+                                g_free (name);
+                                name = g_strdup (values->pdata[i]);
+                                continue;
+                        }
+                        /* A value which is not a number is an error
+                         * here, not a 0 like in a footprintwizard
+                         * file. */
+                        for (j = 0; j < G_N_ELEMENTS (fpw_fields); j++)
+                        {
+                                if (!strcmp (fpw_fields[j].name, keys->pdata[i]))
+                                {
+                                        break;
+                                }
+                        }
+                        if ((j < G_N_ELEMENTS (fpw_fields)) &&
+                                ((fpw_fields[j].type == FPW_DOUBLE) || (fpw_fields[j].type == FPW_INTEGER)) &&
+                                !parse_fpw_number (values->pdata[i], strlen (values->pdata[i]), &number))
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("invalid number %s for key %s in request."),
+                                        (gchar *) values->pdata[i],
+                                        (gchar *) keys->pdata[i]);
+                                result = EXIT_FAILURE;
+                                continue;
+                        }
+                        if (set_footprintwizard_value (keys->pdata[i], values->pdata[i],
+                                strlen (values->pdata[i]), "request") == EXIT_FAILURE)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        _("unknown or invalid key %s in request."),
+                                        (gchar *) keys->pdata[i]);
+                                result = EXIT_FAILURE;
+                        }
+                }
+                if ((result == EXIT_SUCCESS) && (!name || !strcmp (name, "")))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("footprint name contains an empty string."));
+                        result = EXIT_FAILURE;
+                }
+                if ((result == EXIT_SUCCESS) &&
+                        (!footprint_type || !footprint_units || !pad_shape ||
+                        (get_package_type () == EXIT_FAILURE) ||
+                        (update_units_variables () == EXIT_FAILURE) ||
+                        (update_pad_shapes_variables () == EXIT_FAILURE)))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("unknown package type, units or pad shape in request."));
+                        result = EXIT_FAILURE;
+                }
+                if (result == EXIT_SUCCESS)
+                {
+                        footprint_name = name;
+                        footprint_filename = g_strconcat (name, ".", fp_suffix, NULL);
+                        footprint_output = open_memstream (&text, &size);
+                        result = write_footprint ();
+                        fclose (footprint_output);
+                        footprint_output = NULL;
+                        g_free (footprint_filename);
+                        footprint_filename = NULL;
+                        footprint_name = NULL;
+                        if (size == 0)
+                        {
+                                result = EXIT_FAILURE;
+                        }
+                }
+                g_log_remove_handler ("", log_handler);
+                verbose = saved_verbose;
+                silent = saved_silent;
+        }
+        /* Write the response. */
+        g_string_append_c (response, '{');
+        if (id)
+        {
+                g_string_append_printf (response, "\"id\":%s,", id);
+        }
+        if (result == EXIT_SUCCESS)
+        {
+                g_string_append (response, "\"status\":\"ok\",\"footprint\":");
+                serve_append_string (response, text);
+        }
+        else
+        {
+                g_string_append (response, "\"status\":\"error\"");
+        }
+        if (messages->len > 0)
+        {
+                g_string_append (response, (result == EXIT_SUCCESS) ?
+                        ",\"warnings\":[" : ",\"errors\":[");
+                for (i = 0; i < messages->len; i++)
+                {
+                        if (i > 0)
+                        {
+                                g_string_append_c (response, ',');
+                        }
+                        serve_append_string (response, messages->pdata[i]);
+                }
+                g_string_append_c (response, ']');
+        }
+        g_string_append_c (response, '}');
+        free (text);
+        g_free (id);
+        g_free (fpw);
+        g_free (name);
+        g_ptr_array_foreach (keys, (GFunc) g_free, NULL);
+        g_ptr_array_foreach (values, (GFunc) g_free, NULL);
+        g_ptr_array_foreach (messages, (GFunc) g_free, NULL);
+        g_ptr_array_free (keys, TRUE);
+        g_ptr_array_free (values, TRUE);
+        g_ptr_array_free (messages, TRUE);
+        g_string_free (key, TRUE);
+        g_string_free (value, TRUE);
+        return (result);
+}
+
+
+/*!
+ * \brief Serve requests on a Unix socket.
+ *
+ * A pool of \c workers processes accepts the connections, every
+ * connection is served like serve_stream () until the client closes it.
+ * A worker which dies is replaced.\n
+ * The server stops on SIGINT or SIGTERM and removes the socket.
+ *
+ * \return \c EXIT_SUCCESS when the server was stopped,
+ * \c EXIT_FAILURE when the socket could not be created.
+ */
+int
+serve_socket
+(
+        const gchar *socket_path,
+                /*!< : the path of the socket.*/
+        gint workers
+                /*!< : the number of worker processes, 0 for one per
+                 * processor.*/
+)
+{
+        struct sockaddr_un address;
+        struct sigaction action;
+        pid_t *pids;
+        pid_t pid;
+        gint listener;
+        gint status;
+        gint i;
+
+        if (strlen (socket_path) >= sizeof (address.sun_path))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("socket path %s is too long."), socket_path);
+                return (EXIT_FAILURE);
+        }
+        memset (&address, 0, sizeof (address));
+        address.sun_family = AF_UNIX;
+        strcpy (address.sun_path, socket_path);
+        listener = socket (AF_UNIX, SOCK_STREAM, 0);
+        unlink (socket_path);
+        if ((listener < 0) ||
+                (bind (listener, (struct sockaddr *) &address, sizeof (address)) < 0) ||
+                (listen (listener, SOMAXCONN) < 0))
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not listen on socket %s: %s."),
+                        socket_path, g_strerror (errno));
+                return (EXIT_FAILURE);
+        }
+        if (workers < 1)
+        {
+                workers = MAX (1, sysconf (_SC_NPROCESSORS_ONLN));
+        }
+        /* The defaults are saved before forking, so every worker starts
+         * from the same values. */
+        serve_restore_defaults ();
+        signal (SIGPIPE, SIG_IGN);
+        memset (&action, 0, sizeof (action));
+        action.sa_handler = serve_signal_handler;
+        sigaction (SIGINT, &action, NULL);
+        sigaction (SIGTERM, &action, NULL);
+        pids = g_new0 (pid_t, workers);
+        for (i = 0; i < workers; i++)
+        {
+                if ((pids[i] = fork ()) == 0)
+                {
+                        serve_worker (listener);
+                }
+        }
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("serving on socket %s with %d workers."),
+                        socket_path, workers);
+        }
+        while (!serve_stop)
+        {
+                pid = waitpid (-1, &status, 0);
+                if (pid < 0)
+                {
+                        if (errno == EINTR)
+                        {
+                                continue;
+                        }
+                        break;
+                }
+                for (i = 0; (i < workers) && !serve_stop; i++)
+                {
+                        if ((pids[i] == pid) && ((pids[i] = fork ()) == 0))
+                        {
+                                serve_worker (listener);
+                        }
+                }
+        }
+        for (i = 0; i < workers; i++)
+        {
+                if (pids[i] > 0)
+                {
+                        kill (pids[i], SIGTERM);
+                        waitpid (pids[i], &status, 0);
+                }
+        }
+        g_free (pids);
+        close (listener);
+        unlink (socket_path);
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Serve the requests on a stream, one JSON object per line,
+ * until the end of the stream.
+ *
+ * Every response is flushed, so a client can wait for it.
+ *
+ * \return \c EXIT_SUCCESS when the end of the stream was reached,
+ * \c EXIT_FAILURE when a response could not be written.
+ */
+int
+serve_stream
+(
+        FILE *input,
+                /*!< : the stream to read requests from.*/
+        FILE *output
+                /*!< : the stream to write responses to.*/
+)
+{
+        GString *response;
+        gchar *line = NULL;
+        size_t allocated = 0;
+        guint64 hits;
+        guint64 misses;
+        guint entries;
+        gint result = EXIT_SUCCESS;
+
+        response = g_string_sized_new (4096);
+        while (getline (&line, &allocated, input) != -1)
+        {
+                if (g_strstrip (line)[0] == '\0')
+                {
+                        continue;
+                }
+                g_string_truncate (response, 0);
+                serve_request (line, response);
+                g_string_append_c (response, '\n');
+                if ((fwrite (response->str, 1, response->len, output) != response->len) ||
+                        fflush (output))
+                {
+                        result = EXIT_FAILURE;
+                        break;
+                }
+        }
+        free (line);
+        g_string_free (response, TRUE);
+        if (verbose)
+        {
+                footprint_cache_get_statistics (&hits, &misses, &entries);
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("footprint cache: %" G_GUINT64_FORMAT " hits, %" G_GUINT64_FORMAT " misses, %u footprints."),
+                        hits, misses, entries);
+                footprint_cache_get_directory_statistics (&hits, &misses);
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("footprint cache directory: %" G_GUINT64_FORMAT " hits, %" G_GUINT64_FORMAT " misses."),
+                        hits, misses);
+        }
+        return (result);
+}
+
+
+/* EOF */
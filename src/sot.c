@@ -35,18 +35,16 @@
 int
 sot_create_element ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
         gdouble x_text;
         gdouble y_text;
         gdouble dx;
         gint pin_number;
         gchar *pin_pad_name = g_strdup ("");
         FlagType pad_flag;
+        FlagType pin1_flag;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -59,101 +57,13 @@ sot_create_element ()
          * put the element mark */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = multiplier *
-        (
-                ((-pitch_x * number_of_columns) / 2.0) -
-                (pad_length / 2.0) -
-                pad_solder_mask_clearance
-        );
-        xmax = multiplier *
-        (
-                ((pitch_x * number_of_columns) / 2.0) +
-                (pad_length / 2.0) +
-                pad_solder_mask_clearance
-        );
-        ymin = multiplier *
-        (
-                ((-pitch_y * number_of_rows) / 2.0) -
-                (pad_width / 2.0) -
-                pad_solder_mask_clearance
-        );
-        ymax = multiplier *
-        (
-                ((pitch_y * number_of_rows) / 2.0) +
-                (pad_width / 2.0) +
-                pad_solder_mask_clearance
-        );
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
-        /* Guess for a place where to put the element name */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
-        /* Guess for a place where to put the element refdes */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
-        /* Guess for a place where to put the element value */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
         /* Write pin and/or pad entities */
         if (pad_shapes_type == SQUARE)
                 pad_flag.f = SQUARE;
         else
                 pad_flag.f = CLEAR;
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
         if (thermal)
         {
                 /* Left side pads */
@@ -164,13 +74,13 @@ sot_create_element ()
                         create_new_pad
                         (
                                 element,
-                                (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y0-coordinate */
-                                (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y1-coordinate */
-                                (int) (multiplier * pad_width), /* pad width */
-                                (int) (multiplier * pad_clearance), /* clearance */
-                                (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
+                                units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y1-coordinate */
+                                units_to_coord (pad_width), /* pad width */
+                                units_to_coord (pad_clearance), /* clearance */
+                                units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                 "", /* pin name */
                                 g_strdup_printf ("%d", pin_number), /* pin number */
                                 pad_flag /* flags */
@@ -181,23 +91,23 @@ sot_create_element ()
                 create_new_pad
                 (
                         element,
-                        (int) (thermal_length > thermal_width
-                        ? multiplier * ((pitch_x - thermal_length + thermal_width) / 2.0)
-                        : multiplier * (pitch_x / 2.0)), /* x0 coordinate */
-                        (int) (thermal_length > thermal_width
-                        ? 0
-                        : multiplier * ((- thermal_width + thermal_length) / 2.0)), /* y0-coordinate */
-                        (int) (thermal_length > thermal_width
-                        ? multiplier * ((pitch_x + thermal_length - thermal_width) / 2.0)
-                        : multiplier * (pitch_x / 2.0)), /* x1 coordinate */
-                        (int) (thermal_length > thermal_width
-                        ? 0
-                        : multiplier * ((+ thermal_width - thermal_length) / 2.0)), /* y1-coordinate */
-                        (int) (thermal_length > thermal_width
-                        ? multiplier * thermal_width
-                        : multiplier * thermal_length), /* pad width */
-                        (int) (multiplier * pad_clearance), /* clearance */
-                        (int) (multiplier * ((thermal_length > thermal_width ? thermal_width : thermal_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                        units_to_coord (thermal_length > thermal_width
+                        ? (pitch_x - thermal_length + thermal_width) / 2.0
+                        : pitch_x / 2.0), /* x0 coordinate */
+                        units_to_coord (thermal_length > thermal_width
+                        ? 0.0
+                        : (- thermal_width + thermal_length) / 2.0), /* y0-coordinate */
+                        units_to_coord (thermal_length > thermal_width
+                        ? (pitch_x + thermal_length - thermal_width) / 2.0
+                        : pitch_x / 2.0), /* x1 coordinate */
+                        units_to_coord (thermal_length > thermal_width
+                        ? 0.0
+                        : (+ thermal_width - thermal_length) / 2.0), /* y1-coordinate */
+                        units_to_coord (thermal_length > thermal_width
+                        ? thermal_width
+                        : thermal_length), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance */
+                        units_to_coord ((thermal_length > thermal_width ? thermal_width : thermal_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                         "", /* pin name */
                         g_strdup_printf ("%d", pin_number), /* pin number */
                         pad_flag /* flags */
@@ -212,29 +122,29 @@ sot_create_element ()
                         create_new_pad
                         (
                                 element,
-                                (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                (int) (multiplier * (-pitch_y)), /* y0-coordinate */
-                                (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                (int) (multiplier * (-pitch_y)), /* y1-coordinate */
-                                (int) (multiplier * pad_width), /* pad width */
-                                (int) (multiplier * pad_clearance), /* clearance */
-                                (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                units_to_coord (-pitch_y), /* y0-coordinate */
+                                units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                units_to_coord (-pitch_y), /* y1-coordinate */
+                                units_to_coord (pad_width), /* pad width */
+                                units_to_coord (pad_clearance), /* clearance */
+                                units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                 "", /* pin name */
                                 g_strdup_printf ("%d", pin_number), /* pin number */
-                                pad_flag /* flags */
+                                pin1_flag /* flags */
                         );
                         /* Pad #2 */
                         pin_number++;
                         create_new_pad
                         (
                                 element,
-                                (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                (int) (multiplier * (pitch_y)), /* y0-coordinate */
-                                (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                (int) (multiplier * (pitch_y)), /* y1-coordinate */
-                                (int) (multiplier * pad_width), /* pad width */
-                                (int) (multiplier * pad_clearance), /* clearance */
-                                (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                units_to_coord (pitch_y), /* y0-coordinate */
+                                units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                units_to_coord (pitch_y), /* y1-coordinate */
+                                units_to_coord (pad_width), /* pad width */
+                                units_to_coord (pad_clearance), /* clearance */
+                                units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                 "", /* pin name */
                                 g_strdup_printf ("%d", pin_number), /* pin number */
                                 pad_flag /* flags */
@@ -244,13 +154,13 @@ sot_create_element ()
                         create_new_pad
                         (
                                 element,
-                                (int) (multiplier * ((pitch_x + pad_length - pad_width) / 2.0)), /* x0 coordinate */
+                                units_to_coord ((pitch_x + pad_length - pad_width) / 2.0), /* x0 coordinate */
                                 0, /* y0-coordinate */
-                                (int) (multiplier * ((pitch_x - pad_length + pad_width) / 2.0)), /* x1 coordinate */
+                                units_to_coord ((pitch_x - pad_length + pad_width) / 2.0), /* x1 coordinate */
                                 0, /* y1-coordinate */
-                                (int) (multiplier * pad_width), /* pad width */
-                                (int) (multiplier * pad_clearance), /* clearance */
-                                (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                units_to_coord (pad_width), /* pad width */
+                                units_to_coord (pad_clearance), /* clearance */
+                                units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                 "", /* pin name */
                                 g_strdup_printf ("%d", pin_number), /* pin number */
                                 pad_flag /* flags */
@@ -275,13 +185,13 @@ sot_create_element ()
                                 create_new_pad
                                 (
                                         element,
-                                        (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y1-coordinate */
-                                        (int) (multiplier * pad_width), /* pad width */
-                                        (int) (multiplier * pad_clearance), /* clearance */
-                                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                        units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                        units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
+                                        units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                        units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y1-coordinate */
+                                        units_to_coord (pad_width), /* pad width */
+                                        units_to_coord (pad_clearance), /* clearance */
+                                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                         "", /* pin name */
                                         g_strdup_printf ("%d", pin_number), /* pin number */
                                         pad_flag /* flags */
@@ -291,13 +201,13 @@ sot_create_element ()
                                 create_new_pad
                                 (
                                         element,
-                                        (int) (multiplier * ((pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                        (int) (multiplier * (pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * ((pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                        (int) (multiplier * (pitch_y)), /* y1-coordinate */
-                                        (int) (multiplier * pad_width), /* pad width */
-                                        (int) (multiplier * pad_clearance), /* clearance */
-                                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                        units_to_coord ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                        units_to_coord (pitch_y), /* y0-coordinate */
+                                        units_to_coord ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                        units_to_coord (pitch_y), /* y1-coordinate */
+                                        units_to_coord (pad_width), /* pad width */
+                                        units_to_coord (pad_clearance), /* clearance */
+                                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                         "", /* pin name */
                                         g_strdup_printf ("%d", pin_number), /* pin number */
                                         pad_flag /* flags */
@@ -306,13 +216,13 @@ sot_create_element ()
                                 create_new_pad
                                 (
                                         element,
-                                        (int) (multiplier * ((pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                        (int) (multiplier * (-pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * ((pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                        (int) (multiplier * (-pitch_y)), /* y1-coordinate */
-                                        (int) (multiplier * pad_width), /* pad width */
-                                        (int) (multiplier * pad_clearance), /* clearance */
-                                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                        units_to_coord ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                        units_to_coord (-pitch_y), /* y0-coordinate */
+                                        units_to_coord ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                        units_to_coord (-pitch_y), /* y1-coordinate */
+                                        units_to_coord (pad_width), /* pad width */
+                                        units_to_coord (pad_clearance), /* clearance */
+                                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                         "", /* pin name */
                                         g_strdup_printf ("%d", pin_number), /* pin number */
                                         pad_flag /* flags */
@@ -329,13 +239,13 @@ sot_create_element ()
                                 create_new_pad
                                 (
                                         element,
-                                        (int) (multiplier * ((-pitch_x - pad_length + pad_width) / 2.0)), /* x0 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * ((-pitch_x + pad_length - pad_width) / 2.0)), /* x1 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y)), /* y1-coordinate */
-                                        (int) (multiplier * pad_width), /* pad width */
-                                        (int) (multiplier * pad_clearance), /* clearance */
-                                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                        units_to_coord ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                        units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
+                                        units_to_coord ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                        units_to_coord ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y1-coordinate */
+                                        units_to_coord (pad_width), /* pad width */
+                                        units_to_coord (pad_clearance), /* clearance */
+                                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                         "", /* pin name */
                                         g_strdup_printf ("%d", pin_number), /* pin number */
                                         pad_flag /* flags */
@@ -344,13 +254,13 @@ sot_create_element ()
                                 create_new_pad
                                 (
                                         element,
-                                        (int) (multiplier * (pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * (pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                        (int) (multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y)), /* y0-coordinate */
-                                        (int) (multiplier * pad_width), /* width of the pad */
-                                        (int) (multiplier * pad_clearance), /* clearance */
-                                        (int) (multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance))), /* solder mask clearance */
+                                        units_to_coord ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
+                                        units_to_coord ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
+                                        units_to_coord ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
+                                        units_to_coord ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
+                                        units_to_coord (pad_width), /* width of the pad */
+                                        units_to_coord (pad_clearance), /* clearance */
+                                        units_to_coord ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
                                         "", /* pin name */
                                         g_strdup_printf ("%d", pin_number), /* pin number */
                                         pad_flag /* flags */
@@ -367,44 +277,71 @@ sot_create_element ()
                         }
                 }
         }
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
         /* Create a package body. */
         if (silkscreen_package_outline)
         {
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-silkscreen_length / 2.0)),
-                        (int) (multiplier * (-silkscreen_width / 2.0)),
-                        (int) (multiplier * (-silkscreen_length / 2.0)),
-                        (int) (multiplier * (silkscreen_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-silkscreen_length / 2.0),
+                        units_to_coord (-silkscreen_width / 2.0),
+                        units_to_coord (-silkscreen_length / 2.0),
+                        units_to_coord (silkscreen_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (silkscreen_length / 2.0)),
-                        (int) (multiplier * (-silkscreen_width / 2.0)),
-                        (int) (multiplier * (silkscreen_length / 2.0)),
-                        (int) (multiplier * (silkscreen_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (silkscreen_length / 2.0),
+                        units_to_coord (-silkscreen_width / 2.0),
+                        units_to_coord (silkscreen_length / 2.0),
+                        units_to_coord (silkscreen_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (-silkscreen_length / 2.0)),
-                        (int) (multiplier * (-silkscreen_width / 2.0)),
-                        (int) (multiplier * (silkscreen_length / 2.0)),
-                        (int) (multiplier * (-silkscreen_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (-silkscreen_length / 2.0),
+                        units_to_coord (-silkscreen_width / 2.0),
+                        units_to_coord (silkscreen_length / 2.0),
+                        units_to_coord (-silkscreen_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (multiplier * (silkscreen_length / 2.0)),
-                        (int) (multiplier * (silkscreen_width / 2.0)),
-                        (int) (multiplier * (-silkscreen_length / 2.0)),
-                        (int) (multiplier * (silkscreen_width / 2.0)),
-                        (int) (multiplier * silkscreen_line_width)
+                        units_to_coord (silkscreen_length / 2.0),
+                        units_to_coord (silkscreen_width / 2.0),
+                        units_to_coord (-silkscreen_length / 2.0),
+                        units_to_coord (silkscreen_width / 2.0),
+                        units_to_coord (silkscreen_line_width)
                 );
         }
         /* Create a pin #1 marker. */
@@ -413,13 +350,13 @@ sot_create_element ()
                 create_new_arc
                 (
                         element,
-                        (int) (multiplier * (-pitch_x)), /* x-coordinate */
-                        (int) (multiplier * (-pitch_y * (number_of_rows) / 2.0)), /* y-coordinate */
-                        (int) (multiplier * 0.5 * silkscreen_line_width), /* width */
-                        (int) (multiplier * 0.5 * silkscreen_line_width), /*height */
+                        units_to_coord (-pitch_x), /* x-coordinate */
+                        units_to_coord (-pitch_y * (number_of_rows) / 2.0), /* y-coordinate */
+                        units_to_coord (0.5 * silkscreen_line_width), /* width */
+                        units_to_coord (0.5 * silkscreen_line_width), /*height */
                         0, /* start angke */
                         360, /* delta angle */
-                        (int) (multiplier * silkscreen_line_width) /* line width */
+                        units_to_coord (silkscreen_line_width) /* line width */
                 );
         }
         /* Create a courtyard outline. */
@@ -428,38 +365,38 @@ sot_create_element ()
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymin), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
                 create_new_line
                 (
                         element,
-                        (int) (xmax), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (xmin), /* already in mil/100 */
-                        (int) (ymax), /* already in mil/100 */
-                        (int) (multiplier * courtyard_line_width)
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
                 );
         }
         /* Create attributes. */
@@ -475,7 +412,8 @@ sot_create_element ()
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
@@ -829,7 +767,7 @@ sot_drc ()
         }
         /* Check for clearance of the package length with regard to the
          * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -841,7 +779,7 @@ sot_drc ()
         }
         /* Check for clearance of the package width with regard to the
          * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
         {
                 if (verbose)
                 {
@@ -890,8 +828,8 @@ sot_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MIL_100:
                 if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
                 {
@@ -902,8 +840,8 @@ sot_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 case MM:
                 if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
                 {
@@ -914,8 +852,8 @@ sot_drc ()
                                         footprint_type);
                         }
                         result = EXIT_FAILURE;
-                        break;
                 }
+                break;
                 default:
                 {
                         if (verbose)
@@ -998,6 +936,9 @@ sot_drc ()
  * - SOT230P700X180-4AN.
  * - SOT230P700X180-4BN.
  *
+ * Other well-formed IPC-7351 footprint names are decoded by
+ * ipc7351_get_default_footprint_values ().
+ *
  * \return \c EXIT_SUCCESS when default values for a footprint were
  * found, \c EXIT_FAILURE when the footprint name was not found.
  */
@@ -3263,6 +3204,12 @@ sot_get_default_footprint_values ()
         }
         else
         {
+                /* Not a predefined footprint, try to derive the values
+                 * from the IPC-7351 footprint name. */
+                if (ipc7351_get_default_footprint_values (SOT) == EXIT_SUCCESS)
+                {
+                        return (EXIT_SUCCESS);
+                }
                 if (verbose)
                 {
                         g_log ("", G_LOG_LEVEL_WARNING,
@@ -3332,373 +3279,7 @@ sot_set_gui_constraints ()
 int
 sot_write_footprint ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gdouble dx;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
-        gchar *pin_pad_flags = g_strdup ("");
-
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
-        {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                _("could not open file for %s footprint: %s."),
-                                footprint_type, footprint_filename);
-                }
-                fclose (fp);
-                return (EXIT_FAILURE);
-        }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = multiplier *
-        (
-                ((-pitch_x * number_of_columns) / 2.0) -
-                (pad_length / 2.0) -
-                pad_solder_mask_clearance
-        );
-        xmax = multiplier *
-        (
-                ((pitch_x * number_of_columns) / 2.0) +
-                (pad_length / 2.0) +
-                pad_solder_mask_clearance
-        );
-        ymin = multiplier *
-        (
-                ((-pitch_y * number_of_rows) / 2.0) -
-                (pad_width / 2.0) -
-                pad_solder_mask_clearance
-        );
-        ymax = multiplier *
-        (
-                ((pitch_y * number_of_rows) / 2.0) +
-                (pad_width / 2.0) +
-                pad_solder_mask_clearance
-        );
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (pad_shapes_type == SQUARE)
-        {
-                pin_pad_flags = g_strdup ("square");
-        }
-        else
-        {
-                pin_pad_flags = g_strdup ("");
-        }
-        if (thermal)
-        {
-                /* Left side pads */
-                int i;
-                for (i = 0; (i < (number_of_rows)); i++)
-                {
-                        pin_number = 1 + i;
-                        write_pad
-                        (
-                                pin_number, /* pin number */
-                                "", /* pin name */
-                                multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
-                                multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y1-coordinate */
-                                multiplier * pad_width, /* pad width */
-                                multiplier * pad_clearance, /* clearance */
-                                multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                pin_pad_flags /* flags */
-                        );
-                }
-                /* Thermal pad */
-                pin_number++;
-                write_pad
-                (
-                        pin_number, /* pin number */
-                        "", /* pin name */
-                        thermal_length > thermal_width
-                        ? multiplier * ((pitch_x - thermal_length + thermal_width) / 2.0)
-                        : multiplier * (pitch_x / 2.0), /* x0 coordinate */
-                        thermal_length > thermal_width
-                        ? 0
-                        : multiplier * ((- thermal_width + thermal_length) / 2.0), /* y0-coordinate */
-                        thermal_length > thermal_width
-                        ? multiplier * ((pitch_x + thermal_length - thermal_width) / 2.0)
-                        : multiplier * (pitch_x / 2.0), /* x1 coordinate */
-                        thermal_length > thermal_width
-                        ? 0
-                        : multiplier * ((+ thermal_width - thermal_length) / 2.0), /* y1-coordinate */
-                        thermal_length > thermal_width
-                        ? multiplier * thermal_width
-                        : multiplier * thermal_length, /* pad width */
-                        multiplier * pad_clearance, /* clearance */
-                        multiplier * ((thermal_length > thermal_width ? thermal_width : thermal_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-        }
-        else
-        {
-                if (number_of_pins == 3)
-                {
-                        /* Pad #1 */
-                        pin_number = 1;
-                        write_pad
-                        (
-                                pin_number, /* pin number */
-                                "", /* pin name */
-                                multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                multiplier * (-pitch_y), /* y0-coordinate */
-                                multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                multiplier * (-pitch_y), /* y1-coordinate */
-                                multiplier * pad_width, /* pad width */
-                                multiplier * pad_clearance, /* clearance */
-                                multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                pin1_square ? "square" : pin_pad_flags /* flags */
-                        );
-                        /* Pad #2 */
-                        pin_number++;
-                        write_pad
-                        (
-                                pin_number, /* pin number */
-                                "", /* pin name */
-                                multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                multiplier * (pitch_y), /* y0-coordinate */
-                                multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                multiplier * (pitch_y), /* y1-coordinate */
-                                multiplier * pad_width, /* pad width */
-                                multiplier * pad_clearance, /* clearance */
-                                multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                pin_pad_flags /* flags */
-                        );
-                        /* Pad #3 */
-                        pin_number++;
-                        write_pad
-                        (
-                                pin_number, /* pin number */
-                                "", /* pin name */
-                                multiplier * ((pitch_x + pad_length - pad_width) / 2.0), /* x0 coordinate */
-                                0, /* y0-coordinate */
-                                multiplier * ((pitch_x - pad_length + pad_width) / 2.0), /* x1 coordinate */
-                                0, /* y1-coordinate */
-                                multiplier * pad_width, /* pad width */
-                                multiplier * pad_clearance, /* clearance */
-                                multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                pin_pad_flags /* flags */
-                        );
-                }
-                else if (number_of_pins == 4)
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        _("for now a number of pins of %d without a thermal pad is not implemented yet in sot_write_footprint()."),
-                                        number_of_pins);
-                        }
-                }
-                else if (number_of_pins == 5)
-                {
-                        int i;
-                        for (i = 0; (i < (number_of_rows)); i++)
-                        {
-                                pin_number = 1 + i;
-                                /* Left side pads */
-                                write_pad
-                                (
-                                        pin_number, /* pin number */
-                                        "", /* pin name */
-                                        multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
-                                        multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y1-coordinate */
-                                        multiplier * pad_width, /* pad width */
-                                        multiplier * pad_clearance, /* clearance */
-                                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                                /* Right side pads */
-                                pin_number++;
-                                write_pad
-                                (
-                                        pin_number, /* pin number */
-                                        "", /* pin name */
-                                        multiplier * ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                        multiplier * (pitch_y), /* y0-coordinate */
-                                        multiplier * ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                        multiplier * (pitch_y), /* y1-coordinate */
-                                        multiplier * pad_width, /* pad width */
-                                        multiplier * pad_clearance, /* clearance */
-                                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                                pin_number++;
-                                write_pad
-                                (
-                                        pin_number, /* pin number */
-                                        "", /* pin name */
-                                        multiplier * ((pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                        multiplier * (-pitch_y), /* y0-coordinate */
-                                        multiplier * ((pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                        multiplier * (-pitch_y), /* y1-coordinate */
-                                        multiplier * pad_width, /* pad width */
-                                        multiplier * pad_clearance, /* clearance */
-                                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                        }
-                }
-                else if ((number_of_pins == 6) || (number_of_pins == 8))
-                {
-                        int i;
-                        for (i = 0; (i < (number_of_rows)); i++)
-                        {
-                                pin_number = 1 + i;
-                                /* Left side pads */
-                                write_pad
-                                (
-                                        pin_number, /* pin number */
-                                        "", /* pin name */
-                                        multiplier * ((-pitch_x - pad_length + pad_width) / 2.0), /* x0 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y0-coordinate */
-                                        multiplier * ((-pitch_x + pad_length - pad_width) / 2.0), /* x1 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) +1 + i) * pitch_y), /* y1-coordinate */
-                                        multiplier * pad_width, /* pad width */
-                                        multiplier * pad_clearance, /* clearance */
-                                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                                pin_number = (number_of_columns * number_of_rows) - i;
-                                /* Right side pads */
-                                write_pad
-                                (
-                                        pin_number, /* pad number = pin_number*/
-                                        pin_pad_name, /* pad name */
-                                        multiplier * (pitch_x - pad_length + pad_width) / 2.0, /* x0 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
-                                        multiplier * (pitch_x + pad_length - pad_width) / 2.0, /* x1 coordinate */
-                                        multiplier * ((((-number_of_rows - 1) / 2.0) + 1 + i) * pitch_y), /* y0-coordinate */
-                                        multiplier * pad_width, /* width of the pad */
-                                        multiplier * pad_clearance, /* clearance */
-                                        multiplier * ((pad_length > pad_width ? pad_width : pad_length) + (2 * pad_solder_mask_clearance)), /* solder mask clearance */
-                                        pin_pad_flags /* flags */
-                                );
-                        }
-                }
-                else
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        _("number of pins of %d is not defined in sot_write_footprint()."),
-                                        number_of_pins);
-                        }
-                }
-        }
-        /* Write a package body on the silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_rectangle
-                (
-                        multiplier * (-silkscreen_length / 2.0),
-                        multiplier * (-silkscreen_width / 2.0),
-                        multiplier * (silkscreen_length / 2.0),
-                        multiplier * (silkscreen_width / 2.0),
-                        multiplier * silkscreen_line_width
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                fprintf (fp, "# Write a pin 1 marker on the silkscreen\n");
-                write_element_arc
-                (
-                        multiplier * (-pitch_x), /* x-coordinate */
-                        multiplier * (-pitch_y * (number_of_rows) / 2.0), /* y-coordinate */
-                        multiplier * 0.5 * silkscreen_line_width, /* width */
-                        multiplier * 0.5 * silkscreen_line_width, /*height */
-                        0, /* start angke */
-                        360, /* delta angle */
-                        multiplier * silkscreen_line_width /* line width */
-                );
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        _("wrote a footprint for a %s package: %s."),
-                        footprint_type,
-                        footprint_filename);
-        }
-        return (EXIT_SUCCESS);
+        return (write_footprint_element (sot_create_element));
 }
 
 
@@ -0,0 +1,724 @@
+/*!
+ * \file src/stats.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for the timing and counters of fpw --stats and the
+ * trace of fpw --trace.
+ *
+ * The time spent in every phase of writing a footprint is measured with
+ * the monotonic clock, and the pads, lines, bytes, allocations and cache
+ * hits are counted, per package type.\n
+ * The statistics are kept in shared memory, so the worker processes of a
+ * batch run add up to one summary.\n
+ * The same spans can be written as a trace, in the Chrome trace event
+ * format, to be viewed in Perfetto or chrome://tracing.\n
+ * Every thread collects its events in its own buffer, without locks,
+ * and appends the buffer to the trace file with one write () when it is
+ * full and when the thread or the process exits.\n
+ * When neither the statistics nor the trace are enabled every function
+ * returns at once, so the instrumentation costs next to nothing.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "stats.h"
+
+
+/*!
+ * \brief The names of the phases, in the order of stats_phase_t.
+ */
+static gchar *stats_phase_names[] =
+{
+        "startup", "read", "package_type", "drc", "geometry", "write"
+};
+
+/*!
+ * \brief The names of the phases in the trace, in the order of
+ * stats_phase_t.
+ */
+static gchar *stats_trace_phase_names[] =
+{
+        "startup", "parse", "package type", "DRC", "create element", "serialise"
+};
+
+/*!
+ * \brief The names of the counters, in the order of stats_counter_t.
+ */
+static gchar *stats_counter_names[] =
+{
+        "footprints", "pads", "lines", "bytes", "allocations", "cache_hits"
+};
+
+/*!
+ * \brief The statistics per package type, in shared memory, \c NULL
+ * when the statistics are not enabled.
+ */
+static stats_record_t *stats_records = NULL;
+
+/*!
+ * \brief The time of all spans which ended in this process, to leave
+ * the time of nested spans out of the span they are nested in.
+ */
+static gint64 stats_spans_time = 0;
+
+/*!
+ * \brief The trace file, opened with O_APPEND, -1 when there is no
+ * trace.
+ */
+static gint stats_trace_fd = -1;
+
+/*!
+ * \brief The process which opened the trace, and closes it.
+ */
+static pid_t stats_trace_pid = 0;
+
+/*!
+ * \brief The key of the trace buffer of a thread.
+ */
+static pthread_key_t stats_trace_key;
+
+
+/*!
+ * \brief Write the events in a trace buffer to the trace file.
+ *
+ * The trace file is opened with O_APPEND, so the buffers of all threads
+ * and processes are appended whole.
+ */
+static void
+stats_trace_write
+(
+        stats_trace_buffer_t *buffer
+                /*!< : the trace buffer.*/
+)
+{
+        gsize written = 0;
+        gssize n;
+
+        while (written < buffer->events->len)
+        {
+                n = write (stats_trace_fd, buffer->events->str + written,
+                        buffer->events->len - written);
+                if (n <= 0)
+                {
+                        break;
+                }
+                written += n;
+        }
+        g_string_truncate (buffer->events, 0);
+}
+
+
+/*!
+ * \brief Write and free the trace buffer of a thread which exits.
+ */
+static void
+stats_trace_free_buffer
+(
+        gpointer data
+                /*!< : the trace buffer.*/
+)
+{
+        stats_trace_buffer_t *buffer = data;
+
+        if ((stats_trace_fd >= 0) && (buffer->pid == getpid ()))
+        {
+                stats_trace_write (buffer);
+        }
+        g_string_free (buffer->events, TRUE);
+        g_free (buffer);
+}
+
+
+/*!
+ * \brief Get the trace buffer of this thread.
+ *
+ * A buffer inherited from the parent of a forked worker process is
+ * emptied and takes the process id and thread id of the worker.
+ *
+ * \return the trace buffer.
+ */
+static stats_trace_buffer_t *
+stats_trace_get_buffer ()
+{
+        stats_trace_buffer_t *buffer;
+
+        buffer = pthread_getspecific (stats_trace_key);
+        if (!buffer)
+        {
+                buffer = g_new0 (stats_trace_buffer_t, 1);
+                buffer->events = g_string_sized_new (STATS_TRACE_BUFFER_SIZE);
+                pthread_setspecific (stats_trace_key, buffer);
+        }
+        if (buffer->pid != getpid ())
+        {
+                g_string_truncate (buffer->events, 0);
+                buffer->pid = getpid ();
+                buffer->tid = (gint) syscall (SYS_gettid);
+        }
+        return (buffer);
+}
+
+
+/*!
+ * \brief Append a string to a trace buffer as a JSON string.
+ */
+static void
+stats_trace_append_string
+(
+        GString *events,
+                /*!< : the events of a trace buffer.*/
+        const gchar *string
+                /*!< : the string.*/
+)
+{
+        const gchar *c;
+
+        g_string_append_c (events, '"');
+        for (c = string; *c; c++)
+        {
+                if ((*c == '"') || (*c == '\\'))
+                {
+                        g_string_append_c (events, '\\');
+                        g_string_append_c (events, *c);
+                }
+                else if ((guchar) *c < 0x20)
+                {
+                        g_string_append_printf (events, "\\u%04x", (guint) *c);
+                }
+                else
+                {
+                        g_string_append_c (events, *c);
+                }
+        }
+        g_string_append_c (events, '"');
+}
+
+
+/*!
+ * \brief Print a record of the statistics as a JSON object.
+ */
+static void
+stats_print_json_record
+(
+        FILE *stream,
+                /*!< : the stream to print to.*/
+        const gchar *name,
+                /*!< : the name of the package type, or "total".*/
+        stats_record_t *record
+                /*!< : the record.*/
+)
+{
+        gint i;
+
+        fprintf (stream, "{\"package_type\":\"%s\"", name);
+        for (i = 0; i < STATS_NUMBER_OF_PHASES; i++)
+        {
+                fprintf (stream, ",\"%s_us\":%" G_GUINT64_FORMAT,
+                        stats_phase_names[i], record->time[i]);
+        }
+        for (i = 0; i < STATS_NUMBER_OF_COUNTERS; i++)
+        {
+                fprintf (stream, ",\"%s\":%" G_GUINT64_FORMAT,
+                        stats_counter_names[i], record->count[i]);
+        }
+        fprintf (stream, "}");
+}
+
+
+/*!
+ * \brief Print a record of the statistics as a row of the summary
+ * table.
+ */
+static void
+stats_print_table_record
+(
+        FILE *stream,
+                /*!< : the stream to print to.*/
+        const gchar *name,
+                /*!< : the name of the package type, or "total".*/
+        stats_record_t *record
+                /*!< : the record.*/
+)
+{
+        gint i;
+
+        fprintf (stream, "%-8s", name);
+        for (i = 0; i < STATS_NUMBER_OF_PHASES; i++)
+        {
+                fprintf (stream, " %12.3f", record->time[i] / 1000.0);
+        }
+        for (i = 0; i < STATS_NUMBER_OF_COUNTERS; i++)
+        {
+                fprintf (stream, " %12" G_GUINT64_FORMAT, record->count[i]);
+        }
+        fprintf (stream, "\n");
+}
+
+
+/*!
+ * \brief Start a span of a phase.
+ */
+void
+stats_begin
+(
+        stats_span_t *span
+                /*!< : the span.*/
+)
+{
+        if (!stats_records && (stats_trace_fd < 0))
+        {
+                return;
+        }
+        span->start = g_get_monotonic_time ();
+        span->nested = stats_spans_time;
+}
+
+
+/*!
+ * \brief Add to a counter of the current package type.
+ */
+void
+stats_count
+(
+        stats_counter_t counter,
+                /*!< : the counter.*/
+        guint64 n
+                /*!< : the number to add.*/
+)
+{
+        if (!stats_records)
+        {
+                return;
+        }
+        __sync_fetch_and_add (&stats_records[package_type].count[counter], n);
+}
+
+
+/*!
+ * \brief Enable the statistics.
+ *
+ * The statistics are mapped in shared memory, so they are shared with
+ * the worker processes forked after this.
+ *
+ * \return \c EXIT_SUCCESS when the statistics are enabled,
+ * \c EXIT_FAILURE when the memory could not be mapped.
+ */
+int
+stats_enable ()
+{
+        gpointer memory;
+
+        if (stats_records)
+        {
+                return (EXIT_SUCCESS);
+        }
+        memory = mmap (NULL, STATS_NUMBER_OF_PACKAGE_TYPES * sizeof (stats_record_t),
+                PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not map shared memory for the statistics."));
+                }
+                return (EXIT_FAILURE);
+        }
+        stats_records = memory;
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief End a span of a phase and add its time to the current package
+ * type.
+ *
+ * The time of the spans nested in this span is left out, so the time of
+ * every phase is only counted once.\n
+ * The span is added to the trace, with the package type as category.
+ */
+void
+stats_end
+(
+        stats_span_t *span,
+                /*!< : the span started with stats_begin ().*/
+        stats_phase_t phase
+                /*!< : the phase.*/
+)
+{
+        gint64 time;
+
+        if (!stats_records && (stats_trace_fd < 0))
+        {
+                return;
+        }
+        time = g_get_monotonic_time () - span->start;
+        time -= stats_spans_time - span->nested;
+        stats_spans_time += time;
+        if (stats_records)
+        {
+                __sync_fetch_and_add (&stats_records[package_type].time[phase], time);
+        }
+        stats_trace (stats_trace_phase_names[phase], library_package_names[package_type], span->start);
+}
+
+
+/*!
+ * \brief Write the trace buffer of this thread to the trace file.
+ *
+ * Call it before fork (), so a worker process does not inherit the
+ * events of its parent, and before _exit ().
+ */
+void
+stats_flush ()
+{
+        stats_trace_buffer_t *buffer;
+
+        if (stats_trace_fd < 0)
+        {
+                return;
+        }
+        buffer = pthread_getspecific (stats_trace_key);
+        if (buffer && (buffer->pid == getpid ()))
+        {
+                stats_trace_write (buffer);
+        }
+}
+
+
+/*!
+ * \brief Disable the statistics and free them.
+ */
+void
+stats_free ()
+{
+        if (stats_records)
+        {
+                munmap (stats_records, STATS_NUMBER_OF_PACKAGE_TYPES * sizeof (stats_record_t));
+                stats_records = NULL;
+        }
+}
+
+
+/*!
+ * \brief Get the sum of the statistics of all package types.
+ *
+ * The sum is all zero when the statistics are not enabled.
+ */
+void
+stats_get_total
+(
+        stats_record_t *total
+                /*!< : the sum.*/
+)
+{
+        gint type;
+        gint i;
+
+        memset (total, 0, sizeof (stats_record_t));
+        if (!stats_records)
+        {
+                return;
+        }
+        for (type = 0; type < STATS_NUMBER_OF_PACKAGE_TYPES; type++)
+        {
+                for (i = 0; i < STATS_NUMBER_OF_PHASES; i++)
+                {
+                        total->time[i] += stats_records[type].time[i];
+                }
+                for (i = 0; i < STATS_NUMBER_OF_COUNTERS; i++)
+                {
+                        total->count[i] += stats_records[type].count[i];
+                }
+        }
+}
+
+
+/*!
+ * \brief Check if the statistics are enabled.
+ *
+ * \return \c TRUE when the statistics are enabled.
+ */
+gboolean
+stats_is_enabled ()
+{
+        return (stats_records != NULL);
+}
+
+
+/*!
+ * \brief Print the statistics, one row per package type which was
+ * written and a total.
+ *
+ * The summary table has the times in milliseconds, the JSON object has
+ * the times in microseconds.\n
+ * The statistics which do not belong to a package type, like the
+ * startup, are in the NO_TYPE row.
+ */
+void
+stats_print
+(
+        FILE *stream,
+                /*!< : the stream to print to.*/
+        gboolean json
+                /*!< : print a JSON object instead of a table.*/
+)
+{
+        stats_record_t total;
+        stats_record_t *record;
+        gboolean first = TRUE;
+        gboolean empty;
+        gint type;
+        gint i;
+
+        if (!stats_records)
+        {
+                return;
+        }
+        memset (&total, 0, sizeof (total));
+        if (json)
+        {
+                fprintf (stream, "{\"packages\":[");
+        }
+        else
+        {
+                fprintf (stream, "%-8s", "package");
+                for (i = 0; i < STATS_NUMBER_OF_PHASES; i++)
+                {
+                        fprintf (stream, " %12s", stats_phase_names[i]);
+                }
+                for (i = 0; i < STATS_NUMBER_OF_COUNTERS; i++)
+                {
+                        fprintf (stream, " %12s", stats_counter_names[i]);
+                }
+                fprintf (stream, "\n");
+        }
+        for (type = 0; type < STATS_NUMBER_OF_PACKAGE_TYPES; type++)
+        {
+                record = &stats_records[type];
+                empty = TRUE;
+                for (i = 0; i < STATS_NUMBER_OF_PHASES; i++)
+                {
+                        total.time[i] += record->time[i];
+                        empty = empty && (record->time[i] == 0);
+                }
+                for (i = 0; i < STATS_NUMBER_OF_COUNTERS; i++)
+                {
+                        total.count[i] += record->count[i];
+                        empty = empty && (record->count[i] == 0);
+                }
+                if (empty)
+                {
+                        continue;
+                }
+                if (json)
+                {
+                        fprintf (stream, first ? "" : ",");
+                        stats_print_json_record (stream, library_package_names[type], record);
+                }
+                else
+                {
+                        stats_print_table_record (stream, library_package_names[type], record);
+                }
+                first = FALSE;
+        }
+        if (json)
+        {
+                fprintf (stream, "],\"total\":");
+                stats_print_json_record (stream, "total", &total);
+                fprintf (stream, "}\n");
+        }
+        else
+        {
+                stats_print_table_record (stream, "total", &total);
+        }
+        fflush (stream);
+}
+
+
+/*!
+ * \brief Run a function of a package as a span of a phase.
+ *
+ * \return the result of the function.
+ */
+int
+stats_run
+(
+        stats_phase_t phase,
+                /*!< : the phase.*/
+        int (*function) ()
+                /*!< : the function, like the DRC of a package.*/
+)
+{
+        stats_span_t span;
+        gint result;
+
+        if (!stats_records && (stats_trace_fd < 0))
+        {
+                return (function ());
+        }
+        stats_begin (&span);
+        result = function ();
+        stats_end (&span, phase);
+        return (result);
+}
+
+
+/*!
+ * \brief Add a complete event to the trace, from \c start until now.
+ */
+void
+stats_trace
+(
+        const gchar *name,
+                /*!< : the name of the event, like a phase or a
+                 * footprint.*/
+        const gchar *category,
+                /*!< : the category of the event, like the package
+                 * type.*/
+        gint64 start
+                /*!< : the monotonic time at the start of the event.*/
+)
+{
+        stats_trace_buffer_t *buffer;
+        gint64 end;
+
+        if (stats_trace_fd < 0)
+        {
+                return;
+        }
+        end = g_get_monotonic_time ();
+        buffer = stats_trace_get_buffer ();
+        g_string_append (buffer->events, "{\"name\":");
+        stats_trace_append_string (buffer->events, name);
+        g_string_append (buffer->events, ",\"cat\":");
+        stats_trace_append_string (buffer->events, category);
+        g_string_append_printf (buffer->events,
+                ",\"ph\":\"X\",\"ts\":%" G_GINT64_FORMAT ",\"dur\":%" G_GINT64_FORMAT
+                ",\"pid\":%d,\"tid\":%d},\n",
+                start, end - start, (gint) buffer->pid, buffer->tid);
+        if (buffer->events->len >= STATS_TRACE_BUFFER_SIZE)
+        {
+                stats_trace_write (buffer);
+        }
+}
+
+
+/*!
+ * \brief Close the trace, at exit of the process which opened it.
+ *
+ * The events of this thread are written and the trace is completed as
+ * a JSON array.
+ */
+void
+stats_trace_close ()
+{
+        gchar *end;
+
+        if ((stats_trace_fd < 0) || (getpid () != stats_trace_pid))
+        {
+                return;
+        }
+        stats_flush ();
+        end = g_strdup_printf ("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,"
+                "\"args\":{\"name\":\"fpw\"}}]\n", (gint) stats_trace_pid);
+        if (write (stats_trace_fd, end, strlen (end)) < 0)
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not write trace: %s."),
+                                g_strerror (errno));
+                }
+        }
+        g_free (end);
+        close (stats_trace_fd);
+        stats_trace_fd = -1;
+}
+
+
+/*!
+ * \brief Open a trace file and start tracing.
+ *
+ * The trace is a JSON array of Chrome trace events, one per line.\n
+ * Close it with stats_trace_close (), the worker processes and threads
+ * only append to it.
+ *
+ * \return \c EXIT_SUCCESS when the trace was opened,
+ * \c EXIT_FAILURE when it could not be opened.
+ */
+int
+stats_trace_open
+(
+        const gchar *filename
+                /*!< : the trace file.*/
+)
+{
+        stats_trace_fd = open (filename, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+        if ((stats_trace_fd < 0) || (write (stats_trace_fd, "[\n", 2) != 2) ||
+                (pthread_key_create (&stats_trace_key, stats_trace_free_buffer) != 0))
+        {
+                if ((verbose) || (!silent))
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not open trace %s."),
+                                filename);
+                }
+                if (stats_trace_fd >= 0)
+                {
+                        close (stats_trace_fd);
+                        stats_trace_fd = -1;
+                }
+                return (EXIT_FAILURE);
+        }
+        stats_trace_pid = getpid ();
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Name the thread which calls this in the trace.
+ */
+void
+stats_trace_set_thread_name
+(
+        const gchar *name
+                /*!< : the name of the thread.*/
+)
+{
+        stats_trace_buffer_t *buffer;
+
+        if (stats_trace_fd < 0)
+        {
+                return;
+        }
+        buffer = stats_trace_get_buffer ();
+        g_string_append_printf (buffer->events,
+                "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                (gint) buffer->pid, buffer->tid);
+        stats_trace_append_string (buffer->events, name);
+        g_string_append (buffer->events, "}},\n");
+}
+
+
+/* EOF */
@@ -0,0 +1,131 @@
+/*!
+ * \file src/stats.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for the timing and counters of fpw --stats and
+ * --trace.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __STATS_INCLUDED__
+#define __STATS_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief The number of package types, the statistics are kept per
+ * package type.
+ */
+#define STATS_NUMBER_OF_PACKAGE_TYPES (TO220W + 1)
+
+/*!
+ * \brief The size at which the trace buffer of a thread is written to the
+ * trace file.
+ */
+#define STATS_TRACE_BUFFER_SIZE 65536
+
+/*!
+ * \brief The phases of writing a footprint which are timed.
+ */
+typedef enum stats_phase
+{
+        STATS_STARTUP, /*!< Parsing the command line and setting up.*/
+        STATS_READ, /*!< Reading (parsing) a footprintwizard file.*/
+        STATS_PACKAGE_TYPE, /*!< Determining the package type.*/
+        STATS_DRC, /*!< The design rule check of a package.*/
+        STATS_GEOMETRY, /*!< Creating the element of a footprint.*/
+        STATS_WRITE, /*!< Writing (serialising) the footprint text.*/
+        STATS_NUMBER_OF_PHASES
+} stats_phase_t;
+
+/*!
+ * \brief The counters.
+ */
+typedef enum stats_counter
+{
+        STATS_FOOTPRINTS, /*!< Footprints written.*/
+        STATS_PADS, /*!< Pads and pins emitted.*/
+        STATS_LINES, /*!< Element lines and arcs emitted.*/
+        STATS_BYTES, /*!< Bytes of footprint text written.*/
+        STATS_ALLOCATIONS, /*!< Elements, pads, pins, lines, arcs and
+                * attributes allocated.*/
+        STATS_CACHE_HITS, /*!< Footprints found in the footprint cache.*/
+        STATS_NUMBER_OF_COUNTERS
+} stats_counter_t;
+
+/*!
+ * \brief The statistics of a package type.
+ */
+typedef struct stats_record
+{
+        guint64 time[STATS_NUMBER_OF_PHASES];
+                /*!< : is the time spent in every phase, in microseconds.*/
+        guint64 count[STATS_NUMBER_OF_COUNTERS];
+                /*!< : are the counters.*/
+} stats_record_t;
+
+/*!
+ * \brief A timed span of a phase.
+ */
+typedef struct stats_span
+{
+        gint64 start;
+                /*!< : is the monotonic time at the start of the span.*/
+        gint64 nested;
+                /*!< : is the time of the spans which ended before the
+                 * start, the time of the spans nested in this span is
+                 * not counted for this span.*/
+} stats_span_t;
+
+/*!
+ * \brief The trace events of a thread, waiting to be written.
+ */
+typedef struct stats_trace_buffer
+{
+        GString *events;
+                /*!< : are the events, one JSON object per line.*/
+        pid_t pid;
+                /*!< : is the process of the thread.*/
+        gint tid;
+                /*!< : is the thread id.*/
+} stats_trace_buffer_t;
+
+
+void stats_begin (stats_span_t *span);
+void stats_count (stats_counter_t counter, guint64 n);
+int stats_enable ();
+void stats_end (stats_span_t *span, stats_phase_t phase);
+void stats_flush ();
+void stats_free ();
+void stats_get_total (stats_record_t *total);
+gboolean stats_is_enabled ();
+void stats_print (FILE *stream, gboolean json);
+int stats_run (stats_phase_t phase, int (*function) ());
+void stats_trace (const gchar *name, const gchar *category, gint64 start);
+void stats_trace_close ();
+int stats_trace_open (const gchar *filename);
+void stats_trace_set_thread_name (const gchar *name);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __STATS_INCLUDED__ */
+
+
+/* EOF */
@@ -26,26 +26,20 @@
 
 
 /*!
- * \brief Create an Element for a TO92 package.
+ * \brief Create an Element for a TO220 package.
  *
  * \return \c EXIT_SUCCESS when an element was created,
  * \c EXIT_FAILURE when errors were encountered.
  */
 int
-to_create_element_to92 ()
+to_create_element_to220 ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gdouble dx;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
         FlagType pad_flag;
+        FlagType pin1_flag;
+        FlagType hole_flag;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -58,73 +52,6 @@ to_create_element_to92 ()
          * put the element mark */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
-        /* Guess for a place where to put the element name */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
-        /* Guess for a place where to put the element refdes */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
-        /* Guess for a place where to put the element value */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
         /* Create pin and/or pad entities */
         if (pad_shapes_type == SQUARE)
         {
@@ -134,88 +61,330 @@ to_create_element_to92 ()
         {
                 pad_flag.f = CLEAR;
         }
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
+        hole_flag.f = HOLE;
         create_new_pin
         (
                 element,
-                (int) (5000), /* x0 coordinate */
-                (int) (0), /* y0-coordinate */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                -10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                "3", /* pin number */
-                pad_flag /* flags */
+                "1", /* pin number */
+                pin1_flag /* flags */
         );
         create_new_pin
         (
                 element,
-                (int) (0), /* x0 coordinate */
-                (int) (0), /* y0-coordinate */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                0, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
                 "2", /* pin number */
                 pad_flag /* flags */
         );
-        if (pin1_square || (pad_shapes_type == SQUARE))
-        {
-                pad_flag.f = SQUARE;
-        }
-        else
-        {
-                pad_flag.f = CLEAR;
-        }
         create_new_pin
         (
                 element,
-                -5000, /* x0 coordinate, already in mil/100 */
-                0, /* y0-coordinate, already in mil/100 */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                "1", /* pin number */
+                "3", /* pin number */
                 pad_flag /* flags */
         );
-        /* Create a package body. */
-        create_new_line
-        (
-                element,
-                -8600, /* x0 coordinate, already in mil/100 */
-                -6000, /* y0-coordinate, already in mil/100 */
-                8600, /* x1-coordinate, already in mil/100 */
-                -6000, /* y1-coordinate, already in mil/100 */
-                (int) (multiplier * silkscreen_line_width) /* line width */
-        );
-        create_new_arc
-        (
-                element,
-                0, /* x coordinate of center point, already in mil/100 */
-                0, /* y coordinate of center point, already in mil/100 */
-                10500, /* width, already in mil/100 */
-                10500, /* height, already in mil/100 */
-                -35, /* start angle */
-                250, /* delta angle */
-                (int) (multiplier * silkscreen_line_width) /* line width */
-        );
-        /* Create a pin #1 marker. */
-                /* package has marker in package body outline geometry */
-        /* Create a courtyard outline. */
-        create_new_arc
+        /* Attachment drill hole (PTH). */
+        create_new_pin
         (
                 element,
-                0, /* x coordinate of center point, already in mil/100 */
-                0, /* y coordinate of center point, already in mil/100 */
-                xmax, /* width, already in mil/100 */
-                ymax, /* height, already in mil/100 */
-                0, /* start angle */
-                360, /* delta angle */
-                (int) (multiplier * silkscreen_line_width) /* line width */
+                10000, /* x0 coordinate */
+                -67000, /* y0-coordinate */
+                15000, /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                15000 + units_to_coord (pad_solder_mask_clearance), /* solder mask clearance */
+                13000, /* pin drill diameter */
+                "", /* pin name */
+                "0", /* pin number */
+                hole_flag /* flags */
         );
+        /* Add a thermal pad if the user requests for it. */
+        if (thermal)
+        {
+                create_new_pad
+                (
+                        element,
+                        0, /* x0 coordinate */
+                        -67000 - units_to_coord (thermal_width + (thermal_length / 2)), /* y0-coordinate */
+                        0, /* x1 coordinate */
+                        -67000 + units_to_coord (thermal_width + (thermal_length / 2)), /* y1-coordinate */
+                        units_to_coord (thermal_length), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance with other copper */
+                        units_to_coord (thermal_length + (2 * thermal_solder_mask_clearance)), /* solder mask clearance */
+                        "", /* pin name */
+                        "0", /* pin number */
+                        pad_flag /* flags */
+                );
+        }
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create package body */
+        if (silkscreen_package_outline)
+        {
+	        /* Leads. */
+                create_new_line
+                (
+                        element,
+                        -10000,
+                        units_to_coord (-pad_diameter),
+                        -10000,
+                        -18000,
+                        units_to_coord (2 * silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        0,
+                        units_to_coord (-pad_diameter),
+                        0,
+                        -18000,
+                        units_to_coord (2 * silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        10000,
+                        units_to_coord (-pad_diameter),
+                        10000,
+                        -18000,
+                        units_to_coord (2 * silkscreen_line_width)
+                );
+	        /* Body. */
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -18000,
+                        -20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -18000,
+                        20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -55500,
+                        20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -18000,
+                        20000,
+                        -18000,
+                        units_to_coord (silkscreen_line_width)
+                );
+	        /* Cooling tab with notches. */
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -55500,
+                        20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -55500,
+                        20000,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -68000,
+                        18500,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        18500,
+                        -68000,
+                        18500,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        18500,
+                        -75000,
+                        20000,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -75000,
+                        20000,
+                        -79000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -79000,
+                        -20000,
+                        -79000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -79000,
+                        -20000,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -75000,
+                        -18500,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -18500,
+                        -75000,
+                        -18500,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -18500,
+                        -68000,
+                        -20000,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -68000,
+                        -20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+        }
+        /* Create a pin #1 marker */
+        if (silkscreen_indicate_1)
+        {
+                /*! \todo Write a pin #1 marker on the silkscreen ! */
+        }
+        /* Create a courtyard */
+        if (courtyard)
+        {
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+        }
         /* Create attributes. */
         if (attributes_in_footprint)
         {
@@ -229,32 +398,28 @@ to_create_element_to92 ()
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
 
+
 /*!
- * \brief Create an Element for a TO92S package.
+ * \brief Create an Element for a TO220S package.
  *
  * \return \c EXIT_SUCCESS when an element was created,
  * \c EXIT_FAILURE when errors were encountered.
  */
 int
-to_create_element_to92_staggered ()
+to_create_element_to220_staggered ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gdouble dx;
-        gint pin_number;
-        gchar *pin_pad_name = g_strdup ("");
         FlagType pad_flag;
+        FlagType pin1_flag;
+        FlagType hole_flag;
         ElementTypePtr element;
 
+        element = create_new_element ();
         if (!element)
         {
                 if (verbose)
@@ -267,73 +432,6 @@ to_create_element_to92_staggered ()
          * put the element mark */
         element->MarkX = 0;
         element->MarkY = 0;
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-        {
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-        {
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-        {
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        }
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-        {
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        }
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-        {
-                xmin = multiplier * (-courtyard_length / 2.0);
-        }
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-        {
-                xmax = multiplier * (courtyard_length / 2.0);
-        }
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-        {
-                ymin = multiplier * (-courtyard_width / 2.0);
-        }
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-        {
-                ymax = multiplier * (courtyard_width / 2.0);
-        }
-        /* Store the courtyard dimensions in Virtual (bounding) Box. */
-        element->VBox.X1 = (int) xmin;
-        element->VBox.Y1 = (int) ymin;
-        element->VBox.X2 = (int) xmax;
-        element->VBox.Y2 = (int) ymax;
-        /* Guess for a place where to put the element name */
-        element->Name[1].Scale = 100; /* 100 percent */
-        element->Name[1].X = 0.0 ; /* already in mil/100 */
-        element->Name[1].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[1].TextString = footprint_name;
-        element->Name[1].Element = element;
-        element->Name[1].Direction = EAST;
-        element->Name[1].ID = ID++;
-        /* Guess for a place where to put the element refdes */
-        element->Name[2].Scale = 100; /* 100 percent */
-        element->Name[2].X = 0.0 ; /* already in mil/100 */
-        element->Name[2].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[2].TextString = footprint_refdes;
-        element->Name[2].Element = element;
-        element->Name[2].Direction = EAST;
-        element->Name[2].ID = ID++;
-        /* Guess for a place where to put the element value */
-        element->Name[3].Scale = 100; /* 100 percent */
-        element->Name[3].X = 0.0 ; /* already in mil/100 */
-        element->Name[3].Y = (ymin - 10000.0); /* already in mil/100 */
-        element->Name[3].TextString = footprint_value;
-        element->Name[3].Element = element;
-        element->Name[3].Direction = EAST;
-        element->Name[3].ID = ID++;
         /* Create pin and/or pad entities */
         if (pad_shapes_type == SQUARE)
         {
@@ -343,1378 +441,1671 @@ to_create_element_to92_staggered ()
         {
                 pad_flag.f = CLEAR;
         }
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
+        hole_flag.f = HOLE;
         create_new_pin
         (
                 element,
-                5000, /* x0 coordinate */
+                -10000, /* x0 coordinate */
                 0, /* y0-coordinate */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                "3", /* pin number */
-                pad_flag /* flags */
+                "1", /* pin number */
+                pin1_flag /* flags */
         );
         create_new_pin
         (
                 element,
                 0, /* x0 coordinate */
-                -5000, /* y0-coordinate */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                10000, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
                 "2", /* pin number */
                 pad_flag /* flags */
         );
-        if (pin1_square || (pad_shapes_type == SQUARE))
-        {
-                pad_flag.f = SQUARE;
-        }
-        else
-        {
-                pad_flag.f = CLEAR;
-        }
         create_new_pin
         (
                 element,
-                -5000, /* x0 coordinate, already in mil/100 */
-                0, /* y0-coordinate, already in mil/100 */
-                (int) (multiplier * pad_diameter), /* pad width */
-                (int) (multiplier * pad_clearance), /* clearance */
-                (int) (multiplier * (pad_diameter + pad_solder_mask_clearance)), /* solder mask clearance */
-                (int) (multiplier * pin_drill_diameter), /* pin drill diameter */
+                10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                "1", /* pin number */
+                "3", /* pin number */
                 pad_flag /* flags */
         );
-        /* Create a package body. */
-        create_new_line
-        (
-                element,
-                -8600, /* x0 coordinate, already in mil/100 */
-                -6000, /* y0-coordinate, already in mil/100 */
-                8600, /* x1-coordinate, already in mil/100 */
-                -6000, /* y1-coordinate, already in mil/100 */
-                (int) (multiplier * silkscreen_line_width) /* line width */
-        );
-        create_new_arc
-        (
-                element,
-                0, /* x coordinate of center point, already in mil/100 */
-                0, /* y coordinate of center point, already in mil/100 */
-                10500, /* width, already in mil/100 */
-                10500, /* height, already in mil/100 */
-                -35, /* start angle */
-                250, /* delta angle */
-                (int) (multiplier * silkscreen_line_width) /* line width */
-        );
-        /* Create a pin #1 marker. */
-                /* package has marker in package body outline geometry */
-        /* Create a courtyard outline. */
-        create_new_arc
+        /* Attachment drill hole (PTH). */
+        create_new_pin
         (
                 element,
-                0, /* x coordinate of center point, already in mil/100 */
-                0, /* y coordinate of center point, already in mil/100 */
-                xmax, /* width, already in mil/100 */
-                ymax, /* height, already in mil/100 */
-                0, /* start angle */
-                360, /* delta angle */
-                (int) (multiplier * silkscreen_line_width) /* line width */
+                10000, /* x0 coordinate */
+                -67000, /* y0-coordinate */
+                15000, /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                15000 + units_to_coord (pad_solder_mask_clearance), /* solder mask clearance */
+                13000, /* pin drill diameter */
+                "", /* pin name */
+                "0", /* pin number */
+                hole_flag /* flags */
         );
-        /* Create attributes. */
-        if (attributes_in_footprint)
+        /* Add a thermal pad if the user requests for it. */
+        if (thermal)
         {
-                element = create_attributes_in_element (element);
+                create_new_pad
+                (
+                        element,
+                        0, /* x0 coordinate */
+                        -67000 - units_to_coord (thermal_width + (thermal_length / 2)), /* y0-coordinate */
+                        0, /* x1 coordinate */
+                        -67000 + units_to_coord (thermal_width + (thermal_length / 2)), /* y1-coordinate */
+                        units_to_coord (thermal_length), /* pad width */
+                        units_to_coord (pad_clearance), /* clearance with other copper */
+                        units_to_coord (thermal_length + (2 * thermal_solder_mask_clearance)), /* solder mask clearance */
+                        "", /* pin name */
+                        "0", /* pin number */
+                        pad_flag /* flags */
+                );
         }
-        /* We are ready creating an element. */
-        if (verbose)
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create package body */
+        if (silkscreen_package_outline)
         {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        _("created an element for a %s package: %s."),
+	        /* Leads. */
+                create_new_line
+                (
+                        element,
+                        -10000,
+                        units_to_coord (-pad_diameter),
+                        -10000,
+                        -18000,
+                        units_to_coord (2 * silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        0,
+                        units_to_coord (-pad_diameter),
+                        0,
+                        -8000,
+                        units_to_coord (2 * silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        10000,
+                        units_to_coord (-pad_diameter),
+                        10000,
+                        -18000,
+                        units_to_coord (2 * silkscreen_line_width)
+                );
+	        /* Body. */
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -18000,
+                        -20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -18000,
+                        20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -55500,
+                        20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -18000,
+                        20000,
+                        -18000,
+                        units_to_coord (silkscreen_line_width)
+                );
+	        /* Cooling tab with notches. */
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -55500,
+                        20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -55500,
+                        20000,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -68000,
+                        18500,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        18500,
+                        -68000,
+                        18500,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        18500,
+                        -75000,
+                        20000,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -75000,
+                        20000,
+                        -79000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20000,
+                        -79000,
+                        -20000,
+                        -79000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -79000,
+                        -20000,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -75000,
+                        -18500,
+                        -75000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -18500,
+                        -75000,
+                        -18500,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -18500,
+                        -68000,
+                        -20000,
+                        -68000,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20000,
+                        -68000,
+                        -20000,
+                        -55500,
+                        units_to_coord (silkscreen_line_width)
+                );
+        }
+        /* Create a pin #1 marker */
+        if (silkscreen_indicate_1)
+        {
+                /*! \todo Write a pin #1 marker on the silkscreen ! */
+        }
+        /* Create a courtyard */
+        if (courtyard)
+        {
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+        }
+        /* Create attributes. */
+        if (attributes_in_footprint)
+        {
+                element = create_attributes_in_element (element);
+        }
+        /* We are ready creating an element. */
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("created an element for a %s package: %s."),
                         footprint_type,
                         footprint_filename);
         }
-        current_element = (ElementTypePtr) &element;
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
 
+
 /*!
- * \brief Create a list of TO packages with pre-defined values.
- *
- * The data in this list can be used in a combobox to select a
- * pre-defined package.
+ * \brief Create an Element for a TO220W package.
  *
  * \return \c EXIT_SUCCESS when an element was created,
  * \c EXIT_FAILURE when errors were encountered.
  */
 int
-to_create_packages_list ()
+to_create_element_to220_standing ()
 {
-        g_list_free (packages_list);
-        packages_list = g_list_append (packages_list, "TO92");
-        packages_list = g_list_append (packages_list, "TO92S");
-        packages_list = g_list_append (packages_list, "TO220");
-        packages_list = g_list_append (packages_list, "TO220S");
-        packages_list = g_list_append (packages_list, "TO220SW");
-        packages_list = g_list_append (packages_list, "TO220W");
-        return (EXIT_SUCCESS);
-}
-
+        FlagType pad_flag;
+        FlagType pin1_flag;
+        ElementTypePtr element;
 
-/*!
- * \brief Do some Design Rule Checking for the TO package type.
- *
- * <ul>
- * <li> check for allowed pad shapes.
- * <li> check for zero sized packages.
- * <li> check for a zero sized courtyard.
- * <li> check for minimum clearance between copper (X-direction).
- * <li> check for minimum clearance between copper (Y-direction).
- * <li> check if no fiducials exist.
- * <li> check for clearance of the package length with regard to the
- * courtyard dimensions.
- * <li> check for clearance of the package width with regard to the
- * courtyard dimensions.
- * <li> check for any silk lines or texts touching bare copper.
- * <li> check for soldermask clearance (solder mask overlapping copper
- * at the solder fillet area or worse).
- * <li> check for a reasonable silk line width.
- * </ul>
- *
- * \return \c EXIT_SUCCESS when no DRC violations were encountered,
- * \c EXIT_FAILURE when DRC violations were found.
- */
-int
-to_drc ()
-{
-        int result = EXIT_SUCCESS;
-        if (verbose)
-        {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        (_("[%s] DRC Check: checking package %s.")),
-                        footprint_type, footprint_name);
-        }
-        /* Check for allowed pad shapes. */
-        switch (pad_shapes_type)
-        {
-                case NO_SHAPE:
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: NO_SHAPE specified for check for allowed pad shapes.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                case ROUND:
-                {
-                        break;
-                }
-                case SQUARE:
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: square pad shape specified for check for allowed pad shapes.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                case OCTAGONAL:
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: octagonal pad shape specified for check for allowed pad shapes.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                case ROUND_ELONGATED:
-                {
-                        break;
-                }
-                default:
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: no valid pad shape type specified.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-        }
-        /* Check for pitch (X-direction) > 0.0. */
-        if (pitch_x <= 0.0)
+        element = create_new_element ();
+        if (!element)
         {
                 if (verbose)
-                {
                         g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: pitch (X-direction) should be greater than 0.")),
+                                _("could not create a valid element pointer for a %s package."),
                                 footprint_type);
-                }
-                result = EXIT_FAILURE;
+                return (EXIT_FAILURE);
         }
-        /* Check for zero sized packages. */
-        if (package_body_length <= 0.0)
+        /* Define the center of our universe and guess for a place where to
+         * put the element mark */
+        element->MarkX = 0;
+        element->MarkY = 0;
+        /* Create pin and/or pad entities */
+        if (pad_shapes_type == SQUARE)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: specified package body length is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                pad_flag.f = SQUARE;
         }
-        if (package_body_width <= 0.0)
+        else
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: specified package body width is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                pad_flag.f = CLEAR;
         }
-        if (package_body_height <= 0.0)
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
+        create_new_pin
+        (
+                element,
+                -10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
+                "", /* pin name */
+                "1", /* pin number */
+                pin1_flag /* flags */
+        );
+        create_new_pin
+        (
+                element,
+                0, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
+                "", /* pin name */
+                "2", /* pin number */
+                pad_flag /* flags */
+        );
+        create_new_pin
+        (
+                element,
+                10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
+                "", /* pin name */
+                "3", /* pin number */
+                pad_flag /* flags */
+        );
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create package body */
+        if (silkscreen_package_outline)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: specified package body height is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                create_new_line
+                (
+                        element,
+                        -20750,
+                        -12600,
+                        -20750,
+                        5900,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -20750,
+                        5900,
+                        20750,
+                        5900,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20750,
+                        5900,
+                        20750,
+                        -12600,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20750,
+                        -12600,
+                        -20750,
+                        -12600,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -18750,
+                        -10000,
+                        18750,
+                        -10000,
+                        5200
+                );
+                create_new_line
+                (
+                        element,
+                        -20750,
+                        -7600,
+                        20750,
+                        -7600,
+                        units_to_coord (silkscreen_line_width)
+                );
         }
-        /* Check for a zero sized courtyard. */
-        if (courtyard_length <= 0.0)
+        /* Create a pin #1 marker */
+        if (silkscreen_indicate_1)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: specified courtyard length is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                /*! \todo Write a pin #1 marker on the silkscreen ! */
         }
-        if (courtyard_width <= 0.0)
+        /* Create a courtyard */
+        if (courtyard)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: specified courtyard width is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
         }
-        /* Check for minimum clearance between copper (Y-direction). */
-        if ((pitch_y - pad_diameter < pad_clearance) || (pitch_y - pad_width < pad_clearance))
+        /* Create attributes. */
+        if (attributes_in_footprint)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: minimum clearance between copper (Y-direction) is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                element = create_attributes_in_element (element);
         }
-        /* Checking for fiducials. */
-        if (fiducial)
+        /* We are ready creating an element. */
+        if (verbose)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: package should not have any fiducials.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("created an element for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
         }
-        /* Check for clearance of the package length with regard to the
-         * courtyard dimensions. */
-        if (package_body_length - courtyard_length < courtyard_clearance_with_package)
+        free_element (current_element);
+        current_element = element;
+        return (EXIT_SUCCESS);
+}
+
+
+
+/*!
+ * \brief Create an Element for a TO220SW package.
+ *
+ * \return \c EXIT_SUCCESS when an element was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+to_create_element_to220_standing_staggered ()
+{
+        FlagType pad_flag;
+        FlagType pin1_flag;
+        ElementTypePtr element;
+
+        element = create_new_element ();
+        if (!element)
         {
                 if (verbose)
-                {
                         g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: clearance of the package length with regard to the courtyard dimensions is too small.")),
+                                _("could not create a valid element pointer for a %s package."),
                                 footprint_type);
-                }
-                result = EXIT_FAILURE;
+                return (EXIT_FAILURE);
         }
-        /* Check for clearance of the package width with regard to the
-         * courtyard dimensions. */
-        if (package_body_width - courtyard_width < courtyard_clearance_with_package)
+        /* Define the center of our universe and guess for a place where to
+         * put the element mark */
+        element->MarkX = 0;
+        element->MarkY = 0;
+        /* Create pin and/or pad entities */
+        if (pad_shapes_type == SQUARE)
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: clearance of the package width with regard to the courtyard dimensions is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                pad_flag.f = SQUARE;
         }
-        /*! \todo Check for any silk lines or texts touching bare copper. */
-
-        /*! \todo Check for soldermask clearance (solder mask overlapping copper at
-         * the solder fillet area or worse). */
-
-        /* Check for a reasonable silk line width. */
-        if (silkscreen_package_outline && (silkscreen_line_width == 0.0))
+        else
         {
-                if (verbose)
-                {
-                        g_log ("", G_LOG_LEVEL_WARNING,
-                                (_("[%s] DRC Error: silkscreen line width is too small.")),
-                                footprint_type);
-                }
-                result = EXIT_FAILURE;
+                pad_flag.f = CLEAR;
         }
-        switch (units_type)
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
+        create_new_pin
+        (
+                element,
+                -10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
+                "", /* pin name */
+                "1", /* pin number */
+                pin1_flag /* flags */
+        );
+        create_new_pin
+        (
+                element,
+                0, /* x0 coordinate */
+                -10000, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
+                "", /* pin name */
+                "2", /* pin number */
+                pad_flag /* flags */
+        );
+        create_new_pin
+        (
+                element,
+                10000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
+                "", /* pin name */
+                "3", /* pin number */
+                pad_flag /* flags */
+        );
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create package body */
+        if (silkscreen_package_outline)
         {
-                case NO_UNITS:
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: no units specified.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                case MIL:
-                if (silkscreen_package_outline && (silkscreen_line_width > 40.0))
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: silkscreen line width too wide.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                case MIL_100:
-                if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: silkscreen line width too wide.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                case MM:
-                if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: silkscreen line width too wide.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
-                default:
-                {
-                        if (verbose)
-                        {
-                                g_log ("", G_LOG_LEVEL_WARNING,
-                                        (_("[%s] DRC Error: no valid units type specified.")),
-                                        footprint_type);
-                        }
-                        result = EXIT_FAILURE;
-                        break;
-                }
+                create_new_line
+                (
+                        element,
+                        -30750,
+                        -12600,
+                        -30750,
+                        5900,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -30750,
+                        5900,
+                        20750,
+                        5900,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20750,
+                        5900,
+                        20750,
+                        -12600,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        20750,
+                        -12600,
+                        -30750,
+                        -12600,
+                        units_to_coord (silkscreen_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        -18750,
+                        -10000,
+                        18750,
+                        -10000,
+                        5200
+                );
+                create_new_line
+                (
+                        element,
+                        -30750,
+                        -7600,
+                        20750,
+                        -7600,
+                        units_to_coord (silkscreen_line_width)
+                );
         }
-        /* No failures on DRC found. */
-        if (verbose && (result == EXIT_SUCCESS))
+        /* Create a pin #1 marker */
+        if (silkscreen_indicate_1)
         {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        (_("[%s] DRC Check: no errors while checking package %s.")),
-                        footprint_type, footprint_name);
+                /*! \todo Write a pin #1 marker on the silkscreen ! */
         }
-        return (result);
-}
-
-
-/*!
- * \brief Look up default values for TO footprint.
- *
- * Footprint values can be looked up by placing a question mark "?" in front
- * of the footprint name.\n
- * If the footprint name is recognised known values will be loaded and the
- * entries involved in the GUI will be updated accordingly.\n
- * Currently the following footprints are supported:\n
- * - .
- *
- * \return \c EXIT_SUCCESS when default values for a footprint were
- * found, \c EXIT_FAILURE when the footprint name was not found.
- */
-int
-to_get_default_footprint_values ()
-{
-        if (!strcmp (footprint_name, "?TO92"))
+        /* Create a courtyard */
+        if (courtyard)
         {
-                number_of_pins = 3;
-                package_body_length = 0.0;
-                package_body_width = 0.0;
-                package_body_height = 0.0;
-                package_is_radial = TRUE;
-                number_of_columns = 0;
-                number_of_rows = 0;
-                pitch_x = 0.0;
-                pitch_y = 0.0;
-                pad_diameter = 1.00; /* approx. 40 mil */
-                pin_drill_diameter = 0.72; /* approx. 28 mil */
-                pad_length = 0.0;
-                pad_width = 0.0;
-                pad_shape = g_strdup ("rounded pad");
-                pad_shapes_type = ROUND;
-                thermal = FALSE;
-                thermal_length = 0.0;
-                thermal_width = 0.0;
-                silkscreen_package_outline = FALSE;
-                silkscreen_length = 0.0;
-                silkscreen_width = 0.0;
-                courtyard_length = 0.0;
-                courtyard_width = 0.0;
-                count_x = 0;
-                count_y = 0;
-                footprint_units = g_strdup ("mm");
-                g_free (footprint_name);
-                footprint_name = g_strdup ("TO92");
-                return (EXIT_SUCCESS);
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y1, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
+                create_new_line
+                (
+                        element,
+                        element->VBox.X2, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        element->VBox.X1, /* already in mil/100 */
+                        element->VBox.Y2, /* already in mil/100 */
+                        units_to_coord (courtyard_line_width)
+                );
         }
-        else
+        /* Create attributes. */
+        if (attributes_in_footprint)
         {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("default values for footprint %s not found.\n"),
-                        footprint_name);
-                return (EXIT_FAILURE);
+                element = create_attributes_in_element (element);
         }
-}
-
-
-/*!
- * \brief Set GUI constraints for the TO package type.
- *
- * This function is only to be compiled for GUI targets.
- *
- * \return \c EXIT_SUCCESS when the function is completed.
- */
-#if GUI
-int
-to_set_gui_constraints ()
-{
-        /* Widgets on tab "Footprint" */
-        GtkWidget *package_is_radial_checkbutton = lookup_widget (GTK_WIDGET (widget),
-                "package_is_radial_checkbutton");
-        gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (package_is_radial_checkbutton), FALSE);
-        gtk_widget_set_sensitive (package_is_radial_checkbutton, FALSE);
-
-        /* Widgets on tab "Pins/Pads" */
-        GtkWidget *number_of_columns_entry = lookup_widget (GTK_WIDGET (widget),
-                "number_of_columns_entry");
-        gtk_entry_set_text (GTK_ENTRY (number_of_columns_entry), "3");
-        gtk_widget_set_sensitive (number_of_columns_entry, FALSE);
-        GtkWidget *number_of_rows_entry = lookup_widget (GTK_WIDGET (widget),
-                "number_of_rows_entry");
-        gtk_entry_set_text (GTK_ENTRY (number_of_rows_entry), "1");
-        gtk_widget_set_sensitive (number_of_rows_entry, FALSE);
-        GtkWidget *count_x_entry = lookup_widget (GTK_WIDGET (widget),
-                "count_x_entry");
-        gtk_entry_set_text (GTK_ENTRY (count_x_entry), "");
-        gtk_widget_set_sensitive (count_x_entry, FALSE);
-        GtkWidget *count_y_entry = lookup_widget (GTK_WIDGET (widget),
-                "count_y_entry");
-        gtk_entry_set_text (GTK_ENTRY (count_y_entry), "");
-        gtk_widget_set_sensitive (count_y_entry, FALSE);
-        GtkWidget *number_1_position_entry = lookup_widget (GTK_WIDGET (widget),
-                "number_1_position_entry");
-        gtk_combo_box_set_active (GTK_COMBO_BOX (number_1_position_entry), UPPER_LEFT);
-        gtk_widget_set_sensitive (number_1_position_entry, FALSE);
-
-        /* Widgets on tab "Thermal Pad" */
-        gui_constraints_disable_thermal_tab_widgets (widget);
-
-        /* Widgets on tab "Heel & Toe goals" */
-        gui_constraints_disable_heel_and_toe_goals_tab_widgets (widget);
+        /* We are ready creating an element. */
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("created an element for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
+        }
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
-#endif /* GUI */
+
 
 
 /*!
- * \brief Write a footprint for a TO220 transistor package.
+ * \brief Create an Element for a TO92 package.
  *
- * \return \c EXIT_FAILURE when errors were encountered,
- * \c EXIT_SUCCESS when OK.
+ * \return \c EXIT_SUCCESS when an element was created,
+ * \c EXIT_FAILURE when errors were encountered.
  */
 int
-to_write_footprint_to220 ()
+to_create_element_to92 ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
+        FlagType pad_flag;
+        FlagType pin1_flag;
+        ElementTypePtr element;
 
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
+        element = create_new_element ();
+        if (!element)
         {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open file for %s footprint: %s."),
-                        footprint_type, footprint_filename);
-                fclose (fp);
+                if (verbose)
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create a valid element pointer for a %s package."),
+                                footprint_type);
                 return (EXIT_FAILURE);
         }
-        /* Print a license if requested. */
-        if (license_in_footprint)
+        /* Define the center of our universe and guess for a place where to
+         * put the element mark */
+        element->MarkX = 0;
+        element->MarkY = 0;
+        /* Create pin and/or pad entities */
+        if (pad_shapes_type == SQUARE)
         {
-                write_license ();
+                pad_flag.f = SQUARE;
         }
-        /* Determine (extreme) courtyard dimensions based on pin/pad/
-         * package body properties */
-        xmin = -20000 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        xmax = 20000 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymin = -79000 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymax = 10000 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (!strcmp (pad_shape, "rectangular pad"))
-                pin_pad_flags = g_strdup ("square");
         else
-                pin_pad_flags = g_strdup ("");
-        write_pin
+        {
+                pad_flag.f = CLEAR;
+        }
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
+        create_new_pin
         (
-                1, /* pin number */
+                element,
+                -5000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                -10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                /* Write pin #1 with a square pad */
-                (pin1_square) ? "square" : "" /* flags */
+                "1", /* pin number */
+                pin1_flag /* flags */
         );
-        write_pin
+        create_new_pin
         (
-                2, /* pin number */
+                element,
+                0, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                0.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
+                "2", /* pin number */
+                pad_flag /* flags */
         );
-        write_pin
+        create_new_pin
         (
-                3, /* pin number */
+                element,
+                5000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        /* Attachment drill hole (PTH). */
-        write_pin
-        (
-                0, /* pin number */
-                "", /* pin name */
-                10000.0, /* x0 coordinate */
-                -67000.0, /* y0-coordinate */
-                15000.0, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                15000.0 + (multiplier * pad_solder_mask_clearance), /* solder mask clearance */
-                13000.0, /* pin drill diameter */
-                "hole" /* flags */
+                "3", /* pin number */
+                pad_flag /* flags */
         );
-        /* Add a thermal pad if the user requests for it. */
-        if (thermal)
-        {
-                write_pad
-                (
-                        0, /* pin number */
-                        "", /* pin name */
-                        0, /* x0 coordinate */
-                        -67000 - (multiplier * (thermal_width + (thermal_length / 2))), /* y0-coordinate */
-                        0, /* x1 coordinate */
-                        -67000 + (multiplier * (thermal_width + (thermal_length / 2))), /* y1-coordinate */
-                        multiplier * thermal_length, /* pad width */
-                        multiplier * pad_clearance, /* clearance with other copper */
-                        multiplier * (thermal_length + (2 * thermal_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-        }
-        /* Write package body on the silkscreen */
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create package body */
         if (silkscreen_package_outline)
         {
-	        /* Leads. */
-                fprintf (fp, "# Write leads on the silkscreen\n");
-                write_element_line
-                (
-                        -10000,
-                        (int) (multiplier * (-pad_diameter)),
-                        -10000,
-                        -18000,
-                        (int) multiplier * (2 * silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        0,
-                        (int) (multiplier * (-pad_diameter)),
-                        0,
-                        -18000,
-                        (int) multiplier * (2 * silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        10000,
-                        (int) (multiplier * (-pad_diameter)),
-                        10000,
-                        -18000,
-                        (int) multiplier * (2 * silkscreen_line_width)
-                );
-	        /* Body. */
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_element_line
-                (
-                        -20000,
-                        -18000,
-                        -20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -18000,
-                        20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -55500,
-                        20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -18000,
-                        20000,
-                        -18000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-	        /* Cooling tab with notches. */
-                fprintf (fp, "# Write a Cooling tab with notches on the silkscreen\n");
-                write_element_line
-                (
-                        -20000,
-                        -55500,
-                        20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -55500,
-                        20000,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -68000,
-                        18500,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        18500,
-                        -68000,
-                        18500,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        18500,
-                        -75000,
-                        20000,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -75000,
-                        20000,
-                        -79000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -79000,
-                        -20000,
-                        -79000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -79000,
-                        -20000,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -75000,
-                        -18500,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -18500,
-                        -75000,
-                        -18500,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
+                create_new_line
                 (
-                        -18500,
-                        -68000,
-                        -20000,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
+                        element,
+                        -8600, /* x0-coordinate */
+                        -6000, /* y0-coordinate */
+                        8600, /* x1-coordinate */
+                        -6000, /* y1-coordinate */
+                        units_to_coord (silkscreen_line_width)
                 );
-                write_element_line
+                create_new_arc
                 (
-                        -20000,
-                        -68000,
-                        -20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
+                        element,
+                        0, /* x-coordinate */
+                        0, /* y-coordinate */
+                        10500, /* width */
+                        10500, /*height */
+                        -35, /* start angke */
+                        250, /* delta angle */
+                        units_to_coord (silkscreen_line_width) /* line width */
                 );
         }
-        /* Write a pin #1 marker on the silkscreen */
+        /* Create a pin #1 marker */
         if (silkscreen_indicate_1)
         {
                 /*! \todo Write a pin #1 marker on the silkscreen ! */
         }
-        /* Write a courtyard on the silkscreen */
+        /* Create a courtyard */
         if (courtyard)
         {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
+                if (package_is_radial)
+                {
+                        create_new_arc
+                        (
+                                element,
+                                0,
+                                0,
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                0,
+                                360,
+                                units_to_coord (courtyard_line_width)
+                        );
+                }
+                else
+                {
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                }
         }
-        /* Write attributes to the footprint file. */
+        /* Create attributes. */
         if (attributes_in_footprint)
         {
-                write_attributes ();
+                element = create_attributes_in_element (element);
         }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
+        /* We are ready creating an element. */
         if (verbose)
         {
                 g_log ("", G_LOG_LEVEL_INFO,
-                        _("wrote a footprint for a %s package: %s."),
+                        _("created an element for a %s package: %s."),
                         footprint_type,
                         footprint_filename);
         }
+        free_element (current_element);
+        current_element = element;
         return (EXIT_SUCCESS);
 }
 
 
+
 /*!
- * \brief Write a footprint for a TO220S transistor package (with
- * staggered pins).
+ * \brief Create an Element for a TO92S package.
  *
- * \return \c EXIT_FAILURE when errors were encountered,
- * \c EXIT_SUCCESS when OK.
+ * \return \c EXIT_SUCCESS when an element was created,
+ * \c EXIT_FAILURE when errors were encountered.
  */
 int
-to_write_footprint_to220_staggered ()
+to_create_element_to92_staggered ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
+        FlagType pad_flag;
+        FlagType pin1_flag;
+        ElementTypePtr element;
 
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
+        element = create_new_element ();
+        if (!element)
         {
-                g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open file for %s footprint: %s."),
-                        footprint_type, footprint_filename);
-                fclose (fp);
+                if (verbose)
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                _("could not create a valid element pointer for a %s package."),
+                                footprint_type);
                 return (EXIT_FAILURE);
         }
-        /* Print a license if requested. */
-        if (license_in_footprint)
+        /* Define the center of our universe and guess for a place where to
+         * put the element mark */
+        element->MarkX = 0;
+        element->MarkY = 0;
+        /* Create pin and/or pad entities */
+        if (pad_shapes_type == SQUARE)
         {
-                write_license ();
+                pad_flag.f = SQUARE;
         }
-        /* Determine (extreme) courtyard dimensions based on pin/pad/
-         * package body properties */
-        xmin = -20000 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        xmax = 20000 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymin = -79000 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymax = 10000 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (!strcmp (pad_shape, "rectangular pad"))
-                pin_pad_flags = g_strdup ("square");
         else
-                pin_pad_flags = g_strdup ("");
-        write_pin
-        (
-                1, /* pin number */
-                "", /* pin name */
-                -10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                /* Write pin #1 with a square pad */
-                (pin1_square) ? "square" : "" /* flags */
-        );
-        write_pin
+        {
+                pad_flag.f = CLEAR;
+        }
+        /* Create pin #1 with a square pad if checked. */
+        pin1_flag.f = (pin1_square) ? SQUARE : pad_flag.f;
+        create_new_pin
         (
-                2, /* pin number */
+                element,
+                -5000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                0.0, /* x0 coordinate */
-                10000.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
+                "1", /* pin number */
+                pin1_flag /* flags */
         );
-        write_pin
+        create_new_pin
         (
-                3, /* pin number */
+                element,
+                0, /* x0 coordinate */
+                -5000, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
+                "2", /* pin number */
+                pad_flag /* flags */
         );
-        /* Attachment drill hole (PTH). */
-        write_pin
+        create_new_pin
         (
-                0, /* pin number */
+                element,
+                5000, /* x0 coordinate */
+                0, /* y0-coordinate */
+                units_to_coord (pad_diameter), /* width of the annulus ring (pad) */
+                units_to_coord (pad_clearance), /* clearance */
+                units_to_coord (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
+                units_to_coord (pin_drill_diameter), /* pin drill diameter */
                 "", /* pin name */
-                10000.0, /* x0 coordinate */
-                -67000.0, /* y0-coordinate */
-                15000.0, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                15000.0 + (multiplier * pad_solder_mask_clearance), /* solder mask clearance */
-                13000.0, /* pin drill diameter */
-                "hole" /* flags */
+                "3", /* pin number */
+                pad_flag /* flags */
         );
-        /* Add a thermal pad if the user requests for it. */
-        if (thermal)
-        {
-                write_pad
-                (
-                        0, /* pin number */
-                        "", /* pin name */
-                        0, /* x0 coordinate */
-                        -67000 - (multiplier * (thermal_width + (thermal_length / 2))), /* y0-coordinate */
-                        0, /* x1 coordinate */
-                        -67000 + (multiplier * (thermal_width + (thermal_length / 2))), /* y1-coordinate */
-                        multiplier * thermal_length, /* pad width */
-                        multiplier * pad_clearance, /* clearance with other copper */
-                        multiplier * (thermal_length + (2 * thermal_solder_mask_clearance)), /* solder mask clearance */
-                        pin_pad_flags /* flags */
-                );
-        }
-        /* Write package body on the silkscreen */
+        /* Determine (extreme) courtyard dimensions based on the created
+         * pins/pads and the package properties. */
+        update_element_courtyard (element);
+        /* Guess for a place where to put the element name */
+        element->Name[DESCRIPTION_INDEX].Scale = 100; /* 100 percent */
+        element->Name[DESCRIPTION_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[DESCRIPTION_INDEX].TextString = footprint_name;
+        element->Name[DESCRIPTION_INDEX].Element = element;
+        element->Name[DESCRIPTION_INDEX].Direction = EAST;
+        element->Name[DESCRIPTION_INDEX].ID = ID++;
+        /* Guess for a place where to put the element refdes */
+        element->Name[NAMEONPCB_INDEX].Scale = 100; /* 100 percent */
+        element->Name[NAMEONPCB_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[NAMEONPCB_INDEX].TextString = footprint_refdes;
+        element->Name[NAMEONPCB_INDEX].Element = element;
+        element->Name[NAMEONPCB_INDEX].Direction = EAST;
+        element->Name[NAMEONPCB_INDEX].ID = ID++;
+        /* Guess for a place where to put the element value */
+        element->Name[VALUE_INDEX].Scale = 100; /* 100 percent */
+        element->Name[VALUE_INDEX].X = 0.0 ; /* already in mil/100 */
+        element->Name[VALUE_INDEX].Y = (element->VBox.Y1 - 10000.0); /* already in mil/100 */
+        element->Name[VALUE_INDEX].TextString = footprint_value;
+        element->Name[VALUE_INDEX].Element = element;
+        element->Name[VALUE_INDEX].Direction = EAST;
+        element->Name[VALUE_INDEX].ID = ID++;
+        /* Create package body */
         if (silkscreen_package_outline)
         {
-	        /* Leads. */
-                fprintf (fp, "# Write leads on the silkscreen\n");
-                write_element_line
+                create_new_line
                 (
-                        -10000,
-                        (int) (multiplier * (-pad_diameter)),
-                        -10000,
-                        -18000,
-                        (int) multiplier * (2 * silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        0,
-                        (int) (multiplier * (-pad_diameter)),
-                        0,
-                        -8000,
-                        (int) multiplier * (2 * silkscreen_line_width)
+                        element,
+                        -8600, /* x0-coordinate */
+                        -6000, /* y0-coordinate */
+                        8600, /* x1-coordinate */
+                        -6000, /* y1-coordinate */
+                        units_to_coord (silkscreen_line_width)
                 );
-                write_element_line
+                create_new_arc
                 (
-                        10000,
-                        (int) (multiplier * (-pad_diameter)),
-                        10000,
-                        -18000,
-                        (int) multiplier * (2 * silkscreen_line_width)
-                );
-	        /* Body. */
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_element_line
-                (
-                        -20000,
-                        -18000,
-                        -20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -18000,
-                        20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -55500,
-                        20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -18000,
-                        20000,
-                        -18000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-	        /* Cooling tab with notches. */
-                fprintf (fp, "# Write a Cooling tab with notches on the silkscreen\n");
-                write_element_line
-                (
-                        -20000,
-                        -55500,
-                        20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -55500,
-                        20000,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -68000,
-                        18500,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        18500,
-                        -68000,
-                        18500,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        18500,
-                        -75000,
-                        20000,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -75000,
-                        20000,
-                        -79000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20000,
-                        -79000,
-                        -20000,
-                        -79000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -79000,
-                        -20000,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -75000,
-                        -18500,
-                        -75000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -18500,
-                        -75000,
-                        -18500,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -18500,
-                        -68000,
-                        -20000,
-                        -68000,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20000,
-                        -68000,
-                        -20000,
-                        -55500,
-                        (int) multiplier * (silkscreen_line_width)
+                        element,
+                        0, /* x-coordinate */
+                        0, /* y-coordinate */
+                        10500, /* width */
+                        10500, /*height */
+                        -35, /* start angke */
+                        250, /* delta angle */
+                        units_to_coord (silkscreen_line_width) /* line width */
                 );
         }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
+        /* Create a pin #1 marker */
+        if (silkscreen_indicate_1)
+        {
+                /*! \todo Write a pin #1 marker on the silkscreen ! */
+        }
+        /* Create a courtyard */
+        if (courtyard)
+        {
+                if (package_is_radial)
+                {
+                        create_new_arc
+                        (
+                                element,
+                                0,
+                                0,
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                0,
+                                360,
+                                units_to_coord (courtyard_line_width)
+                        );
+                }
+                else
+                {
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y1, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                        create_new_line
+                        (
+                                element,
+                                element->VBox.X2, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                element->VBox.X1, /* already in mil/100 */
+                                element->VBox.Y2, /* already in mil/100 */
+                                units_to_coord (courtyard_line_width)
+                        );
+                }
+        }
+        /* Create attributes. */
+        if (attributes_in_footprint)
+        {
+                element = create_attributes_in_element (element);
+        }
+        /* We are ready creating an element. */
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("created an element for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
+        }
+        free_element (current_element);
+        current_element = element;
+        return (EXIT_SUCCESS);
+}
+
+
+
+/*!
+ * \brief Create a list of TO packages with pre-defined values.
+ *
+ * The data in this list can be used in a combobox to select a
+ * pre-defined package.
+ *
+ * \return \c EXIT_SUCCESS when an element was created,
+ * \c EXIT_FAILURE when errors were encountered.
+ */
+int
+to_create_packages_list ()
+{
+        g_list_free (packages_list);
+        packages_list = g_list_append (packages_list, "TO92");
+        packages_list = g_list_append (packages_list, "TO92S");
+        packages_list = g_list_append (packages_list, "TO220");
+        packages_list = g_list_append (packages_list, "TO220S");
+        packages_list = g_list_append (packages_list, "TO220SW");
+        packages_list = g_list_append (packages_list, "TO220W");
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Do some Design Rule Checking for the TO package type.
+ *
+ * <ul>
+ * <li> check for allowed pad shapes.
+ * <li> check for zero sized packages.
+ * <li> check for a zero sized courtyard.
+ * <li> check for minimum clearance between copper (X-direction).
+ * <li> check for minimum clearance between copper (Y-direction).
+ * <li> check if no fiducials exist.
+ * <li> check for clearance of the package length with regard to the
+ * courtyard dimensions.
+ * <li> check for clearance of the package width with regard to the
+ * courtyard dimensions.
+ * <li> check for any silk lines or texts touching bare copper.
+ * <li> check for soldermask clearance (solder mask overlapping copper
+ * at the solder fillet area or worse).
+ * <li> check for a reasonable silk line width.
+ * </ul>
+ *
+ * \return \c EXIT_SUCCESS when no DRC violations were encountered,
+ * \c EXIT_FAILURE when DRC violations were found.
+ */
+int
+to_drc ()
+{
+        int result = EXIT_SUCCESS;
+        if (verbose)
+        {
+                g_log ("", G_LOG_LEVEL_INFO,
+                        (_("[%s] DRC Check: checking package %s.")),
+                        footprint_type, footprint_name);
+        }
+        /* Check for allowed pad shapes. */
+        switch (pad_shapes_type)
+        {
+                case NO_SHAPE:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: NO_SHAPE specified for check for allowed pad shapes.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
+                case ROUND:
+                {
+                        break;
+                }
+                case SQUARE:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: square pad shape specified for check for allowed pad shapes.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
+                case OCTAGONAL:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: octagonal pad shape specified for check for allowed pad shapes.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
+                case ROUND_ELONGATED:
+                {
+                        break;
+                }
+                default:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: no valid pad shape type specified.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
+        }
+        /* Check for pitch (X-direction) > 0.0. */
+        if (pitch_x <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: pitch (X-direction) should be greater than 0.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for zero sized packages. */
+        if (package_body_length <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: specified package body length is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        if (package_body_width <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: specified package body width is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        if (package_body_height <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: specified package body height is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for a zero sized courtyard. */
+        if (courtyard_length <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: specified courtyard length is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        if (courtyard_width <= 0.0)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: specified courtyard width is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for minimum clearance between copper (Y-direction). */
+        if ((pitch_y - pad_diameter < pad_clearance) || (pitch_y - pad_width < pad_clearance))
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: minimum clearance between copper (Y-direction) is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Checking for fiducials. */
+        if (fiducial)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: package should not have any fiducials.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for clearance of the package length with regard to the
+         * courtyard dimensions. */
+        if (courtyard_length - package_body_length < 2.0 * courtyard_clearance_with_package)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: clearance of the package length with regard to the courtyard dimensions is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /* Check for clearance of the package width with regard to the
+         * courtyard dimensions. */
+        if (courtyard_width - package_body_width < 2.0 * courtyard_clearance_with_package)
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: clearance of the package width with regard to the courtyard dimensions is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        /*! \todo Check for any silk lines or texts touching bare copper. */
+
+        /*! \todo Check for soldermask clearance (solder mask overlapping copper at
+         * the solder fillet area or worse). */
+
+        /* Check for a reasonable silk line width. */
+        if (silkscreen_package_outline && (silkscreen_line_width == 0.0))
+        {
+                if (verbose)
+                {
+                        g_log ("", G_LOG_LEVEL_WARNING,
+                                (_("[%s] DRC Error: silkscreen line width is too small.")),
+                                footprint_type);
+                }
+                result = EXIT_FAILURE;
+        }
+        switch (units_type)
         {
-                /*! \todo Write a pin #1 marker on the silkscreen ! */
+                case NO_UNITS:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: no units specified.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
+                case MIL:
+                if (silkscreen_package_outline && (silkscreen_line_width > 40.0))
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: silkscreen line width too wide.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                }
+                break;
+                case MIL_100:
+                if (silkscreen_package_outline && (silkscreen_line_width > 4000.0))
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: silkscreen line width too wide.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                }
+                break;
+                case MM:
+                if (silkscreen_package_outline && (silkscreen_line_width > 1.0))
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: silkscreen line width too wide.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                }
+                break;
+                default:
+                {
+                        if (verbose)
+                        {
+                                g_log ("", G_LOG_LEVEL_WARNING,
+                                        (_("[%s] DRC Error: no valid units type specified.")),
+                                        footprint_type);
+                        }
+                        result = EXIT_FAILURE;
+                        break;
+                }
         }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
+        /* No failures on DRC found. */
+        if (verbose && (result == EXIT_SUCCESS))
         {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
+                g_log ("", G_LOG_LEVEL_INFO,
+                        (_("[%s] DRC Check: no errors while checking package %s.")),
+                        footprint_type, footprint_name);
         }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
+        return (result);
+}
+
+
+/*!
+ * \brief Look up default values for TO footprint.
+ *
+ * Footprint values can be looked up by placing a question mark "?" in front
+ * of the footprint name.\n
+ * If the footprint name is recognised known values will be loaded and the
+ * entries involved in the GUI will be updated accordingly.\n
+ * Currently the following footprints are supported:\n
+ * - .
+ *
+ * \return \c EXIT_SUCCESS when default values for a footprint were
+ * found, \c EXIT_FAILURE when the footprint name was not found.
+ */
+int
+to_get_default_footprint_values ()
+{
+        if (!strcmp (footprint_name, "?TO92"))
         {
-                write_attributes ();
+                number_of_pins = 3;
+                package_body_length = 0.0;
+                package_body_width = 0.0;
+                package_body_height = 0.0;
+                package_is_radial = TRUE;
+                number_of_columns = 0;
+                number_of_rows = 0;
+                pitch_x = 0.0;
+                pitch_y = 0.0;
+                pad_diameter = 1.00; /* approx. 40 mil */
+                pin_drill_diameter = 0.72; /* approx. 28 mil */
+                pad_length = 0.0;
+                pad_width = 0.0;
+                pad_shape = g_strdup ("rounded pad");
+                pad_shapes_type = ROUND;
+                thermal = FALSE;
+                thermal_length = 0.0;
+                thermal_width = 0.0;
+                silkscreen_package_outline = FALSE;
+                silkscreen_length = 0.0;
+                silkscreen_width = 0.0;
+                courtyard_length = 0.0;
+                courtyard_width = 0.0;
+                count_x = 0;
+                count_y = 0;
+                footprint_units = g_strdup ("mm");
+                g_free (footprint_name);
+                footprint_name = g_strdup ("TO92");
+                return (EXIT_SUCCESS);
         }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
-        if (verbose)
+        else
         {
-                g_log ("", G_LOG_LEVEL_INFO,
-                        _("wrote a footprint for a %s package: %s."),
-                        footprint_type,
-                        footprint_filename);
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("default values for footprint %s not found.\n"),
+                        footprint_name);
+                return (EXIT_FAILURE);
         }
+}
+
+
+/*!
+ * \brief Set GUI constraints for the TO package type.
+ *
+ * This function is only to be compiled for GUI targets.
+ *
+ * \return \c EXIT_SUCCESS when the function is completed.
+ */
+#if GUI
+int
+to_set_gui_constraints ()
+{
+        /* Widgets on tab "Footprint" */
+        GtkWidget *package_is_radial_checkbutton = lookup_widget (GTK_WIDGET (widget),
+                "package_is_radial_checkbutton");
+        gtk_toggle_button_set_active (GTK_TOGGLE_BUTTON (package_is_radial_checkbutton), FALSE);
+        gtk_widget_set_sensitive (package_is_radial_checkbutton, FALSE);
+
+        /* Widgets on tab "Pins/Pads" */
+        GtkWidget *number_of_columns_entry = lookup_widget (GTK_WIDGET (widget),
+                "number_of_columns_entry");
+        gtk_entry_set_text (GTK_ENTRY (number_of_columns_entry), "3");
+        gtk_widget_set_sensitive (number_of_columns_entry, FALSE);
+        GtkWidget *number_of_rows_entry = lookup_widget (GTK_WIDGET (widget),
+                "number_of_rows_entry");
+        gtk_entry_set_text (GTK_ENTRY (number_of_rows_entry), "1");
+        gtk_widget_set_sensitive (number_of_rows_entry, FALSE);
+        GtkWidget *count_x_entry = lookup_widget (GTK_WIDGET (widget),
+                "count_x_entry");
+        gtk_entry_set_text (GTK_ENTRY (count_x_entry), "");
+        gtk_widget_set_sensitive (count_x_entry, FALSE);
+        GtkWidget *count_y_entry = lookup_widget (GTK_WIDGET (widget),
+                "count_y_entry");
+        gtk_entry_set_text (GTK_ENTRY (count_y_entry), "");
+        gtk_widget_set_sensitive (count_y_entry, FALSE);
+        GtkWidget *number_1_position_entry = lookup_widget (GTK_WIDGET (widget),
+                "number_1_position_entry");
+        gtk_combo_box_set_active (GTK_COMBO_BOX (number_1_position_entry), UPPER_LEFT);
+        gtk_widget_set_sensitive (number_1_position_entry, FALSE);
+
+        /* Widgets on tab "Thermal Pad" */
+        gui_constraints_disable_thermal_tab_widgets (widget);
+
+        /* Widgets on tab "Heel & Toe goals" */
+        gui_constraints_disable_heel_and_toe_goals_tab_widgets (widget);
         return (EXIT_SUCCESS);
 }
+#endif /* GUI */
 
 
 /*!
- * \brief Write a footprint for a TO220W transistor package (standing).
+ * \brief Write a footprint for a TO220 transistor package.
  *
  * \return \c EXIT_FAILURE when errors were encountered,
  * \c EXIT_SUCCESS when OK.
  */
 int
-to_write_footprint_to220_standing ()
+to_write_footprint_to220 ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
-
-        /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
-        if (!fp)
+        /* Create the element from the current footprint values. */
+        if (to_create_element_to220 () == EXIT_FAILURE)
         {
                 g_log ("", G_LOG_LEVEL_WARNING,
-                        _("could not open file for %s footprint: %s."),
+                        _("could not create an element for %s footprint: %s."),
                         footprint_type, footprint_filename);
-                fclose (fp);
                 return (EXIT_FAILURE);
         }
-        /* Print a license if requested. */
-        if (license_in_footprint)
-        {
-                write_license ();
-        }
-        /* Determine (extreme) courtyard dimensions based on pin/pad/
-         * package body properties */
-        xmin = -20750 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        xmax = 20750 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymin = -12600 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymax = 5900 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (!strcmp (pad_shape, "rectangular pad"))
-                pin_pad_flags = g_strdup ("square");
-        else
-                pin_pad_flags = g_strdup ("");
-        write_pin
-        (
-                1, /* pin number */
-                "", /* pin name */
-                -10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                /* Write pin #1 with a square pad */
-                (pin1_square) ? "square" : "" /* flags */
-        );
-        write_pin
-        (
-                2, /* pin number */
-                "", /* pin name */
-                0.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        write_pin
-        (
-                3, /* pin number */
-                "", /* pin name */
-                10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        /* Write package body on the silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_element_line
-                (
-                        -20750,
-                        -12600,
-                        -20750,
-                        5900,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -20750,
-                        5900,
-                        20750,
-                        5900,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20750,
-                        5900,
-                        20750,
-                        -12600,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20750,
-                        -12600,
-                        -20750,
-                        -12600,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -18750,
-                        -10000,
-                        18750,
-                        -10000,
-                        5200
-                );
-                write_element_line
-                (
-                        -20750,
-                        -7600,
-                        20750,
-                        -7600,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                /*! \todo Write a pin #1 marker on the silkscreen ! */
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
+        /* Attempt to open a file with write permission. */
+        fp = open_footprint_file ();
+        if (!fp)
         {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not open file for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                close_footprint_file ();
+                return (EXIT_FAILURE);
         }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
+        /* Print a license if requested. */
+        if (license_in_footprint)
         {
-                write_attributes ();
+                write_license ();
         }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
+        /* Serialize the element. */
+        write_element (current_element);
+        close_footprint_file ();
         if (verbose)
         {
                 g_log ("", G_LOG_LEVEL_INFO,
@@ -1727,31 +2118,31 @@ to_write_footprint_to220_standing ()
 
 
 /*!
- * \brief Write a footprint for a TO220SW transistor package (standing
- * with staggered pins).
+ * \brief Write a footprint for a TO220S transistor package (with
+ * staggered pins).
  *
  * \return \c EXIT_FAILURE when errors were encountered,
  * \c EXIT_SUCCESS when OK.
  */
 int
-to_write_footprint_to220_standing_staggered ()
+to_write_footprint_to220_staggered ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
-
+        /* Create the element from the current footprint values. */
+        if (to_create_element_to220_staggered () == EXIT_FAILURE)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not create an element for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
         /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
+        fp = open_footprint_file ();
         if (!fp)
         {
                 g_log ("", G_LOG_LEVEL_WARNING,
                         _("could not open file for %s footprint: %s."),
                         footprint_type, footprint_filename);
-                fclose (fp);
+                close_footprint_file ();
                 return (EXIT_FAILURE);
         }
         /* Print a license if requested. */
@@ -1759,159 +2150,55 @@ to_write_footprint_to220_standing_staggered ()
         {
                 write_license ();
         }
-        /* Determine (extreme) courtyard dimensions based on pin/pad/
-         * package body properties */
-        xmin = -30750 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        xmax = 20750 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymin = -12600 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymax = 5900 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (!strcmp (pad_shape, "rectangular pad"))
-                pin_pad_flags = g_strdup ("square");
-        else
-                pin_pad_flags = g_strdup ("");
-        write_pin
-        (
-                1, /* pin number */
-                "", /* pin name */
-                -10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                /* Write pin #1 with a square pad */
-                (pin1_square) ? "square" : "" /* flags */
-        );
-        write_pin
-        (
-                2, /* pin number */
-                "", /* pin name */
-                0.0, /* x0 coordinate */
-                -10000.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        write_pin
-        (
-                3, /* pin number */
-                "", /* pin name */
-                10000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        /* Write package body on the silkscreen */
-        if (silkscreen_package_outline)
+        /* Serialize the element. */
+        write_element (current_element);
+        close_footprint_file ();
+        if (verbose)
         {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_element_line
-                (
-                        -30750,
-                        -12600,
-                        -30750,
-                        5900,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -30750,
-                        5900,
-                        20750,
-                        5900,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20750,
-                        5900,
-                        20750,
-                        -12600,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        20750,
-                        -12600,
-                        -30750,
-                        -12600,
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_line
-                (
-                        -18750,
-                        -10000,
-                        18750,
-                        -10000,
-                        5200
-                );
-                write_element_line
-                (
-                        -30750,
-                        -7600,
-                        20750,
-                        -7600,
-                        (int) multiplier * (silkscreen_line_width)
-                );
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("wrote a footprint for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
         }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a footprint for a TO220W transistor package (standing).
+ *
+ * \return \c EXIT_FAILURE when errors were encountered,
+ * \c EXIT_SUCCESS when OK.
+ */
+int
+to_write_footprint_to220_standing ()
+{
+        /* Create the element from the current footprint values. */
+        if (to_create_element_to220_standing () == EXIT_FAILURE)
         {
-                /*! \todo Write a pin #1 marker on the silkscreen ! */
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not create an element for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
         }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
+        /* Attempt to open a file with write permission. */
+        fp = open_footprint_file ();
+        if (!fp)
         {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                write_rectangle
-                (
-                        xmin, /* already in mil/100 */
-                        ymin, /* already in mil/100 */
-                        xmax, /* already in mil/100 */
-                        ymax, /* already in mil/100 */
-                        multiplier * courtyard_line_width
-                );
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not open file for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                close_footprint_file ();
+                return (EXIT_FAILURE);
         }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
+        /* Print a license if requested. */
+        if (license_in_footprint)
         {
-                write_attributes ();
+                write_license ();
         }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
+        /* Serialize the element. */
+        write_element (current_element);
+        close_footprint_file ();
         if (verbose)
         {
                 g_log ("", G_LOG_LEVEL_INFO,
@@ -1924,30 +2211,31 @@ to_write_footprint_to220_standing_staggered ()
 
 
 /*!
- * \brief Write a footprint for a TO92 transistor package.
+ * \brief Write a footprint for a TO220SW transistor package (standing
+ * with staggered pins).
  *
  * \return \c EXIT_FAILURE when errors were encountered,
  * \c EXIT_SUCCESS when OK.
  */
 int
-to_write_footprint_to92 ()
+to_write_footprint_to220_standing_staggered ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
-
+        /* Create the element from the current footprint values. */
+        if (to_create_element_to220_standing_staggered () == EXIT_FAILURE)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not create an element for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
         /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
+        fp = open_footprint_file ();
         if (!fp)
         {
                 g_log ("", G_LOG_LEVEL_WARNING,
                         _("could not open file for %s footprint: %s."),
                         footprint_type, footprint_filename);
-                fclose (fp);
+                close_footprint_file ();
                 return (EXIT_FAILURE);
         }
         /* Print a license if requested. */
@@ -1955,145 +2243,55 @@ to_write_footprint_to92 ()
         {
                 write_license ();
         }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = -10500 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        xmax = 10500 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymin = -8600 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymax = 10500 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (!strcmp (pad_shape, "rectangular pad"))
-                pin_pad_flags = g_strdup ("square");
-        else
-                pin_pad_flags = g_strdup ("");
-        write_pin
-        (
-                1, /* pin number */
-                "", /* pin name */
-                -5000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                /* Write pin #1 with a square pad */
-                (pin1_square) ? "square" : "" /* flags */
-        );
-        write_pin
-        (
-                2, /* pin number */
-                "", /* pin name */
-                0.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        write_pin
-        (
-                3, /* pin number */
-                "", /* pin name */
-                5000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        /* Write package body on the silkscreen */
-        if (silkscreen_package_outline)
+        /* Serialize the element. */
+        write_element (current_element);
+        close_footprint_file ();
+        if (verbose)
         {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_element_line
-                (
-                        -8600, /* x0-coordinate */
-                        -6000, /* y0-coordinate */
-                        8600, /* x1-coordinate */
-                        -6000, /* y1-coordinate */
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_arc
-                (
-                        0, /* x-coordinate */
-                        0, /* y-coordinate */
-                        10500, /* width */
-                        10500, /*height */
-                        -35, /* start angke */
-                        250, /* delta angle */
-                        multiplier * silkscreen_line_width /* line width */
-                );
+                g_log ("", G_LOG_LEVEL_INFO,
+                        _("wrote a footprint for a %s package: %s."),
+                        footprint_type,
+                        footprint_filename);
         }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Write a footprint for a TO92 transistor package.
+ *
+ * \return \c EXIT_FAILURE when errors were encountered,
+ * \c EXIT_SUCCESS when OK.
+ */
+int
+to_write_footprint_to92 ()
+{
+        /* Create the element from the current footprint values. */
+        if (to_create_element_to92 () == EXIT_FAILURE)
         {
-                /*! \todo Write a pin #1 marker on the silkscreen ! */
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not create an element for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
         }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
+        /* Attempt to open a file with write permission. */
+        fp = open_footprint_file ();
+        if (!fp)
         {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                if (package_is_radial)
-                {
-                        write_element_arc
-                        (
-                                0.0,
-                                0.0,
-                                xmax, /* already in mil/100 */
-                                ymax, /* already in mil/100 */
-                                0,
-                                360,
-                                multiplier * courtyard_line_width
-                        );
-                }
-                else
-                {
-                        write_rectangle
-                        (
-                                xmin, /* already in mil/100 */
-                                ymin, /* already in mil/100 */
-                                xmax, /* already in mil/100 */
-                                ymax, /* already in mil/100 */
-                                multiplier * courtyard_line_width
-                        );
-                }
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not open file for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                close_footprint_file ();
+                return (EXIT_FAILURE);
         }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
+        /* Print a license if requested. */
+        if (license_in_footprint)
         {
-                write_attributes ();
+                write_license ();
         }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
+        /* Serialize the element. */
+        write_element (current_element);
+        close_footprint_file ();
         if (verbose)
         {
                 g_log ("", G_LOG_LEVEL_INFO,
@@ -2115,22 +2313,22 @@ to_write_footprint_to92 ()
 int
 to_write_footprint_to92_staggered ()
 {
-        gdouble xmax;
-        gdouble xmin;
-        gdouble ymax;
-        gdouble ymin;
-        gdouble x_text;
-        gdouble y_text;
-        gchar *pin_pad_flags = g_strdup ("");
-
+        /* Create the element from the current footprint values. */
+        if (to_create_element_to92_staggered () == EXIT_FAILURE)
+        {
+                g_log ("", G_LOG_LEVEL_WARNING,
+                        _("could not create an element for %s footprint: %s."),
+                        footprint_type, footprint_filename);
+                return (EXIT_FAILURE);
+        }
         /* Attempt to open a file with write permission. */
-        fp = fopen (footprint_filename, "w");
+        fp = open_footprint_file ();
         if (!fp)
         {
                 g_log ("", G_LOG_LEVEL_WARNING,
                         _("could not open file for %s footprint: %s."),
                         footprint_type, footprint_filename);
-                fclose (fp);
+                close_footprint_file ();
                 return (EXIT_FAILURE);
         }
         /* Print a license if requested. */
@@ -2138,145 +2336,9 @@ to_write_footprint_to92_staggered ()
         {
                 write_license ();
         }
-        /* Determine (extreme) courtyard dimensions based on pin/pad
-         * properties */
-        xmin = -10500 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        xmax = 10500 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymin = -8600 - (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        ymax = 10500 + (multiplier * courtyard_clearance_with_package); /* in mil/100 */
-        /* Determine (extreme) courtyard dimensions based on package
-         * properties */
-        if ((multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package)) < xmin)
-                xmin = (multiplier * ((-package_body_length / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package)) > xmax)
-                xmax = (multiplier * ((package_body_length / 2.0) + courtyard_clearance_with_package));
-        if ((multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package)) < ymin)
-                ymin = (multiplier * ((-package_body_width / 2.0) - courtyard_clearance_with_package));
-        if ((multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package)) > ymax)
-                ymax = (multiplier * ((package_body_width / 2.0) + courtyard_clearance_with_package));
-        /* If the user input is using even more real-estate then use it */
-        if (multiplier * (-courtyard_length / 2.0) < xmin)
-                xmin = multiplier * (-courtyard_length / 2.0);
-        if (multiplier * (courtyard_length / 2.0) > xmax)
-                xmax = multiplier * (courtyard_length / 2.0);
-        if (multiplier * (-courtyard_width / 2.0) < ymin)
-                ymin = multiplier * (-courtyard_width / 2.0);
-        if (multiplier * (courtyard_width / 2.0) > ymax)
-                ymax = multiplier * (courtyard_width / 2.0);
-        /* Write element header
-         * Guess for a place where to put the refdes text */
-        x_text = 0.0 ; /* already in mil/100 */
-        y_text = (ymin - 10000.0); /* already in mil/100 */
-        write_element_header (x_text, y_text);
-        /* Write pin and/or pad entities */
-        if (!strcmp (pad_shape, "rectangular pad"))
-                pin_pad_flags = g_strdup ("square");
-        else
-                pin_pad_flags = g_strdup ("");
-        write_pin
-        (
-                1, /* pin number */
-                "", /* pin name */
-                -5000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                /* Write pin #1 with a square pad */
-                (pin1_square) ? "square" : "" /* flags */
-        );
-        write_pin
-        (
-                2, /* pin number */
-                "", /* pin name */
-                0.0, /* x0 coordinate */
-                -5000.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        write_pin
-        (
-                3, /* pin number */
-                "", /* pin name */
-                5000.0, /* x0 coordinate */
-                0.0, /* y0-coordinate */
-                multiplier * pad_diameter, /* width of the annulus ring (pad) */
-                multiplier * pad_clearance, /* clearance */
-                multiplier * (pad_diameter + pad_solder_mask_clearance), /* solder mask clearance */
-                multiplier * pin_drill_diameter, /* pin drill diameter */
-                pin_pad_flags /* flags */
-        );
-        /* Write package body on the silkscreen */
-        if (silkscreen_package_outline)
-        {
-                fprintf (fp, "# Write a package body on the silkscreen\n");
-                write_element_line
-                (
-                        -8600, /* x0-coordinate */
-                        -6000, /* y0-coordinate */
-                        8600, /* x1-coordinate */
-                        -6000, /* y1-coordinate */
-                        (int) multiplier * (silkscreen_line_width)
-                );
-                write_element_arc
-                (
-                        0, /* x-coordinate */
-                        0, /* y-coordinate */
-                        10500, /* width */
-                        10500, /*height */
-                        -35, /* start angke */
-                        250, /* delta angle */
-                        multiplier * silkscreen_line_width /* line width */
-                );
-        }
-        /* Write a pin #1 marker on the silkscreen */
-        if (silkscreen_indicate_1)
-        {
-                /*! \todo Write a pin #1 marker on the silkscreen ! */
-        }
-        /* Write a courtyard on the silkscreen */
-        if (courtyard)
-        {
-                fprintf (fp, "# Write a courtyard on the silkscreen\n");
-                if (package_is_radial)
-                {
-                        write_element_arc
-                        (
-                                0.0,
-                                0.0,
-                                xmax, /* already in mil/100 */
-                                ymax, /* already in mil/100 */
-                                0,
-                                360,
-                                multiplier * courtyard_line_width
-                        );
-                }
-                else
-                {
-                        write_rectangle
-                        (
-                                xmin, /* already in mil/100 */
-                                ymin, /* already in mil/100 */
-                                xmax, /* already in mil/100 */
-                                ymax, /* already in mil/100 */
-                                multiplier * courtyard_line_width
-                        );
-                }
-        }
-        /* Write attributes to the footprint file. */
-        if (attributes_in_footprint)
-        {
-                write_attributes ();
-        }
-        /* Finishing touch. */
-        fprintf (fp, "\n");
-        fprintf (fp, ")\n");
-        fclose (fp);
-        /* We are ready creating a footprint. */
+        /* Serialize the element. */
+        write_element (current_element);
+        close_footprint_file ();
         if (verbose)
         {
                 g_log ("", G_LOG_LEVEL_INFO,
@@ -2302,6 +2364,30 @@ to_function_list[] =
                 NULL
         },
 #endif /* GUI */
+        {
+                "Create element",
+                to_create_element_to220,
+                "Create an element for a TO220 package",
+                NULL
+        },
+        {
+                "Create element",
+                to_create_element_to220_staggered,
+                "Create an element for a TO220S package",
+                NULL
+        },
+        {
+                "Create element",
+                to_create_element_to220_standing,
+                "Create an element for a TO220W package",
+                NULL
+        },
+        {
+                "Create element",
+                to_create_element_to220_standing_staggered,
+                "Create an element for a TO220SW package",
+                NULL
+        },
         {
                 "Create element",
                 to_create_element_to92,
@@ -27,9 +27,14 @@
 
 G_BEGIN_DECLS /* keep c++ happy */
 
+int to_create_element_to220 ();
+int to_create_element_to220_staggered ();
+int to_create_element_to220_standing ();
+int to_create_element_to220_standing_staggered ();
 int to_create_element_to92 ();
 int to_create_element_to92_staggered ();
 int to_create_packages_list ();
+int to_drc ();
 int to_get_default_footprint_values ();
 #if GUI
 int to_set_gui_constraints ();
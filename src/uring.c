@@ -0,0 +1,474 @@
+/*!
+ * \file src/uring.c
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Functions for writing batches of files through io_uring.
+ *
+ * A library build writes thousands of small footprint files, with an
+ * open, a write and a close system call for every file.\n
+ * With io_uring a batch of files is opened with one system call, and
+ * written and closed with a second one, every file with one write of
+ * its whole text.\n
+ * The rings are set up with the system calls directly, so there is no
+ * dependency on liburing.\n
+ * When the kernel has no io_uring, or it is not allowed, the files are
+ * written with pwrite () instead.\n
+ * \n
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#ifdef HAVE_LINUX_IO_URING_H
+#  include <linux/io_uring.h>
+#  include <sys/syscall.h>
+#endif
+
+#include "uring.h"
+
+
+#ifdef HAVE_LINUX_IO_URING_H
+/*!
+ * \brief Get the next free submission queue entry of a ring.
+ *
+ * The entry is cleared and queued, it is submitted by
+ * uring_submit ().
+ *
+ * \return the entry.
+ */
+static struct io_uring_sqe *
+uring_get_sqe
+(
+        uring_t *ring,
+                /*!< : the ring.*/
+        guint *tail
+                /*!< : the tail of the entries queued so far, is
+                 * advanced.*/
+)
+{
+        struct io_uring_sqe *sqe;
+        guint index;
+
+        index = *tail & *ring->sq_mask;
+        sqe = &((struct io_uring_sqe *) ring->sqes)[index];
+        memset (sqe, 0, sizeof (struct io_uring_sqe));
+        ring->sq_array[index] = index;
+        (*tail)++;
+        return (sqe);
+}
+
+
+/*!
+ * \brief Submit the queued entries of a ring and wait for all of them
+ * to complete.
+ *
+ * \c complete is called for every completion with the \c user_data and
+ * the result of the entry.
+ *
+ * \return \c EXIT_SUCCESS when all entries completed,
+ * \c EXIT_FAILURE when the ring failed, \c errno is set.
+ */
+static int
+uring_submit
+(
+        uring_t *ring,
+                /*!< : the ring.*/
+        guint tail,
+                /*!< : the tail of the entries queued.*/
+        void (*complete) (guint64 user_data, gint result, gpointer data),
+                /*!< : is called for every completion.*/
+        gpointer data
+                /*!< : is passed to \c complete.*/
+)
+{
+        struct io_uring_cqe *cqe;
+        guint head;
+        guint submit;
+        guint pending;
+        gint submitted;
+
+        submit = tail - *ring->sq_tail;
+        __atomic_store_n (ring->sq_tail, tail, __ATOMIC_RELEASE);
+        pending = submit;
+        while (pending > 0)
+        {
+                submitted = syscall (__NR_io_uring_enter, ring->fd, submit,
+                        pending, IORING_ENTER_GETEVENTS, NULL, 0);
+                if (submitted < 0)
+                {
+                        if (errno == EINTR)
+                        {
+                                continue;
+                        }
+                        return (EXIT_FAILURE);
+                }
+                submit -= submitted;
+                head = *ring->cq_head;
+                while (head != __atomic_load_n (ring->cq_tail, __ATOMIC_ACQUIRE))
+                {
+                        cqe = &((struct io_uring_cqe *) ring->cqes)[head & *ring->cq_mask];
+                        complete (cqe->user_data, cqe->res, data);
+                        head++;
+                        pending--;
+                }
+                __atomic_store_n (ring->cq_head, head, __ATOMIC_RELEASE);
+        }
+        return (EXIT_SUCCESS);
+}
+
+
+/*!
+ * \brief Store the result of an entry of a batch in the results of the
+ * batch.
+ *
+ * The \c user_data is the index in the batch.
+ */
+static void
+uring_store_result
+(
+        guint64 user_data,
+                /*!< : is the index in the batch.*/
+        gint result,
+                /*!< : is the result of the entry.*/
+        gpointer data
+                /*!< : are the results of the batch.*/
+)
+{
+        ((gint *) data)[user_data] = result;
+}
+#endif /* HAVE_LINUX_IO_URING_H */
+
+
+/*!
+ * \brief Free a ring.
+ */
+void
+uring_free
+(
+        uring_t *ring
+                /*!< : the ring, may be \c NULL.*/
+)
+{
+        if (!ring)
+        {
+                return;
+        }
+        if (ring->sqes)
+        {
+                munmap (ring->sqes, ring->sqes_size);
+        }
+        if (ring->cq_ring && (ring->cq_ring != ring->sq_ring))
+        {
+                munmap (ring->cq_ring, ring->cq_ring_size);
+        }
+        if (ring->sq_ring)
+        {
+                munmap (ring->sq_ring, ring->sq_ring_size);
+        }
+        if (ring->fd >= 0)
+        {
+                close (ring->fd);
+        }
+        g_free (ring);
+}
+
+
+/*!
+ * \brief Set up a ring.
+ *
+ * \return the ring, \c NULL when io_uring is not available.
+ */
+uring_t *
+uring_new
+(
+        guint entries
+                /*!< : the number of submission queue entries, a power of
+                 * two.*/
+)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+        struct io_uring_params parameters;
+        uring_t *ring;
+
+        ring = g_new0 (uring_t, 1);
+        memset (&parameters, 0, sizeof (parameters));
+        ring->fd = syscall (__NR_io_uring_setup, entries, &parameters);
+        if (ring->fd < 0)
+        {
+                g_free (ring);
+                return (NULL);
+        }
+        ring->entries = parameters.sq_entries;
+        ring->sq_ring_size = parameters.sq_off.array + parameters.sq_entries * sizeof (guint);
+        ring->cq_ring_size = parameters.cq_off.cqes + parameters.cq_entries * sizeof (struct io_uring_cqe);
+        if (parameters.features & IORING_FEAT_SINGLE_MMAP)
+        {
+                ring->sq_ring_size = MAX (ring->sq_ring_size, ring->cq_ring_size);
+                ring->cq_ring_size = ring->sq_ring_size;
+        }
+        ring->sq_ring = mmap (NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+        if (ring->sq_ring == MAP_FAILED)
+        {
+                ring->sq_ring = NULL;
+                uring_free (ring);
+                return (NULL);
+        }
+        if (parameters.features & IORING_FEAT_SINGLE_MMAP)
+        {
+                ring->cq_ring = ring->sq_ring;
+        }
+        else
+        {
+                ring->cq_ring = mmap (NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+                if (ring->cq_ring == MAP_FAILED)
+                {
+                        ring->cq_ring = NULL;
+                        uring_free (ring);
+                        return (NULL);
+                }
+        }
+        ring->sqes_size = parameters.sq_entries * sizeof (struct io_uring_sqe);
+        ring->sqes = mmap (NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+        if (ring->sqes == MAP_FAILED)
+        {
+                ring->sqes = NULL;
+                uring_free (ring);
+                return (NULL);
+        }
+        ring->sq_head = (guint *) ((gchar *) ring->sq_ring + parameters.sq_off.head);
+        ring->sq_tail = (guint *) ((gchar *) ring->sq_ring + parameters.sq_off.tail);
+        ring->sq_mask = (guint *) ((gchar *) ring->sq_ring + parameters.sq_off.ring_mask);
+        ring->sq_array = (guint *) ((gchar *) ring->sq_ring + parameters.sq_off.array);
+        ring->cq_head = (guint *) ((gchar *) ring->cq_ring + parameters.cq_off.head);
+        ring->cq_tail = (guint *) ((gchar *) ring->cq_ring + parameters.cq_off.tail);
+        ring->cq_mask = (guint *) ((gchar *) ring->cq_ring + parameters.cq_off.ring_mask);
+        ring->cqes = (gchar *) ring->cq_ring + parameters.cq_off.cqes;
+        return (ring);
+#else
+        return (NULL);
+#endif /* HAVE_LINUX_IO_URING_H */
+}
+
+
+/*!
+ * \brief Write a file with pwrite ().
+ *
+ * This is the fallback when io_uring is not available.
+ *
+ * \return \c EXIT_SUCCESS when the file was written,
+ * \c EXIT_FAILURE when it was not, \c errno is set.
+ */
+int
+uring_pwrite_file
+(
+        const gchar *filename,
+                /*!< : the name of the file.*/
+        const gchar *text,
+                /*!< : the contents of the file.*/
+        gsize size
+                /*!< : the size of the contents.*/
+)
+{
+        gssize written;
+        gsize offset = 0;
+        gint fd;
+        gint error;
+
+        fd = open (filename, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+        {
+                return (EXIT_FAILURE);
+        }
+        while (offset < size)
+        {
+                written = pwrite (fd, text + offset, size - offset, offset);
+                if ((written < 0) && (errno == EINTR))
+                {
+                        continue;
+                }
+                if (written <= 0)
+                {
+                        error = (written < 0) ? errno : EIO;
+                        close (fd);
+                        errno = error;
+                        return (EXIT_FAILURE);
+                }
+                offset += written;
+        }
+        return ((close (fd) == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+
+/*!
+ * \brief Write a batch of files through a ring.
+ *
+ * The files are opened with one submission, then every file is written
+ * with one write of its whole text, linked to its close, in a second
+ * submission.\n
+ * A short write breaks the link, the rest of that file is written with
+ * pwrite () and it is closed directly.\n
+ * The number of files may be at most half the entries of the ring.
+ *
+ * \return \c EXIT_SUCCESS when the batch went through the ring, the
+ * result of every file is in \c errors, \c EXIT_FAILURE when the ring
+ * failed, the files are to be written by uring_pwrite_file () and the
+ * ring is not to be used again.
+ */
+int
+uring_write_files
+(
+        uring_t *ring,
+                /*!< : the ring.*/
+        guint n,
+                /*!< : the number of files.*/
+        gchar **filenames,
+                /*!< : the names of the files.*/
+        gchar **texts,
+                /*!< : the contents of the files.*/
+        gsize *sizes,
+                /*!< : the sizes of the contents.*/
+        gint *errors
+                /*!< : is set to 0 for every file written, or to the
+                 * error number.*/
+)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+        struct io_uring_sqe *sqe;
+        gint *fds;
+        gint *results;
+        guint tail;
+        guint i;
+
+        if ((n == 0) || (2 * n > ring->entries))
+        {
+                return ((n == 0) ? EXIT_SUCCESS : EXIT_FAILURE);
+        }
+        fds = g_new (gint, n);
+        results = g_new0 (gint, 2 * n);
+        for (i = 0; i < n; i++)
+        {
+                fds[i] = -ECANCELED;
+        }
+        /* Open all files. */
+        tail = *ring->sq_tail;
+        for (i = 0; i < n; i++)
+        {
+                sqe = uring_get_sqe (ring, &tail);
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = (guint64) (guintptr) filenames[i];
+                sqe->open_flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+                sqe->len = 0644;
+                sqe->user_data = i;
+        }
+        if (uring_submit (ring, tail, uring_store_result, fds) == EXIT_FAILURE)
+        {
+                for (i = 0; i < n; i++)
+                {
+                        if (fds[i] >= 0)
+                        {
+                                close (fds[i]);
+                        }
+                }
+                g_free (fds);
+                g_free (results);
+                return (EXIT_FAILURE);
+        }
+        /* Write and close the files which were opened. */
+        tail = *ring->sq_tail;
+        for (i = 0; i < n; i++)
+        {
+                if (fds[i] < 0)
+                {
+                        continue;
+                }
+                sqe = uring_get_sqe (ring, &tail);
+                sqe->opcode = IORING_OP_WRITE;
+                sqe->fd = fds[i];
+                sqe->addr = (guint64) (guintptr) texts[i];
+                sqe->len = sizes[i];
+                sqe->off = 0;
+                sqe->flags = IOSQE_IO_LINK;
+                sqe->user_data = 2 * i;
+                sqe = uring_get_sqe (ring, &tail);
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = fds[i];
+                sqe->user_data = 2 * i + 1;
+        }
+        if (uring_submit (ring, tail, uring_store_result, results) == EXIT_FAILURE)
+        {
+                /* The files were opened, their descriptors are lost in
+                 * the ring, so close them here. */
+                for (i = 0; i < n; i++)
+                {
+                        if (fds[i] >= 0)
+                        {
+                                close (fds[i]);
+                        }
+                }
+                g_free (fds);
+                g_free (results);
+                return (EXIT_FAILURE);
+        }
+        for (i = 0; i < n; i++)
+        {
+                errors[i] = 0;
+                if (fds[i] < 0)
+                {
+                        errors[i] = -fds[i];
+                }
+                else if ((results[2 * i] >= 0) && ((gsize) results[2 * i] < sizes[i]))
+                {
+                        /* A short write, the close was cancelled. */
+                        if (pwrite (fds[i], texts[i] + results[2 * i],
+                                sizes[i] - results[2 * i], results[2 * i]) != (gssize) (sizes[i] - results[2 * i]))
+                        {
+                                errors[i] = EIO;
+                        }
+                        if (close (fds[i]) != 0)
+                        {
+                                errors[i] = errno;
+                        }
+                }
+                else if (results[2 * i] < 0)
+                {
+                        errors[i] = -results[2 * i];
+                        if (results[2 * i + 1] == -ECANCELED)
+                        {
+                                close (fds[i]);
+                        }
+                }
+                else if (results[2 * i + 1] < 0)
+                {
+                        errors[i] = -results[2 * i + 1];
+                }
+        }
+        g_free (fds);
+        g_free (results);
+        return (EXIT_SUCCESS);
+#else
+        return (EXIT_FAILURE);
+#endif /* HAVE_LINUX_IO_URING_H */
+}
+
+
+/* EOF */
@@ -0,0 +1,87 @@
+/*!
+ * \file src/uring.h
+ *
+ * \author Copyright (C) 2007-2011 by Bert Timmerman <bert.timmerman@xs4all.nl>
+ *
+ * \brief Header file for writing batches of files through io_uring.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.\n
+ * \n
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.\n
+ * \n
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.\n
+ */
+
+
+#ifndef __URING_INCLUDED__
+#define __URING_INCLUDED__
+
+G_BEGIN_DECLS /* keep c++ happy */
+
+
+/*!
+ * \brief An io_uring instance, the submission and completion rings are
+ * mapped from the kernel.
+ */
+typedef struct uring
+{
+        gint fd;
+                /*!< : is the file descriptor of the io_uring.*/
+        guint entries;
+                /*!< : is the number of submission queue entries.*/
+        guint *sq_head;
+                /*!< : is the head of the submission ring, moved by the
+                 * kernel.*/
+        guint *sq_tail;
+                /*!< : is the tail of the submission ring.*/
+        guint *sq_mask;
+                /*!< : is the mask of the submission ring.*/
+        guint *sq_array;
+                /*!< : are the indices of the submitted entries.*/
+        gpointer sqes;
+                /*!< : are the submission queue entries.*/
+        guint *cq_head;
+                /*!< : is the head of the completion ring.*/
+        guint *cq_tail;
+                /*!< : is the tail of the completion ring, moved by the
+                 * kernel.*/
+        guint *cq_mask;
+                /*!< : is the mask of the completion ring.*/
+        gpointer cqes;
+                /*!< : are the completion queue entries.*/
+        gpointer sq_ring;
+                /*!< : is the mapping of the submission ring.*/
+        gsize sq_ring_size;
+                /*!< : is the size of the mapping of the submission
+                 * ring.*/
+        gpointer cq_ring;
+                /*!< : is the mapping of the completion ring, the same as
+                 * \c sq_ring when the kernel maps both at once.*/
+        gsize cq_ring_size;
+                /*!< : is the size of the mapping of the completion
+                 * ring.*/
+        gsize sqes_size;
+                /*!< : is the size of the mapping of the entries.*/
+} uring_t;
+
+
+void uring_free (uring_t *ring);
+uring_t *uring_new (guint entries);
+int uring_pwrite_file (const gchar *filename, const gchar *text, gsize size);
+int uring_write_files (uring_t *ring, guint n, gchar **filenames, gchar **texts, gsize *sizes, gint *errors);
+
+G_END_DECLS /* keep c++ happy */
+
+#endif /* __URING_INCLUDED__ */
+
+
+/* EOF */